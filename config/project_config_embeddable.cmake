@@ -305,6 +305,13 @@ macro (get_external_libs)
   set (PROJ_DEP_LIBS_FOR_PYEXT "")
   set (PROJ_DEP_LIBS_FOR_BIN "")
   set (PROJ_DEP_LIBS_FOR_TST "")
+
+  # The C++ Standard threads (e.g., std::thread, std::mutex) may require
+  # a dedicated library (e.g., pthread)
+  find_package (Threads REQUIRED)
+  list (APPEND PROJ_DEP_LIBS_FOR_LIB ${CMAKE_THREAD_LIBS_INIT})
+  list (APPEND PROJ_DEP_LIBS_FOR_TST ${CMAKE_THREAD_LIBS_INIT})
+
   foreach (_arg ${ARGV})
     string (TOLOWER ${_arg} _arg_lower_full)
 
@@ -0,0 +1,132 @@
+#ifndef __OPENTREP_DOCUMENTFORMAT_HPP
+#define __OPENTREP_DOCUMENTFORMAT_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Enumeration of the formats of the Xapian document data and of
+   *        the serialised_place column of the SQL database, i.e., of the
+   *        serialised POR (points of reference).
+   *
+   * <ul>
+   *   <li>CSV: the raw line of the OPTD-maintained POR data file, as is.
+   *       It has to be parsed by the search process.</li>
+   *   <li>Binary: a compact binary encoding of the Location structure
+   *       (see LocationSerialiser), the scalar fields of which may be
+   *       read without decoding the rest. It keeps the raw POR line,
+   *       and is stored in its (Base64) text form within the SQL
+   *       database.</li>
+   * </ul>
+   */
+  struct DocumentFormat {
+  public:
+    typedef enum {
+      CSV = 0,
+      BINARY,
+      LAST_VALUE
+    } EN_DocumentFormat;
+
+    /**
+     * Get the label as a string (e.g., "CSV" or "Binary").
+     */
+    static const std::string& getLabel (const EN_DocumentFormat&);
+
+    /**
+     * Get the format value from parsing a single char (e.g., 'C' or 'B').
+     */
+    static EN_DocumentFormat getFormat (const char);
+
+    /**
+     * Get the label as a single char (e.g., 'C' or 'B').
+     */
+    static char getFormatLabel (const EN_DocumentFormat&);
+
+    /**
+     * Get the label as a string of a single char (e.g., "C" or "B").
+     */
+    static std::string getFormatLabelAsString (const EN_DocumentFormat&);
+
+    /**
+     * List the labels.
+     */
+    static std::string describeLabels();
+
+    /**
+     * Get the enumerated value.
+     */
+    EN_DocumentFormat getFormat() const;
+
+    /**
+     * Get the enumerated value as a short string (e.g., 'C' or 'B').
+     */
+    char getFormatAsChar() const;
+    
+    /**
+     * Get the enumerated value as a short string (e.g., "C" or "B").
+     */
+    std::string getFormatAsString() const;
+    
+    /**
+     * Give a description of the structure (e.g., "CSV" or "Binary").
+     */
+    const std::string describe() const;
+
+  public:
+    /**
+     * Comparison operator.
+     */
+    bool operator== (const EN_DocumentFormat&) const;
+    
+  public:
+    /**
+     * Main constructor.
+     */
+    DocumentFormat (const EN_DocumentFormat&);
+    /**
+     * Alternative constructor.
+     */
+    DocumentFormat (const char iFormat);
+    /**
+     * Alternative constructor.
+     */
+    DocumentFormat (const std::string& iFormat);
+    /**
+     * Default copy constructor.
+     */
+    DocumentFormat (const DocumentFormat&);
+
+  private:
+    /**
+     * Default constructor.
+     */
+    DocumentFormat();
+
+
+  private:
+    /**
+     * String version of the enumeration.
+     */
+    static const std::string _labels[LAST_VALUE];
+    /**
+     * Format version of the enumeration.
+     */
+    static const char _formatLabels[LAST_VALUE];
+
+  private:
+    // //////// Attributes /////////
+    /**
+     * Document format.
+     */
+    EN_DocumentFormat _format;
+  };
+
+}
+#endif // __OPENTREP_DOCUMENTFORMAT_HPP
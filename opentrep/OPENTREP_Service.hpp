@@ -10,6 +10,7 @@
 // OpenTREP
 #include <opentrep/OPENTREP_Types.hpp>
 #include <opentrep/DBType.hpp>
+#include <opentrep/DocumentFormat.hpp>
 #include <opentrep/LocationList.hpp>
 #include <opentrep/DistanceErrorRule.hpp>
 
@@ -48,6 +49,29 @@ namespace OPENTREP {
      * Match the given string, thanks to a full-text search on the
      * underlying Xapian index (named "database").
      *
+     * That method may be called concurrently, from several threads, on the
+     * same OPENTREP_Service instance (thread-safe query mode):
+     * <ul>
+     *   <li>the BOM objects of every request are allocated from an arena
+     *       local to that request (see BomArena), and are therefore not
+     *       shared with the other requests;</li>
+     *   <li>every thread is given its own Unicode transliterator and its
+     *       own handle on the Xapian index, both created at the first
+     *       query of the thread and released when the thread exits;</li>
+     *   <li>the cache of the query results, if enabled (see
+     *       setQueryResultCacheLimits()), is split into stripes, each
+     *       protected by its own lock;</li>
+     *   <li>the log entries are serialised by the Logger, but those
+     *       filtered out by the log level are neither formatted nor
+     *       serialised;</li>
+     *   <li>the factories and the Logger, once created, are reached
+     *       without any lock.</li>
+     * </ul>
+     * The other methods of the service (e.g., the ones re-building the
+     * index or altering the deployment number), except the ones of the
+     * query result cache, must not be called while queries are being
+     * performed.
+     *
      * @param const std::string& (Travel-related) query string (e.g.,
      *        "sna francicso rio de janero lso angles reykyavki nce iev mow").
      * @param LocationList_T& List of (geographical) locations, if any,
@@ -58,6 +82,42 @@ namespace OPENTREP {
     NbOfMatches_T interpretTravelRequest (const std::string& iTravelQuery,
                                           LocationList_T&, WordList_T&);
 
+    /**
+     * Set the limits of the cache of the results of the travel queries
+     * (see interpretTravelRequest()). The cached results are then removed.
+     *
+     * The results are cached by travel query, taken as is (the results
+     * hold the original keywords and the unmatched words of the query),
+     * for the current deployment number and Xapian index. As long as the size is 0 (the default), the results
+     * are not cached. The cache is emptied whenever the Xapian index is
+     * re-built or the deployment number is toggled.
+     *
+     * @param const NbOfDBEntries_T& Maximum number of travel queries held
+     *        by the cache (0 meaning no caching at all).
+     * @param const NbOfSeconds_T& Time-to-live, in seconds, of the cached
+     *        results (0 meaning that they never expire).
+     */
+    void setQueryResultCacheLimits (const NbOfDBEntries_T&,
+                                    const NbOfSeconds_T&);
+
+    /**
+     * Remove all the results from the cache of the travel queries. That
+     * method may be called while queries are being performed.
+     */
+    void clearQueryResultCache();
+
+    /**
+     * Get the number of travel queries the results of which have been
+     * found in the cache, since the service has been initialised.
+     */
+    NbOfLookups_T getNbOfQueryResultCacheHits() const;
+
+    /**
+     * Get the number of travel queries the results of which have not been
+     * found in the cache (or had expired), while that latter was enabled.
+     */
+    NbOfLookups_T getNbOfQueryResultCacheMisses() const;
+
 
     /**
      * Get the file-paths of the Xapian database/index and of the OPTD-maintained
@@ -159,6 +219,58 @@ namespace OPENTREP {
      */
     OPENTREP::shouldAddPORInSQLDB_T toggleShouldAddPORInSQLDBFlag();
 
+    /**
+     * Set the format of the data of the Xapian documents and of the
+     * serialised places of the SQL database, to be used by the next
+     * (re-)indexation (see insertIntoDBAndXapian()).
+     *
+     * @param const DocumentFormat& Format (raw CSV POR line or compact
+     *        binary encoding).
+     */
+    void setDocumentFormat (const DocumentFormat&);
+
+    /**
+     * Set the number of rows loaded into the SQL database within a single
+     * transaction, to be used by the next (re-)indexation (see
+     * insertIntoDBAndXapian()).
+     *
+     * @param const NbOfDBEntries_T& Number of rows per transaction (at
+     *        least 1).
+     */
+    void setSQLDBBulkLoadBatchSize (const NbOfDBEntries_T&);
+
+    /**
+     * Set the number of worker threads parsing the POR and building their
+     * Xapian documents, to be used by the next (re-)indexation (see
+     * insertIntoDBAndXapian()).
+     *
+     * @param const NbOfThreads_T& Number of worker threads (0 meaning one
+     *        per hardware thread, 1 meaning no pipeline at all).
+     */
+    void setNbOfIndexingThreads (const NbOfThreads_T&);
+
+    /**
+     * Set the number of Xapian shards, to be used by the next
+     * (re-)indexation (see insertIntoDBAndXapian()). The POR file is then
+     * split into as many contiguous ranges, indexed in parallel into
+     * partial Xapian databases, which are eventually merged (compacted)
+     * into the Xapian database/index.
+     *
+     * @param const NbOfShards_T& Number of shards (0 or 1 meaning no shard).
+     */
+    void setNbOfIndexingShards (const NbOfShards_T&);
+
+    /**
+     * Set the maximum span, in number of words, of the word combinations
+     * indexed for the alternate names of the POR, to be used by the next
+     * (re-)indexation (see insertIntoDBAndXapian()). Bounding that span
+     * reduces the number of terms (and spelling terms) of the Xapian index,
+     * as well as the indexing time, for the POR having long names.
+     *
+     * @param const NbOfWords_T& Maximum span (0 meaning no maximum).
+     */
+    void setMaxWordCombinationSpan (const NbOfWords_T&);
+
     /**
      * From the file of OPTD-maintained POR (points of reference):
      * <ul>
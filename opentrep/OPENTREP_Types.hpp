@@ -649,6 +649,16 @@ namespace OPENTREP {
    */
   typedef unsigned int XapianDocID_T;
 
+  /**
+   * Number of a value slot of a Xapian document.
+   */
+  typedef unsigned int XapianValueSlot_T;
+
+  /**
+   * Version of the format of the Xapian index.
+   */
+  typedef std::string XapianIndexFormatVersion_T;
+
   /**
    * Weight when indexing terms of a Xapian document.
    */
@@ -679,6 +689,26 @@ namespace OPENTREP {
    */
   typedef unsigned int NbOfDBEntries_T;
   
+  /**
+   * Number of look-ups (e.g., into a cache).
+   */
+  typedef unsigned long long NbOfLookups_T;
+
+  /**
+   * Duration, in seconds (e.g., time-to-live of the cached query results).
+   */
+  typedef unsigned int NbOfSeconds_T;
+
+  /**
+   * Number of threads (e.g., of the indexing pipeline).
+   */
+  typedef unsigned short NbOfThreads_T;
+
+  /**
+   * Number of shards (i.e., of partial Xapian databases/indexes).
+   */
+  typedef unsigned short NbOfShards_T;
+
   /**
    * Word, which is the atomic element of a query string.
    */
@@ -107,6 +107,94 @@ namespace OPENTREP {
    */
   const bool DEFAULT_OPENTREP_ADD_IN_DB (false);
 
+  /**
+   * Format of the data of the Xapian documents.
+   *
+   * By default, store the raw CSV POR line.
+   */
+  const char DEFAULT_OPENTREP_DOCUMENT_FORMAT ('C');
+
+  /**
+   * Number of connections of the pool of connections to the SQL database.
+   */
+  const unsigned short DEFAULT_OPENTREP_SQL_DB_POOL_SIZE (4);
+
+  /**
+   * Maximal time (in milliseconds) to wait for a pooled connection.
+   */
+  const int DEFAULT_OPENTREP_SQL_DB_POOL_LEASE_TIMEOUT (10000);
+
+  /**
+   * Idle time (in seconds) after which a pooled connection is checked.
+   */
+  const unsigned int DEFAULT_OPENTREP_SQL_DB_HEALTH_CHECK_INTERVAL (30);
+
+  /**
+   * Number of rows loaded into the SQL database per transaction.
+   */
+  const unsigned int DEFAULT_OPENTREP_SQL_DB_BULK_LOAD_BATCH_SIZE (10000);
+
+  /**
+   * Number of indexing worker threads (0 meaning one per hardware thread).
+   */
+  const unsigned short DEFAULT_OPENTREP_NB_OF_INDEXING_THREADS (0);
+
+  /**
+   * Number of lines of the POR file per indexing work item.
+   */
+  const unsigned int DEFAULT_OPENTREP_INDEXING_BATCH_SIZE (256);
+
+  /**
+   * Number of Xapian shards (1 meaning no shard at all).
+   */
+  const unsigned short DEFAULT_OPENTREP_NB_OF_INDEXING_SHARDS (1);
+
+  /**
+   * Suffix of the directories of the Xapian shards.
+   */
+  const std::string DEFAULT_OPENTREP_XAPIAN_SHARD_SUFFIX ("_shard");
+
+  /**
+   * Maximum span of the indexed word combinations (0 meaning no maximum).
+   */
+  const unsigned short DEFAULT_OPENTREP_MAX_WORD_COMBINATION_SPAN (0);
+
+  /**
+   * Maximum number of Unicode normalisations cached by indexing thread.
+   */
+  const unsigned int DEFAULT_OPENTREP_NORMALISATION_CACHE_SIZE (100000);
+
+  /**
+   * Expected rate of false positives of the vocabulary sketch (1%).
+   */
+  const double DEFAULT_OPENTREP_VOCABULARY_SKETCH_FALSE_POSITIVE_RATE (0.01);
+
+  /**
+   * Maximum number of travel queries cached (0 meaning no caching).
+   */
+  const unsigned int DEFAULT_OPENTREP_QUERY_RESULT_CACHE_SIZE (0);
+
+  /**
+   * Time-to-live of the cached query results (1 hour).
+   */
+  const unsigned int DEFAULT_OPENTREP_QUERY_RESULT_CACHE_TTL (3600);
+
+  /**
+   * Number of stripes (locks) of the query result cache.
+   */
+  const unsigned short DEFAULT_OPENTREP_QUERY_RESULT_CACHE_NB_OF_STRIPES (16);
+
+  /**
+   * Maximum number of spelling suggestions cached by process.
+   */
+  const unsigned int DEFAULT_OPENTREP_SPELLING_SUGGESTION_CACHE_SIZE (100000);
+
+  /**
+   * Number of stripes (locks) of the spelling suggestion cache.
+   */
+  const unsigned short
+  DEFAULT_OPENTREP_SPELLING_SUGGESTION_CACHE_NB_OF_STRIPES (16);
+
   /**
    * Default date-time with std::tm structure as type.
    */
@@ -131,6 +219,12 @@ namespace OPENTREP {
   const char* K_ICU_QUOTATION_REMOVAL_RULE =
     "[\\u02B9] > \\u0027; [\\u002D] > \\u0020; [\\u201C] > \\u0020; [\\u201D] > \\u0020; [\\u0027] > \\u0020;";
 
+  /**
+   * Identifier of the Unicode transliterator for the removal of
+   * quotes (e.g., "RBTUnaccent")
+   */
+  const char* K_ICU_QUOTATION_REMOVAL_ID = "RBTUnaccent";
+
   /**
    * Default Unicode transliterator rule for the removal of
    * punctuation (e.g., "[:P:] Remove;")
@@ -204,6 +298,66 @@ namespace OPENTREP {
    */
   const NbOfWords_T K_DEFAULT_MAXIMUM_NUMBER_OF_WORDS_IN_STRING (14);
 
+  /**
+   * Maximum number of words a query slice may have (e.g., 64), when it is
+   * segmented (see StringSegmentation).
+   */
+  const NbOfWords_T K_DEFAULT_MAXIMUM_NUMBER_OF_WORDS_IN_QUERY_SLICE (64);
+
+  /**
+   * Key of the Xapian index metadata holding the version of the format
+   * of the index (e.g., "opentrep_index_format_version").
+   */
+  const std::string
+  K_XAPIAN_INDEX_FORMAT_VERSION_KEY ("opentrep_index_format_version");
+
+  /**
+   * Version of the format of the Xapian index built by that release
+   * (e.g., "3").
+   */
+  const XapianIndexFormatVersion_T K_XAPIAN_INDEX_FORMAT_VERSION ("3");
+
+  /**
+   * Name of the file, within the directory of the Xapian index, holding
+   * the vocabulary sketch of that index.
+   */
+  const std::string
+  K_XAPIAN_VOCABULARY_SKETCH_FILENAME ("opentrep_vocabulary_sketch.bin");
+
+  /**
+   * Version of the format of the vocabulary sketch file.
+   */
+  const std::string K_XAPIAN_VOCABULARY_SKETCH_FORMAT_VERSION ("1");
+
+  /**
+   * Value slots of the Xapian documents.
+   */
+  const XapianValueSlot_T K_XAPIAN_SLOT_IATA_CODE (0);
+  const XapianValueSlot_T K_XAPIAN_SLOT_LOCATION_TYPE (1);
+  const XapianValueSlot_T K_XAPIAN_SLOT_GEONAMES_ID (2);
+  const XapianValueSlot_T K_XAPIAN_SLOT_ENVELOPE_ID (3);
+  const XapianValueSlot_T K_XAPIAN_SLOT_PAGE_RANK (4);
+  const XapianValueSlot_T K_XAPIAN_SLOT_LATITUDE (5);
+  const XapianValueSlot_T K_XAPIAN_SLOT_LONGITUDE (6);
+  const XapianValueSlot_T K_XAPIAN_SLOT_ICAO_CODE (7);
+  const XapianValueSlot_T K_XAPIAN_SLOT_UNLOCODE_LIST (8);
+
+  /**
+   * Magic prefix of the binary-encoded Location structures.
+   */
+  const std::string K_LOCATION_BINARY_MAGIC ("\0OTB", 4);
+
+  /**
+   * Version of the binary encoding of the Location structures.
+   */
+  const unsigned char K_LOCATION_BINARY_FORMAT_VERSION (2);
+
+  /**
+   * Prefix of the text (Base64) form of the binary-encoded Location
+   * structures.
+   */
+  const std::string K_LOCATION_TEXT_PREFIX ("otb64:");
+
   /**
    * Black list, i.e., a list of words which should not be indexed
    * and/or searched for (e.g., "airport", "international").
@@ -70,6 +70,82 @@ namespace OPENTREP {
    */
   extern const NbOfWords_T K_DEFAULT_MAXIMUM_NUMBER_OF_WORDS_IN_STRING;
 
+  /**
+   * Maximum number of words a query slice may have (e.g., 64), when it is
+   * segmented (see StringSegmentation). As the segmentation does not
+   * enumerate all the partitions of the query slice, that maximum is much
+   * higher than K_DEFAULT_MAXIMUM_NUMBER_OF_WORDS_IN_STRING.
+   */
+  extern const NbOfWords_T K_DEFAULT_MAXIMUM_NUMBER_OF_WORDS_IN_QUERY_SLICE;
+
+  /**
+   * Key of the Xapian index metadata holding the version of the format
+   * of the index (e.g., "opentrep_index_format_version").
+   */
+  extern const std::string K_XAPIAN_INDEX_FORMAT_VERSION_KEY;
+
+  /**
+   * Version of the format of the Xapian index built by that release
+   * (e.g., "3"). The indexes built before the version 2 have no value slot,
+   * and their documents have to be parsed in order to get the ranking fields.
+   * The indexes built before the version 3 have no code slot (ICAO and
+   * UN/LOCODE codes), and their documents have to be parsed in order to
+   * build the dictionary of codes (see CodeDictionary).
+   */
+  extern const XapianIndexFormatVersion_T K_XAPIAN_INDEX_FORMAT_VERSION;
+
+  /**
+   * Name of the file, within the directory of the Xapian index, holding
+   * the vocabulary sketch of that index (see VocabularySketch).
+   */
+  extern const std::string K_XAPIAN_VOCABULARY_SKETCH_FILENAME;
+
+  /**
+   * Version of the format of the vocabulary sketch file (e.g., "1"). A file
+   * of another version is ignored, as if there were no sketch at all.
+   */
+  extern const std::string K_XAPIAN_VOCABULARY_SKETCH_FORMAT_VERSION;
+
+  /**
+   * Value slots of the Xapian documents, holding the fields used by the
+   * ranking rules and by the dictionary of codes, so that they do not need
+   * to parse the document data. The numbers are serialised with
+   * Xapian::sortable_serialise(), and the UN/LOCODE codes are separated
+   * by spaces.
+   */
+  extern const XapianValueSlot_T K_XAPIAN_SLOT_IATA_CODE;
+  extern const XapianValueSlot_T K_XAPIAN_SLOT_LOCATION_TYPE;
+  extern const XapianValueSlot_T K_XAPIAN_SLOT_GEONAMES_ID;
+  extern const XapianValueSlot_T K_XAPIAN_SLOT_ENVELOPE_ID;
+  extern const XapianValueSlot_T K_XAPIAN_SLOT_PAGE_RANK;
+  extern const XapianValueSlot_T K_XAPIAN_SLOT_LATITUDE;
+  extern const XapianValueSlot_T K_XAPIAN_SLOT_LONGITUDE;
+  extern const XapianValueSlot_T K_XAPIAN_SLOT_ICAO_CODE;
+  extern const XapianValueSlot_T K_XAPIAN_SLOT_UNLOCODE_LIST;
+
+  /**
+   * Magic prefix of the binary-encoded Location structures (see
+   * LocationSerialiser). As it starts with a null character, it cannot
+   * be mistaken for the beginning of a raw (CSV) POR line.
+   */
+  extern const std::string K_LOCATION_BINARY_MAGIC;
+
+  /**
+   * Version of the binary encoding of the Location structures, stored
+   * right after the magic prefix (e.g., 2). The version 1 did not hold
+   * the raw data string; it can still be decoded.
+   */
+  extern const unsigned char K_LOCATION_BINARY_FORMAT_VERSION;
+
+  /**
+   * Prefix of the text (Base64) form of the binary-encoded Location
+   * structures, as stored within the SQL database (see
+   * LocationSerialiser::encodeAsText()). A raw (CSV) POR line starts
+   * with a (possibly empty, upper-case) IATA code followed by a caret
+   * ('^'), so that it cannot be mistaken for that prefix.
+   */
+  extern const std::string K_LOCATION_TEXT_PREFIX;
+
   /**
    * Default "black list".
    */
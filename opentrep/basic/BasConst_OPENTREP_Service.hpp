@@ -157,5 +157,124 @@ namespace OPENTREP {
    */
   extern const bool DEFAULT_OPENTREP_ADD_IN_DB;
 
+  /**
+   * Format of the data of the Xapian documents (e.g., 'C' for the raw
+   * CSV POR line, 'B' for the compact binary encoding).
+   *
+   * By default, store the raw CSV POR line.
+   */
+  extern const char DEFAULT_OPENTREP_DOCUMENT_FORMAT;
+
+  /**
+   * Number of connections of the pool of connections to the SQL database
+   * (see DBConnectionPool).
+   */
+  extern const unsigned short DEFAULT_OPENTREP_SQL_DB_POOL_SIZE;
+
+  /**
+   * Maximal time (in milliseconds) to wait for a connection of the pool
+   * to be available.
+   */
+  extern const int DEFAULT_OPENTREP_SQL_DB_POOL_LEASE_TIMEOUT;
+
+  /**
+   * Idle time (in seconds) after which a pooled connection to the SQL
+   * database is checked before being used again.
+   */
+  extern const unsigned int DEFAULT_OPENTREP_SQL_DB_HEALTH_CHECK_INTERVAL;
+
+  /**
+   * Number of rows loaded into the SQL database within a single transaction
+   * when the POR are (re-)indexed (see DBBulkLoader).
+   */
+  extern const unsigned int DEFAULT_OPENTREP_SQL_DB_BULK_LOAD_BATCH_SIZE;
+
+  /**
+   * Number of worker threads parsing the POR and building their Xapian
+   * documents when the POR are (re-)indexed (see IndexBuilder).
+   *
+   * By default (0), there are as many worker threads as hardware threads.
+   */
+  extern const unsigned short DEFAULT_OPENTREP_NB_OF_INDEXING_THREADS;
+
+  /**
+   * Number of lines of the POR file handed over at once to an indexing
+   * worker thread.
+   */
+  extern const unsigned int DEFAULT_OPENTREP_INDEXING_BATCH_SIZE;
+
+  /**
+   * Number of shards, i.e. of partial Xapian databases/indexes built in
+   * parallel and then merged (compacted) into the final one, when the POR
+   * are (re-)indexed (see IndexBuilder).
+   *
+   * By default (1), the Xapian database/index is built directly, without
+   * any shard.
+   */
+  extern const unsigned short DEFAULT_OPENTREP_NB_OF_INDEXING_SHARDS;
+
+  /**
+   * Suffix of the directories of the Xapian shards, appended to the
+   * file-path of the Xapian database/index, and followed by the rank of
+   * the shard.
+   */
+  extern const std::string DEFAULT_OPENTREP_XAPIAN_SHARD_SUFFIX;
+
+  /**
+   * Maximum span, in number of words, of the word combinations derived
+   * from the alternate names of the POR, when the POR are (re-)indexed
+   * (see WordCombinationHolder).
+   *
+   * By default (0), there is no maximum: all the contiguous groups of words
+   * and all the skip-grams are indexed.
+   */
+  extern const unsigned short DEFAULT_OPENTREP_MAX_WORD_COMBINATION_SPAN;
+
+  /**
+   * Maximum number of Unicode normalisations kept in the cache of every
+   * indexing thread (see NormalisationCache).
+   */
+  extern const unsigned int DEFAULT_OPENTREP_NORMALISATION_CACHE_SIZE;
+
+  /**
+   * Expected rate of false positives of the Bloom filters of the vocabulary
+   * sketch, built along with the Xapian index (see VocabularySketch).
+   */
+  extern const double DEFAULT_OPENTREP_VOCABULARY_SKETCH_FALSE_POSITIVE_RATE;
+
+  /**
+   * Maximum number of travel queries, the results of which are kept in
+   * the cross-query result cache (see QueryResultCache).
+   *
+   * By default (0), the results are not cached: every travel query is
+   * interpreted on the Xapian index.
+   */
+  extern const unsigned int DEFAULT_OPENTREP_QUERY_RESULT_CACHE_SIZE;
+
+  /**
+   * Time-to-live, in seconds, of the results kept in the cross-query
+   * result cache (0 meaning that they never expire).
+   */
+  extern const unsigned int DEFAULT_OPENTREP_QUERY_RESULT_CACHE_TTL;
+
+  /**
+   * Number of stripes of the cross-query result cache, i.e., of parts
+   * of that cache protected by distinct locks.
+   */
+  extern const unsigned short DEFAULT_OPENTREP_QUERY_RESULT_CACHE_NB_OF_STRIPES;
+
+  /**
+   * Maximum number of spelling suggestions, including the absences of
+   * suggestion, kept in the process-wide cache (see SpellingSuggestionCache).
+   */
+  extern const unsigned int DEFAULT_OPENTREP_SPELLING_SUGGESTION_CACHE_SIZE;
+
+  /**
+   * Number of stripes of the spelling suggestion cache, i.e., of parts
+   * of that cache protected by distinct locks.
+   */
+  extern const unsigned short
+  DEFAULT_OPENTREP_SPELLING_SUGGESTION_CACHE_NB_OF_STRIPES;
+
 }
 #endif // __OPENTREP_BAS_BASCONST_OPENTREP_SERVICE_HPP
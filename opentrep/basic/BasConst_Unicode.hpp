@@ -19,6 +19,12 @@ namespace OPENTREP {
    */
   extern const char* K_ICU_QUOTATION_REMOVAL_RULE;
 
+  /**
+   * Identifier under which the Unicode transliterator for the removal of
+   * quotes (built from the above rule) is registered (e.g., "RBTUnaccent").
+   */
+  extern const char* K_ICU_QUOTATION_REMOVAL_ID;
+
   /**
    * Default Unicode transliterator rule for the removal of
    * punctuation (e.g., "[:P:] Remove;")
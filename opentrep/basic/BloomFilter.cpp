@@ -0,0 +1,152 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cmath>
+#include <istream>
+#include <ostream>
+#include <sstream>
+// OpenTrep
+#include <opentrep/basic/BloomFilter.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  BloomFilter::BloomFilter()
+    : _nbOfItems (0), _nbOfBits (0), _nbOfHashes (0) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  BloomFilter::~BloomFilter() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  BloomFilter::HashValue_T BloomFilter::hash (const std::string& iString) {
+    HashValue_T oHash = 14695981039346656037ULL;
+    for (std::string::const_iterator itChar = iString.begin();
+         itChar != iString.end(); ++itChar) {
+      oHash ^= static_cast<unsigned char> (*itChar);
+      oHash *= 1099511628211ULL;
+    }
+    return oHash;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void BloomFilter::reset (const NbOfDBEntries_T& iNbOfItems,
+                           const Percentage_T& iFalsePositiveRate) {
+    assert (iFalsePositiveRate > 0.0 && iFalsePositiveRate < 1.0);
+    _nbOfItems = iNbOfItems;
+
+    // Optimal number of bits, m = - n ln(p) / ln(2)^2, and of hash
+    // functions, k = (m / n) ln(2)
+    const double lLn2 = std::log (2.0);
+    const double lNbOfBits =
+      - static_cast<double> (iNbOfItems) * std::log (iFalsePositiveRate)
+      / (lLn2 * lLn2);
+    _nbOfBits = static_cast<NbOfBits_T> (std::ceil (lNbOfBits));
+    if (_nbOfBits < 64) {
+      _nbOfBits = 64;
+    }
+
+    _nbOfHashes = 1;
+    if (iNbOfItems != 0) {
+      const double lNbOfHashes =
+        static_cast<double> (_nbOfBits) / iNbOfItems * lLn2;
+      _nbOfHashes = static_cast<NbOfHashes_T> (std::floor (lNbOfHashes + 0.5));
+    }
+    if (_nbOfHashes < 1) {
+      _nbOfHashes = 1;
+    }
+    if (_nbOfHashes > 16) {
+      _nbOfHashes = 16;
+    }
+
+    _bitList.assign ((_nbOfBits + 7) / 8, 0);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  BloomFilter::NbOfBits_T BloomFilter::
+  getBitPosition (const HashValue_T& iHash,
+                  const NbOfHashes_T& iHashRank) const {
+    assert (_nbOfBits != 0);
+
+    // Second hash, derived from the first one by a bit mixer. It is odd,
+    // so that the successive positions do not collapse
+    HashValue_T lSecondHash = iHash;
+    lSecondHash ^= lSecondHash >> 33;
+    lSecondHash *= 0xff51afd7ed558ccdULL;
+    lSecondHash ^= lSecondHash >> 33;
+    lSecondHash |= 1ULL;
+
+    return (iHash + iHashRank * lSecondHash) % _nbOfBits;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void BloomFilter::insert (const HashValue_T& iHash) {
+    for (NbOfHashes_T lHashRank = 0; lHashRank != _nbOfHashes; ++lHashRank) {
+      const NbOfBits_T lBitPosition = getBitPosition (iHash, lHashRank);
+      _bitList[lBitPosition / 8] |=
+        static_cast<unsigned char> (1U << (lBitPosition % 8));
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool BloomFilter::mayContain (const HashValue_T& iHash) const {
+    if (_bitList.empty() == true) {
+      return false;
+    }
+
+    for (NbOfHashes_T lHashRank = 0; lHashRank != _nbOfHashes; ++lHashRank) {
+      const NbOfBits_T lBitPosition = getBitPosition (iHash, lHashRank);
+      if ((_bitList[lBitPosition / 8] & (1U << (lBitPosition % 8))) == 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void BloomFilter::toStream (std::ostream& ioOut) const {
+    ioOut << _nbOfItems << " " << _nbOfBits << " " << _nbOfHashes << "\n";
+    if (_bitList.empty() == false) {
+      ioOut.write (reinterpret_cast<const char*> (&_bitList[0]),
+                   _bitList.size());
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool BloomFilter::fromStream (std::istream& ioIn) {
+    _nbOfItems = 0; _nbOfBits = 0; _nbOfHashes = 0;
+    _bitList.clear();
+
+    NbOfDBEntries_T lNbOfItems = 0;
+    NbOfBits_T lNbOfBits = 0;
+    NbOfHashes_T lNbOfHashes = 0;
+    ioIn >> lNbOfItems >> lNbOfBits >> lNbOfHashes;
+    if (!ioIn || ioIn.get() != '\n' || lNbOfBits == 0 || lNbOfHashes == 0) {
+      return false;
+    }
+
+    std::vector<unsigned char> lBitList ((lNbOfBits + 7) / 8, 0);
+    ioIn.read (reinterpret_cast<char*> (&lBitList[0]), lBitList.size());
+    if (!ioIn) {
+      return false;
+    }
+
+    _nbOfItems = lNbOfItems;
+    _nbOfBits = lNbOfBits;
+    _nbOfHashes = lNbOfHashes;
+    _bitList.swap (lBitList);
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string BloomFilter::describe() const {
+    std::ostringstream oStr;
+    oStr << _nbOfItems << " items, " << _nbOfBits << " bits, "
+         << _nbOfHashes << " hashes";
+    return oStr.str();
+  }
+
+}
@@ -0,0 +1,179 @@
+#ifndef __OPENTREP_BAS_BLOOMFILTER_HPP
+#define __OPENTREP_BAS_BLOOMFILTER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iosfwd>
+#include <string>
+#include <vector>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Bloom filter, i.e., a compact set of strings which may give
+   *        false positives, but never false negatives.
+   *
+   * The positions of the bits of an item are derived from a single 64-bit
+   * hash of that item (double hashing). As the hash function does not
+   * depend on the platform, the filter may be stored in a file (see
+   * toStream()) and loaded back by another process (see fromStream()).
+   */
+  class BloomFilter {
+  public:
+    // //////////////// Type definitions ///////////////
+    /**
+     * Hash of an item.
+     */
+    typedef unsigned long long HashValue_T;
+
+    /**
+     * Number of bits of the filter.
+     */
+    typedef unsigned long long NbOfBits_T;
+
+    /**
+     * Number of hash functions, i.e., of bits set for every item.
+     */
+    typedef unsigned short NbOfHashes_T;
+
+  public:
+    // //////////////// Getters ///////////////
+    /**
+     * Get the number of items the filter has been sized for.
+     */
+    const NbOfDBEntries_T& getNbOfItems() const {
+      return _nbOfItems;
+    }
+
+    /**
+     * Get the number of bits of the filter.
+     */
+    const NbOfBits_T& getNbOfBits() const {
+      return _nbOfBits;
+    }
+
+    /**
+     * Get the number of hash functions.
+     */
+    const NbOfHashes_T& getNbOfHashes() const {
+      return _nbOfHashes;
+    }
+
+    /**
+     * Get the size, in bytes, of the bits of the filter.
+     */
+    size_t getSize() const {
+      return _bitList.size();
+    }
+
+  public:
+    // //////////////// Business methods ///////////////
+    /**
+     * Hash the given string (64-bit FNV-1a).
+     *
+     * @param const std::string& The string to be hashed.
+     * @return HashValue_T The hash of that string.
+     */
+    static HashValue_T hash (const std::string&);
+
+    /**
+     * Empty the filter, and size it for the given number of items and
+     * false positive rate.
+     *
+     * @param const NbOfDBEntries_T& Number of items to be inserted.
+     * @param const Percentage_T& Expected rate of false positives
+     *        (e.g., 0.01).
+     */
+    void reset (const NbOfDBEntries_T&, const Percentage_T&);
+
+    /**
+     * Insert the item having the given hash.
+     *
+     * @param const HashValue_T& Hash of the item (see hash()).
+     */
+    void insert (const HashValue_T&);
+
+    /**
+     * Check whether the item having the given hash may have been inserted.
+     * When false, the item has certainly not been inserted.
+     *
+     * @param const HashValue_T& Hash of the item (see hash()).
+     * @return bool Whether the item may have been inserted.
+     */
+    bool mayContain (const HashValue_T&) const;
+
+  public:
+    // //////////////// (De)serialisation methods ///////////////
+    /**
+     * Write the filter (dimensions and bits) into the given output stream.
+     *
+     * @param std::ostream& Output stream, opened in binary mode.
+     */
+    void toStream (std::ostream&) const;
+
+    /**
+     * Read the filter from the given input stream.
+     *
+     * @param std::istream& Input stream, opened in binary mode.
+     * @return bool Whether the filter could be read. When not, it is empty.
+     */
+    bool fromStream (std::istream&);
+
+    /**
+     * Give a short description of the filter (items, bits and hashes).
+     */
+    std::string describe() const;
+
+  public:
+    // //////////////// Construction and destruction ///////////////
+    /**
+     * Default constructor. The filter is empty.
+     */
+    BloomFilter();
+
+    /**
+     * Destructor.
+     */
+    ~BloomFilter();
+
+  private:
+    // //////////////// Helper methods ///////////////
+    /**
+     * Get the position of the given bit of the item having the given hash.
+     *
+     * @param const HashValue_T& Hash of the item.
+     * @param const NbOfHashes_T& Rank of the hash function.
+     * @return NbOfBits_T Position of the bit.
+     */
+    NbOfBits_T getBitPosition (const HashValue_T&, const NbOfHashes_T&) const;
+
+  private:
+    // /////////////////////// Attributes //////////////////////
+    /**
+     * Number of items the filter has been sized for.
+     */
+    NbOfDBEntries_T _nbOfItems;
+
+    /**
+     * Number of bits of the filter.
+     */
+    NbOfBits_T _nbOfBits;
+
+    /**
+     * Number of hash functions.
+     */
+    NbOfHashes_T _nbOfHashes;
+
+    /**
+     * Bits of the filter, by bytes (so that the stored filter does not
+     * depend on the endianness of the platform).
+     */
+    std::vector<unsigned char> _bitList;
+  };
+
+}
+#endif // __OPENTREP_BAS_BLOOMFILTER_HPP
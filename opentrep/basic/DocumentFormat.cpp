@@ -0,0 +1,139 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// OpenTREP
+#include <opentrep/DocumentFormat.hpp>
+
+namespace OPENTREP {
+  
+  // //////////////////////////////////////////////////////////////////////
+  const std::string DocumentFormat::_labels[LAST_VALUE] =
+    { "CSV", "Binary" };
+
+  // //////////////////////////////////////////////////////////////////////
+  const char DocumentFormat::_formatLabels[LAST_VALUE] = { 'C', 'B' };
+
+  
+  // //////////////////////////////////////////////////////////////////////
+  DocumentFormat::DocumentFormat() : _format (LAST_VALUE) {
+    assert (false);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DocumentFormat::
+  DocumentFormat (const DocumentFormat& iDocumentFormat)
+    : _format (iDocumentFormat._format) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DocumentFormat::
+  DocumentFormat (const EN_DocumentFormat& iDocumentFormat)
+    : _format (iDocumentFormat) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DocumentFormat::EN_DocumentFormat
+  DocumentFormat::getFormat (const char iFormatChar) {
+    EN_DocumentFormat oFormat;
+    switch (iFormatChar) {
+    case 'C': oFormat = CSV; break;
+    case 'B': oFormat = BINARY; break;
+    default: oFormat = LAST_VALUE; break;
+    }
+
+    if (oFormat == LAST_VALUE) {
+      const std::string& lLabels = describeLabels();
+      std::ostringstream oMessage;
+      oMessage << "The document format '" << iFormatChar
+               << "' is not known. Known document formats: " << lLabels;
+      throw CodeConversionException (oMessage.str());
+    }
+
+    return oFormat;
+  }
+  
+  // //////////////////////////////////////////////////////////////////////
+  DocumentFormat::DocumentFormat (const char iFormatChar)
+    : _format (getFormat (iFormatChar)) {
+  }
+  
+  // //////////////////////////////////////////////////////////////////////
+  DocumentFormat::
+  DocumentFormat (const std::string& iFormatStr) {
+    // 
+#ifndef NDEBUG
+    const size_t lSize = iFormatStr.size();
+    assert (lSize == 1);
+#endif
+    const char lFormatChar = iFormatStr[0];
+    _format = getFormat (lFormatChar);
+  }
+  
+  // //////////////////////////////////////////////////////////////////////
+  const std::string& DocumentFormat::
+  getLabel (const EN_DocumentFormat& iFormat) {
+    return _labels[iFormat];
+  }
+  
+  // //////////////////////////////////////////////////////////////////////
+  char DocumentFormat::
+  getFormatLabel (const EN_DocumentFormat& iFormat) {
+    return _formatLabels[iFormat];
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string DocumentFormat::
+  getFormatLabelAsString (const EN_DocumentFormat& iFormat) {
+    std::ostringstream oStr;
+    oStr << _formatLabels[iFormat];
+    return oStr.str();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string DocumentFormat::describeLabels() {
+    std::ostringstream ostr;
+    for (unsigned short idx = 0; idx != LAST_VALUE; ++idx) {
+      if (idx != 0) {
+        ostr << ", ";
+      }
+      ostr << _labels[idx];
+    }
+    return ostr.str();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DocumentFormat::EN_DocumentFormat
+  DocumentFormat::getFormat() const {
+    return _format;
+  }
+  
+  // //////////////////////////////////////////////////////////////////////
+  char DocumentFormat::getFormatAsChar() const {
+    const char oFormatChar = _formatLabels[_format];
+    return oFormatChar;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string DocumentFormat::getFormatAsString() const {
+    std::ostringstream oStr;
+    oStr << _formatLabels[_format];
+    return oStr.str();
+  }
+  
+  // //////////////////////////////////////////////////////////////////////
+  const std::string DocumentFormat::describe() const {
+    std::ostringstream ostr;
+    ostr << _labels[_format];
+    return ostr.str();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool DocumentFormat::
+  operator== (const EN_DocumentFormat& iFormat) const {
+    return (_format == iFormat);
+  }
+  
+}
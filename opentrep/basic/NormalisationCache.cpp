@@ -0,0 +1,87 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// OpenTrep
+#include <opentrep/basic/OTransliterator.hpp>
+#include <opentrep/basic/NormalisationCache.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  NormalisationCache::
+  NormalisationCache (const OTransliterator& iTransliterator,
+                      const NbOfDBEntries_T& iCapacity)
+    : _transliterator (iTransliterator), _capacity (iCapacity),
+      _nbOfHits (0), _nbOfMisses (0), _nbOfEvictions (0) {
+    _normalisationMap.reserve (iCapacity);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NormalisationCache::~NormalisationCache() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Percentage_T NormalisationCache::getHitRate() const {
+    const NbOfLookups_T lNbOfLookups = _nbOfHits + _nbOfMisses;
+    if (lNbOfLookups == 0) {
+      return 0.0;
+    }
+    return 100.0 * _nbOfHits / lNbOfLookups;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string NormalisationCache::normalise (const std::string& iString) {
+    // Look for the string within the cache
+    NormalisationMap_T::iterator itEntry = _normalisationMap.find (iString);
+    if (itEntry != _normalisationMap.end()) {
+      ++_nbOfHits;
+
+      // The string becomes the most recently used one
+      CacheEntry_T& lCacheEntry = itEntry->second;
+      _recencyList.splice (_recencyList.begin(), _recencyList,
+                           lCacheEntry.second);
+      return lCacheEntry.first;
+    }
+
+    // Cache miss: the string has to be normalised by ICU
+    ++_nbOfMisses;
+    const std::string& lNormalisedString = _transliterator.normalise (iString);
+
+    if (_capacity == 0) {
+      return lNormalisedString;
+    }
+
+    // Make room for the new normalisation, by evicting the least
+    // recently used one
+    if (_normalisationMap.size() >= _capacity) {
+      assert (_recencyList.empty() == false);
+      const std::string& lLeastRecentlyUsedString = _recencyList.back();
+      _normalisationMap.erase (lLeastRecentlyUsedString);
+      _recencyList.pop_back();
+      ++_nbOfEvictions;
+    }
+
+    // Store the new normalisation, as the most recently used one
+    _recencyList.push_front (iString);
+    _normalisationMap.insert (NormalisationMap_T::
+                              value_type (iString,
+                                          CacheEntry_T (lNormalisedString,
+                                                        _recencyList.begin())));
+
+    return lNormalisedString;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string NormalisationCache::describe() const {
+    std::ostringstream oStr;
+    oStr << getSize() << " normalisations (out of " << _capacity
+         << ") in the cache, " << _nbOfHits << " hits, " << _nbOfMisses
+         << " misses (" << getHitRate() << "% hit rate), "
+         << _nbOfEvictions << " evictions";
+    return oStr.str();
+  }
+
+}
@@ -0,0 +1,172 @@
+#ifndef __OPENTREP_BAS_NORMALISATIONCACHE_HPP
+#define __OPENTREP_BAS_NORMALISATIONCACHE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <list>
+#include <unordered_map>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+
+namespace OPENTREP {
+
+  // Forward declarations
+  class OTransliterator;
+
+  /**
+   * @brief Bounded cache of the Unicode normalisations, see
+   *        OTransliterator::normalise().
+   *
+   * Many words and word combinations (e.g., "airport", "international",
+   * city, administrative and country names) are repeated across the POR.
+   * Once normalised, they are kept in the cache, so that their next
+   * normalisations do not involve ICU at all. When the cache is full,
+   * the least recently used normalisation is evicted.
+   *
+   * The cache is not thread-safe: every indexing thread owns its cache,
+   * wrapping its own clone of the Unicode transliterator.
+   */
+  class NormalisationCache {
+  public:
+    // //////////////// Getters ///////////////
+    /**
+     * Get the maximum number of normalisations held by the cache.
+     */
+    const NbOfDBEntries_T& getCapacity() const {
+      return _capacity;
+    }
+
+    /**
+     * Get the number of normalisations held by the cache.
+     */
+    NbOfDBEntries_T getSize() const {
+      return _normalisationMap.size();
+    }
+
+    /**
+     * Get the number of look-ups found in the cache.
+     */
+    const NbOfLookups_T& getNbOfHits() const {
+      return _nbOfHits;
+    }
+
+    /**
+     * Get the number of look-ups not found in the cache (i.e., the number
+     * of calls to the Unicode transliterator).
+     */
+    const NbOfLookups_T& getNbOfMisses() const {
+      return _nbOfMisses;
+    }
+
+    /**
+     * Get the number of normalisations evicted from the cache.
+     */
+    const NbOfLookups_T& getNbOfEvictions() const {
+      return _nbOfEvictions;
+    }
+
+    /**
+     * Get the hit rate, i.e., the percentage of the look-ups found
+     * in the cache (0 when there has been no look-up).
+     */
+    Percentage_T getHitRate() const;
+
+  public:
+    // //////////////// Business methods ///////////////
+    /**
+     * Normalise the given string, either from the cache or thanks to the
+     * Unicode transliterator (see OTransliterator::normalise()).
+     *
+     * @param const std::string& The string to be normalised.
+     * @return std::string The normalised string.
+     */
+    std::string normalise (const std::string& iString);
+
+  public:
+    // //////////////// Display methods ///////////////
+    /**
+     * Give the statistics of the cache (size, hits, misses, hit rate).
+     */
+    std::string describe() const;
+
+  public:
+    // //////////////// Construction and destruction ///////////////
+    /**
+     * Main constructor.
+     *
+     * @param const OTransliterator& Unicode transliterator, which must
+     *        outlive the cache.
+     * @param const NbOfDBEntries_T& Maximum number of normalisations held
+     *        by the cache (0 meaning no caching at all).
+     */
+    NormalisationCache (const OTransliterator&, const NbOfDBEntries_T&);
+
+    /**
+     * Destructor.
+     */
+    ~NormalisationCache();
+
+  private:
+    /**
+     * Default constructor. It should not be used.
+     */
+    NormalisationCache();
+
+    /**
+     * Copy constructor. It should not be used.
+     */
+    NormalisationCache (const NormalisationCache&);
+
+  private:
+    // //////////////// Type definitions ///////////////
+    /**
+     * List of the cached strings, from the most to the least recently used.
+     */
+    typedef std::list<std::string> RecencyList_T;
+
+    /**
+     * Normalised string, along with the position of the original string
+     * within the recency list.
+     */
+    typedef std::pair<std::string, RecencyList_T::iterator> CacheEntry_T;
+
+    /**
+     * Map of the normalised strings, keyed by the original strings.
+     */
+    typedef std::unordered_map<std::string, CacheEntry_T> NormalisationMap_T;
+
+  private:
+    // /////////////////////// Attributes //////////////////////
+    /**
+     * Unicode transliterator, called on the cache misses.
+     */
+    const OTransliterator& _transliterator;
+
+    /**
+     * Maximum number of normalisations held by the cache.
+     */
+    const NbOfDBEntries_T _capacity;
+
+    /**
+     * Normalised strings, keyed by the original strings.
+     */
+    NormalisationMap_T _normalisationMap;
+
+    /**
+     * Original strings, from the most to the least recently used.
+     */
+    RecencyList_T _recencyList;
+
+    /**
+     * Statistics of the look-ups.
+     */
+    NbOfLookups_T _nbOfHits;
+    NbOfLookups_T _nbOfMisses;
+    NbOfLookups_T _nbOfEvictions;
+  };
+
+}
+#endif // __OPENTREP_BAS_NORMALISATIONCACHE_HPP
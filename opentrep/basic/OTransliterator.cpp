@@ -16,14 +16,16 @@ namespace OPENTREP {
   // //////////////////////////////////////////////////////////////////////
   OTransliterator::OTransliterator()
     : _punctuationRemover (NULL), _quoteRemover (NULL), _accentRemover (NULL),
-      _tranlist (NULL) {
+      _tranlist (NULL), _normaliser (NULL),
+      _punctuationAndQuoteRemover (NULL) {
     init();
   }
 
   // //////////////////////////////////////////////////////////////////////
   OTransliterator::OTransliterator (const OTransliterator& iTransliterator)
     : _punctuationRemover (NULL), _quoteRemover (NULL), _accentRemover (NULL),
-      _tranlist (NULL) {
+      _tranlist (NULL), _normaliser (NULL),
+      _punctuationAndQuoteRemover (NULL) {
     assert (iTransliterator._punctuationRemover != NULL);
     _punctuationRemover = iTransliterator._punctuationRemover->clone();
 
@@ -36,6 +38,12 @@ namespace OPENTREP {
     assert (iTransliterator._tranlist != NULL);
     _tranlist = iTransliterator._tranlist->clone();
 
+    assert (iTransliterator._normaliser != NULL);
+    _normaliser = iTransliterator._normaliser->clone();
+
+    assert (iTransliterator._punctuationAndQuoteRemover != NULL);
+    _punctuationAndQuoteRemover =
+      iTransliterator._punctuationAndQuoteRemover->clone();
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -60,8 +68,9 @@ namespace OPENTREP {
     }
     assert (_punctuationRemover != NULL);
                
-    // Register the Unicode Transliterator
-    icu::Transliterator::registerInstance (_punctuationRemover);
+    // Register a copy of the Unicode Transliterator, as the registry
+    // takes ownership of (and eventually deletes) the registered instance
+    icu::Transliterator::registerInstance (_punctuationRemover->clone());
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -71,7 +80,8 @@ namespace OPENTREP {
     UParseError pError;
     icu::UnicodeString lUnquotedRules (K_ICU_QUOTATION_REMOVAL_RULE);
     _quoteRemover =
-      icu::Transliterator::createFromRules ("RBTUnaccent", lUnquotedRules,
+      icu::Transliterator::createFromRules (K_ICU_QUOTATION_REMOVAL_ID,
+                                       lUnquotedRules,
                                        UTRANS_FORWARD, pError, lStatus);
 
     if (_quoteRemover == NULL || U_FAILURE (lStatus)) {
@@ -83,8 +93,9 @@ namespace OPENTREP {
     }
     assert (_quoteRemover != NULL);
                
-    // Register the Unicode Transliterator
-    icu::Transliterator::registerInstance (_quoteRemover);
+    // Register a copy of the Unicode Transliterator, as the registry
+    // takes ownership of (and eventually deletes) the registered instance
+    icu::Transliterator::registerInstance (_quoteRemover->clone());
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -104,8 +115,9 @@ namespace OPENTREP {
     }
     assert (_accentRemover != NULL);
                
-    // Register the Unicode Transliterator
-    icu::Transliterator::registerInstance (_accentRemover);
+    // Register a copy of the Unicode Transliterator, as the registry
+    // takes ownership of (and eventually deletes) the registered instance
+    icu::Transliterator::registerInstance (_accentRemover->clone());
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -125,8 +137,57 @@ namespace OPENTREP {
     }
     assert (_tranlist != NULL);
                
-    // Register the Unicode Transliterator
-    icu::Transliterator::registerInstance (_tranlist);
+    // Register a copy of the Unicode Transliterator, as the registry
+    // takes ownership of (and eventually deletes) the registered instance
+    icu::Transliterator::registerInstance (_tranlist->clone());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  icu::Transliterator* createCompoundTransliterator (const std::string& iIDs) {
+    // The quotation remover is referred to by its identifier, under which
+    // it has been registered (see OTransliterator::initQuoteRemover()).
+    // The compound rule starts with the Null transliterator, as a leading
+    // filter (e.g., the one of "[:P:] Remove;") would otherwise be taken
+    // by ICU as a global filter, applying to the whole compound rule
+    const std::string lIDs = "Null; " + iIDs;
+    UErrorCode lStatus = U_ZERO_ERROR;
+    icu::Transliterator* oTransliterator_ptr =
+      icu::Transliterator::createInstance (lIDs.c_str(), UTRANS_FORWARD,
+                                           lStatus);
+
+    if (oTransliterator_ptr == NULL || U_FAILURE (lStatus)) {
+      delete oTransliterator_ptr; oTransliterator_ptr = NULL;
+      std::ostringstream oStr;
+      oStr << "Unicode error: no Transliterator can be created for the '"
+           << lIDs << "' compound rule.";
+      OPENTREP_LOG_ERROR (oStr.str());
+      throw UnicodeTransliteratorCreationException (oStr.str());
+    }
+    assert (oTransliterator_ptr != NULL);
+
+    return oTransliterator_ptr;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OTransliterator::initNormaliser() {
+    // Concatenate the rules, in the order of the normalisation (unaccent,
+    // unquote, unpunctuate, transliterate)
+    std::ostringstream lIDs;
+    lIDs << K_ICU_ACCENT_REMOVAL_RULE << " " << K_ICU_QUOTATION_REMOVAL_ID
+         << "; " << K_ICU_PUNCTUATION_REMOVAL_RULE
+         << " " << K_ICU_GENERIC_TRANSLITERATOR_RULE;
+
+    _normaliser = createCompoundTransliterator (lIDs.str());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OTransliterator::initPunctuationAndQuoteRemover() {
+    // Concatenate the rules (unpunctuate, unquote)
+    std::ostringstream lIDs;
+    lIDs << K_ICU_PUNCTUATION_REMOVAL_RULE
+         << " " << K_ICU_QUOTATION_REMOVAL_ID << ";";
+
+    _punctuationAndQuoteRemover = createCompoundTransliterator (lIDs.str());
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -135,6 +196,16 @@ namespace OPENTREP {
     initQuoteRemover();
     initAccentRemover();
     initTranlisterator();
+    initNormaliser();
+    initPunctuationAndQuoteRemover();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  icu::UnicodeString& getScratchString() {
+    // Scratch buffer of the current thread, re-used from one string to the
+    // next one, so that it is not re-allocated for every string
+    static thread_local icu::UnicodeString lScratchString;
+    return lScratchString;
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -143,6 +214,8 @@ namespace OPENTREP {
     delete _quoteRemover; _quoteRemover = NULL;
     delete _accentRemover; _accentRemover = NULL;
     delete _tranlist; _tranlist = NULL;
+    delete _normaliser; _normaliser = NULL;
+    delete _punctuationAndQuoteRemover; _punctuationAndQuoteRemover = NULL;
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -154,8 +227,9 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   std::string OTransliterator::unpunctuate (const std::string& iString) const {
-    // Build a UnicodeString from the STL string
-    icu::UnicodeString lString (iString.c_str());
+    // Decode the STL string into the scratch UnicodeString
+    icu::UnicodeString& lString = getScratchString();
+    setFromUTF8 (iString, lString);
 
     // Apply the punctuation removal scheme
     unpunctuate (lString);
@@ -175,8 +249,9 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   std::string OTransliterator::unquote (const std::string& iString) const {
-    // Build a UnicodeString from the STL string
-    icu::UnicodeString lString (iString.c_str());
+    // Decode the STL string into the scratch UnicodeString
+    icu::UnicodeString& lString = getScratchString();
+    setFromUTF8 (iString, lString);
 
     // Apply the quotation removal scheme
     unquote (lString);
@@ -196,8 +271,9 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   std::string OTransliterator::unaccent (const std::string& iString) const {
-    // Build a UnicodeString from the STL string
-    icu::UnicodeString lString (iString.c_str());
+    // Decode the STL string into the scratch UnicodeString
+    icu::UnicodeString& lString = getScratchString();
+    setFromUTF8 (iString, lString);
 
     // Apply the accent removal scheme
     unaccent (lString);
@@ -217,8 +293,9 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   std::string OTransliterator::transliterate (const std::string& iString) const {
-    // Build a UnicodeString from the STL string
-    icu::UnicodeString lString (iString.c_str());
+    // Decode the STL string into the scratch UnicodeString
+    icu::UnicodeString& lString = getScratchString();
+    setFromUTF8 (iString, lString);
 
     // Apply the transliteration scheme
     transliterate (lString);
@@ -231,14 +308,13 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   std::string OTransliterator::normalise (const std::string& iString) const {
-    // Build a UnicodeString from the STL string
-    icu::UnicodeString lString (iString.c_str());
+    // Decode the STL string into the scratch UnicodeString
+    icu::UnicodeString& lString = getScratchString();
+    setFromUTF8 (iString, lString);
 
-    // Apply the whole sery of transformators
-    unaccent (lString);
-    unquote (lString);
-    unpunctuate (lString);
-    transliterate (lString);
+    // Apply the whole sery of transformators, in a single pass
+    assert (_normaliser != NULL);
+    _normaliser->transliterate (lString);
 
     // Convert back from UnicodeString to UTF8-encoded STL string
     const std::string& lNormalisedString = getUTF8 (lString);
@@ -246,4 +322,21 @@ namespace OPENTREP {
     return lNormalisedString;
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  std::string OTransliterator::
+  unpunctuateAndUnquote (const std::string& iString) const {
+    // Decode the STL string into the scratch UnicodeString
+    icu::UnicodeString& lString = getScratchString();
+    setFromUTF8 (iString, lString);
+
+    // Remove the punctuation and then the quotation, in a single pass
+    assert (_punctuationAndQuoteRemover != NULL);
+    _punctuationAndQuoteRemover->transliterate (lString);
+
+    // Convert back from UnicodeString to UTF8-encoded STL string
+    const std::string& lCleanedString = getUTF8 (lString);
+
+    return lCleanedString;
+  }
+
 }
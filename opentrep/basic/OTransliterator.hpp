@@ -62,11 +62,24 @@ namespace OPENTREP {
      * Perform all the above operations (unaccent, unquote, unpunctuate,
      * transliterate) the given string.
      *
+     * The operations are fused into a single (compound) Unicode
+     * transliterator, applied in a single pass on the UTF-16 buffer:
+     * the string is decoded from, and encoded back into, UTF-8 only once.
+     *
      * @param const std::string& The string to be normalised.
      * @return std::string The normalised string.
      */
     std::string normalise (const std::string& iString) const;
 
+    /**
+     * Remove the punctuation, and then the quote characters, of the given
+     * string, in a single pass (as for normalise()).
+     *
+     * @param const std::string& The string to be cleaned.
+     * @return std::string The unpunctuated and unquoted string.
+     */
+    std::string unpunctuateAndUnquote (const std::string& iString) const;
+
 
   public:
     // //////////////// Construction and destruction ///////////////
@@ -163,6 +176,24 @@ namespace OPENTREP {
      */
     void initTranlisterator();
 
+    /**
+     * Create the compound "Unicode normaliser", chaining the above ones
+     * (accent, quotation and punctuation removers, and transliterator).
+     *
+     * The underlying specific Transliterator object is instantiated,
+     * from the concatenation of the rules of the above ones.
+     */
+    void initNormaliser();
+
+    /**
+     * Create the compound "Unicode normaliser" chaining the punctuation
+     * and quotation removers.
+     *
+     * The underlying specific Transliterator object is instantiated,
+     * from the concatenation of the rules of the above ones.
+     */
+    void initPunctuationAndQuoteRemover();
+
     /**
      * Perform all the above initialisation operations.
      */
@@ -197,6 +228,18 @@ namespace OPENTREP {
      * Katakana, Thai) to Latin characters.
      */
     icu::Transliterator* _tranlist;
+
+    /**
+     * Pointer on the compound Unicode Transliterator for the whole
+     * normalisation (see normalise()).
+     */
+    icu::Transliterator* _normaliser;
+
+    /**
+     * Pointer on the compound Unicode Transliterator for the removal of
+     * punctuation and then of quotation.
+     */
+    icu::Transliterator* _punctuationAndQuoteRemover;
   };
 
 }
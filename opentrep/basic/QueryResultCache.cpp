@@ -0,0 +1,103 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// OpenTrep
+#include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
+#include <opentrep/basic/QueryResultCache.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  QueryResultCache::QueryResultCache()
+    : _cache (DEFAULT_OPENTREP_QUERY_RESULT_CACHE_NB_OF_STRIPES,
+              DEFAULT_OPENTREP_QUERY_RESULT_CACHE_SIZE,
+              DEFAULT_OPENTREP_QUERY_RESULT_CACHE_TTL) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  QueryResultCache::QueryResultCache (const NbOfDBEntries_T& iCapacity,
+                                      const NbOfSeconds_T& iTimeToLive)
+    : _cache (DEFAULT_OPENTREP_QUERY_RESULT_CACHE_NB_OF_STRIPES,
+              iCapacity, iTimeToLive) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  QueryResultCache::~QueryResultCache() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string QueryResultCache::
+  buildKey (const DeploymentNumber_T& iDeploymentNumber,
+            const std::string& iXapianDatabaseUUID,
+            const std::string& iTravelQuery) {
+    // Neither the deployment number nor the UUID contain any space
+    std::ostringstream oStr;
+    oStr << iDeploymentNumber << " " << iXapianDatabaseUUID << " "
+         << iTravelQuery;
+    return oStr.str();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool QueryResultCache::find (const std::string& iKey,
+                               LocationList_T& ioLocationList,
+                               WordList_T& ioWordList,
+                               NbOfMatches_T& ioNbOfMatches) {
+    QueryResultsPtr_T lQueryResults_ptr;
+    if (_cache.find (iKey, lQueryResults_ptr) == false) {
+      return false;
+    }
+    assert (lQueryResults_ptr != NULL);
+
+    // The results are copied without holding the lock of the cache
+    ioLocationList.insert (ioLocationList.end(),
+                           lQueryResults_ptr->_locationList.begin(),
+                           lQueryResults_ptr->_locationList.end());
+    ioWordList.insert (ioWordList.end(), lQueryResults_ptr->_wordList.begin(),
+                       lQueryResults_ptr->_wordList.end());
+    ioNbOfMatches = lQueryResults_ptr->_nbOfMatches;
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void QueryResultCache::insert (const std::string& iKey,
+                                 const LocationList_T& iLocationList,
+                                 const WordList_T& iWordList,
+                                 const NbOfMatches_T& iNbOfMatches) {
+    if (isEnabled() == false) {
+      return;
+    }
+
+    std::shared_ptr<QueryResults_T> lQueryResults_ptr =
+      std::make_shared<QueryResults_T>();
+    lQueryResults_ptr->_locationList = iLocationList;
+    lQueryResults_ptr->_wordList = iWordList;
+    lQueryResults_ptr->_nbOfMatches = iNbOfMatches;
+    _cache.insert (iKey, lQueryResults_ptr);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void QueryResultCache::clear() {
+    _cache.clear();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void QueryResultCache::reset (const NbOfDBEntries_T& iCapacity,
+                                const NbOfSeconds_T& iTimeToLive) {
+    _cache.reset (iCapacity, iTimeToLive);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string QueryResultCache::describe() const {
+    std::ostringstream oStr;
+    oStr << getSize() << " travel queries (out of " << getCapacity()
+         << ", with a time-to-live of " << getTimeToLive()
+         << "s) in the cache, " << getNbOfHits() << " hits, "
+         << getNbOfMisses() << " misses, " << getNbOfEvictions()
+         << " evictions";
+    return oStr.str();
+  }
+
+}
@@ -0,0 +1,213 @@
+#ifndef __OPENTREP_BAS_QUERYRESULTCACHE_HPP
+#define __OPENTREP_BAS_QUERYRESULTCACHE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <memory>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/CityDetails.hpp>
+#include <opentrep/Location.hpp>
+#include <opentrep/basic/StripedLRUCache.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Bounded cache of the results of the travel queries, shared by
+   *        all the queries (and threads) of a service.
+   *
+   * The same travel queries (e.g., "nce", "paris", "new york") make up a
+   * large part of the traffic. Once interpreted, their results (list of
+   * Location structures and list of unmatched words) are kept in the cache,
+   * keyed by the query (see buildKey()), so that the next identical
+   * queries do not involve the Xapian index at all.
+   *
+   * The results are held by a striped LRU cache (see StripedLRUCache),
+   * so that concurrent queries seldom wait for each other: the least
+   * recently used results are evicted when the cache is full, and the
+   * results older than the time-to-live are not used.
+   *
+   * The key is made of the query as is, rather than of a normalised form
+   * of it, as the results hold fields specific to the query (the original
+   * keywords of the Location structures and the unmatched words): the
+   * results of "PARIS" cannot be given back for "paris".
+   */
+  class QueryResultCache {
+  public:
+    // //////////////// Getters ///////////////
+    /**
+     * Whether the results may be cached, i.e., whether the capacity of
+     * the cache is not null.
+     */
+    bool isEnabled() const {
+      return _cache.isEnabled();
+    }
+
+    /**
+     * Get the maximum number of travel queries held by the cache. As that
+     * capacity is spread evenly over the stripes, the capacity of every
+     * stripe being rounded up, the cache may actually hold a few more
+     * travel queries (less than the number of stripes).
+     */
+    NbOfDBEntries_T getCapacity() const {
+      return _cache.getCapacity();
+    }
+
+    /**
+     * Get the time-to-live, in seconds, of the cached results (0 meaning
+     * that they never expire).
+     */
+    NbOfSeconds_T getTimeToLive() const {
+      return _cache.getTimeToLive();
+    }
+
+    /**
+     * Get the number of travel queries held by the cache.
+     */
+    NbOfDBEntries_T getSize() const {
+      return _cache.getSize();
+    }
+
+    /**
+     * Get the number of look-ups found in the cache.
+     */
+    NbOfLookups_T getNbOfHits() const {
+      return _cache.getNbOfHits();
+    }
+
+    /**
+     * Get the number of look-ups not found in the cache (including the
+     * expired results).
+     */
+    NbOfLookups_T getNbOfMisses() const {
+      return _cache.getNbOfMisses();
+    }
+
+    /**
+     * Get the number of results evicted from the cache, as the least
+     * recently used ones.
+     */
+    NbOfLookups_T getNbOfEvictions() const {
+      return _cache.getNbOfEvictions();
+    }
+
+    /**
+     * Build the key of the given travel query.
+     *
+     * @param const DeploymentNumber_T& Deployment number.
+     * @param const std::string& UUID of the Xapian database/index.
+     * @param const std::string& Travel query.
+     * @return std::string Key of the travel query.
+     */
+    static std::string buildKey (const DeploymentNumber_T&,
+                                 const std::string&, const std::string&);
+
+  public:
+    // //////////////// Business methods ///////////////
+    /**
+     * Look for the results of the travel query having the given key. When
+     * found, and not expired, those results are added to the given lists.
+     *
+     * @param const std::string& Key of the travel query (see buildKey()).
+     * @param LocationList_T& List to which the Location structures are added.
+     * @param WordList_T& List to which the unmatched words are added.
+     * @param NbOfMatches_T& Number of matches of the travel query.
+     * @return bool Whether the results have been found.
+     */
+    bool find (const std::string&, LocationList_T&, WordList_T&,
+               NbOfMatches_T&);
+
+    /**
+     * Store the results of the travel query having the given key, as the
+     * most recently used ones. Nothing is stored when the cache is not
+     * enabled.
+     *
+     * @param const std::string& Key of the travel query (see buildKey()).
+     * @param const LocationList_T& List of Location structures.
+     * @param const WordList_T& List of unmatched words.
+     * @param const NbOfMatches_T& Number of matches of the travel query.
+     */
+    void insert (const std::string&, const LocationList_T&,
+                 const WordList_T&, const NbOfMatches_T&);
+
+    /**
+     * Remove all the results from the cache (e.g., when the Xapian index
+     * has been re-built). The statistics are kept.
+     */
+    void clear();
+
+    /**
+     * Change the limits of the cache. All the results are removed.
+     *
+     * @param const NbOfDBEntries_T& Maximum number of travel queries held
+     *        by the cache (0 meaning no caching at all). The cache may
+     *        actually hold up to one more travel query per stripe (see
+     *        getCapacity()).
+     * @param const NbOfSeconds_T& Time-to-live, in seconds, of the cached
+     *        results (0 meaning that they never expire).
+     */
+    void reset (const NbOfDBEntries_T&, const NbOfSeconds_T&);
+
+  public:
+    // //////////////// Display methods ///////////////
+    /**
+     * Give the statistics of the cache (size, hits, misses, evictions).
+     */
+    std::string describe() const;
+
+  public:
+    // //////////////// Construction and destruction ///////////////
+    /**
+     * Default constructor. The cache gets its default limits (see
+     * DEFAULT_OPENTREP_QUERY_RESULT_CACHE_SIZE and
+     * DEFAULT_OPENTREP_QUERY_RESULT_CACHE_TTL).
+     */
+    QueryResultCache();
+
+    /**
+     * Main constructor.
+     *
+     * @param const NbOfDBEntries_T& Maximum number of travel queries held
+     *        by the cache (0 meaning no caching at all).
+     * @param const NbOfSeconds_T& Time-to-live, in seconds, of the cached
+     *        results (0 meaning that they never expire).
+     */
+    QueryResultCache (const NbOfDBEntries_T&, const NbOfSeconds_T&);
+
+    /**
+     * Destructor.
+     */
+    ~QueryResultCache();
+
+  private:
+    /**
+     * Copy constructor. It should not be used.
+     */
+    QueryResultCache (const QueryResultCache&);
+
+  private:
+    // //////////////// Type definitions ///////////////
+    /**
+     * Results of a travel query. They are immutable once cached, so that
+     * they may be copied out of the cache without holding any lock.
+     */
+    struct QueryResults_T {
+      LocationList_T _locationList;
+      WordList_T _wordList;
+      NbOfMatches_T _nbOfMatches;
+    };
+    typedef std::shared_ptr<const QueryResults_T> QueryResultsPtr_T;
+
+  private:
+    // /////////////////////// Attributes //////////////////////
+    /**
+     * Results of the travel queries, keyed by the travel queries.
+     */
+    StripedLRUCache<QueryResultsPtr_T> _cache;
+  };
+
+}
+#endif // __OPENTREP_BAS_QUERYRESULTCACHE_HPP
@@ -0,0 +1,346 @@
+#ifndef __OPENTREP_BAS_STRIPEDLRUCACHE_HPP
+#define __OPENTREP_BAS_STRIPEDLRUCACHE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <string>
+#include <list>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <unordered_map>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Bounded cache of values keyed by strings, which may be shared
+   *        by concurrent threads.
+   *
+   * The cache is split into stripes, each protected by its own lock, so
+   * that concurrent look-ups seldom wait for each other. Within every
+   * stripe, the least recently used values are evicted when the stripe is
+   * full, and the values older than the time-to-live, if any, are not used.
+   *
+   * The capacity is spread evenly over the stripes, the capacity of every
+   * stripe being rounded up, so that every stripe may hold at least one
+   * value. The cache may therefore hold up to the capacity plus one value
+   * per stripe (strictly, less than the capacity plus the number of
+   * stripes).
+   *
+   * That is the storage of both QueryResultCache and
+   * SpellingSuggestionCache.
+   */
+  template <typename VALUE>
+  class StripedLRUCache {
+  public:
+    // //////////////// Getters ///////////////
+    /**
+     * Whether the values may be cached, i.e., whether the capacity of
+     * the cache is not null.
+     */
+    bool isEnabled() const {
+      return (_capacity != 0);
+    }
+
+    /**
+     * Get the maximum number of values held by the cache (see above for
+     * the rounding per stripe).
+     */
+    NbOfDBEntries_T getCapacity() const {
+      return _capacity;
+    }
+
+    /**
+     * Get the time-to-live, in seconds, of the cached values (0 meaning
+     * that they never expire).
+     */
+    NbOfSeconds_T getTimeToLive() const {
+      return _timeToLive;
+    }
+
+    /**
+     * Get the number of values held by the cache.
+     */
+    NbOfDBEntries_T getSize() const {
+      NbOfDBEntries_T oSize = 0;
+      for (typename StripeList_T::const_iterator itStripe =
+             _stripeList.begin(); itStripe != _stripeList.end(); ++itStripe) {
+        Stripe_T& lStripe = **itStripe;
+        std::lock_guard<std::mutex> lGuard (lStripe._mutex);
+        oSize += lStripe._valueMap.size();
+      }
+      return oSize;
+    }
+
+    /**
+     * Get the number of look-ups found in the cache.
+     */
+    NbOfLookups_T getNbOfHits() const {
+      return _nbOfHits;
+    }
+
+    /**
+     * Get the number of look-ups not found in the cache (including the
+     * expired values).
+     */
+    NbOfLookups_T getNbOfMisses() const {
+      return _nbOfMisses;
+    }
+
+    /**
+     * Get the number of values evicted from the cache, as the least
+     * recently used ones.
+     */
+    NbOfLookups_T getNbOfEvictions() const {
+      return _nbOfEvictions;
+    }
+
+  public:
+    // //////////////// Business methods ///////////////
+    /**
+     * Look for the value having the given key. When found, and not
+     * expired, that value becomes the most recently used one.
+     *
+     * @param const std::string& Key of the value.
+     * @param VALUE& Value, when found.
+     * @return bool Whether the value has been found.
+     */
+    bool find (const std::string& iKey, VALUE& ioValue) {
+      Stripe_T& lStripe = getStripe (iKey);
+      std::lock_guard<std::mutex> lGuard (lStripe._mutex);
+
+      typename ValueMap_T::iterator itEntry = lStripe._valueMap.find (iKey);
+      if (itEntry == lStripe._valueMap.end()) {
+        ++_nbOfMisses;
+        return false;
+      }
+      CacheEntry_T& lCacheEntry = itEntry->second;
+
+      // The expired values are removed
+      const NbOfSeconds_T lTimeToLive = _timeToLive;
+      if (lTimeToLive != 0
+          && Clock_T::now() - lCacheEntry._insertionTime
+          >= std::chrono::seconds (lTimeToLive)) {
+        lStripe._recencyList.erase (lCacheEntry._recencyPosition);
+        lStripe._valueMap.erase (itEntry);
+        ++_nbOfMisses;
+        return false;
+      }
+
+      // The value becomes the most recently used one
+      ++_nbOfHits;
+      lStripe._recencyList.splice (lStripe._recencyList.begin(),
+                                   lStripe._recencyList,
+                                   lCacheEntry._recencyPosition);
+      ioValue = lCacheEntry._value;
+      return true;
+    }
+
+    /**
+     * Store the value having the given key, as the most recently used one.
+     * When the key is already held by the cache (e.g., when it has been
+     * stored by a concurrent thread in the meantime), its value is
+     * refreshed. Nothing is stored when the cache is not enabled.
+     *
+     * @param const std::string& Key of the value.
+     * @param const VALUE& Value.
+     */
+    void insert (const std::string& iKey, const VALUE& iValue) {
+      const NbOfDBEntries_T lCapacity = _capacity;
+      if (lCapacity == 0) {
+        return;
+      }
+
+      Stripe_T& lStripe = getStripe (iKey);
+      std::lock_guard<std::mutex> lGuard (lStripe._mutex);
+
+      typename ValueMap_T::iterator itEntry = lStripe._valueMap.find (iKey);
+      if (itEntry != lStripe._valueMap.end()) {
+        CacheEntry_T& lCacheEntry = itEntry->second;
+        lCacheEntry._value = iValue;
+        lCacheEntry._insertionTime = Clock_T::now();
+        lStripe._recencyList.splice (lStripe._recencyList.begin(),
+                                     lStripe._recencyList,
+                                     lCacheEntry._recencyPosition);
+        return;
+      }
+
+      // Make room for the new value, by evicting the least recently
+      // used ones
+      const NbOfDBEntries_T lNbOfStripes = _stripeList.size();
+      const NbOfDBEntries_T lStripeCapacity =
+        (lCapacity + lNbOfStripes - 1) / lNbOfStripes;
+      while (lStripe._valueMap.size() >= lStripeCapacity
+             && lStripe._recencyList.empty() == false) {
+        const std::string& lLeastRecentlyUsedKey = lStripe._recencyList.back();
+        lStripe._valueMap.erase (lLeastRecentlyUsedKey);
+        lStripe._recencyList.pop_back();
+        ++_nbOfEvictions;
+      }
+
+      // Store the new value, as the most recently used one
+      lStripe._recencyList.push_front (iKey);
+      CacheEntry_T& lCacheEntry = lStripe._valueMap[iKey];
+      lCacheEntry._value = iValue;
+      lCacheEntry._insertionTime = Clock_T::now();
+      lCacheEntry._recencyPosition = lStripe._recencyList.begin();
+    }
+
+    /**
+     * Remove all the values from the cache. The statistics are kept.
+     */
+    void clear() {
+      for (typename StripeList_T::iterator itStripe = _stripeList.begin();
+           itStripe != _stripeList.end(); ++itStripe) {
+        Stripe_T& lStripe = **itStripe;
+        std::lock_guard<std::mutex> lGuard (lStripe._mutex);
+        lStripe._valueMap.clear();
+        lStripe._recencyList.clear();
+      }
+    }
+
+    /**
+     * Change the limits of the cache. All the values are removed.
+     *
+     * @param const NbOfDBEntries_T& Maximum number of values held by the
+     *        cache (0 meaning no caching at all).
+     * @param const NbOfSeconds_T& Time-to-live, in seconds, of the cached
+     *        values (0 meaning that they never expire).
+     */
+    void reset (const NbOfDBEntries_T& iCapacity,
+                const NbOfSeconds_T& iTimeToLive) {
+      _capacity = iCapacity;
+      _timeToLive = iTimeToLive;
+      clear();
+    }
+
+  public:
+    // //////////////// Construction and destruction ///////////////
+    /**
+     * Main constructor.
+     *
+     * @param const unsigned short& Number of stripes (at least 1).
+     * @param const NbOfDBEntries_T& Maximum number of values held by the
+     *        cache (0 meaning no caching at all).
+     * @param const NbOfSeconds_T& Time-to-live, in seconds, of the cached
+     *        values (0 meaning that they never expire).
+     */
+    StripedLRUCache (const unsigned short& iNbOfStripes,
+                     const NbOfDBEntries_T& iCapacity,
+                     const NbOfSeconds_T& iTimeToLive)
+      : _capacity (iCapacity), _timeToLive (iTimeToLive),
+        _nbOfHits (0), _nbOfMisses (0), _nbOfEvictions (0) {
+      assert (iNbOfStripes != 0);
+      for (unsigned short idx = 0; idx != iNbOfStripes; ++idx) {
+        _stripeList.push_back (std::unique_ptr<Stripe_T> (new Stripe_T));
+      }
+    }
+
+    /**
+     * Destructor.
+     */
+    ~StripedLRUCache() {
+    }
+
+  private:
+    /**
+     * Default constructor. It should not be used.
+     */
+    StripedLRUCache();
+
+    /**
+     * Copy constructor. It should not be used.
+     */
+    StripedLRUCache (const StripedLRUCache&);
+
+  private:
+    // //////////////// Type definitions ///////////////
+    /**
+     * Clock measuring the age of the cached values.
+     */
+    typedef std::chrono::steady_clock Clock_T;
+
+    /**
+     * List of the keys of the cached values, from the most to the least
+     * recently used.
+     */
+    typedef std::list<std::string> RecencyList_T;
+
+    /**
+     * Cached value, along with the date-time at which it has been stored
+     * and the position of its key within the recency list.
+     */
+    struct CacheEntry_T {
+      VALUE _value;
+      typename Clock_T::time_point _insertionTime;
+      typename RecencyList_T::iterator _recencyPosition;
+    };
+
+    /**
+     * Map of the cached values, keyed by strings.
+     */
+    typedef std::unordered_map<std::string, CacheEntry_T> ValueMap_T;
+
+    /**
+     * Part of the cache, protected by its own lock.
+     */
+    struct Stripe_T {
+      std::mutex _mutex;
+      ValueMap_T _valueMap;
+      RecencyList_T _recencyList;
+    };
+
+    /**
+     * List of the stripes of the cache.
+     */
+    typedef std::vector<std::unique_ptr<Stripe_T> > StripeList_T;
+
+  private:
+    // //////////////// Helper methods ///////////////
+    /**
+     * Get the stripe holding the given key.
+     */
+    Stripe_T& getStripe (const std::string& iKey) {
+      assert (_stripeList.empty() == false);
+      const size_t lStripeIdx = std::hash<std::string>() (iKey)
+        % _stripeList.size();
+      Stripe_T* lStripe_ptr = _stripeList[lStripeIdx].get();
+      assert (lStripe_ptr != NULL);
+      return *lStripe_ptr;
+    }
+
+  private:
+    // /////////////////////// Attributes //////////////////////
+    /**
+     * Maximum number of values held by the cache.
+     */
+    std::atomic<NbOfDBEntries_T> _capacity;
+
+    /**
+     * Time-to-live, in seconds, of the cached values.
+     */
+    std::atomic<NbOfSeconds_T> _timeToLive;
+
+    /**
+     * Stripes of the cache. Their number does not change.
+     */
+    StripeList_T _stripeList;
+
+    /**
+     * Statistics of the look-ups.
+     */
+    std::atomic<NbOfLookups_T> _nbOfHits;
+    std::atomic<NbOfLookups_T> _nbOfMisses;
+    std::atomic<NbOfLookups_T> _nbOfEvictions;
+  };
+
+}
+#endif // __OPENTREP_BAS_STRIPEDLRUCACHE_HPP
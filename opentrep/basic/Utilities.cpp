@@ -268,6 +268,77 @@ namespace OPENTREP {
     return oStr.str();
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  StringMap_T
+  parsePGConnectionString (const SQLDBConnectionString_T& iSQLDBConnStr) {
+    StringMap_T oStrMap;
+
+    std::stringstream lConnStream (iSQLDBConnStr);
+    std::string kvStr;
+    while (std::getline (lConnStream, kvStr, ' ')) {
+      // Skip the repeated spaces
+      if (kvStr.empty() == true) {
+        continue;
+      }
+
+      // Split the key-value pair on the first equal sign, as the value
+      // (e.g., the password) may itself contain some
+      const std::string::size_type lEqualPos = kvStr.find ('=');
+      if (lEqualPos == std::string::npos) {
+        std::ostringstream errStr;
+        errStr << "Error when parsing the PostgreSQL connection string ('"
+               << iSQLDBConnStr << "'), '" << kvStr
+               << "' is not a key-value pair";
+        OPENTREP_LOG_ERROR (errStr.str());
+        throw SQLDatabaseConnectionStringParsingException (errStr.str());
+      }
+      const std::string lKeyStr (kvStr.substr (0, lEqualPos));
+      const std::string lValueStr (kvStr.substr (lEqualPos + 1));
+      oStrMap[lKeyStr] = lValueStr;
+    }
+
+    /**
+     * Check that the parsing went well. The user and password may be
+     * derived by libpq (e.g., from the environment or the peer
+     * authentication), but not the database name.
+     */
+    const StringMap_T::const_iterator itDBName = oStrMap.find ("dbname");
+    if (itDBName == oStrMap.end()) {
+      std::ostringstream errStr;
+      errStr << "Error when parsing the PostgreSQL connection string ('"
+             << iSQLDBConnStr << "'), the 'dbname' value cannot be found";
+      OPENTREP_LOG_ERROR (errStr.str());
+      throw SQLDatabaseConnectionStringParsingException (errStr.str());
+    }
+
+    return oStrMap;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SQLDBConnectionString_T
+  buildPGConnectionString (const StringMap_T& iStringMap,
+                           const DeploymentNumber_T& iDeploymentNumber) {
+    std::ostringstream oStr;
+
+    unsigned short idx = 0;
+    for (StringMap_T::const_iterator itDBKV = iStringMap.begin();
+         itDBKV != iStringMap.end(); ++itDBKV, ++idx) {
+      const std::string& lDBKey = itDBKV->first;
+      const std::string& lDBValue = itDBKV->second;
+      if (idx != 0) {
+        oStr << " ";
+      }
+      oStr << lDBKey << "=" << lDBValue;
+      if (lDBKey == "dbname" && lDBValue != "postgres"
+          && lDBValue != "template1"
+          && iDeploymentNumber != DEFAULT_OPENTREP_DEPLOYMENT_NUMBER_SIZE) {
+        oStr << iDeploymentNumber;
+      }
+    }
+
+    return SQLDBConnectionString_T (oStr.str());
+  }
+
   // //////////////////////////////////////////////////////////////////////
   std::string
   parseAndDisplayConnectionString (const DBType& iDBType,
@@ -292,6 +363,17 @@ namespace OPENTREP {
       const std::string& lNewSQLDBConnStr =
         displayMySQLConnectionString (lStrMap, iDeploymentNumber);
       oStr << lNewSQLDBConnStr;
+
+    } else if (iDBType == DBType::PG) {
+      // Parse the connection string
+      const SQLDBConnectionString_T lSQLDBConnStr (iSQLDBConnStr);
+      const StringMap_T& lStrMap = parsePGConnectionString (lSQLDBConnStr);
+
+      // Re-build the new connection string, taking into account the
+      // deployment number/version
+      const SQLDBConnectionString_T& lNewSQLDBConnStr =
+        buildPGConnectionString (lStrMap, iDeploymentNumber);
+      oStr << lNewSQLDBConnStr;
     }
 
     //
@@ -81,6 +81,33 @@ namespace OPENTREP {
   std::string displayMySQLConnectionString (const StringMap_T&,
                                             const DeploymentNumber_T& iDN = DEFAULT_OPENTREP_DEPLOYMENT_NUMBER_SIZE);
 
+  /**
+   * Parse the PostgreSQL connection string.
+   *
+   * Typically, the PostgreSQL connection string is like
+   * 'dbname=trep_trep user=trep password=trep', in the keyword/value
+   * format of libpq. Any keyword (e.g., host, port) is kept; only the
+   * 'dbname' one is mandatory.
+   *
+   * @param const SQLDBConnectionString_T& Connection string for PostgreSQL
+   * @return StringMap_T Connection details to the PostgreSQL database
+   */
+  StringMap_T parsePGConnectionString (const SQLDBConnectionString_T&);
+  
+  /**
+   * Recompose the PostgreSQL connection string.
+   *
+   * For instance, 'dbname=trep_trep0 password=trep user=trep'. The
+   * administration databases (i.e., 'postgres' and 'template1') are not
+   * suffixed by the deployment number.
+   *
+   * @param const StringMap_T& Connection details to the PostgreSQL database
+   * @param const const DeploymentNumber_T& Deployment number
+   * @return SQLDBConnectionString_T Connection string for PostgreSQL
+   */
+  SQLDBConnectionString_T buildPGConnectionString (const StringMap_T&,
+                                                   const DeploymentNumber_T&);
+
   /**
    * Parse the connection string, and re-build it taking into account
    * the deployment number/version.
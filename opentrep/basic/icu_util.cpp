@@ -7,6 +7,7 @@
 #include <sstream>
 // ICU
 #include <unicode/ucnv.h> // Converter
+#include <unicode/ustring.h> // UTF-8 conversions
 // OpenTrep
 #include <opentrep/service/Logger.hpp>
 // Local
@@ -63,23 +64,28 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   std::string getUTF8 (const icu::UnicodeString& iString) {
-    std::ostringstream oStr;
-  
-    const int32_t len = iString.length();
-    // int32_t bufLen = iString.extract(0, len, buf); // Preflight
-    /* Preflighting seems to be broken now, so assume 1-1 conversion,
-       plus some slop. */
-    const int32_t bufLen = len + 256;
-
-    // Default codepage conversion
-    char* buf = new char[bufLen + 1];
-    const int32_t actualLen = iString.extract (0, len, buf/*, bufLen*/);
-    buf[actualLen] = '\0';
+    std::string oString;
+    iString.toUTF8String (oString);
+    return oString;
+  }
 
-    oStr << buf;
-    delete[] buf; buf = NULL;
+  // //////////////////////////////////////////////////////////////////////
+  void setFromUTF8 (const std::string& iString, icu::UnicodeString& ioString) {
+    // A UTF-8 string never has more UTF-16 code units than bytes
+    const int32_t lCapacity = static_cast<int32_t> (iString.size()) + 1;
+    UChar* lBuffer_ptr = ioString.getBuffer (lCapacity);
+    assert (lBuffer_ptr != NULL);
 
-    return oStr.str();
+    int32_t lLength = 0;
+    UErrorCode lStatus = U_ZERO_ERROR;
+    u_strFromUTF8WithSub (lBuffer_ptr, lCapacity, &lLength,
+                          iString.data(),
+                          static_cast<int32_t> (iString.size()),
+                          0xFFFD, NULL, &lStatus);
+    if (check (lStatus, "UTF-8 decoding") == false) {
+      lLength = 0;
+    }
+    ioString.releaseBuffer (lLength);
   }
 
 }
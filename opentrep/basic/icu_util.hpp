@@ -30,12 +30,24 @@ namespace OPENTREP {
   icu::UnicodeString escape (const icu::UnicodeString&);
 
   /**
-   * Get a STL string from the given UnicodeString.
+   * Get a (UTF-8 encoded) STL string from the given UnicodeString.
    *
    * @param const UnicodeString& ICU Unicode string
    * @return std::string STL string
    */
   std::string getUTF8 (const icu::UnicodeString&);
 
+  /**
+   * Decode the given UTF-8 encoded STL string into the given UnicodeString.
+   * The internal buffer of that latter is re-used whenever it is large
+   * enough, so that a UnicodeString used as a scratch buffer is not
+   * re-allocated for every string. The invalid UTF-8 sequences are
+   * replaced by the U+FFFD replacement character.
+   *
+   * @param const std::string& UTF-8 encoded STL string
+   * @param UnicodeString& ICU Unicode string, replaced by the decoded string
+   */
+  void setFromUTF8 (const std::string&, icu::UnicodeString&);
+
 }
 #endif // __OPENTREP_BAS_ICU_UTIL_HPP
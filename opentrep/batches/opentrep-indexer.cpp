@@ -14,6 +14,7 @@
 #include <opentrep/Location.hpp>
 #include <opentrep/CityDetails.hpp>
 #include <opentrep/DBType.hpp>
+#include <opentrep/DocumentFormat.hpp>
 #include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
 #include <opentrep/basic/Utilities.hpp>
 #include <opentrep/config/opentrep-paths.hpp>
@@ -58,6 +59,11 @@ int readConfiguration (int argc, char* argv[],
                        bool& ioIncludeNonIATAPOR,
                        bool& ioIndexPORInXapian,
                        bool& ioAddPORInDB,
+                       char& ioDocumentFormatChar,
+                       unsigned int& ioSQLDBBatchSize,
+                       unsigned short& ioNbOfThreads,
+                       unsigned short& ioNbOfShards,
+                       unsigned short& ioMaxWordCombinationSpan,
                        std::string& ioLogFilename,
                        std::ostringstream& oStr) {
 
@@ -80,7 +86,7 @@ int readConfiguration (int argc, char* argv[],
      "Xapian database filepath (e.g., /tmp/opentrep/xapian_traveldb)")
     ("sqldbtype,t",
      boost::program_options::value< std::string >(&ioSQLDBTypeString)->default_value(OPENTREP::DEFAULT_OPENTREP_SQL_DB_TYPE),
-     "SQL database type (e.g., nodb for no SQL database, sqlite for SQLite, mysql for MariaDB/MySQL)")
+     "SQL database type (e.g., nodb for no SQL database, sqlite for SQLite, mysql for MariaDB/MySQL, pg for PostgreSQL)")
     ("sqldbconx,s",
      boost::program_options::value< std::string >(&ioSQLDBConnectionString),
      "SQL database connection string (e.g., ~/tmp/opentrep/sqlite_travel.db for SQLite, \"db=trep_trep user=trep password=trep\" for MariaDB/MySQL)")
@@ -96,6 +102,21 @@ int readConfiguration (int argc, char* argv[],
     ("dbadd,a",
      boost::program_options::value<bool>(&ioAddPORInDB)->default_value(OPENTREP::DEFAULT_OPENTREP_ADD_IN_DB),
      "Whether or not to add and index the POR in the SQL-based database (0 = do not touch the SQL-based database, 1 = add and re-index all the POR in the SQL-based database)")
+    ("docformat,f",
+     boost::program_options::value<char>(&ioDocumentFormatChar)->default_value(OPENTREP::DEFAULT_OPENTREP_DOCUMENT_FORMAT),
+     "Format of the data of the Xapian documents and of the SQL database rows (C = raw CSV POR line, B = compact binary encoding, faster to decode at search time, which still holds the raw CSV POR line and is Base64-encoded within the SQL database)")
+    ("sqldbbatch,b",
+     boost::program_options::value<unsigned int>(&ioSQLDBBatchSize)->default_value(OPENTREP::DEFAULT_OPENTREP_SQL_DB_BULK_LOAD_BATCH_SIZE),
+     "Number of POR loaded into the SQL-based database within a single transaction")
+    ("threads,j",
+     boost::program_options::value<unsigned short>(&ioNbOfThreads)->default_value(OPENTREP::DEFAULT_OPENTREP_NB_OF_INDEXING_THREADS),
+     "Number of threads parsing the POR and building their Xapian documents (0 = as many as hardware threads, 1 = no parallel pipeline)")
+    ("shards,S",
+     boost::program_options::value<unsigned short>(&ioNbOfShards)->default_value(OPENTREP::DEFAULT_OPENTREP_NB_OF_INDEXING_SHARDS),
+     "Number of Xapian shards, built in parallel from as many parts of the POR file and then compacted into the Xapian index (0 or 1 = no shard). With shards, the number of threads is not used")
+    ("wordspan,w",
+     boost::program_options::value<unsigned short>(&ioMaxWordCombinationSpan)->default_value(OPENTREP::DEFAULT_OPENTREP_MAX_WORD_COMBINATION_SPAN),
+     "Maximum number of words spanned by the indexed combinations of the words of the place names (0 = no limit)")
     ("log,l",
      boost::program_options::value< std::string >(&ioLogFilename)->default_value(K_OPENTREP_DEFAULT_LOG_FILENAME),
      "Filepath for the logs")
@@ -188,6 +209,10 @@ int readConfiguration (int argc, char* argv[],
     ioAddPORInDB = true;
     ioSQLDBConnectionString = OPENTREP::DEFAULT_OPENTREP_SQLITE_DB_FILEPATH;
 
+  } else if (lDBType == OPENTREP::DBType::PG) {
+    ioAddPORInDB = true;
+    ioSQLDBConnectionString = OPENTREP::DEFAULT_OPENTREP_PG_CONN_STRING;
+
   } else if (lDBType == OPENTREP::DBType::MYSQL) {
     ioAddPORInDB = true;
     ioSQLDBConnectionString = OPENTREP::DEFAULT_OPENTREP_MYSQL_CONN_STRING;
@@ -200,7 +225,8 @@ int readConfiguration (int argc, char* argv[],
 
   // Reporting of the SQL database connection string
   if (lDBType == OPENTREP::DBType::SQLITE3
-      || lDBType == OPENTREP::DBType::MYSQL) {
+      || lDBType == OPENTREP::DBType::MYSQL
+      || lDBType == OPENTREP::DBType::PG) {
     const std::string& lSQLDBConnString =
       OPENTREP::parseAndDisplayConnectionString (lDBType,
                                                  ioSQLDBConnectionString,
@@ -217,6 +243,38 @@ int readConfiguration (int argc, char* argv[],
   
   oStr << "Add and re-index the POR in the SQL-based database? " << ioAddPORInDB
        << std::endl;
+
+  // Parse the format of the Xapian documents
+  if (vm.count ("docformat")) {
+    ioDocumentFormatChar = vm["docformat"].as< char >();
+  }
+  const OPENTREP::DocumentFormat lDocumentFormat (ioDocumentFormatChar);
+  oStr << "Format of the Xapian documents: " << lDocumentFormat.describe()
+       << std::endl;
+
+  if (vm.count ("sqldbbatch")) {
+    ioSQLDBBatchSize = vm["sqldbbatch"].as< unsigned int >();
+  }
+  oStr << "Number of POR per SQL-based database transaction: "
+       << ioSQLDBBatchSize << std::endl;
+
+  if (vm.count ("threads")) {
+    ioNbOfThreads = vm["threads"].as< unsigned short >();
+  }
+  oStr << "Number of indexing threads (0 = as many as hardware threads): "
+       << ioNbOfThreads << std::endl;
+
+  if (vm.count ("shards")) {
+    ioNbOfShards = vm["shards"].as< unsigned short >();
+  }
+  oStr << "Number of Xapian shards (0 or 1 = no shard): " << ioNbOfShards
+       << std::endl;
+
+  if (vm.count ("wordspan")) {
+    ioMaxWordCombinationSpan = vm["wordspan"].as< unsigned short >();
+  }
+  oStr << "Maximum span of the word combinations (0 = no limit): "
+       << ioMaxWordCombinationSpan << std::endl;
   
   if (vm.count ("log")) {
     ioLogFilename = vm["log"].as< std::string >();
@@ -257,6 +315,21 @@ int main (int argc, char* argv[]) {
   // Whether or not to insert the POR in the SQL database
   OPENTREP::shouldAddPORInSQLDB_T lShouldAddPORInSQLDB;
 
+  // Format of the data of the Xapian documents
+  char lDocumentFormatChar;
+
+  // Number of POR loaded into the SQL database within a single transaction
+  unsigned int lSQLDBBatchSize;
+
+  // Number of threads parsing the POR and building their Xapian documents
+  unsigned short lNbOfThreads;
+
+  // Number of Xapian shards, built in parallel and then compacted
+  unsigned short lNbOfShards;
+
+  // Maximum number of words spanned by the indexed word combinations
+  unsigned short lMaxWordCombinationSpan;
+
   // Log stream for the introduction part
   std::ostringstream oIntroStr;
 
@@ -265,7 +338,9 @@ int main (int argc, char* argv[]) {
     readConfiguration (argc, argv, lPORFilepathStr, lXapianDBNameStr,
                        lSQLDBTypeStr, lSQLDBConnectionStr, lDeploymentNumber,
                        lIncludeNonIATAPOR, lShouldIndexPORInXapian,
-                       lShouldAddPORInSQLDB, lLogFilename, oIntroStr);
+                       lShouldAddPORInSQLDB, lDocumentFormatChar,
+                       lSQLDBBatchSize, lNbOfThreads, lNbOfShards,
+                       lMaxWordCombinationSpan, lLogFilename, oIntroStr);
 
   if (lOptionParserStatus == K_OPENTREP_EARLY_RETURN_STATUS) {
     return 0;
@@ -304,13 +379,41 @@ int main (int argc, char* argv[]) {
                                               lShouldIndexPORInXapian,
                                               lShouldAddPORInSQLDB);
 
+  // Set the format of the Xapian documents
+  const OPENTREP::DocumentFormat lDocumentFormat (lDocumentFormatChar);
+  opentrepService.setDocumentFormat (lDocumentFormat);
+
+  // Set the number of POR per SQL database transaction
+  opentrepService.setSQLDBBulkLoadBatchSize (lSQLDBBatchSize);
+
+  // Set the number of indexing threads
+  opentrepService.setNbOfIndexingThreads (lNbOfThreads);
+
+  // Set the number of Xapian shards
+  opentrepService.setNbOfIndexingShards (lNbOfShards);
+
+  // Set the maximum span of the word combinations
+  opentrepService.setMaxWordCombinationSpan (lMaxWordCombinationSpan);
+
   // Launch the indexation
+  const boost::posix_time::ptime lStartTime =
+    boost::posix_time::microsec_clock::universal_time();
   const OPENTREP::NbOfDBEntries_T lNbOfEntries =
     opentrepService.insertIntoDBAndXapian();
+  const boost::posix_time::time_duration lElapsedTime =
+    boost::posix_time::microsec_clock::universal_time() - lStartTime;
 
   //
+  const double lElapsedSeconds =
+    static_cast<double> (lElapsedTime.total_microseconds()) / 1e6;
   std::ostringstream oStr;
-  oStr << lNbOfEntries << " entries have been processed" << std::endl;
+  oStr << lNbOfEntries << " entries have been processed in "
+       << lElapsedSeconds << " s";
+  if (lElapsedSeconds > 0) {
+    oStr << " (" << static_cast<unsigned long> (lNbOfEntries / lElapsedSeconds)
+         << " records per second)";
+  }
+  oStr << std::endl;
   std::cout << oStr.str();
 
   // Get the current time in UTC Timezone
@@ -141,7 +141,7 @@ int readConfiguration (int argc, char* argv[],
      "Xapian database filepath (e.g., /tmp/opentrep/xapian_traveldb)")
     ("sqldbtype,t",
      boost::program_options::value< std::string >(&ioSQLDBTypeString)->default_value(OPENTREP::DEFAULT_OPENTREP_SQL_DB_TYPE),
-     "SQL database type (e.g., nodb for no SQL database, sqlite for SQLite, mysql for MariaDB/MySQL)")
+     "SQL database type (e.g., nodb for no SQL database, sqlite for SQLite, mysql for MariaDB/MySQL, pg for PostgreSQL)")
     ("sqldbconx,s",
      boost::program_options::value< std::string >(&ioSQLDBConnectionString),
      "SQL database connection string (e.g., ~/tmp/opentrep/sqlite_travel.db for SQLite, "
@@ -231,6 +231,9 @@ int readConfiguration (int argc, char* argv[],
   } else if (lDBType == OPENTREP::DBType::SQLITE3) {
     ioSQLDBConnectionString = OPENTREP::DEFAULT_OPENTREP_SQLITE_DB_FILEPATH;
 
+  } else if (lDBType == OPENTREP::DBType::PG) {
+    ioSQLDBConnectionString = OPENTREP::DEFAULT_OPENTREP_PG_CONN_STRING;
+
   } else if (lDBType == OPENTREP::DBType::MYSQL) {
     ioSQLDBConnectionString = OPENTREP::DEFAULT_OPENTREP_MYSQL_CONN_STRING;
   }
@@ -242,7 +245,8 @@ int readConfiguration (int argc, char* argv[],
 
   // Reporting of the SQL database connection string
   if (lDBType == OPENTREP::DBType::SQLITE3
-      || lDBType == OPENTREP::DBType::MYSQL) {
+      || lDBType == OPENTREP::DBType::MYSQL
+      || lDBType == OPENTREP::DBType::PG) {
     const std::string& lSQLDBConnString =
       OPENTREP::parseAndDisplayConnectionString (lDBType,
                                                  ioSQLDBConnectionString,
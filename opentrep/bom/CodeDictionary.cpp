@@ -0,0 +1,267 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+#include <vector>
+// Boost
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+// OpenTrep
+#include <opentrep/basic/BasConst_General.hpp>
+#include <opentrep/Location.hpp>
+#include <opentrep/CityDetails.hpp>
+#include <opentrep/bom/Result.hpp>
+#include <opentrep/bom/CodeDictionary.hpp>
+#include <opentrep/service/Logger.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * First version of the format of the Xapian index holding the codes
+   * within value slots.
+   */
+  static const unsigned int K_CODE_SLOTS_INDEX_FORMAT_VERSION (3);
+
+  // //////////////////////////////////////////////////////////////////////
+  CodeDictionary::CodeDictionary() : _nbOfDocuments (0) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void CodeDictionary::addUniqueCode (UniqueCodeMap_T& ioCodeMap,
+                                      const std::string& iCode,
+                                      const RankedDocID_T& iRankedDocID,
+                                      const bool iShouldWinTies) {
+    if (iCode.empty() == true) {
+      return;
+    }
+
+    std::pair<UniqueCodeMap_T::iterator, bool> lInsertion =
+      ioCodeMap.insert (UniqueCodeMap_T::value_type (iCode, iRankedDocID));
+    if (lInsertion.second == true) {
+      return;
+    }
+
+    // The code is already known: keep the POR with the highest PageRank
+    RankedDocID_T& lRankedDocID = lInsertion.first->second;
+    const PageRank_T& lKeptPageRank = lRankedDocID.second;
+    const PageRank_T& lNewPageRank = iRankedDocID.second;
+    if (lNewPageRank > lKeptPageRank
+        || (iShouldWinTies == true && lNewPageRank == lKeptPageRank)) {
+      lRankedDocID = iRankedDocID;
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void CodeDictionary::add (const Xapian::docid& iDocID,
+                            const Location& iLocation) {
+    const RankedDocID_T lRankedDocID (iDocID, iLocation.getPageRank());
+
+    // IATA code. As for the SQL database, the last POR wins in case of a tie
+    const LocationKey& lKey = iLocation.getKey();
+    const std::string& lIataCode =
+      boost::algorithm::to_upper_copy (static_cast<const std::string&>
+                                       (lKey.getIataCode()));
+    addUniqueCode (_iataCodeMap, lIataCode, lRankedDocID, true);
+
+    // UN/LOCODE codes. As for the SQL database, the first POR wins in case
+    // of a tie. Contrary to the SQL database, which holds only the first
+    // UN/LOCODE code of every POR, all the codes are kept
+    const UNLOCodeList_T& lUNLOCodeList = iLocation.getUNLOCodeList();
+    for (UNLOCodeList_T::const_iterator itUNLOCode = lUNLOCodeList.begin();
+         itUNLOCode != lUNLOCodeList.end(); ++itUNLOCode) {
+      const std::string& lUNLOCode =
+        boost::algorithm::to_upper_copy (static_cast<const std::string&>
+                                         (*itUNLOCode));
+      addUniqueCode (_unloCodeMap, lUNLOCode, lRankedDocID, false);
+    }
+
+    // ICAO code
+    const std::string& lIcaoCode =
+      boost::algorithm::to_upper_copy (static_cast<const std::string&>
+                                       (iLocation.getIcaoCode()));
+    if (lIcaoCode.empty() == false) {
+      _icaoCodeMap[lIcaoCode].push_back (iDocID);
+    }
+
+    // Geonames ID
+    _geonamesIDMap[lKey.getGeonamesID()].push_back (iDocID);
+
+    ++_nbOfDocuments;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool CodeDictionary::hasCodeSlots (const Xapian::Database& iDatabase) {
+    const std::string& lFormatVersionStr =
+      iDatabase.get_metadata (K_XAPIAN_INDEX_FORMAT_VERSION_KEY);
+
+    // The older indexes have no (or no numeric) format version
+    unsigned int lFormatVersion = 0;
+    try {
+      lFormatVersion = boost::lexical_cast<unsigned int> (lFormatVersionStr);
+
+    } catch (const boost::bad_lexical_cast&) {
+      return false;
+    }
+    return (lFormatVersion >= K_CODE_SLOTS_INDEX_FORMAT_VERSION);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void CodeDictionary::load (const Xapian::Database& iDatabase) {
+    _xapianDatabaseUUID = iDatabase.get_uuid();
+
+    if (hasCodeSlots (iDatabase) == true) {
+      loadFromValueSlots (iDatabase);
+    } else {
+      loadFromDocuments (iDatabase);
+    }
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("Loaded the code dictionary from the Xapian index ("
+                        << _xapianDatabaseUUID << "): " << describe());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void CodeDictionary::loadFromDocuments (const Xapian::Database& iDatabase) {
+    // Browse all the documents, in the order of their IDs
+    for (Xapian::PostingIterator itDocID = iDatabase.postlist_begin ("");
+         itDocID != iDatabase.postlist_end (""); ++itDocID) {
+      const Xapian::docid& lDocID = *itDocID;
+      const Xapian::Document& lDocument = iDatabase.get_document (lDocID);
+
+      // Retrieve the POR details held by that document (whatever the
+      // format of the document data)
+      const Location& lLocation = Result::retrieveLocation (lDocument);
+      add (lDocID, lLocation);
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void CodeDictionary::loadFromValueSlots (const Xapian::Database& iDatabase) {
+    /**
+     * Every slot is browsed on its own, in the order of the document IDs,
+     * so that the ties between the POR of a given code are broken the
+     * same way as when the documents are parsed (see add()). The PageRank
+     * values are needed by the IATA and UN/LOCODE codes, and are therefore
+     * retrieved first.
+     */
+    std::vector<PageRank_T> lPageRankList (iDatabase.get_lastdocid() + 1, 0.0);
+    for (Xapian::ValueIterator itValue =
+           iDatabase.valuestream_begin (K_XAPIAN_SLOT_PAGE_RANK);
+         itValue != iDatabase.valuestream_end (K_XAPIAN_SLOT_PAGE_RANK);
+         ++itValue) {
+      const Xapian::docid& lDocID = itValue.get_docid();
+      assert (lDocID < lPageRankList.size());
+      lPageRankList[lDocID] = Xapian::sortable_unserialise (*itValue);
+    }
+
+    // IATA codes. As for the SQL database, the last POR wins in case of a tie
+    for (Xapian::ValueIterator itValue =
+           iDatabase.valuestream_begin (K_XAPIAN_SLOT_IATA_CODE);
+         itValue != iDatabase.valuestream_end (K_XAPIAN_SLOT_IATA_CODE);
+         ++itValue) {
+      const Xapian::docid& lDocID = itValue.get_docid();
+      const RankedDocID_T lRankedDocID (lDocID, lPageRankList[lDocID]);
+      const std::string& lIataCode = boost::algorithm::to_upper_copy (*itValue);
+      addUniqueCode (_iataCodeMap, lIataCode, lRankedDocID, true);
+    }
+
+    // UN/LOCODE codes. As for the SQL database, the first POR wins in case
+    // of a tie
+    for (Xapian::ValueIterator itValue =
+           iDatabase.valuestream_begin (K_XAPIAN_SLOT_UNLOCODE_LIST);
+         itValue != iDatabase.valuestream_end (K_XAPIAN_SLOT_UNLOCODE_LIST);
+         ++itValue) {
+      const Xapian::docid& lDocID = itValue.get_docid();
+      const RankedDocID_T lRankedDocID (lDocID, lPageRankList[lDocID]);
+      std::istringstream lUNLOCodeListStr (*itValue);
+      std::string lUNLOCode;
+      while (lUNLOCodeListStr >> lUNLOCode) {
+        boost::algorithm::to_upper (lUNLOCode);
+        addUniqueCode (_unloCodeMap, lUNLOCode, lRankedDocID, false);
+      }
+    }
+
+    // ICAO codes
+    for (Xapian::ValueIterator itValue =
+           iDatabase.valuestream_begin (K_XAPIAN_SLOT_ICAO_CODE);
+         itValue != iDatabase.valuestream_end (K_XAPIAN_SLOT_ICAO_CODE);
+         ++itValue) {
+      const std::string& lIcaoCode = boost::algorithm::to_upper_copy (*itValue);
+      _icaoCodeMap[lIcaoCode].push_back (itValue.get_docid());
+    }
+
+    // Geonames IDs. That slot is never empty
+    for (Xapian::ValueIterator itValue =
+           iDatabase.valuestream_begin (K_XAPIAN_SLOT_GEONAMES_ID);
+         itValue != iDatabase.valuestream_end (K_XAPIAN_SLOT_GEONAMES_ID);
+         ++itValue) {
+      const GeonamesID_T lGeonamesID =
+        static_cast<const GeonamesID_T> (Xapian::sortable_unserialise
+                                         (*itValue));
+      _geonamesIDMap[lGeonamesID].push_back (itValue.get_docid());
+      ++_nbOfDocuments;
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool CodeDictionary::findIataCode (const std::string& iIataCode,
+                                     Xapian::docid& ioDocID) const {
+    const std::string& lCode = boost::algorithm::to_upper_copy (iIataCode);
+    UniqueCodeMap_T::const_iterator itCode = _iataCodeMap.find (lCode);
+    if (itCode == _iataCodeMap.end()) {
+      return false;
+    }
+    ioDocID = itCode->second.first;
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool CodeDictionary::findUNLOCode (const std::string& iUNLOCode,
+                                     Xapian::docid& ioDocID) const {
+    const std::string& lCode = boost::algorithm::to_upper_copy (iUNLOCode);
+    UniqueCodeMap_T::const_iterator itCode = _unloCodeMap.find (lCode);
+    if (itCode == _unloCodeMap.end()) {
+      return false;
+    }
+    ioDocID = itCode->second.first;
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  const CodeDictionary::DocIDList_T& CodeDictionary::
+  findIcaoCode (const std::string& iIcaoCode) const {
+    static const DocIDList_T lEmptyList;
+    const std::string& lCode = boost::algorithm::to_upper_copy (iIcaoCode);
+    CodeMap_T::const_iterator itCode = _icaoCodeMap.find (lCode);
+    if (itCode == _icaoCodeMap.end()) {
+      return lEmptyList;
+    }
+    return itCode->second;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  const CodeDictionary::DocIDList_T& CodeDictionary::
+  findGeonamesID (const GeonamesID_T& iGeonamesID) const {
+    static const DocIDList_T lEmptyList;
+    GeonamesIDMap_T::const_iterator itGeonamesID =
+      _geonamesIDMap.find (iGeonamesID);
+    if (itGeonamesID == _geonamesIDMap.end()) {
+      return lEmptyList;
+    }
+    return itGeonamesID->second;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string CodeDictionary::describe() const {
+    std::ostringstream oStr;
+    oStr << _nbOfDocuments << " documents; "
+         << _iataCodeMap.size() << " IATA codes; "
+         << _icaoCodeMap.size() << " ICAO codes; "
+         << _unloCodeMap.size() << " UN/LOCODE codes; "
+         << _geonamesIDMap.size() << " Geonames IDs";
+    return oStr.str();
+  }
+
+}
@@ -0,0 +1,204 @@
+#ifndef __OPENTREP_BOM_CODEDICTIONARY_HPP
+#define __OPENTREP_BOM_CODEDICTIONARY_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+#include <unordered_map>
+// Xapian
+#include <xapian.h>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+
+namespace OPENTREP {
+
+  // Forward declarations
+  struct Location;
+
+  /**
+   * @brief In-memory dictionary of the codes (IATA, ICAO, UN/LOCODE) and
+   *        Geonames IDs of all the POR (points of reference) of a given
+   *        Xapian index.
+   *
+   * It maps every code and Geonames ID onto the IDs of the Xapian documents
+   * holding the corresponding POR, so that the travel queries made only of
+   * codes may be answered without any SQL request nor full-text search.
+   *
+   * The selection rules are the same as the ones of the SQL database (see
+   * DBManager::getPORByIATACode() and DBManager::getPORByUNLOCode()):
+   * <ul>
+   *   <li>For a given IATA code (resp. UN/LOCODE code), only the POR having
+   *       the highest PageRank value is kept. When several POR have the same
+   *       PageRank value, the last (resp. first) one of the index wins.</li>
+   *   <li>For a given ICAO code or Geonames ID, all the POR are kept.</li>
+   * </ul>
+   * The codes are stored uppercase, and may be looked up irrespective of
+   * their case.
+   *
+   * Once loaded, the dictionary is immutable, and may therefore be shared
+   * by concurrent queries.
+   */
+  class CodeDictionary {
+  public:
+    // ////////////// Type definitions /////////////
+    /** List of Xapian document IDs. */
+    typedef std::vector<Xapian::docid> DocIDList_T;
+
+    /** Xapian document ID, along with the PageRank of its POR. */
+    typedef std::pair<Xapian::docid, PageRank_T> RankedDocID_T;
+
+    /** Unique (highest PageRank) POR for every code. */
+    typedef std::unordered_map<std::string, RankedDocID_T> UniqueCodeMap_T;
+
+    /** All the POR for every code. */
+    typedef std::unordered_map<std::string, DocIDList_T> CodeMap_T;
+
+    /** All the POR for every Geonames ID. */
+    typedef std::unordered_map<GeonamesID_T, DocIDList_T> GeonamesIDMap_T;
+
+  public:
+    /**
+     * Load the codes of all the documents of the given Xapian index.
+     * The documents are browsed in the order of their IDs, i.e., in the
+     * order in which they have been indexed.
+     *
+     * When the Xapian index holds the codes within value slots (see
+     * K_XAPIAN_SLOT_ICAO_CODE), only those slots are read. Otherwise,
+     * the data of every document is parsed.
+     *
+     * @param const Xapian::Database& Xapian index.
+     */
+    void load (const Xapian::Database&);
+
+    /**
+     * Add the codes of the POR held by the given Xapian document.
+     * The documents are expected to be added in the order of their IDs.
+     *
+     * @param const Xapian::docid& ID of the Xapian document.
+     * @param const Location& Location structure held by that document.
+     */
+    void add (const Xapian::docid&, const Location&);
+
+    /**
+     * Get the ID of the document holding the POR having the highest
+     * PageRank value for the given IATA code.
+     *
+     * @param const std::string& IATA code (whatever its case).
+     * @param Xapian::docid& ID of the Xapian document, when found.
+     * @return bool Whether the IATA code is known.
+     */
+    bool findIataCode (const std::string&, Xapian::docid&) const;
+
+    /**
+     * Get the ID of the document holding the POR having the highest
+     * PageRank value for the given UN/LOCODE code.
+     *
+     * @param const std::string& UN/LOCODE code (whatever its case).
+     * @param Xapian::docid& ID of the Xapian document, when found.
+     * @return bool Whether the UN/LOCODE code is known.
+     */
+    bool findUNLOCode (const std::string&, Xapian::docid&) const;
+
+    /**
+     * Get the IDs of the documents holding the POR for the given ICAO code.
+     *
+     * @param const std::string& ICAO code (whatever its case).
+     * @return const DocIDList_T& IDs of the Xapian documents (may be empty).
+     */
+    const DocIDList_T& findIcaoCode (const std::string&) const;
+
+    /**
+     * Get the IDs of the documents holding the POR for the given
+     * Geonames ID.
+     *
+     * @param const GeonamesID_T& Geonames ID.
+     * @return const DocIDList_T& IDs of the Xapian documents (may be empty).
+     */
+    const DocIDList_T& findGeonamesID (const GeonamesID_T&) const;
+
+    /**
+     * Get the UUID of the Xapian index the dictionary has been loaded from.
+     * It is empty as long as the dictionary has not been loaded.
+     */
+    const std::string& getXapianDatabaseUUID() const {
+      return _xapianDatabaseUUID;
+    }
+
+    /**
+     * Get the number of Xapian documents the dictionary has been loaded from.
+     */
+    NbOfDBEntries_T getNbOfDocuments() const {
+      return _nbOfDocuments;
+    }
+
+    /**
+     * Give a short description of the dictionary (number of codes).
+     */
+    std::string describe() const;
+
+  public:
+    /**
+     * Constructor. The dictionary is empty.
+     */
+    CodeDictionary();
+
+  private:
+    /**
+     * Load the codes from the value slots of the given Xapian index.
+     *
+     * @param const Xapian::Database& Xapian index.
+     */
+    void loadFromValueSlots (const Xapian::Database&);
+
+    /**
+     * Load the codes from the data of all the documents of the given
+     * Xapian index.
+     *
+     * @param const Xapian::Database& Xapian index.
+     */
+    void loadFromDocuments (const Xapian::Database&);
+
+    /**
+     * Whether the given Xapian index holds the codes within value slots,
+     * according to the version of its format.
+     *
+     * @param const Xapian::Database& Xapian index.
+     */
+    static bool hasCodeSlots (const Xapian::Database&);
+
+    /**
+     * Keep the given document for the given code, when the PageRank value
+     * of its POR is higher than the one of the document already kept.
+     *
+     * @param UniqueCodeMap_T& Map of the codes.
+     * @param const std::string& Code (uppercase).
+     * @param const RankedDocID_T& Document ID and PageRank value.
+     * @param const bool Whether the new document wins in case of a tie.
+     */
+    static void addUniqueCode (UniqueCodeMap_T&, const std::string&,
+                               const RankedDocID_T&, const bool);
+
+  private:
+    /** POR having the highest PageRank value, for every IATA code. */
+    UniqueCodeMap_T _iataCodeMap;
+
+    /** POR having the highest PageRank value, for every UN/LOCODE code. */
+    UniqueCodeMap_T _unloCodeMap;
+
+    /** All the POR, for every ICAO code. */
+    CodeMap_T _icaoCodeMap;
+
+    /** All the POR, for every Geonames ID. */
+    GeonamesIDMap_T _geonamesIDMap;
+
+    /** UUID of the Xapian index the dictionary has been loaded from. */
+    std::string _xapianDatabaseUUID;
+
+    /** Number of Xapian documents the dictionary has been loaded from. */
+    NbOfDBEntries_T _nbOfDocuments;
+  };
+}
+#endif // __OPENTREP_BOM_CODEDICTIONARY_HPP
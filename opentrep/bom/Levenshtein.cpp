@@ -2,13 +2,313 @@
 // Import section
 // //////////////////////////////////////////////////////////////////////
 // STL
+#include <cassert>
+#include <cstdlib>
 #include <string>
 #include <vector>
+#include <algorithm>
 // OpenTREP
 #include <opentrep/bom/Levenshtein.hpp>
 
 namespace OPENTREP {
 
+  /**
+   * Word of the bit-vectors of the bit-parallel algorithm.
+   */
+  typedef unsigned long long BitWord_T;
+
+  /**
+   * Number of bits of a word of the bit-vectors.
+   */
+  static const size_t K_BIT_WORD_SIZE = 64;
+
+  /**
+   * Symbol (byte or Unicode code point) of a string.
+   */
+  typedef unsigned int Symbol_T;
+
+  /**
+   * @brief Helper class
+   *
+   * Array, the elements of which are held on the stack as long as they
+   * are no more than N, and on the heap otherwise.
+   */
+  template <typename T, size_t N>
+  class InlineArray {
+  public:
+    InlineArray (const size_t& iSize, const T& iValue)
+      : _data (_inlineData), _size (iSize) {
+      if (iSize > N) {
+        _heapData.assign (iSize, iValue);
+        _data = &_heapData[0];
+      } else {
+        std::fill (_inlineData, _inlineData + iSize, iValue);
+      }
+    }
+    size_t size() const {
+      return _size;
+    }
+    void shrink (const size_t& iSize) {
+      assert (iSize <= _size);
+      _size = iSize;
+    }
+    T& operator[] (const size_t& idx) {
+      return _data[idx];
+    }
+    const T& operator[] (const size_t& idx) const {
+      return _data[idx];
+    }
+    T* begin() {
+      return _data;
+    }
+    T* end() {
+      return _data + _size;
+    }
+  private:
+    InlineArray (const InlineArray&);
+    T _inlineData[N];
+    std::vector<T> _heapData;
+    T* _data;
+    size_t _size;
+  };
+
+  /**
+   * Sequence of the symbols of a string.
+   */
+  typedef InlineArray<Symbol_T, 128> SymbolSequence_T;
+
+  /**
+   * @brief Helper function
+   *
+   * Split the given string into symbols, i.e., either into bytes or into
+   * (UTF-8 decoded) Unicode code points. The bytes which are not part of
+   * a valid UTF-8 sequence are kept as distinct symbols, out of the range
+   * of the Unicode code points.
+   */
+  // //////////////////////////////////////////////////////////////////
+  static void splitIntoSymbols (const std::string& iString,
+                                const bool& iShouldCountCodePoints,
+                                SymbolSequence_T& ioSymbolSequence) {
+    const size_t lLength = iString.size();
+    assert (ioSymbolSequence.size() == lLength);
+
+    if (iShouldCountCodePoints == false) {
+      for (size_t idx = 0; idx != lLength; ++idx) {
+        ioSymbolSequence[idx] = static_cast<unsigned char> (iString[idx]);
+      }
+      return;
+    }
+
+    size_t lNbOfSymbols = 0;
+    size_t idx = 0;
+    while (idx != lLength) {
+      const unsigned char lLeadByte = static_cast<unsigned char> (iString[idx]);
+      size_t lNbOfContinuationBytes = 0;
+      Symbol_T lCodePoint = lLeadByte;
+      if (lLeadByte >= 0xC2 && lLeadByte <= 0xDF) {
+        lNbOfContinuationBytes = 1; lCodePoint = lLeadByte & 0x1F;
+      } else if (lLeadByte >= 0xE0 && lLeadByte <= 0xEF) {
+        lNbOfContinuationBytes = 2; lCodePoint = lLeadByte & 0x0F;
+      } else if (lLeadByte >= 0xF0 && lLeadByte <= 0xF4) {
+        lNbOfContinuationBytes = 3; lCodePoint = lLeadByte & 0x07;
+      }
+
+      bool isValid = (lLeadByte < 0x80 || lNbOfContinuationBytes != 0)
+        && (idx + lNbOfContinuationBytes < lLength);
+      for (size_t idxByte = 1;
+           isValid == true && idxByte <= lNbOfContinuationBytes; ++idxByte) {
+        const unsigned char lByte =
+          static_cast<unsigned char> (iString[idx + idxByte]);
+        isValid = ((lByte & 0xC0) == 0x80);
+        lCodePoint = (lCodePoint << 6) | (lByte & 0x3F);
+      }
+
+      if (isValid == true) {
+        ioSymbolSequence[lNbOfSymbols] = lCodePoint;
+        idx += 1 + lNbOfContinuationBytes;
+      } else {
+        ioSymbolSequence[lNbOfSymbols] = 0x110000 + lLeadByte;
+        ++idx;
+      }
+      ++lNbOfSymbols;
+    }
+    ioSymbolSequence.shrink (lNbOfSymbols);
+  }
+
+  /**
+   * @brief Helper class
+   *
+   * Bit-vectors of the positions of every symbol within the pattern
+   * (shorter string). For the bytes, the bit-vectors are directly indexed
+   * by the byte values; for the Unicode code points, by the ranks of those
+   * latter among the (sorted) distinct code points of the pattern.
+   */
+  class PatternMatchVectors {
+  public:
+    PatternMatchVectors (const SymbolSequence_T& iPattern,
+                         const size_t& iNbOfBlocks,
+                         const bool& iShouldCountCodePoints)
+      : _nbOfBlocks (iNbOfBlocks), _isByteIndexed (!iShouldCountCodePoints),
+        _symbolList (iShouldCountCodePoints ? iPattern.size() : 0, 0),
+        _vectorList (iShouldCountCodePoints ? (iPattern.size() + 1) * iNbOfBlocks
+                     : 256 * iNbOfBlocks, 0) {
+      const size_t lPatternLength = iPattern.size();
+
+      if (_isByteIndexed == false) {
+        // Sorted distinct code points of the pattern. The bit-vectors of
+        // the code points absent from the pattern are the last ones (all
+        // the bits being unset)
+        for (size_t idx = 0; idx != lPatternLength; ++idx) {
+          _symbolList[idx] = iPattern[idx];
+        }
+        std::sort (_symbolList.begin(), _symbolList.end());
+        const Symbol_T* lSymbolListEnd =
+          std::unique (_symbolList.begin(), _symbolList.end());
+        _symbolList.shrink (lSymbolListEnd - _symbolList.begin());
+      }
+
+      for (size_t idx = 0; idx != lPatternLength; ++idx) {
+        BitWord_T* lVector_ptr = getVector (iPattern[idx]);
+        lVector_ptr[idx / K_BIT_WORD_SIZE] |=
+          (static_cast<BitWord_T> (1) << (idx % K_BIT_WORD_SIZE));
+      }
+    }
+
+    BitWord_T* getVector (const Symbol_T& iSymbol) {
+      if (_isByteIndexed == true) {
+        assert (iSymbol < 256);
+        return &_vectorList[iSymbol * _nbOfBlocks];
+      }
+      const Symbol_T* itSymbol =
+        std::lower_bound (_symbolList.begin(), _symbolList.end(), iSymbol);
+      size_t lRank = itSymbol - _symbolList.begin();
+      if (itSymbol == _symbolList.end() || *itSymbol != iSymbol) {
+        lRank = _symbolList.size();
+      }
+      return &_vectorList[lRank * _nbOfBlocks];
+    }
+
+  private:
+    PatternMatchVectors (const PatternMatchVectors&);
+    const size_t _nbOfBlocks;
+    const bool _isByteIndexed;
+    InlineArray<Symbol_T, K_BIT_WORD_SIZE> _symbolList;
+    InlineArray<BitWord_T, 256> _vectorList;
+  };
+
+  /**
+   * @brief Helper function
+   *
+   * Calculate the edit distance between the pattern and the text, column
+   * by column of the (virtual) matrix of distances, i.e., symbol by symbol
+   * of the text. Every column is encoded by bit-vectors of the vertical
+   * deltas, split into blocks of 64 bits. The pattern must not be longer
+   * than the text.
+   */
+  // //////////////////////////////////////////////////////////////////
+  static int calculateBitParallelDistance (const SymbolSequence_T& iPattern,
+                                           const SymbolSequence_T& iText,
+                                           const int& iMaxDistance,
+                                           const bool& iShouldCountCodePoints) {
+    const size_t m = iPattern.size();
+    const size_t n = iText.size();
+    assert (m <= n);
+
+    if (m == 0) {
+      return (iMaxDistance >= 0 && static_cast<int> (n) > iMaxDistance) ?
+        iMaxDistance + 1 : static_cast<int> (n);
+    }
+
+    const size_t lNbOfBlocks = (m + K_BIT_WORD_SIZE - 1) / K_BIT_WORD_SIZE;
+    PatternMatchVectors lPatternMatchVectors (iPattern, lNbOfBlocks,
+                                              iShouldCountCodePoints);
+
+    // Vertical positive and negative deltas, diagonal zero deltas and
+    // pattern match vectors of the previous column
+    const BitWord_T lAllOnes = ~static_cast<BitWord_T> (0);
+    InlineArray<BitWord_T, 4> lVPList (lNbOfBlocks, lAllOnes);
+    InlineArray<BitWord_T, 4> lVNList (lNbOfBlocks, 0);
+    InlineArray<BitWord_T, 4> lD0List (lNbOfBlocks, 0);
+    InlineArray<BitWord_T, 4> lPMList (lNbOfBlocks, 0);
+
+    const size_t lLastBlock = lNbOfBlocks - 1;
+    const BitWord_T lLastBit =
+      static_cast<BitWord_T> (1) << ((m - 1) % K_BIT_WORD_SIZE);
+    int oDistance = static_cast<int> (m);
+
+    for (size_t j = 0; j != n; ++j) {
+      const BitWord_T* lPM_ptr = lPatternMatchVectors.getVector (iText[j]);
+
+      // Carries from one block to the next: the first row of the matrix
+      // is made of horizontal positive deltas
+      BitWord_T lAddCarry = 0;
+      BitWord_T lHPCarry = 1;
+      BitWord_T lHNCarry = 0;
+      BitWord_T lTRCarry = 0;
+
+      for (size_t b = 0; b != lNbOfBlocks; ++b) {
+        const BitWord_T lPM = lPM_ptr[b];
+        const BitWord_T lVP = lVPList[b];
+        const BitWord_T lVN = lVNList[b];
+
+        // Transpositions of two adjacent letters. As for the reference
+        // implementation, they are not considered for the first two
+        // letters of either string
+        const BitWord_T lTRBase = ~lD0List[b] & lPM;
+        BitWord_T lTR = ((lTRBase << 1) | lTRCarry) & lPMList[b];
+        lTRCarry = lTRBase >> (K_BIT_WORD_SIZE - 1);
+        if (j < 2) {
+          lTR = 0;
+        }
+        if (b == 0) {
+          lTR &= ~static_cast<BitWord_T> (3);
+        }
+
+        // Diagonal zero deltas, the addition being carried over the blocks
+        const BitWord_T lMatchVP = lPM & lVP;
+        const BitWord_T lSum1 = lMatchVP + lVP;
+        const BitWord_T lSum2 = lSum1 + lAddCarry;
+        lAddCarry = (lSum1 < lMatchVP || lSum2 < lSum1) ? 1 : 0;
+        const BitWord_T lD0 = (lSum2 ^ lVP) | lPM | lVN | lTR;
+
+        // Horizontal positive and negative deltas
+        const BitWord_T lHP = lVN | ~(lD0 | lVP);
+        const BitWord_T lHN = lD0 & lVP;
+        if (b == lLastBlock) {
+          if ((lHP & lLastBit) != 0) {
+            ++oDistance;
+          }
+          if ((lHN & lLastBit) != 0) {
+            --oDistance;
+          }
+        }
+
+        // Vertical deltas of the current column
+        const BitWord_T lHPShifted = (lHP << 1) | lHPCarry;
+        const BitWord_T lHNShifted = (lHN << 1) | lHNCarry;
+        lHPCarry = lHP >> (K_BIT_WORD_SIZE - 1);
+        lHNCarry = lHN >> (K_BIT_WORD_SIZE - 1);
+        lVNList[b] = lHPShifted & lD0;
+        lVPList[b] = lHNShifted | ~(lHPShifted | lD0);
+        lD0List[b] = lD0;
+        lPMList[b] = lPM;
+      }
+
+      // The distance can decrease by at most one for every remaining
+      // column: when it cannot go down to the maximum, there is no need
+      // to go further
+      if (iMaxDistance >= 0
+          && oDistance - static_cast<int> (n - j - 1) > iMaxDistance) {
+        return iMaxDistance + 1;
+      }
+    }
+
+    if (iMaxDistance >= 0 && oDistance > iMaxDistance) {
+      return iMaxDistance + 1;
+    }
+    return oDistance;
+  }
+
   // //////////////////////////////////////////////////////////////////
   int Levenshtein::getDistance (const std::string& iSource,
                                 const std::string& iTarget) {
@@ -108,4 +408,34 @@ namespace OPENTREP {
     return matrix[n][m];
   }
 
+  // //////////////////////////////////////////////////////////////////
+  int Levenshtein::getBoundedDistance (const std::string& iSource,
+                                       const std::string& iTarget,
+                                       const int& iMaxDistance,
+                                       const bool& iShouldCountCodePoints) {
+    // Split both strings into symbols (bytes or Unicode code points)
+    SymbolSequence_T lSourceSymbols (iSource.size(), 0);
+    splitIntoSymbols (iSource, iShouldCountCodePoints, lSourceSymbols);
+    SymbolSequence_T lTargetSymbols (iTarget.size(), 0);
+    splitIntoSymbols (iTarget, iShouldCountCodePoints, lTargetSymbols);
+
+    // The distance is at least the difference of the lengths
+    const int lLengthDifference =
+      std::abs (static_cast<int> (lSourceSymbols.size())
+                - static_cast<int> (lTargetSymbols.size()));
+    if (iMaxDistance >= 0 && lLengthDifference > iMaxDistance) {
+      return iMaxDistance + 1;
+    }
+
+    // The edit distance being symmetric, the shorter string is taken as
+    // the pattern, so that the bit-vectors be as short as possible
+    if (lSourceSymbols.size() <= lTargetSymbols.size()) {
+      return calculateBitParallelDistance (lSourceSymbols, lTargetSymbols,
+                                           iMaxDistance,
+                                           iShouldCountCodePoints);
+    }
+    return calculateBitParallelDistance (lTargetSymbols, lSourceSymbols,
+                                         iMaxDistance, iShouldCountCodePoints);
+  }
+
 }
@@ -19,10 +19,45 @@ namespace OPENTREP {
       distance/error. */
   class Levenshtein : public BomAbstract {
   public:
-    /** Calculate the edit distance between two strings. */
+    /** Calculate the edit distance between two strings.
+
+        That is the reference implementation, filling the full matrix
+        of the distances between all the prefixes of both strings. The
+        strings are compared byte by byte. */
     static int getDistance (const std::string& iSource,
                             const std::string& iTarget);
+
+    /** Calculate the edit distance between two strings, with the same
+        edit operations as getDistance() (including the transpositions
+        of two adjacent letters), thanks to a bit-parallel algorithm
+        (Myers, extended by Hyyro for the transpositions). As with
+        getDistance(), the transposition of the first two letters is not
+        recognised as a single edit, so that, byte by byte, both methods
+        always give the same distance.
+
+        The distance is calculated in O(ceil(m/64).n), where m is the
+        length of the shorter string and n the length of the longer one.
+        As long as the shorter string is at most 64-letter long, no memory
+        is allocated on the heap.
+
+        @param const std::string& iSource Source string.
+        @param const std::string& iTarget Target string.
+        @param const int& iMaxDistance Maximum distance of interest (a
+               negative value meaning no maximum). As soon as the distance
+               is known to be greater, the calculation stops, and
+               iMaxDistance + 1 is returned.
+        @param const bool& iShouldCountCodePoints Whether the (UTF-8)
+               strings are compared Unicode code point by code point
+               (e.g., "zurich" and "zürich" being one edit apart)
+               rather than byte by byte (as getDistance() does, "ü"
+               then counting as two letters).
+        @return int The edit distance, or iMaxDistance + 1 when that
+                latter is exceeded. */
+    static int getBoundedDistance (const std::string& iSource,
+                                   const std::string& iTarget,
+                                   const int& iMaxDistance,
+                                   const bool& iShouldCountCodePoints);
   };
-  
+
 }
 #endif // __OPENTREP_BOM_LEVENSHTEIN_HPP
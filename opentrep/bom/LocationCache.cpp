@@ -0,0 +1,44 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// C
+#include <cassert>
+// OpenTrep
+#include <opentrep/Location.hpp>
+#include <opentrep/CityDetails.hpp>
+#include <opentrep/bom/LocationCache.hpp>
+
+namespace OPENTREP {
+
+  thread_local LocationCache* LocationCache::_currentCache = NULL;
+
+  // //////////////////////////////////////////////////////////////////////
+  LocationCache::LocationCache() : _previousCache (_currentCache) {
+    _currentCache = this;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  LocationCache::~LocationCache() {
+    // Caches are scoped: the one being destroyed is the current one
+    assert (_currentCache == this);
+    _currentCache = _previousCache;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  LocationCache::LocationPtr_T LocationCache::
+  find (const Xapian::docid& iDocID) const {
+    LocationMap_T::const_iterator itLocation = _locationMap.find (iDocID);
+    if (itLocation == _locationMap.end()) {
+      return LocationPtr_T();
+    }
+    return itLocation->second;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void LocationCache::insert (const Xapian::docid& iDocID,
+                              const LocationPtr_T& iLocation_ptr) {
+    assert (iLocation_ptr != NULL);
+    _locationMap.insert (LocationMap_T::value_type (iDocID, iLocation_ptr));
+  }
+
+}
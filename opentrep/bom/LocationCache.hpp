@@ -0,0 +1,108 @@
+#ifndef __OPENTREP_BOM_LOCATIONCACHE_HPP
+#define __OPENTREP_BOM_LOCATIONCACHE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <memory>
+#include <unordered_map>
+// Xapian
+#include <xapian.h>
+
+namespace OPENTREP {
+
+  // Forward declarations
+  struct Location;
+
+  /**
+   * @brief Cache of the Location structures parsed from the Xapian documents
+   *        during a single request.
+   *
+   * The data of a Xapian document is a raw POR (point of reference) string,
+   * made of caret-separated fields, which may be several kB long with all
+   * the alternate names. Parsing it is expensive, whereas the same document
+   * is scored several times (primary key, envelope ID, PageRank), within
+   * several Result objects.
+   *
+   * As long as a LocationCache object is alive, it is the current cache of
+   * the thread which has created it, and Result::getLocation() parses any
+   * given Xapian document only once; the parsed (immutable) Location
+   * structure is then shared by all the subsequent calls.
+   *
+   * As the Xapian document IDs are specific to a given revision of the
+   * Xapian index, the cache is meant to be scoped to a single request.
+   */
+  class LocationCache {
+  public:
+    // ////////////// Type definitions /////////////
+    /** Shared handle on an immutable Location structure. */
+    typedef std::shared_ptr<const Location> LocationPtr_T;
+
+    /** Parsed Location structures, keyed by Xapian document ID. */
+    typedef std::unordered_map<Xapian::docid, LocationPtr_T> LocationMap_T;
+
+  public:
+    /**
+     * Get the current cache of the calling thread.
+     *
+     * @return LocationCache* The current cache, or NULL when there is none.
+     */
+    static LocationCache* getCurrent() {
+      return _currentCache;
+    }
+
+    /**
+     * Get the Location structure parsed from the given Xapian document.
+     *
+     * @param const Xapian::docid& ID of the Xapian document.
+     * @return LocationPtr_T The Location structure, or an empty handle
+     *         when that document has not been parsed yet.
+     */
+    LocationPtr_T find (const Xapian::docid&) const;
+
+    /**
+     * Store the Location structure parsed from the given Xapian document.
+     *
+     * @param const Xapian::docid& ID of the Xapian document.
+     * @param const LocationPtr_T& The parsed Location structure.
+     */
+    void insert (const Xapian::docid&, const LocationPtr_T&);
+
+    /**
+     * Get the number of Location structures held by the cache.
+     */
+    std::size_t size() const {
+      return _locationMap.size();
+    }
+
+  public:
+    /**
+     * Constructor. The new cache becomes the current cache of the
+     * calling thread.
+     */
+    LocationCache();
+
+    /**
+     * Destructor. The previous cache (if any) becomes again the current
+     * cache of the calling thread.
+     */
+    ~LocationCache();
+
+  private:
+    /** Caches are neither copyable nor assignable. */
+    LocationCache (const LocationCache&);
+    LocationCache& operator= (const LocationCache&);
+
+  private:
+    /** Current cache of the thread. */
+    static thread_local LocationCache* _currentCache;
+
+    /** Cache being the current one when this one was created. */
+    LocationCache* _previousCache;
+
+    /** Parsed Location structures. */
+    LocationMap_T _locationMap;
+  };
+}
+#endif // __OPENTREP_BOM_LOCATIONCACHE_HPP
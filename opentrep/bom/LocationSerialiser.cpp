@@ -0,0 +1,745 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#include <algorithm>
+// OpenTrep
+#include <opentrep/OPENTREP_exceptions.hpp>
+#include <opentrep/Location.hpp>
+#include <opentrep/CityDetails.hpp>
+#include <opentrep/basic/BasConst_General.hpp>
+#include <opentrep/bom/LocationSerialiser.hpp>
+
+namespace OPENTREP {
+
+  namespace {
+
+    // //////////////////// Layout of the header ////////////////////
+    const std::size_t K_OFFSET_VERSION = 4;
+    const std::size_t K_OFFSET_IATA_TYPE = 5;
+    const std::size_t K_OFFSET_IS_GEONAMES = 6;
+    const std::size_t K_OFFSET_IATA_CODE = 8;
+    const std::size_t K_IATA_CODE_SIZE = 4;
+    const std::size_t K_OFFSET_GEONAMES_ID = 12;
+    const std::size_t K_OFFSET_ENVELOPE_ID = 16;
+    const std::size_t K_OFFSET_LIST_SECTION = 20;
+    const std::size_t K_OFFSET_PAGE_RANK = 24;
+    const std::size_t K_OFFSET_LATITUDE = 32;
+    const std::size_t K_OFFSET_LONGITUDE = 40;
+    const std::size_t K_OFFSET_GEONAME_LATITUDE = 48;
+    const std::size_t K_OFFSET_GEONAME_LONGITUDE = 56;
+    const std::size_t K_OFFSET_GMT_OFFSET = 64;
+    const std::size_t K_OFFSET_DST_OFFSET = 68;
+    const std::size_t K_OFFSET_RAW_OFFSET = 72;
+    const std::size_t K_OFFSET_POPULATION = 76;
+    const std::size_t K_OFFSET_ELEVATION = 80;
+    const std::size_t K_OFFSET_GTOPO30 = 84;
+    const std::size_t K_OFFSET_WAC = 88;
+    const std::size_t K_OFFSET_DATE_FROM = 92;
+    const std::size_t K_OFFSET_DATE_END = 96;
+    const std::size_t K_OFFSET_MODIFICATION_DATE = 100;
+    const std::size_t K_OFFSET_NAME_SECTION = 104;
+    const std::size_t K_HEADER_SIZE = 108;
+
+    /**
+     * Rank of the common name within the string section (the ICAO and FAA
+     * codes come first).
+     */
+    const unsigned short K_COMMON_NAME_STRING_IDX = 2;
+
+    /**
+     * First version of the encoding holding the raw data string.
+     */
+    const unsigned char K_RAW_DATA_STRING_VERSION = 2;
+
+    /**
+     * Alphabet of the Base64 encoding (RFC 4648), the padding character
+     * being '='.
+     */
+    const char K_BASE64_ALPHABET[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const char K_BASE64_PADDING = '=';
+
+    // //////////////////// Encoding ////////////////////
+    /**
+     * Write the given unsigned integer, on 4 bytes, at the given offset.
+     */
+    void writeUInt32 (std::string& ioBuffer, const std::size_t iOffset,
+                      const unsigned int iValue) {
+      for (unsigned short idxByte = 0; idxByte != 4; ++idxByte) {
+        ioBuffer[iOffset + idxByte] =
+          static_cast<char> ((iValue >> (8 * idxByte)) & 0xFF);
+      }
+    }
+
+    /**
+     * Write the given unsigned integer, on 8 bytes, at the given offset.
+     */
+    void writeUInt64 (std::string& ioBuffer, const std::size_t iOffset,
+                      const unsigned long long iValue) {
+      for (unsigned short idxByte = 0; idxByte != 8; ++idxByte) {
+        ioBuffer[iOffset + idxByte] =
+          static_cast<char> ((iValue >> (8 * idxByte)) & 0xFF);
+      }
+    }
+
+    /**
+     * Write the given signed integer, on 4 bytes, at the given offset.
+     */
+    void writeInt32 (std::string& ioBuffer, const std::size_t iOffset,
+                     const int iValue) {
+      writeUInt32 (ioBuffer, iOffset, static_cast<unsigned int> (iValue));
+    }
+
+    /**
+     * Write the given floating point number, on 4 bytes, at the given offset.
+     */
+    void writeFloat (std::string& ioBuffer, const std::size_t iOffset,
+                     const float iValue) {
+      unsigned int lBits = 0;
+      std::memcpy (&lBits, &iValue, sizeof (lBits));
+      writeUInt32 (ioBuffer, iOffset, lBits);
+    }
+
+    /**
+     * Write the given floating point number, on 8 bytes, at the given offset.
+     */
+    void writeDouble (std::string& ioBuffer, const std::size_t iOffset,
+                      const double iValue) {
+      unsigned long long lBits = 0;
+      std::memcpy (&lBits, &iValue, sizeof (lBits));
+      writeUInt64 (ioBuffer, iOffset, lBits);
+    }
+
+    /**
+     * Write the given date, packed on 4 bytes (year, month and day),
+     * at the given offset. The special dates (e.g., not-a-date) are
+     * packed as 0.
+     */
+    void writeDate (std::string& ioBuffer, const std::size_t iOffset,
+                    const Date_T& iDate) {
+      unsigned int lPackedDate = 0;
+      if (iDate.is_special() == false) {
+        const Date_T::ymd_type& lYMD = iDate.year_month_day();
+        lPackedDate = (static_cast<unsigned int> (lYMD.year) << 16)
+          | (static_cast<unsigned int> (lYMD.month) << 8)
+          | static_cast<unsigned int> (lYMD.day);
+      }
+      writeUInt32 (ioBuffer, iOffset, lPackedDate);
+    }
+
+    /**
+     * Append the given unsigned integer, with a variable-length encoding
+     * (7 bits per byte, the most significant bit telling whether other
+     * bytes follow).
+     */
+    void appendVarUInt (std::string& ioBuffer, unsigned int iValue) {
+      while (iValue >= 0x80) {
+        ioBuffer.push_back (static_cast<char> ((iValue & 0x7F) | 0x80));
+        iValue >>= 7;
+      }
+      ioBuffer.push_back (static_cast<char> (iValue));
+    }
+
+    /**
+     * Append the given string, prefixed by its size.
+     */
+    void appendString (std::string& ioBuffer, const std::string& iValue) {
+      appendVarUInt (ioBuffer, iValue.size());
+      ioBuffer.append (iValue);
+    }
+
+    // //////////////////// Decoding ////////////////////
+    /**
+     * Throw a SerDeException, as the given data is truncated or corrupted.
+     */
+    void throwCorruptedData (const std::string& iReason) {
+      std::ostringstream oStr;
+      oStr << "The binary-encoded Location structure cannot be decoded: "
+           << iReason;
+      throw SerDeException (oStr.str());
+    }
+
+    /**
+     * Get the value (between 0 and 63) of the given Base64 character,
+     * or -1 when it is not part of the alphabet.
+     */
+    int getBase64Value (const char iChar) {
+      if (iChar >= 'A' && iChar <= 'Z') {
+        return iChar - 'A';
+      }
+      if (iChar >= 'a' && iChar <= 'z') {
+        return iChar - 'a' + 26;
+      }
+      if (iChar >= '0' && iChar <= '9') {
+        return iChar - '0' + 52;
+      }
+      if (iChar == '+') {
+        return 62;
+      }
+      if (iChar == '/') {
+        return 63;
+      }
+      return -1;
+    }
+
+    /**
+     * Check that the given data has at least a full header, of a
+     * supported version.
+     */
+    void checkHeader (const std::string& iData) {
+      if (LocationSerialiser::isSerialised (iData) == false) {
+        throwCorruptedData ("the magic prefix is missing");
+      }
+      if (iData.size() < K_HEADER_SIZE) {
+        throwCorruptedData ("the header is truncated");
+      }
+      const unsigned char lVersion =
+        static_cast<unsigned char> (iData[K_OFFSET_VERSION]);
+      if (lVersion == 0 || lVersion > K_LOCATION_BINARY_FORMAT_VERSION) {
+        std::ostringstream oStr;
+        oStr << "the version of the encoding (" << static_cast<int> (lVersion)
+             << ") is not supported";
+        throwCorruptedData (oStr.str());
+      }
+    }
+
+    /**
+     * Read an unsigned integer, on 4 bytes, at the given offset.
+     */
+    unsigned int readUInt32 (const std::string& iData,
+                             const std::size_t iOffset) {
+      unsigned int oValue = 0;
+      for (unsigned short idxByte = 0; idxByte != 4; ++idxByte) {
+        const unsigned char lByte =
+          static_cast<unsigned char> (iData[iOffset + idxByte]);
+        oValue |= static_cast<unsigned int> (lByte) << (8 * idxByte);
+      }
+      return oValue;
+    }
+
+    /**
+     * Read an unsigned integer, on 8 bytes, at the given offset.
+     */
+    unsigned long long readUInt64 (const std::string& iData,
+                                   const std::size_t iOffset) {
+      unsigned long long oValue = 0;
+      for (unsigned short idxByte = 0; idxByte != 8; ++idxByte) {
+        const unsigned char lByte =
+          static_cast<unsigned char> (iData[iOffset + idxByte]);
+        oValue |= static_cast<unsigned long long> (lByte) << (8 * idxByte);
+      }
+      return oValue;
+    }
+
+    /**
+     * Read a signed integer, on 4 bytes, at the given offset.
+     */
+    int readInt32 (const std::string& iData, const std::size_t iOffset) {
+      return static_cast<int> (readUInt32 (iData, iOffset));
+    }
+
+    /**
+     * Read a floating point number, on 4 bytes, at the given offset.
+     */
+    float readFloat (const std::string& iData, const std::size_t iOffset) {
+      const unsigned int lBits = readUInt32 (iData, iOffset);
+      float oValue = 0;
+      std::memcpy (&oValue, &lBits, sizeof (oValue));
+      return oValue;
+    }
+
+    /**
+     * Read a floating point number, on 8 bytes, at the given offset.
+     */
+    double readDouble (const std::string& iData, const std::size_t iOffset) {
+      const unsigned long long lBits = readUInt64 (iData, iOffset);
+      double oValue = 0;
+      std::memcpy (&oValue, &lBits, sizeof (oValue));
+      return oValue;
+    }
+
+    /**
+     * Read a packed date at the given offset.
+     */
+    Date_T readDate (const std::string& iData, const std::size_t iOffset) {
+      const unsigned int lPackedDate = readUInt32 (iData, iOffset);
+      if (lPackedDate == 0) {
+        return Date_T (boost::date_time::not_a_date_time);
+      }
+      const unsigned short lYear = lPackedDate >> 16;
+      const unsigned short lMonth = (lPackedDate >> 8) & 0xFF;
+      const unsigned short lDay = lPackedDate & 0xFF;
+      try {
+        return Date_T (lYear, lMonth, lDay);
+
+      } catch (const std::out_of_range&) {
+        throwCorruptedData ("a date is invalid");
+      }
+      return Date_T (boost::date_time::not_a_date_time);
+    }
+
+    /**
+     * Sequential reader of the variable-length sections.
+     */
+    class SectionReader {
+    public:
+      /**
+       * Constructor. The reading starts at the given offset.
+       */
+      SectionReader (const std::string& iData, const std::size_t iOffset)
+        : _data (iData), _offset (iOffset) {
+        if (_offset > _data.size()) {
+          throwCorruptedData ("a section offset is out of range");
+        }
+      }
+
+      /**
+       * Read an unsigned integer with a variable-length encoding.
+       */
+      unsigned int readVarUInt() {
+        unsigned int oValue = 0;
+        for (unsigned short lShift = 0; lShift < 32; lShift += 7) {
+          if (_offset >= _data.size()) {
+            throwCorruptedData ("an integer is truncated");
+          }
+          const unsigned char lByte =
+            static_cast<unsigned char> (_data[_offset]);
+          ++_offset;
+          oValue |= static_cast<unsigned int> (lByte & 0x7F) << lShift;
+          if ((lByte & 0x80) == 0) {
+            return oValue;
+          }
+        }
+        throwCorruptedData ("an integer is too long");
+        return oValue;
+      }
+
+      /**
+       * Read a string prefixed by its size.
+       */
+      std::string readString() {
+        const std::size_t lSize = readVarUInt();
+        if (lSize > _data.size() - _offset) {
+          throwCorruptedData ("a string is truncated");
+        }
+        const std::string oValue (_data, _offset, lSize);
+        _offset += lSize;
+        return oValue;
+      }
+
+      /**
+       * Skip a string prefixed by its size.
+       */
+      void skipString() {
+        const std::size_t lSize = readVarUInt();
+        if (lSize > _data.size() - _offset) {
+          throwCorruptedData ("a string is truncated");
+        }
+        _offset += lSize;
+      }
+
+    private:
+      /** Binary-encoded Location structure. */
+      const std::string& _data;
+
+      /** Current reading offset. */
+      std::size_t _offset;
+    };
+
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool LocationSerialiser::isSerialised (const std::string& iData) {
+    const std::size_t lMagicSize = K_LOCATION_BINARY_MAGIC.size();
+    const bool oIsSerialised =
+      (iData.size() >= lMagicSize
+       && iData.compare (0, lMagicSize, K_LOCATION_BINARY_MAGIC) == 0);
+    return oIsSerialised;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string LocationSerialiser::serialise (const Location& iLocation) {
+    // Fixed-size header
+    std::string oData (K_HEADER_SIZE, '\0');
+    oData.replace (0, K_LOCATION_BINARY_MAGIC.size(), K_LOCATION_BINARY_MAGIC);
+    oData[K_OFFSET_VERSION] =
+      static_cast<char> (K_LOCATION_BINARY_FORMAT_VERSION);
+
+    const LocationKey& lKey = iLocation.getKey();
+    const IATACode_T& lIataCode = lKey.getIataCode();
+    if (lIataCode.size() > K_IATA_CODE_SIZE) {
+      std::ostringstream oStr;
+      oStr << "The IATA code ('" << lIataCode << "') of the location '"
+           << lKey.toString() << "' is too long to be binary-encoded";
+      throw SerDeException (oStr.str());
+    }
+    oData[K_OFFSET_IATA_TYPE] =
+      static_cast<char> (lKey.getIataType().getType());
+    oData[K_OFFSET_IS_GEONAMES] = (iLocation.isGeonames() == true) ? 1 : 0;
+    oData.replace (K_OFFSET_IATA_CODE, lIataCode.size(), lIataCode);
+    writeUInt32 (oData, K_OFFSET_GEONAMES_ID, lKey.getGeonamesID());
+    writeUInt32 (oData, K_OFFSET_ENVELOPE_ID, iLocation.getEnvelopeID());
+    writeDouble (oData, K_OFFSET_PAGE_RANK, iLocation.getPageRank());
+    writeDouble (oData, K_OFFSET_LATITUDE, iLocation.getLatitude());
+    writeDouble (oData, K_OFFSET_LONGITUDE, iLocation.getLongitude());
+    writeDouble (oData, K_OFFSET_GEONAME_LATITUDE,
+                 iLocation.getGeonameLatitude());
+    writeDouble (oData, K_OFFSET_GEONAME_LONGITUDE,
+                 iLocation.getGeonameLongitude());
+    writeFloat (oData, K_OFFSET_GMT_OFFSET, iLocation.getGMTOffset());
+    writeFloat (oData, K_OFFSET_DST_OFFSET, iLocation.getDSTOffset());
+    writeFloat (oData, K_OFFSET_RAW_OFFSET, iLocation.getRawOffset());
+    writeUInt32 (oData, K_OFFSET_POPULATION, iLocation.getPopulation());
+    writeInt32 (oData, K_OFFSET_ELEVATION, iLocation.getElevation());
+    writeInt32 (oData, K_OFFSET_GTOPO30, iLocation.getGTopo30());
+    writeUInt32 (oData, K_OFFSET_WAC, iLocation.getWAC());
+    writeDate (oData, K_OFFSET_DATE_FROM, iLocation.getDateFrom());
+    writeDate (oData, K_OFFSET_DATE_END, iLocation.getDateEnd());
+    writeDate (oData, K_OFFSET_MODIFICATION_DATE,
+               iLocation.getModificationDate());
+
+    // String section. The ICAO and FAA codes must come first
+    // (see K_COMMON_NAME_STRING_IDX)
+    appendString (oData, iLocation.getIcaoCode());
+    appendString (oData, iLocation.getFaaCode());
+    appendString (oData, iLocation.getCommonName());
+    appendString (oData, iLocation.getAsciiName());
+    appendString (oData, iLocation.getAltNameShortListString());
+    appendString (oData, iLocation.getTvlPORListString());
+    appendString (oData, iLocation.getComment());
+    appendString (oData, iLocation.getStateCode());
+    appendString (oData, iLocation.getCountryCode());
+    appendString (oData, iLocation.getAltCountryCode());
+    appendString (oData, iLocation.getCountryName());
+    appendString (oData, iLocation.getWACName());
+    appendString (oData, iLocation.getCurrencyCode());
+    appendString (oData, iLocation.getContinentCode());
+    appendString (oData, iLocation.getContinentName());
+    appendString (oData, iLocation.getFeatureClass());
+    appendString (oData, iLocation.getFeatureCode());
+    appendString (oData, iLocation.getAdmin1Code());
+    appendString (oData, iLocation.getAdmin1UtfName());
+    appendString (oData, iLocation.getAdmin1AsciiName());
+    appendString (oData, iLocation.getAdmin2Code());
+    appendString (oData, iLocation.getAdmin2UtfName());
+    appendString (oData, iLocation.getAdmin2AsciiName());
+    appendString (oData, iLocation.getAdmin3Code());
+    appendString (oData, iLocation.getAdmin4Code());
+    appendString (oData, iLocation.getTimeZone());
+    appendString (oData, iLocation.getWikiLink());
+
+    // List section
+    writeUInt32 (oData, K_OFFSET_LIST_SECTION, oData.size());
+
+    const UNLOCodeList_T& lUNLOCodeList = iLocation.getUNLOCodeList();
+    appendVarUInt (oData, lUNLOCodeList.size());
+    for (UNLOCodeList_T::const_iterator itUNLOCode = lUNLOCodeList.begin();
+         itUNLOCode != lUNLOCodeList.end(); ++itUNLOCode) {
+      appendString (oData, *itUNLOCode);
+    }
+
+    const UICCodeList_T& lUICCodeList = iLocation.getUICCodeList();
+    appendVarUInt (oData, lUICCodeList.size());
+    for (UICCodeList_T::const_iterator itUICCode = lUICCodeList.begin();
+         itUICCode != lUICCodeList.end(); ++itUICCode) {
+      appendVarUInt (oData, *itUICCode);
+    }
+
+    const CityDetailsList_T& lCityList = iLocation.getCityList();
+    appendVarUInt (oData, lCityList.size());
+    for (CityDetailsList_T::const_iterator itCity = lCityList.begin();
+         itCity != lCityList.end(); ++itCity) {
+      const CityDetails& lCity = *itCity;
+      appendString (oData, lCity.getIataCode());
+      appendVarUInt (oData, lCity.getGeonamesID());
+      appendString (oData, lCity.getUtfName());
+      appendString (oData, lCity.getAsciiName());
+      appendString (oData, lCity.getCountryCode());
+      appendString (oData, lCity.getStateCode());
+    }
+
+    // Name section
+    writeUInt32 (oData, K_OFFSET_NAME_SECTION, oData.size());
+
+    const NameMatrix_T& lNameMatrix = iLocation.getNameMatrix().getNameMatrix();
+    appendVarUInt (oData, lNameMatrix.size());
+    for (NameMatrix_T::const_iterator itNames = lNameMatrix.begin();
+         itNames != lNameMatrix.end(); ++itNames) {
+      appendString (oData, itNames->first);
+      const NameList_T& lNameList = itNames->second.getNameList();
+      appendVarUInt (oData, lNameList.size());
+      for (NameList_T::const_iterator itName = lNameList.begin();
+           itName != lNameList.end(); ++itName) {
+        appendString (oData, *itName);
+      }
+    }
+
+    // Raw data string
+    appendString (oData, iLocation.getRawDataString());
+
+    return oData;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Location LocationSerialiser::deserialise (const std::string& iData) {
+    Location oLocation;
+
+    // Fixed-size header
+    checkHeader (iData);
+
+    LocationKey lKey (getIataCode (iData), getIataType (iData),
+                      getGeonamesID (iData));
+    const bool isGeonames = (iData[K_OFFSET_IS_GEONAMES] != 0);
+    lKey.setIsGeonames (isGeonames);
+    oLocation.setKey (lKey);
+    oLocation.setEnvelopeID (readUInt32 (iData, K_OFFSET_ENVELOPE_ID));
+    oLocation.setPageRank (readDouble (iData, K_OFFSET_PAGE_RANK));
+    oLocation.setLatitude (readDouble (iData, K_OFFSET_LATITUDE));
+    oLocation.setLongitude (readDouble (iData, K_OFFSET_LONGITUDE));
+    oLocation.setGeonameLatitude (readDouble (iData,
+                                              K_OFFSET_GEONAME_LATITUDE));
+    oLocation.setGeonameLongitude (readDouble (iData,
+                                               K_OFFSET_GEONAME_LONGITUDE));
+    oLocation.setGMTOffset (readFloat (iData, K_OFFSET_GMT_OFFSET));
+    oLocation.setDSTOffset (readFloat (iData, K_OFFSET_DST_OFFSET));
+    oLocation.setRawOffset (readFloat (iData, K_OFFSET_RAW_OFFSET));
+    oLocation.setPopulation (readUInt32 (iData, K_OFFSET_POPULATION));
+    oLocation.setElevation (readInt32 (iData, K_OFFSET_ELEVATION));
+    oLocation.setGTopo30 (readInt32 (iData, K_OFFSET_GTOPO30));
+    oLocation.setWAC (readUInt32 (iData, K_OFFSET_WAC));
+    oLocation.setDateFrom (readDate (iData, K_OFFSET_DATE_FROM));
+    oLocation.setDateEnd (readDate (iData, K_OFFSET_DATE_END));
+    oLocation.setModificationDate (readDate (iData,
+                                             K_OFFSET_MODIFICATION_DATE));
+
+    // String section
+    SectionReader lStringReader (iData, K_HEADER_SIZE);
+    oLocation.setIcaoCode (lStringReader.readString());
+    oLocation.setFaaCode (lStringReader.readString());
+    oLocation.setCommonName (lStringReader.readString());
+    oLocation.setAsciiName (lStringReader.readString());
+    oLocation.setAltNameShortListString (lStringReader.readString());
+    oLocation.setTvlPORListString (lStringReader.readString());
+    oLocation.setComment (lStringReader.readString());
+    oLocation.setStateCode (lStringReader.readString());
+    oLocation.setCountryCode (lStringReader.readString());
+    oLocation.setAltCountryCode (lStringReader.readString());
+    oLocation.setCountryName (lStringReader.readString());
+    oLocation.setWACName (lStringReader.readString());
+    oLocation.setCurrencyCode (lStringReader.readString());
+    oLocation.setContinentCode (lStringReader.readString());
+    oLocation.setContinentName (lStringReader.readString());
+    oLocation.setFeatureClass (lStringReader.readString());
+    oLocation.setFeatureCode (lStringReader.readString());
+    oLocation.setAdmin1Code (lStringReader.readString());
+    oLocation.setAdmin1UtfName (lStringReader.readString());
+    oLocation.setAdmin1AsciiName (lStringReader.readString());
+    oLocation.setAdmin2Code (lStringReader.readString());
+    oLocation.setAdmin2UtfName (lStringReader.readString());
+    oLocation.setAdmin2AsciiName (lStringReader.readString());
+    oLocation.setAdmin3Code (lStringReader.readString());
+    oLocation.setAdmin4Code (lStringReader.readString());
+    oLocation.setTimeZone (lStringReader.readString());
+    oLocation.setWikiLink (lStringReader.readString());
+
+    // List section
+    SectionReader lListReader (iData,
+                               readUInt32 (iData, K_OFFSET_LIST_SECTION));
+    const unsigned int lNbOfUNLOCodes = lListReader.readVarUInt();
+    for (unsigned int idxCode = 0; idxCode != lNbOfUNLOCodes; ++idxCode) {
+      oLocation.addUNLOCode (UNLOCode_T (lListReader.readString()));
+    }
+
+    const unsigned int lNbOfUICCodes = lListReader.readVarUInt();
+    for (unsigned int idxCode = 0; idxCode != lNbOfUICCodes; ++idxCode) {
+      oLocation.addUICCode (lListReader.readVarUInt());
+    }
+
+    CityDetailsList_T lCityList;
+    const unsigned int lNbOfCities = lListReader.readVarUInt();
+    for (unsigned int idxCity = 0; idxCity != lNbOfCities; ++idxCity) {
+      const IATACode_T lCityCode (lListReader.readString());
+      const GeonamesID_T lCityGeonamesID = lListReader.readVarUInt();
+      const CityUTFName_T lCityUtfName (lListReader.readString());
+      const CityASCIIName_T lCityAsciiName (lListReader.readString());
+      const CountryCode_T lCityCountryCode (lListReader.readString());
+      const StateCode_T lCityStateCode (lListReader.readString());
+      lCityList.push_back (CityDetails (lCityCode, lCityGeonamesID,
+                                        lCityUtfName, lCityAsciiName,
+                                        lCityCountryCode, lCityStateCode));
+    }
+    oLocation.setCityList (lCityList);
+
+    // Name section
+    SectionReader lNameReader (iData,
+                               readUInt32 (iData, K_OFFSET_NAME_SECTION));
+    const unsigned int lNbOfLanguages = lNameReader.readVarUInt();
+    for (unsigned int idxLang = 0; idxLang != lNbOfLanguages; ++idxLang) {
+      const LanguageCode_T lLanguageCode (lNameReader.readString());
+      const unsigned int lNbOfNames = lNameReader.readVarUInt();
+      for (unsigned int idxName = 0; idxName != lNbOfNames; ++idxName) {
+        oLocation.addName (lLanguageCode, lNameReader.readString());
+      }
+    }
+
+    // Raw data string, which follows the name section
+    const unsigned char lVersion =
+      static_cast<unsigned char> (iData[K_OFFSET_VERSION]);
+    if (lVersion >= K_RAW_DATA_STRING_VERSION) {
+      oLocation.setRawDataString (lNameReader.readString());
+    }
+
+    return oLocation;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool LocationSerialiser::isTextEncoded (const std::string& iData) {
+    const std::size_t lPrefixSize = K_LOCATION_TEXT_PREFIX.size();
+    const bool oIsTextEncoded =
+      (iData.size() >= lPrefixSize
+       && iData.compare (0, lPrefixSize, K_LOCATION_TEXT_PREFIX) == 0);
+    return oIsTextEncoded;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string LocationSerialiser::encodeAsText (const std::string& iData) {
+    std::string oText (K_LOCATION_TEXT_PREFIX);
+    oText.reserve (K_LOCATION_TEXT_PREFIX.size() + 4 * (iData.size() + 2) / 3);
+
+    // Every group of 3 bytes gives 4 characters
+    const std::size_t lDataSize = iData.size();
+    for (std::size_t idx = 0; idx < lDataSize; idx += 3) {
+      const std::size_t lNbOfBytes = std::min<std::size_t> (3, lDataSize - idx);
+      unsigned int lGroup = 0;
+      for (std::size_t idxByte = 0; idxByte != 3; ++idxByte) {
+        lGroup <<= 8;
+        if (idxByte < lNbOfBytes) {
+          lGroup |= static_cast<unsigned char> (iData[idx + idxByte]);
+        }
+      }
+      for (std::size_t idxChar = 0; idxChar != 4; ++idxChar) {
+        if (idxChar <= lNbOfBytes) {
+          oText.push_back (K_BASE64_ALPHABET[(lGroup >> (18 - 6 * idxChar))
+                                             & 0x3F]);
+        } else {
+          oText.push_back (K_BASE64_PADDING);
+        }
+      }
+    }
+
+    return oText;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string LocationSerialiser::decodeText (const std::string& iText) {
+    if (isTextEncoded (iText) == false) {
+      throwCorruptedData ("the text prefix is missing");
+    }
+    const std::size_t lPrefixSize = K_LOCATION_TEXT_PREFIX.size();
+    const std::size_t lTextSize = iText.size() - lPrefixSize;
+    if (lTextSize % 4 != 0) {
+      throwCorruptedData ("the Base64 text is truncated");
+    }
+
+    std::string oData;
+    oData.reserve (3 * lTextSize / 4);
+
+    // Every group of 4 characters gives (up to) 3 bytes. The padding
+    // characters may only end the last group
+    for (std::size_t idx = lPrefixSize; idx != iText.size(); idx += 4) {
+      const bool isLastGroup = (idx + 4 == iText.size());
+      unsigned int lGroup = 0;
+      std::size_t lNbOfChars = 0;
+      for (std::size_t idxChar = 0; idxChar != 4; ++idxChar) {
+        const char lChar = iText[idx + idxChar];
+        lGroup <<= 6;
+        if (lChar == K_BASE64_PADDING && isLastGroup == true
+            && idxChar >= 2) {
+          continue;
+        }
+        const int lValue = getBase64Value (lChar);
+        if (lValue < 0 || lNbOfChars != idxChar) {
+          throwCorruptedData ("the Base64 text is invalid");
+        }
+        lGroup |= static_cast<unsigned int> (lValue);
+        ++lNbOfChars;
+      }
+      for (std::size_t idxByte = 0; idxByte + 1 < lNbOfChars; ++idxByte) {
+        oData.push_back (static_cast<char> ((lGroup >> (16 - 8 * idxByte))
+                                            & 0xFF));
+      }
+    }
+
+    return oData;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  IATACode_T LocationSerialiser::getIataCode (const std::string& iData) {
+    checkHeader (iData);
+    const char* lCode = iData.data() + K_OFFSET_IATA_CODE;
+    const std::size_t lCodeSize = strnlen (lCode, K_IATA_CODE_SIZE);
+    const IATACode_T oIataCode (std::string (lCode, lCodeSize));
+    return oIataCode;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  IATAType LocationSerialiser::getIataType (const std::string& iData) {
+    checkHeader (iData);
+    const unsigned char lType =
+      static_cast<unsigned char> (iData[K_OFFSET_IATA_TYPE]);
+    // The LAST_VALUE type stands for an unknown location type (e.g., for
+    // a default-constructed Location structure)
+    if (lType > IATAType::LAST_VALUE) {
+      throwCorruptedData ("the location type is invalid");
+    }
+    const IATAType oIataType (static_cast<IATAType::EN_IATAType> (lType));
+    return oIataType;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  GeonamesID_T LocationSerialiser::getGeonamesID (const std::string& iData) {
+    checkHeader (iData);
+    return readUInt32 (iData, K_OFFSET_GEONAMES_ID);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  EnvelopeID_T LocationSerialiser::getEnvelopeID (const std::string& iData) {
+    checkHeader (iData);
+    return readUInt32 (iData, K_OFFSET_ENVELOPE_ID);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  PageRank_T LocationSerialiser::getPageRank (const std::string& iData) {
+    checkHeader (iData);
+    return readDouble (iData, K_OFFSET_PAGE_RANK);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Latitude_T LocationSerialiser::getLatitude (const std::string& iData) {
+    checkHeader (iData);
+    return readDouble (iData, K_OFFSET_LATITUDE);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Longitude_T LocationSerialiser::getLongitude (const std::string& iData) {
+    checkHeader (iData);
+    return readDouble (iData, K_OFFSET_LONGITUDE);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  CommonName_T LocationSerialiser::getCommonName (const std::string& iData) {
+    checkHeader (iData);
+    SectionReader lStringReader (iData, K_HEADER_SIZE);
+    for (unsigned short idxString = 0;
+         idxString != K_COMMON_NAME_STRING_IDX; ++idxString) {
+      lStringReader.skipString();
+    }
+    const CommonName_T oCommonName (lStringReader.readString());
+    return oCommonName;
+  }
+
+}
@@ -0,0 +1,142 @@
+#ifndef __OPENTREP_BOM_LOCATIONSERIALISER_HPP
+#define __OPENTREP_BOM_LOCATIONSERIALISER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/IATAType.hpp>
+
+namespace OPENTREP {
+
+  // Forward declarations
+  struct Location;
+
+  /**
+   * @brief Compact binary encoding of the Location structures.
+   *
+   * It is an alternative to the raw (CSV) POR line, as the data of the
+   * Xapian documents: decoding it is much cheaper than parsing the raw
+   * line, and the scalar fields used by the ranking rules (key, envelope
+   * ID, PageRank, coordinates) may be read without decoding anything else.
+   *
+   * The encoding (all the integers being little-endian) is made of:
+   * <ul>
+   *   <li>a fixed-size header, starting with the magic prefix
+   *       (K_LOCATION_BINARY_MAGIC) and the version of the encoding
+   *       (K_LOCATION_BINARY_FORMAT_VERSION), followed by all the scalar
+   *       fields, at fixed offsets, and by the offsets of the list and name
+   *       sections;</li>
+   *   <li>the string section, i.e., the codes and names, each of them
+   *       being prefixed by its (variable-length encoded) size;</li>
+   *   <li>the list section, i.e., the UN/LOCODE codes, the UIC codes and
+   *       the served cities;</li>
+   *   <li>the name section, i.e., the alternate names, grouped by
+   *       language;</li>
+   *   <li>the raw data string (i.e., the raw POR line), prefixed by its
+   *       size. It is absent from the version 1 of the encoding.</li>
+   * </ul>
+   *
+   * The SQL database stores the encoding in its text form (see
+   * encodeAsText()), as the serialised_place column is not a binary one.
+   */
+  class LocationSerialiser {
+  public:
+    /**
+     * Check whether the given data is a binary-encoded Location structure
+     * (rather than, for instance, a raw POR line).
+     *
+     * @param const std::string& Data (e.g., of a Xapian document).
+     * @return bool Whether the data starts with the magic prefix.
+     */
+    static bool isSerialised (const std::string&);
+
+    /**
+     * Encode the given Location structure. The fields specific to the
+     * full-text matching process (keywords, matching percentage, edit
+     * distances, extra and alternate locations) are not encoded.
+     *
+     * @param const Location& The Location structure.
+     * @return std::string The binary encoding.
+     */
+    static std::string serialise (const Location&);
+
+    /**
+     * Decode the given binary-encoded Location structure.
+     *
+     * @param const std::string& The binary encoding.
+     * @return Location The Location structure.
+     * @throw SerDeException When the data is not a binary-encoded Location
+     *        structure of a supported version, or is truncated.
+     */
+    static Location deserialise (const std::string&);
+
+    /**
+     * Check whether the given data is the text form of a binary-encoded
+     * Location structure (rather than, for instance, a raw POR line).
+     *
+     * @param const std::string& Data (e.g., of a SQL database row).
+     * @return bool Whether the data starts with the text prefix.
+     */
+    static bool isTextEncoded (const std::string&);
+
+    /**
+     * Give the text form of the given binary-encoded Location structure,
+     * i.e., the text prefix (K_LOCATION_TEXT_PREFIX) followed by the
+     * Base64 encoding of the binary data.
+     *
+     * @param const std::string& The binary encoding.
+     * @return std::string The text form.
+     */
+    static std::string encodeAsText (const std::string&);
+
+    /**
+     * Give back the binary-encoded Location structure from its text form.
+     *
+     * @param const std::string& The text form.
+     * @return std::string The binary encoding.
+     * @throw SerDeException When the data is not a valid text form.
+     */
+    static std::string decodeText (const std::string&);
+
+  public:
+    // ////////// Fixed-offset accessors (no decoding) //////////
+    /** Get the IATA code of the binary-encoded Location structure. */
+    static IATACode_T getIataCode (const std::string&);
+
+    /** Get the location type of the binary-encoded Location structure. */
+    static IATAType getIataType (const std::string&);
+
+    /** Get the Geonames ID of the binary-encoded Location structure. */
+    static GeonamesID_T getGeonamesID (const std::string&);
+
+    /** Get the envelope ID of the binary-encoded Location structure. */
+    static EnvelopeID_T getEnvelopeID (const std::string&);
+
+    /** Get the PageRank of the binary-encoded Location structure. */
+    static PageRank_T getPageRank (const std::string&);
+
+    /** Get the latitude of the binary-encoded Location structure. */
+    static Latitude_T getLatitude (const std::string&);
+
+    /** Get the longitude of the binary-encoded Location structure. */
+    static Longitude_T getLongitude (const std::string&);
+
+    /**
+     * Get the common name of the binary-encoded Location structure.
+     * Only the sizes of the preceding strings are decoded.
+     */
+    static CommonName_T getCommonName (const std::string&);
+
+  private:
+    /**
+     * Default constructor. That class has only static methods.
+     */
+    LocationSerialiser() {}
+  };
+
+}
+#endif // __OPENTREP_BOM_LOCATIONSERIALISER_HPP
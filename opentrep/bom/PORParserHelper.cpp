@@ -3,6 +3,7 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <cassert>
+#include <cstring>
 #include <vector>
 #include <fstream>
 // Boost
@@ -1706,6 +1707,384 @@ namespace OPENTREP {
   }
 
 
+  /////////////////////////////////////////////////////////////////////////
+  //
+  //  Helpers for the hand-written POR line splitter
+  //
+  /////////////////////////////////////////////////////////////////////////
+  namespace PorParserHelper {
+
+    /** Number of caret-separated fields of a POR line. */
+    const unsigned short K_NB_OF_POR_FIELDS = 51;
+
+    /** Index of the alternate name section within a POR line. */
+    const unsigned short K_ALT_NAME_SECTION_FIELD_IDX = 43;
+
+    // //////////////////////////////////////////////////////////////////
+    bool isBlank (const char iChar) {
+      // Same characters as the ones skipped by the bsa::space skipper
+      return (iChar == ' ' || (iChar >= '\t' && iChar <= '\r'));
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    bool isUpper (const char iChar) {
+      return (iChar >= 'A' && iChar <= 'Z');
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    bool isUpperOrDigit (const char iChar) {
+      return (isUpper (iChar) || (iChar >= '0' && iChar <= '9'));
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    bool isFeatureCodeChar (const char iChar) {
+      return (isUpper (iChar) || (iChar >= '1' && iChar <= '5'));
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    bool isPORTypeChar (const char iChar) {
+      return (iChar != '\0' && std::strchr ("ABCGHOPRZ", iChar) != NULL);
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    bool isAltNameQualifierChar (const char iChar) {
+      return (iChar != '\0' && std::strchr ("shpc", iChar) != NULL);
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    bool isCodeQualifierChar (const char iChar) {
+      return (iChar == 'h' || iChar == 'p');
+    }
+
+    /**
+     * Check that the given slice is a code made of iMin to iMax characters,
+     * all of them being accepted by the given predicate.
+     */
+    bool isCode (const char* iBegin, const char* iEnd,
+                 const std::ptrdiff_t iMin, const std::ptrdiff_t iMax,
+                 bool (*iIsCodeChar) (const char)) {
+      const std::ptrdiff_t lLength = iEnd - iBegin;
+      if (lLength < iMin || lLength > iMax) {
+        return false;
+      }
+      for (const char* itChar = iBegin; itChar != iEnd; ++itChar) {
+        if (iIsCodeChar (*itChar) == false) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /**
+     * Check that the given slice is a free text, which the grammar would
+     * store as is: when starting with a blank, the grammar would skip that
+     * blank, and the hand-written splitter rather gives up.
+     */
+    bool isText (const char* iBegin, const char* iEnd) {
+      return (iBegin != iEnd && isBlank (*iBegin) == false);
+    }
+
+    /**
+     * Parse the given slice with the given (numeric) parser, which must
+     * consume the whole slice.
+     */
+    template <typename Parser, typename Attribute>
+    bool parseNumber (const char* iBegin, const char* iEnd,
+                      const Parser& iParser, Attribute& ioAttribute) {
+      const char* lStart = iBegin;
+      return (bsq::parse (lStart, iEnd, iParser, ioAttribute)
+              && lStart == iEnd);
+    }
+
+    /**
+     * Parse the given slice as a YYYY-MM-DD date, which must consume
+     * the whole slice. The date elements are stored within the staging
+     * fields of the Location structure, as the grammar does.
+     */
+    bool parseDate (const char* iBegin, const char* iEnd,
+                    Location& ioLocation) {
+      const char* lStart = iBegin;
+      return (bsq::parse (lStart, iEnd,
+                          year_p >> '-' >> month_p >> '-' >> day_p,
+                          ioLocation._itYear, ioLocation._itMonth,
+                          ioLocation._itDay)
+              && lStart == iEnd);
+    }
+
+    /**
+     * Find the first occurrence of the given character within the given
+     * slice, or the end of the slice when there is none.
+     */
+    const char* findChar (const char* iBegin, const char* iEnd,
+                          const char iChar) {
+      const void* lChar_ptr = std::memchr (iBegin, iChar, iEnd - iBegin);
+      if (lChar_ptr == NULL) {
+        return iEnd;
+      }
+      return static_cast<const char*> (lChar_ptr);
+    }
+
+    /**
+     * Find the first pipe ('|') or equal ('=') character within the given
+     * slice, or the end of the slice when there is none.
+     */
+    const char* findPipeOrEqual (const char* iBegin, const char* iEnd) {
+      const char* itChar = iBegin;
+      while (itChar != iEnd && *itChar != '|' && *itChar != '=') {
+        ++itChar;
+      }
+      return itChar;
+    }
+
+    /**
+     * Split the given POR line on the carets. The beginning and the end
+     * of every field are stored within the given arrays, the end of the
+     * last field being the end of the line.
+     *
+     * @return bool Whether the line is made of exactly K_NB_OF_POR_FIELDS
+     *         fields.
+     */
+    bool splitPORLine (const char* iBegin, const char* iEnd,
+                       const char** ioFieldBeginList,
+                       const char** ioFieldEndList) {
+      unsigned short idxField = 0;
+      const char* itField = iBegin;
+      while (true) {
+        if (idxField == K_NB_OF_POR_FIELDS) {
+          return false;
+        }
+        const char* lCaret = findChar (itField, iEnd, '^');
+        ioFieldBeginList[idxField] = itField;
+        ioFieldEndList[idxField] = lCaret;
+        ++idxField;
+        if (lCaret == iEnd) {
+          break;
+        }
+        itField = lCaret + 1;
+      }
+      return (idxField == K_NB_OF_POR_FIELDS);
+    }
+
+    /**
+     * Parse the alternate name section, made of '='-separated
+     * lang|name|qualifiers entries.
+     */
+    bool parseAltNameSection (const char* iBegin, const char* iEnd,
+                              Location& ioLocation) {
+      const char* itEntry = iBegin;
+      while (true) {
+        const char* lEntryEnd = findChar (itEntry, iEnd, '=');
+
+        // Language code (optional). The grammar would skip any blank in it.
+        const char* lLangEnd = findChar (itEntry, lEntryEnd, '|');
+        if (lLangEnd == lEntryEnd) {
+          return false;
+        }
+        for (const char* itChar = itEntry; itChar != lLangEnd; ++itChar) {
+          if (isBlank (*itChar) == true) {
+            return false;
+          }
+        }
+        if (itEntry != lLangEnd) {
+          ioLocation._itLanguageCode = LanguageCode_T (std::string (itEntry,
+                                                                  lLangEnd));
+        }
+
+        // Name
+        const char* lName = lLangEnd + 1;
+        const char* lNameEnd = findChar (lName, lEntryEnd, '|');
+        if (lNameEnd == lEntryEnd || isText (lName, lNameEnd) == false) {
+          return false;
+        }
+        const std::string lAltNameStr (lName, lNameEnd);
+        const AltNameShortListString_T lAltName (lAltNameStr);
+        ioLocation.addName (ioLocation._itLanguageCode, lAltName);
+        ioLocation._itLanguageCode = LanguageCode_T ("");
+
+        // Qualifiers (optional)
+        if (lNameEnd + 1 != lEntryEnd
+            && isCode (lNameEnd + 1, lEntryEnd, 1, 4,
+                       isAltNameQualifierChar) == false) {
+          return false;
+        }
+
+        if (lEntryEnd == iEnd) {
+          break;
+        }
+        itEntry = lEntryEnd + 1;
+      }
+      return true;
+    }
+
+    /**
+     * Reproduce what the grammar does on an empty alternate name section.
+     *
+     * The grammar then tries to match the language code of a first entry,
+     * which may span over the next fields, up to the first '|' or '='
+     * character of the rest of the line (e.g., within the UN/LOCODE
+     * section), and then the name. When both match, that name is stored
+     * before the grammar realises that the entry is not complete.
+     *
+     * @param const char* Beginning of the rest of the line, i.e., the
+     *        caret following the alternate name section.
+     * @param const char* End of the line.
+     * @return bool Whether the outcome is the one expected here, i.e., the
+     *         entry is eventually not matched.
+     */
+    bool parseEmptyAltNameSection (const char* iBegin, const char* iEnd,
+                                   Location& ioLocation) {
+      // Language code, without any blank
+      const char* lLangEnd = findPipeOrEqual (iBegin, iEnd);
+      std::string lLangCodeStr;
+      for (const char* itChar = iBegin; itChar != lLangEnd; ++itChar) {
+        if (isBlank (*itChar) == false) {
+          lLangCodeStr.push_back (*itChar);
+        }
+      }
+      ioLocation._itLanguageCode = LanguageCode_T (lLangCodeStr);
+      if (lLangEnd == iEnd || *lLangEnd == '=') {
+        return true;
+      }
+
+      // Name, the leading blanks of which are skipped
+      const char* lName = lLangEnd + 1;
+      while (lName != iEnd && isBlank (*lName) == true) {
+        ++lName;
+      }
+      const char* lNameEnd = findPipeOrEqual (lName, iEnd);
+      if (lName == lNameEnd) {
+        return true;
+      }
+      const std::string lAltNameStr (lName, lNameEnd);
+      const AltNameShortListString_T lAltName (lAltNameStr);
+      ioLocation.addName (ioLocation._itLanguageCode, lAltName);
+      ioLocation._itLanguageCode = LanguageCode_T ("");
+
+      // When followed by a '|' character, the entry may well be matched,
+      // and the rest of the line would be parsed in a different way
+      return (lNameEnd == iEnd || *lNameEnd == '=');
+    }
+
+    /**
+     * Parse a UN/LOCODE or UIC section, made of '='-separated
+     * code|qualifiers entries.
+     */
+    bool parseCodeSection (const char* iBegin, const char* iEnd,
+                           const bool isUNLOCode, Location& ioLocation) {
+      const char* itEntry = iBegin;
+      while (true) {
+        const char* lEntryEnd = findChar (itEntry, iEnd, '=');
+        const char* lCodeEnd = findChar (itEntry, lEntryEnd, '|');
+        if (lCodeEnd == lEntryEnd) {
+          return false;
+        }
+
+        if (isUNLOCode == true) {
+          if (isCode (itEntry, lCodeEnd, 5, 5, isUpperOrDigit) == false) {
+            return false;
+          }
+          const std::string lUNLOCodeStr (itEntry, lCodeEnd);
+          const UNLOCode_T lUNLOCode (lUNLOCodeStr);
+          ioLocation.addUNLOCode (lUNLOCode);
+
+        } else {
+          int lUICCode = 0;
+          if (parseNumber (itEntry, lCodeEnd, uint1_9_p, lUICCode) == false) {
+            return false;
+          }
+          ioLocation.addUICCode (static_cast<unsigned int> (lUICCode));
+        }
+
+        // Qualifiers (optional)
+        if (lCodeEnd + 1 != lEntryEnd
+            && isCode (lCodeEnd + 1, lEntryEnd, 1, 2,
+                       isCodeQualifierChar) == false) {
+          return false;
+        }
+
+        if (lEntryEnd == iEnd) {
+          break;
+        }
+        itEntry = lEntryEnd + 1;
+      }
+      return true;
+    }
+
+    /**
+     * Parse the served city details, i.e.,
+     * code|geonames_id|utf_name|ascii_name|country_code|state_code.
+     *
+     * As the state code may contain any character but the caret, the
+     * grammar stores the rest of the field within that state code, and
+     * therefore never sees more than one city. That behaviour is kept.
+     */
+    bool parseCityDetails (const char* iBegin, const char* iEnd,
+                           Location& ioLocation) {
+      // City IATA code
+      const char* lCodeEnd = findChar (iBegin, iEnd, '|');
+      if (lCodeEnd == iEnd
+          || isCode (iBegin, lCodeEnd, 3, 3, isUpper) == false) {
+        return false;
+      }
+      ioLocation._itCityIataCode = std::string (iBegin, lCodeEnd);
+
+      // City Geonames ID
+      const char* lGeoID = lCodeEnd + 1;
+      const char* lGeoIDEnd = findChar (lGeoID, iEnd, '|');
+      int lCityGeonamesID = 0;
+      if (lGeoIDEnd == iEnd
+          || parseNumber (lGeoID, lGeoIDEnd, uint1_9_p,
+                          lCityGeonamesID) == false) {
+        return false;
+      }
+      ioLocation._itCityGeonamesID =
+        static_cast<unsigned int> (lCityGeonamesID);
+
+      // City UTF8 and ASCII names
+      const char* lUtfName = lGeoIDEnd + 1;
+      const char* lUtfNameEnd = findPipeOrEqual (lUtfName, iEnd);
+      if (lUtfNameEnd == iEnd || *lUtfNameEnd != '|'
+          || isText (lUtfName, lUtfNameEnd) == false) {
+        return false;
+      }
+      ioLocation._itCityUtfName = std::string (lUtfName, lUtfNameEnd);
+
+      const char* lAsciiName = lUtfNameEnd + 1;
+      const char* lAsciiNameEnd = findPipeOrEqual (lAsciiName, iEnd);
+      if (lAsciiNameEnd == iEnd || *lAsciiNameEnd != '|'
+          || isText (lAsciiName, lAsciiNameEnd) == false) {
+        return false;
+      }
+      ioLocation._itCityAsciiName = std::string (lAsciiName, lAsciiNameEnd);
+
+      // City country code (optional)
+      const char* lCountry = lAsciiNameEnd + 1;
+      const char* lCountryEnd = findChar (lCountry, iEnd, '|');
+      if (lCountryEnd == iEnd) {
+        return false;
+      }
+      if (lCountry != lCountryEnd) {
+        if (isCode (lCountry, lCountryEnd, 2, 3, isUpper) == false) {
+          return false;
+        }
+        ioLocation._itCityCountryCode = std::string (lCountry, lCountryEnd);
+      }
+
+      // City state code (optional), i.e., the rest of the field
+      const char* lState = lCountryEnd + 1;
+      if (lState != iEnd) {
+        if (isText (lState, iEnd) == false) {
+          return false;
+        }
+        ioLocation._itCityStateCode = std::string (lState, iEnd);
+      }
+
+      ioLocation.consolidateCityDetailsList();
+      return true;
+    }
+  }
+
+
   /////////////////////////////////////////////////////////////////////////
   //
   //  Entry class for the string parser
@@ -1796,6 +2175,377 @@ namespace OPENTREP {
   }
 
 
+  /////////////////////////////////////////////////////////////////////////
+  //
+  //  Reusable line parser
+  //
+  /////////////////////////////////////////////////////////////////////////
+
+  // //////////////////////////////////////////////////////////////////////
+  PORLineParser::PORLineParser() : _grammar (NULL) {
+    // Initialise the parser (grammar) with the helper/staging structure,
+    // once for all the lines to be parsed
+    _grammar = new PorParserHelper::LocationParser<const char*> (_location);
+    assert (_grammar != NULL);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  PORLineParser::~PORLineParser() {
+    delete _grammar; _grammar = NULL;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  PORLineParser& PORLineParser::getThreadParser() {
+    static thread_local PORLineParser lPORLineParser;
+    return lPORLineParser;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  const Location& PORLineParser::parse (const char* iBegin,
+                                        const char* iEnd) {
+    assert (_grammar != NULL);
+
+    // Most of the lines have the regular layout, and are split by hand
+    if (parseRegularLine (iBegin, iEnd) == true) {
+      return _location;
+    }
+
+    // Otherwise, fall back on the grammar, starting from a blank Location
+    // structure, holding only the raw data string
+    _location = Location();
+    const std::string lString (iBegin, iEnd);
+    _location.setRawDataString (lString);
+
+    // Launch the parsing of the line directly from its characters
+    const char* lStart = iBegin;
+    bool hasParsingBeenSuccesful = false;
+    try {
+
+      hasParsingBeenSuccesful = bsq::phrase_parse (lStart, iEnd,
+                                                   *_grammar, bsa::space);
+
+    } catch (const bsq::expectation_failure<const char*>& e) {
+      const std::ptrdiff_t lColumn = e.first - iBegin + 1;
+      std::ostringstream oStr;
+      oStr << "Parse error on POR string '" << lString
+           << "', position " << lColumn << std::endl
+           << "'" << lString << "'" << std::endl
+           << std::setw(lColumn) << " " << "^- here";
+      OPENTREP_LOG_ERROR (oStr.str());
+      throw PorFileParsingException (oStr.str());
+    }
+
+    if (hasParsingBeenSuccesful == false || lStart != iEnd) {
+      OPENTREP_LOG_ERROR ("Parsing of POR input string: '" << lString
+                          << "' failed");
+      throw PorFileParsingException ("Parsing of POR input string: '"
+                                     + lString + "' failed");
+    }
+
+    return _location;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool PORLineParser::parseRegularLine (const char* iBegin,
+                                        const char* iEnd) {
+    using namespace PorParserHelper;
+
+    // Beginning and end of every field
+    const char* lFieldBeginList[K_NB_OF_POR_FIELDS];
+    const char* lFieldEndList[K_NB_OF_POR_FIELDS];
+    if (splitPORLine (iBegin, iEnd, lFieldBeginList, lFieldEndList) == false) {
+      return false;
+    }
+
+    // Start from a blank Location structure, holding only the raw data string
+    _location = Location();
+    _location.setRawDataString (std::string (iBegin, iEnd));
+
+    // The fields are stored in the same order as the grammar does
+    for (unsigned short idxField = 0; idxField != K_NB_OF_POR_FIELDS;
+         ++idxField) {
+      const char* lField = lFieldBeginList[idxField];
+      const char* lFieldEnd = lFieldEndList[idxField];
+      const bool isEmpty = (lField == lFieldEnd);
+      const std::string lFieldStr (lField, lFieldEnd);
+      int lInteger = 0;
+      double lDouble = 0.0;
+      float lFloat = 0.0;
+
+      switch (idxField) {
+      case 0: // IATA code (optional)
+        if (isEmpty == false) {
+          if (isCode (lField, lFieldEnd, 3, 3, isUpper) == false) {
+            return false;
+          }
+          _location.setIataCode (IATACode_T (lFieldStr));
+        }
+        break;
+      case 1: // ICAO code (optional)
+        if (isEmpty == false) {
+          if (isCode (lField, lFieldEnd, 4, 4, isUpperOrDigit) == false) {
+            return false;
+          }
+          _location.setIcaoCode (ICAOCode_T (lFieldStr));
+        }
+        break;
+      case 2: // FAA code (optional)
+        if (isEmpty == false) {
+          if (isCode (lField, lFieldEnd, 1, 4, isUpperOrDigit) == false) {
+            return false;
+          }
+          _location.setFaaCode (FAACode_T (lFieldStr));
+        }
+        break;
+      case 3: // Whether the POR is referenced by Geonames (not stored)
+        if (lFieldStr != "Y" && lFieldStr != "N" && lFieldStr != "Z") {
+          return false;
+        }
+        break;
+      case 4: // Geonames ID
+        if (parseNumber (lField, lFieldEnd, uint1_9_p, lInteger) == false) {
+          return false;
+        }
+        _location.setGeonamesID (static_cast<unsigned int> (lInteger));
+        break;
+      case 5: // Envelope ID (optional)
+        if (isEmpty == false) {
+          if (parseNumber (lField, lFieldEnd, uint1_4_p, lInteger) == false) {
+            return false;
+          }
+          _location.setEnvelopeID (static_cast<unsigned int> (lInteger));
+        }
+        break;
+      case 8: case 9: case 12: case 49: case 50: // Coordinates and PageRank
+        if (isEmpty == false) {
+          if (parseNumber (lField, lFieldEnd, bsq::double_, lDouble) == false) {
+            return false;
+          }
+          if (idxField == 8) {
+            _location.setLatitude (lDouble);
+          } else if (idxField == 9) {
+            _location.setLongitude (lDouble);
+          } else if (idxField == 12) {
+            _location.setPageRank (100.0 * lDouble);
+          } else if (idxField == 49) {
+            _location.setGeonameLatitude (lDouble);
+          } else {
+            _location.setGeonameLongitude (lDouble);
+          }
+        }
+        break;
+      case 10: // Feature class
+        if (isCode (lField, lFieldEnd, 1, 1, isUpper) == false) {
+          return false;
+        }
+        _location.setFeatureClass (FeatureClass_T (lFieldStr));
+        break;
+      case 11: // Feature code
+        if (isCode (lField, lFieldEnd, 2, 5, isFeatureCodeChar) == false) {
+          return false;
+        }
+        _location.setFeatureCode (FeatureCode_T (lFieldStr));
+        break;
+      case 13: case 14: // Validity dates (optional)
+        if (isEmpty == false) {
+          if (parseDate (lField, lFieldEnd, _location) == false) {
+            return false;
+          }
+          const Date_T& lDate = _location.calculateDate();
+          if (idxField == 13) {
+            _location.setDateFrom (lDate);
+          } else {
+            _location.setDateEnd (lDate);
+          }
+        }
+        break;
+      case 16: // Country code
+        if (isCode (lField, lFieldEnd, 2, 3, isUpper) == false) {
+          return false;
+        }
+        _location.setCountryCode (CountryCode_T (lFieldStr));
+        break;
+      case 6: case 7: case 18: case 45: // Mandatory names
+        if (isText (lField, lFieldEnd) == false) {
+          return false;
+        }
+        if (idxField == 6) {
+          _location.setCommonName (CommonName_T (lFieldStr));
+        } else if (idxField == 7) {
+          _location.setAsciiName (ASCIIName_T (lFieldStr));
+        } else if (idxField == 18) {
+          _location.setCountryName (CountryName_T (lFieldStr));
+        } else {
+          _location.setWACName (WACName_T (lFieldStr));
+        }
+        break;
+      case 15: case 17: case 19: case 20: case 21: case 22: case 23:
+      case 24: case 25: case 26: case 27: case 31: case 40: case 42:
+      case 46: // Optional names and codes
+        if (isEmpty == false) {
+          if (isText (lField, lFieldEnd) == false) {
+            return false;
+          }
+          switch (idxField) {
+          case 15: // The comments are not stored
+            break;
+          case 17: _location.setAltCountryCode (CountryCode_T (lFieldStr));
+            break;
+          case 19: _location.setContinentName (ContinentName_T (lFieldStr));
+            break;
+          case 20: _location.setAdmin1Code (Admin1Code_T (lFieldStr)); break;
+          case 21: _location.setAdmin1UtfName (Admin1UTFName_T (lFieldStr));
+            break;
+          case 22:
+            _location.setAdmin1AsciiName (Admin1ASCIIName_T (lFieldStr));
+            break;
+          case 23: _location.setAdmin2Code (Admin2Code_T (lFieldStr)); break;
+          case 24: _location.setAdmin2UtfName (Admin2UTFName_T (lFieldStr));
+            break;
+          case 25:
+            _location.setAdmin2AsciiName (Admin2ASCIIName_T (lFieldStr));
+            break;
+          case 26: _location.setAdmin3Code (Admin3Code_T (lFieldStr)); break;
+          case 27: _location.setAdmin4Code (Admin4Code_T (lFieldStr)); break;
+          case 31: _location.setTimeZone (TimeZone_T (lFieldStr)); break;
+          case 40: _location.setStateCode (StateCode_T (lFieldStr)); break;
+          case 42: _location.setWikiLink (WikiLink_T (lFieldStr)); break;
+          default: _location.setCurrencyCode (CurrencyCode_T (lFieldStr));
+            break;
+          }
+        }
+        break;
+      case 28: // Population (optional)
+        if (isEmpty == false) {
+          if (parseNumber (lField, lFieldEnd, uint1_9_p, lInteger) == false) {
+            return false;
+          }
+          _location.setPopulation (static_cast<unsigned int> (lInteger));
+        }
+        break;
+      case 29: case 30: // Elevation and GTopo30 (optional)
+        if (isEmpty == false) {
+          if (parseNumber (lField, lFieldEnd, int1_5_p, lInteger) == false) {
+            return false;
+          }
+          if (idxField == 29) {
+            _location.setElevation (lInteger);
+          } else {
+            _location.setGTopo30 (lInteger);
+          }
+        }
+        break;
+      case 32: case 33: case 34: // Time offsets (optional)
+        if (isEmpty == false) {
+          if (parseNumber (lField, lFieldEnd, bsq::float_, lFloat) == false) {
+            return false;
+          }
+          if (idxField == 32) {
+            _location.setGMTOffset (lFloat);
+          } else if (idxField == 33) {
+            _location.setDSTOffset (lFloat);
+          } else {
+            _location.setRawOffset (lFloat);
+          }
+        }
+        break;
+      case 35: // Modification date, or -1
+        if (lFieldStr != "-1") {
+          if (parseDate (lField, lFieldEnd, _location) == false) {
+            return false;
+          }
+          _location.setModificationDate (_location.calculateDate());
+        }
+        break;
+      case 36: // Served city codes (optional, only staged)
+        for (const char* itCode = lField; isEmpty == false; ) {
+          const char* lCodeEnd = findChar (itCode, lFieldEnd, ',');
+          if (isCode (itCode, lCodeEnd, 3, 3, isUpper) == false) {
+            return false;
+          }
+          _location._itCityIataCode = std::string (itCode, lCodeEnd);
+          if (lCodeEnd == lFieldEnd) {
+            break;
+          }
+          itCode = lCodeEnd + 1;
+        }
+        break;
+      case 37: // Served city names (optional, only staged)
+        for (const char* itName = lField; isEmpty == false; ) {
+          const char* lNameEnd = findPipeOrEqual (itName, lFieldEnd);
+          if ((lNameEnd != lFieldEnd && *lNameEnd == '|')
+              || isText (itName, lNameEnd) == false) {
+            return false;
+          }
+          _location._itCityUtfName = std::string (itName, lNameEnd);
+          if (lNameEnd == lFieldEnd) {
+            break;
+          }
+          itName = lNameEnd + 1;
+        }
+        break;
+      case 38: // Served city details (optional)
+        if (isEmpty == false
+            && parseCityDetails (lField, lFieldEnd, _location) == false) {
+          return false;
+        }
+        break;
+      case 39: // Travel-related POR (optional)
+        if (isEmpty == false) {
+          for (const char* itCode = lField; ; ) {
+            const char* lCodeEnd = findChar (itCode, lFieldEnd, ',');
+            if (isText (itCode, lCodeEnd) == false) {
+              return false;
+            }
+            const std::string lTvlPORCodeStr (itCode, lCodeEnd);
+            _location._itTvlPORList.push_back (IATACode_T (lTvlPORCodeStr));
+            if (lCodeEnd == lFieldEnd) {
+              break;
+            }
+            itCode = lCodeEnd + 1;
+          }
+          _location.consolidateTvlPORListString();
+        }
+        break;
+      case 41: // POR type
+        if (isCode (lField, lFieldEnd, 1, 3, isPORTypeChar) == false) {
+          return false;
+        }
+        _location.setIataType (IATAType (lFieldStr));
+        break;
+      case 43: // Alternate names (optional)
+        if (isEmpty == true) {
+          if (parseEmptyAltNameSection (lFieldEnd, iEnd, _location) == false) {
+            return false;
+          }
+        } else if (parseAltNameSection (lField, lFieldEnd,
+                                        _location) == false) {
+          return false;
+        }
+        break;
+      case 44: // World Area Code (WAC)
+        if (parseNumber (lField, lFieldEnd, uint1_4_p, lInteger) == false) {
+          return false;
+        }
+        _location.setWAC (static_cast<unsigned int> (lInteger));
+        break;
+      case 47: case 48: // UN/LOCODE and UIC codes (optional)
+        if (isEmpty == false
+            && parseCodeSection (lField, lFieldEnd, (idxField == 47),
+                                 _location) == false) {
+          return false;
+        }
+        break;
+      default:
+        assert (false);
+        break;
+      }
+    }
+
+    return true;
+  }
+
+
   /////////////////////////////////////////////////////////////////////////
   //
   //  Entry class for the file parser
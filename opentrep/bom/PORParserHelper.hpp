@@ -659,6 +659,9 @@ namespace OPENTREP {
                        boost::spirit::qi::unused_type,
                        boost::spirit::qi::unused_type) const;
     };
+
+    /** Grammar for the Por-Rule parser (defined in the implementation). */
+    template <typename Iterator> struct LocationParser;
   
   }
   
@@ -712,6 +715,111 @@ namespace OPENTREP {
   };
     
 
+  /////////////////////////////////////////////////////////////////////////
+  //
+  //  Reusable line parser
+  //
+  /////////////////////////////////////////////////////////////////////////
+  /**
+   * Parser of POR (point of reference) lines, re-usable from one line
+   * to the next.
+   *
+   * Contrary to PORStringParser, which instantiates the whole grammar
+   * (around 100 rules) for every line, and reads that line through
+   * an input stream and a multi_pass iterator, the grammar is built only
+   * once, when the parser is constructed, and the lines are parsed directly
+   * from their characters in memory. The Location structures are identical.
+   *
+   * Moreover, the lines having the regular layout (i.e., nearly all of them)
+   * do not even go through the grammar: they are split on the carets by
+   * a hand-written splitter (see parseRegularLine()). The grammar is used
+   * only for the other lines, so that the outcome (Location structure or
+   * PorFileParsingException) is always the one of the grammar.
+   *
+   * As the grammar stores the parsed fields within the Location structure of
+   * the parser, a parser must not be used concurrently by several threads.
+   * The getThreadParser() method gives a parser dedicated to the calling
+   * thread.
+   */
+  class PORLineParser {
+  public:
+    /**
+     * Get the parser dedicated to the calling thread. It is created
+     * at the first call made by that thread.
+     */
+    static PORLineParser& getThreadParser();
+
+    /**
+     * Parse the given POR line and generate the corresponding Location
+     * structure.
+     *
+     * @param const char* Beginning of the POR line.
+     * @param const char* End of the POR line.
+     * @return const Location& The Location structure. It is held by
+     *         the parser, and is therefore altered by the next parsing.
+     */
+    const Location& parse (const char* iBegin, const char* iEnd);
+
+    /**
+     * Parse the given POR line and generate the corresponding Location
+     * structure.
+     *
+     * @param const std::string& The POR line.
+     * @return const Location& The Location structure. It is held by
+     *         the parser, and is therefore altered by the next parsing.
+     */
+    const Location& parse (const std::string& iString) {
+      const char* lBegin = iString.data();
+      return parse (lBegin, lBegin + iString.size());
+    }
+
+    /**
+     * Parse the given POR line with the hand-written splitter only,
+     * i.e., without falling back on the grammar.
+     *
+     * The line is split on the carets, and every field is checked
+     * against the (strictest) form expected by the grammar. As soon as
+     * a field does not have that form (e.g., it starts with a blank, which
+     * the grammar would skip), the splitter gives up.
+     *
+     * @param const char* Beginning of the POR line.
+     * @param const char* End of the POR line.
+     * @return bool Whether the line has been parsed. When it is the case,
+     *         the Location structure is the same as the one given by
+     *         the grammar. Otherwise, that structure is meaningless.
+     */
+    bool parseRegularLine (const char* iBegin, const char* iEnd);
+
+  public:
+    /**
+     * Constructor. The grammar is built there.
+     */
+    PORLineParser();
+
+    /**
+     * Destructor.
+     */
+    ~PORLineParser();
+
+  private:
+    /** Parsers are neither copyable nor assignable. */
+    PORLineParser (const PORLineParser&);
+    PORLineParser& operator= (const PORLineParser&);
+
+  private:
+    // Attributes
+    /**
+     * POR Structure, filled by the grammar.
+     */
+    Location _location;
+
+    /**
+     * Grammar, bound to the Location structure above.
+     */
+    PorParserHelper::LocationParser<const char*>* _grammar;
+  };
+    
+
   /////////////////////////////////////////////////////////////////////////
   //
   //  Entry class for the file parser
@@ -0,0 +1,196 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+#include <memory>
+// OpenTrep
+#include <opentrep/OPENTREP_exceptions.hpp>
+#include <opentrep/basic/BasConst_General.hpp>
+#include <opentrep/bom/PhraseProbe.hpp>
+#include <opentrep/bom/SpellingSuggestionCache.hpp>
+#include <opentrep/service/Logger.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  PhraseProbe::PhraseProbe (const Xapian::Database& iDatabase)
+    : _database_ptr (&iDatabase), _databaseUUID (iDatabase.get_uuid()),
+      _database (iDatabase), _enquire (iDatabase),
+      _vocabularySketch_ptr (NULL) {
+    // Only the existence of the documents matters, not their relevance
+    _enquire.set_weighting_scheme (Xapian::BoolWeight());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  PhraseProbe::~PhraseProbe() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  PhraseProbe& PhraseProbe::
+  getThreadProbe (const Xapian::Database& iDatabase,
+                  const VocabularySketch& iVocabularySketch) {
+    static thread_local std::unique_ptr<PhraseProbe> lPhraseProbe_ptr;
+
+    // (Re-)create the probe when it does not correspond to the given
+    // Xapian database (e.g., when that latter has been re-built)
+    if (lPhraseProbe_ptr == NULL
+        || lPhraseProbe_ptr->_database_ptr != &iDatabase
+        || lPhraseProbe_ptr->_databaseUUID != iDatabase.get_uuid()) {
+      lPhraseProbe_ptr.reset (new PhraseProbe (iDatabase));
+    }
+    assert (lPhraseProbe_ptr != NULL);
+
+    // The sketch may have been re-loaded since the last call, even for
+    // the same Xapian database
+    lPhraseProbe_ptr->_vocabularySketch_ptr = &iVocabularySketch;
+
+    return *lPhraseProbe_ptr;
+  }
+
+  /**
+   * @brief Helper function
+   *
+   * Given the size of the phrase, determine the allowed edit distance for
+   * spelling purpose. For instance, if K_DEFAULT_SIZE_FOR_SPELLING_ERROR_UNIT
+   * is equal to 4:
+   * <ul>
+   *   <li>An edit distance of 1 will be allowed on a 4-letter word</li>
+   *   <li>While an edit distance of 3 will be allowed on an 11-letter word.</li>
+   * </ul>
+   */
+  // //////////////////////////////////////////////////////////////////////
+  static unsigned int calculateEditDistance (const TravelQuery_T& iPhrase) {
+    NbOfErrors_T oEditDistance = 2;
+
+    const NbOfErrors_T lQueryStringSize = iPhrase.size();
+
+    oEditDistance = lQueryStringSize / K_DEFAULT_SIZE_FOR_SPELLING_ERROR_UNIT;
+    return oEditDistance;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool PhraseProbe::doesPhraseExist (const TermList_T& iTermList) {
+    if (iTermList.empty() == true) {
+      return false;
+    }
+
+    // When the vocabulary sketch states that any of the terms, or any of
+    // the pairs of successive terms, is not indexed, there is no need to
+    // go further
+    assert (_vocabularySketch_ptr != NULL);
+    if (_vocabularySketch_ptr->mayContainPhrase (iTermList) == false) {
+      return false;
+    }
+
+    // When any of the terms is absent from the Xapian index, there is
+    // no need to go further
+    for (TermList_T::const_iterator itTerm = iTermList.begin();
+         itTerm != iTermList.end(); ++itTerm) {
+      const std::string& lTerm = *itTerm;
+      if (_database.get_termfreq (lTerm) == 0) {
+        return false;
+      }
+    }
+
+    // Build the query object. With the 'sna francicso' example, it
+    // yields "(sna PHRASE 2 francicso)"
+    const Xapian::Query lXapianQuery =
+      (iTermList.size() == 1) ?
+      Xapian::Query (iTermList.front()) :
+      Xapian::Query (Xapian::Query::OP_PHRASE,
+                     iTermList.begin(), iTermList.end(), iTermList.size());
+
+    // A single document is enough to state that the phrase exists
+    _enquire.set_query (lXapianQuery);
+    const Xapian::MSet& lMatchingSet = _enquire.get_mset (0, 1);
+
+    return (lMatchingSet.empty() == false);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool PhraseProbe::doesMatch (const std::string& iWord1,
+                               const std::string& iWord2) {
+    bool oDoesMatch = false;
+
+    //
+    std::ostringstream oStr;
+    oStr << iWord1 << " " << iWord2;
+    const std::string lQueryString (oStr.str());
+
+    // Catch any Xapian::Error exceptions thrown
+    try {
+
+      // Check whether the words match, as is
+      TermList_T lTermList;
+      VocabularySketch::deriveTerms (lQueryString, lTermList);
+      if (doesPhraseExist (lTermList) == true) {
+        // DEBUG
+        /*
+        OPENTREP_LOG_DEBUG ("        Query string: `" << lQueryString
+                            << "' provides exact matches.");
+        */
+
+        oDoesMatch = true;
+        return oDoesMatch;
+      }
+
+      /**
+       * Since there is no match, we search for a spelling suggestion, if any.
+       * With the above example, 'sna francisco' yields the suggestion
+       * 'san francisco'.
+       */
+      const NbOfErrors_T& lAllowableEditDistance =
+        calculateEditDistance (lQueryString);
+
+      // Let Xapian find a spelling correction (if any). It is cached, as
+      // well as the absence of correction, for the whole process
+      NbOfErrors_T lEditDistance = 0;
+      const std::string& lCorrectedString = SpellingSuggestionCache::
+        instance().getSpellingSuggestion (_database, lQueryString,
+                                          lAllowableEditDistance,
+                                          lEditDistance);
+
+      // If the correction is no better than the original string, there is
+      // no need to go further: there is no match.
+      if (lCorrectedString.empty() == true || lCorrectedString == lQueryString) {
+        // No match
+        return oDoesMatch;
+      }
+      assert (lCorrectedString.empty() == false
+              && lCorrectedString != lQueryString);
+
+      /**
+       * Since there is no match, we search on the corrected string.
+       *
+       * As, with the above example, the full corrected string is
+       * 'san francisco', it yields the query "(san PHRASE 2 francisco)",
+       * which should provide matches.
+       */
+      TermList_T lCorrectedTermList;
+      VocabularySketch::deriveTerms (lCorrectedString,
+                                      lCorrectedTermList);
+      oDoesMatch = doesPhraseExist (lCorrectedTermList);
+
+      if (oDoesMatch == false) {
+        // Error
+        OPENTREP_LOG_ERROR ("        Query string: `"
+                            << lQueryString << "', spelling suggestion: `"
+                            << lCorrectedString
+                            << "', with an allowable edit distance of "
+                            << lAllowableEditDistance << ", provides no "
+                            << "match, which is not consistent with the "
+                            << "existence of the spelling correction.");
+      }
+
+    } catch (const Xapian::Error& error) {
+      // Error
+      OPENTREP_LOG_ERROR ("Exception: "  << error.get_msg());
+      throw XapianException (error.get_msg());
+    }
+
+    return oDoesMatch;
+  }
+
+}
@@ -0,0 +1,134 @@
+#ifndef __OPENTREP_BOM_PHRASEPROBE_HPP
+#define __OPENTREP_BOM_PHRASEPROBE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+// Xapian
+#include <xapian.h>
+// OpenTrep
+#include <opentrep/bom/VocabularySketch.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Probe checking whether two contiguous words appear as a phrase
+   *        within the Xapian index (see QuerySlices).
+   *
+   * Only the existence of a matching document matters, not its relevance.
+   * The probe therefore:
+   * <ul>
+   *   <li>first checks the vocabulary sketch of the index (in-memory
+   *       look-ups), as there is no phrase when any of the words, or of the
+   *       pairs of contiguous words, is unknown by that sketch;</li>
+   *   <li>then checks the frequencies of the terms (a cheap look-up into
+   *       the posting lists), as there is no phrase when any of the words
+   *       is absent from the index;</li>
+   *   <li>then builds the phrase query directly, without any query parser,
+   *       and fetches at most a single document, with the boolean weighting
+   *       scheme (i.e., no relevance is computed).</li>
+   * </ul>
+   *
+   * Every thread has its own probe (see getThreadProbe()), the Xapian
+   * enquire session of which is re-used from one query to the next one,
+   * as long as the Xapian database stays the same.
+   */
+  class PhraseProbe {
+  public:
+    // ////////////// Type definitions /////////////
+    /**
+     * List of (Xapian) terms.
+     */
+    typedef VocabularySketch::TermList_T TermList_T;
+
+  public:
+    /**
+     * Get the probe of the calling thread for the given Xapian database.
+     * The probe is created when the thread has none yet, or when its
+     * probe has been created for another Xapian database.
+     *
+     * @param const Xapian::Database& Xapian database (index).
+     * @param const VocabularySketch& Vocabulary sketch of that Xapian
+     *        database, which must outlive the use of the probe.
+     * @return PhraseProbe& The probe of the calling thread.
+     */
+    static PhraseProbe& getThreadProbe (const Xapian::Database&,
+                                        const VocabularySketch&);
+
+  public:
+    // ////////////// Business methods /////////////
+    /**
+     * Check whether the juxtaposition of the two given words appears
+     * within the Xapian index, either as is or, when it does not, once
+     * corrected by the Xapian spelling dictionary.
+     *
+     * @param const std::string& First (left-hand side) word.
+     * @param const std::string& Second (right-hand side) word.
+     * @return bool Whether the two words match as a phrase.
+     */
+    bool doesMatch (const std::string& iWord1, const std::string& iWord2);
+
+    /**
+     * Check whether the given terms appear, in that order and contiguously,
+     * within at least a Xapian document.
+     *
+     * @param const TermList_T& List of (Xapian) terms.
+     * @return bool Whether there is at least a matching document.
+     */
+    bool doesPhraseExist (const TermList_T&);
+
+  private:
+    // ////////////// Constructors and destructors /////////////
+    /**
+     * Main constructor.
+     *
+     * @param const Xapian::Database& Xapian database (index).
+     */
+    PhraseProbe (const Xapian::Database&);
+
+    /**
+     * Probes are neither copyable nor assignable.
+     */
+    PhraseProbe (const PhraseProbe&);
+    PhraseProbe& operator= (const PhraseProbe&);
+
+  public:
+    /**
+     * Destructor.
+     */
+    ~PhraseProbe();
+
+  private:
+    // ////////////// Attributes /////////////
+    /**
+     * Address of the Xapian database for which the probe has been created.
+     */
+    const Xapian::Database* _database_ptr;
+
+    /**
+     * UUID of that Xapian database, so that a re-built Xapian index is
+     * not probed through a stale enquire session.
+     */
+    std::string _databaseUUID;
+
+    /**
+     * Handle on the Xapian database.
+     */
+    Xapian::Database _database;
+
+    /**
+     * Xapian enquire session, with the boolean weighting scheme.
+     */
+    Xapian::Enquire _enquire;
+
+    /**
+     * Vocabulary sketch of the Xapian database, as given by the last call
+     * to getThreadProbe().
+     */
+    const VocabularySketch* _vocabularySketch_ptr;
+  };
+
+}
+#endif // __OPENTREP_BOM_PHRASEPROBE_HPP
@@ -5,7 +5,7 @@
 #include <cassert>
 // OpenTrep
 #include <opentrep/basic/BasConst_General.hpp>
-#include <opentrep/basic/OTransliterator.hpp>
+#include <opentrep/basic/NormalisationCache.hpp>
 #include <opentrep/basic/Utilities.hpp>
 #include <opentrep/bom/WordCombinationHolder.hpp>
 #include <opentrep/bom/Place.hpp>
@@ -308,7 +308,7 @@ namespace OPENTREP {
                                    const CountryCode_T& iCountryCode,
                                    const CountryName_T& iCountryName,
                                    const ContinentName_T& iContinentName,
-                                   const OTransliterator& iTransliterator) {
+                                   NormalisationCache& ioNormalisationCache) {
     // Retrieve the string set for the given weight, if existing
     // (empty otherwise)
     StringSet_T lTermSet = getTermSet (iWeight);
@@ -384,7 +384,7 @@ namespace OPENTREP {
     // as the punctuation is eliminated (and not replaced by space)
     // by that latter.
     const std::string& lNormalisedCommonName =
-      iTransliterator.normalise (lTokenisedName);
+      ioNormalisationCache.normalise (lTokenisedName);
 
     // Add the tokenised and normalised name to the Xapian index
     lTermSet.insert (lNormalisedCommonName);
@@ -462,7 +462,8 @@ namespace OPENTREP {
   }
 
   // //////////////////////////////////////////////////////////////////////
-  void Place::buildIndexSets (const OTransliterator& iTransliterator) {
+  void Place::buildIndexSets (const NbOfWords_T& iMaxWordCombinationSpan,
+                              NormalisationCache& ioNormalisationCache) {
 
     /**
      * Add the place/POR details into Xapian:
@@ -685,7 +686,8 @@ namespace OPENTREP {
                            StateCode_T (lStateCode),
                            CountryCode_T (lCountryCode),
                            CountryName_T (lCountryName),
-                           ContinentName_T (lContinentName), iTransliterator);
+                           ContinentName_T (lContinentName),
+                           ioNormalisationCache);
     }
     
     // Add the ASCII name (not necessarily in English).
@@ -702,7 +704,8 @@ namespace OPENTREP {
                            StateCode_T (lStateCode),
                            CountryCode_T (lCountryCode),
                            CountryName_T (lCountryName),
-                           ContinentName_T (lContinentName), iTransliterator);
+                           ContinentName_T (lContinentName),
+                           ioNormalisationCache);
     }
 
     // Retrieve the place names in all the available languages
@@ -725,8 +728,9 @@ namespace OPENTREP {
         // (e.g., 'san francisco').
         if (lName.empty() == false) {
           // Create a list made of all the word combinations of the
-          // initial string
-          WordCombinationHolder lWordCombinationHolder (lName);
+          // initial string, within the maximum span
+          WordCombinationHolder lWordCombinationHolder (lName,
+                                                        iMaxWordCombinationSpan);
 
           // Browse the list of unique strings (word combinations)
           const WordCombinationHolder::StringList_T& lStringList =
@@ -736,7 +740,7 @@ namespace OPENTREP {
                itString != lStringList.end(); ++itString) {
             const std::string& lWordCombination = *itString;
             const std::string& lNormalisedWordCombination =
-              iTransliterator.normalise (lWordCombination);
+              ioNormalisationCache.normalise (lWordCombination);
 
             // Add that combination of words into the set of terms
             lStdTermSet.insert (lWordCombination);
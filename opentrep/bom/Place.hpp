@@ -21,7 +21,7 @@ namespace OPENTREP {
   // Forward declarations
   class World;
   class PlaceHolder;
-  class OTransliterator;
+  class NormalisationCache;
   
   /**
    * @brief Class modelling a place/POR (point of reference).
@@ -29,6 +29,7 @@ namespace OPENTREP {
   class Place : public BomAbstract {
     friend class FacWorld;
     friend class FacPlace;
+    friend class BomArena;
     friend class FacPlaceHolder;
     friend class DbaPlace;
   public:
@@ -997,7 +998,7 @@ namespace OPENTREP {
      * @param const CountryCode_T& ISO code of the country of the POR
      * @param const CountryName_T& Name of the country of the POR
      * @param const ContinentName_T& Name of the continent of the POR
-     * @param const OTransliterator& Unicode transliterator
+     * @param NormalisationCache& Cache of the Unicode normalisations
      */
     void addNameToXapianSets (const Weight_T&,
                               const LocationName_T&, const FeatureCode_T&,
@@ -1007,15 +1008,18 @@ namespace OPENTREP {
                               const Admin2UTFName_T&, const Admin2ASCIIName_T&,
                               const StateCode_T&,
                               const CountryCode_T&, const CountryName_T&,
-                              const ContinentName_T&, const OTransliterator&);
+                              const ContinentName_T&, NormalisationCache&);
 
     /**
      * Build the (STL) sets of (Xapian-related) terms, spelling,
      * synonyms, etc.
      *
-     * @param const OTransliterator& Unicode transliterator
+     * @param const NbOfWords_T& Maximum span of the word combinations
+     *        derived from the alternate names (0 meaning no maximum).
+     *        See WordCombinationHolder for more details.
+     * @param NormalisationCache& Cache of the Unicode normalisations
      */
-    void buildIndexSets (const OTransliterator&);
+    void buildIndexSets (const NbOfWords_T&, NormalisationCache&);
 
     /**
      * Add the given name to the Xapian index with the given weight.
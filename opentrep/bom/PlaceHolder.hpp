@@ -15,6 +15,7 @@ namespace OPENTREP {
   /** Class wrapping functions on a list of Place objects. */
   class PlaceHolder : public BomAbstract {
     friend class FacPlaceHolder;
+    friend class BomArena;
   public:
     // ////////////// Getters /////////////
     /** Retrieve the list of place objects. */
@@ -12,17 +12,18 @@
 // OpenTrep
 #include <opentrep/OPENTREP_Types.hpp>
 #include <opentrep/basic/StructAbstract.hpp>
-#include <opentrep/bom/StringPartition.hpp>
+#include <opentrep/bom/StringSet.hpp>
 
 namespace OPENTREP {
 
   // Forward declarations
   class OTransliterator;
+  class VocabularySketch;
 
   /**
    * Class allowing to slice a query string into multiple slices.
-   * Each of those slices will then give birth to the corresponding
-   * string partitions.
+   * Each of those slices will then be segmented into the best matching
+   * string partition (see StringSegmentation).
    *
    * The initial query string is sliced in the interstices, which split apart
    * any two consecutive words yielding no full text match.
@@ -57,19 +58,19 @@ namespace OPENTREP {
     }
 
     /**
-     * Get the underlying list of string partitions.
+     * Get the underlying list of query slices.
      */
-    const StringPartitionList_T& getStringPartitionList() const {
+    const StringSet& getQuerySliceList() const {
       return _slices;
     }
 
     /**
-     * Add an item (StringPartition) into the list.
+     * Add an item (query slice) into the list.
      *
-     * \note When the given string set is empty (zero-length),
+     * \note When the given query slice is empty (zero-length),
      *       it is (obviously) not added to the list
      */
-    void push_back (const StringPartition& iStringPartition);
+    void push_back (const std::string& iQuerySlice);
   
     /**
      * Return the size of the list.
@@ -133,11 +134,12 @@ namespace OPENTREP {
      * Main constructor.
      *
      * @param const Xapian::Database& Xapian database (index)
+     * @param const VocabularySketch& Vocabulary sketch of that index
      * @param const TravelQuery_T& The string for which the partitions are sought
      * @param const OTransliterator& Unicode transliterator
      */
-    QuerySlices (const Xapian::Database&, const TravelQuery_T&,
-                 const OTransliterator&);
+    QuerySlices (const Xapian::Database&, const VocabularySketch&,
+                 const TravelQuery_T&, const OTransliterator&);
 
     /**
      * Default destructor.
@@ -152,15 +154,20 @@ namespace OPENTREP {
      */
     const Xapian::Database& _database;
 
+    /**
+     * Vocabulary sketch of the Xapian database.
+     */
+    const VocabularySketch& _vocabularySketch;
+
     /**
      * Query string having generated the set of documents.
      */
     TravelQuery_T _queryString;
 
     /**
-     * Partition, i.e., a list containing sub-lists of strings
+     * List of query slices (e.g., "san francisco", "nce", "rio de janeiro")
      */
-    StringPartitionList_T _slices;
+    StringSet _slices;
 
     /**
      * Staging string holding the left part of the query
@@ -13,10 +13,13 @@
 #include <opentrep/bom/Filter.hpp>
 #include <opentrep/bom/WordHolder.hpp>
 #include <opentrep/bom/StringPartition.hpp>
-#include <opentrep/bom/Levenshtein.hpp>
+#include <opentrep/bom/SpellingSuggestionCache.hpp>
 #include <opentrep/bom/Place.hpp>
 #include <opentrep/bom/Result.hpp>
+#include <opentrep/bom/VocabularySketch.hpp>
+#include <opentrep/bom/LocationCache.hpp>
 #include <opentrep/bom/PORParserHelper.hpp>
+#include <opentrep/bom/LocationSerialiser.hpp>
 #include <opentrep/service/Logger.hpp>
 
 namespace OPENTREP {
@@ -256,11 +259,25 @@ namespace OPENTREP {
   
   // //////////////////////////////////////////////////////////////////////
   Location Result::retrieveLocation (const RawDataString_T& iRawDataString) {
-    // Initialise the POR (point of reference) parser
-    PORStringParser lStringParser (iRawDataString);
+    // The data may be a binary-encoded Location structure, which is just
+    // decoded
+    if (LocationSerialiser::isSerialised (iRawDataString) == true) {
+      return LocationSerialiser::deserialise (iRawDataString);
+    }
+
+    // The data stored within the SQL database may be the text form of
+    // such a binary-encoded Location structure
+    if (LocationSerialiser::isTextEncoded (iRawDataString) == true) {
+      return LocationSerialiser::
+        deserialise (LocationSerialiser::decodeText (iRawDataString));
+    }
+
+    // Otherwise, it is a raw POR line. Retrieve the POR (point of reference)
+    // parser of the current thread, the grammar of which is built only once
+    PORLineParser& lLineParser = PORLineParser::getThreadParser();
 
     // Parse the raw data
-    const Location& oLocation = lStringParser.generateLocation();
+    const Location& oLocation = lLineParser.parse (iRawDataString);
 
     // DEBUG
     //OPENTREP_LOG_DEBUG ("Location: " << oLocation);
@@ -280,10 +297,84 @@ namespace OPENTREP {
     return oLocation;
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  LocationCache::LocationPtr_T
+  Result::getLocation (const Xapian::Document& iDocument) {
+    // Outside of any cache, the Xapian document is just parsed
+    LocationCache* lLocationCache_ptr = LocationCache::getCurrent();
+    if (lLocationCache_ptr == NULL) {
+      return std::make_shared<const Location> (retrieveLocation (iDocument));
+    }
+
+    // Parse the Xapian document only when it has not already been parsed
+    // within the current request
+    const Xapian::docid& lDocID = iDocument.get_docid();
+    LocationCache::LocationPtr_T oLocation_ptr =
+      lLocationCache_ptr->find (lDocID);
+    if (oLocation_ptr == NULL) {
+      oLocation_ptr =
+        std::make_shared<const Location> (retrieveLocation (iDocument));
+      lLocationCache_ptr->insert (lDocID, oLocation_ptr);
+    }
+    assert (oLocation_ptr != NULL);
+
+    return oLocation_ptr;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool Result::hasValueSlots (const Xapian::Document& iDocument) {
+    /**
+     * Since the version 2 of the format of the Xapian index, every document
+     * holds the ranking fields within value slots. The Geonames ID slot is
+     * never empty for those documents (even a null ID is serialised into
+     * a non-empty string), whereas it is always empty for the documents of
+     * the older indexes.
+     */
+    const std::string& lGeonamesIDStr =
+      iDocument.get_value (K_XAPIAN_SLOT_GEONAMES_ID);
+    return (lGeonamesIDStr.empty() == false);
+  }
+
   // //////////////////////////////////////////////////////////////////////
   LocationKey Result::getPrimaryKey (const Xapian::Document& iDocument) {
-    // Parse the POR (point of reference) details held by the Xapian document
-    const Location& lLocation = retrieveLocation (iDocument);
+    // Read the key from the value slots, when the index has them
+    if (hasValueSlots (iDocument) == true) {
+      const IATACode_T lIataCode (iDocument.get_value
+                                  (K_XAPIAN_SLOT_IATA_CODE));
+      const std::string& lIataTypeStr =
+        iDocument.get_value (K_XAPIAN_SLOT_LOCATION_TYPE);
+      const std::string& lGeonamesIDStr =
+        iDocument.get_value (K_XAPIAN_SLOT_GEONAMES_ID);
+      const double lGeonamesIDDouble =
+        Xapian::sortable_unserialise (lGeonamesIDStr);
+      const GeonamesID_T lGeonamesID =
+        static_cast<const GeonamesID_T> (lGeonamesIDDouble);
+
+      // The value slots are read from the (on-disk) Xapian index, which
+      // may be corrupted or may have been built by another tool. The
+      // location type must be a single known letter; otherwise, the key
+      // is rather parsed from the document data, as for the older indexes
+      if (lIataTypeStr.size() == 1) {
+        try {
+          const IATAType lIataType (lIataTypeStr[0]);
+          const LocationKey oLocationKey (lIataCode, lIataType, lGeonamesID);
+          return oLocationKey;
+
+        } catch (const CodeConversionException&) {
+          // The fall back is below
+        }
+      }
+
+      OPENTREP_LOG_ERROR ("The location type ('" << lIataTypeStr
+                          << "') held by the value slot of the Xapian "
+                          << "document (ID = " << iDocument.get_docid()
+                          << ") is not valid; the key is parsed from "
+                          << "the document data instead");
+    }
+
+    // Otherwise, retrieve the POR (point of reference) details held by
+    // the Xapian document
+    const Location& lLocation = *getLocation (iDocument);
 
     // Get the key (IATA and ICAO codes, GeonamesID)
     const LocationKey& oLocationKey = lLocation.getKey();
@@ -293,8 +384,17 @@ namespace OPENTREP {
   
   // //////////////////////////////////////////////////////////////////////
   Score_T Result::getEnvelopeID (const Xapian::Document& iDocument) {
-    // Parse the POR (point of reference) details held by the Xapian document
-    const Location& lLocation = retrieveLocation (iDocument);
+    // Read the envelope ID from its value slot, when the index has it
+    if (hasValueSlots (iDocument) == true) {
+      const std::string& lEnvelopeIDStr =
+        iDocument.get_value (K_XAPIAN_SLOT_ENVELOPE_ID);
+      const Score_T oEnvelopeID = Xapian::sortable_unserialise (lEnvelopeIDStr);
+      return oEnvelopeID;
+    }
+
+    // Otherwise, retrieve the POR (point of reference) details held by
+    // the Xapian document
+    const Location& lLocation = *getLocation (iDocument);
 
     // Get the envelope ID (it is an integer value in the Location structure)
     const EnvelopeID_T& lEnvelopeIDInt = lLocation.getEnvelopeID();
@@ -307,8 +407,17 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   PageRank_T Result::getPageRank (const Xapian::Document& iDocument) {
-    // Parse the POR (point of reference) details held by the Xapian document
-    const Location& lLocation = retrieveLocation (iDocument);
+    // Read the PageRank from its value slot, when the index has it
+    if (hasValueSlots (iDocument) == true) {
+      const std::string& lPageRankStr =
+        iDocument.get_value (K_XAPIAN_SLOT_PAGE_RANK);
+      const PageRank_T oPageRank = Xapian::sortable_unserialise (lPageRankStr);
+      return oPageRank;
+    }
+
+    // Otherwise, retrieve the POR (point of reference) details held by
+    // the Xapian document
+    const Location& lLocation = *getLocation (iDocument);
 
     // Get the PageRank value
     const PageRank_T& oPageRank = lLocation.getPageRank();
@@ -317,9 +426,11 @@ namespace OPENTREP {
   }
   
   // //////////////////////////////////////////////////////////////////////
-  std::string Result::fullTextMatch (const Xapian::Database& iDatabase,
-                                     const TravelQuery_T& iQueryString,
-                                     Xapian::MSet& ioMatchingSet) {
+  std::string Result::
+  fullTextMatch (const Xapian::Database& iDatabase,
+                 const VocabularySketch& iVocabularySketch,
+                 const TravelQuery_T& iQueryString,
+                 Xapian::MSet& ioMatchingSet) {
     std::string oMatchedString;
 
     // Catch any Xapian::Error exceptions thrown
@@ -365,8 +476,13 @@ namespace OPENTREP {
       enquire.set_query (lXapianQuery);
 
       // Get the top K_DEFAULT_XAPIAN_MATCHING_SET_SIZE (normally, 30)
-      // results of the query
-      ioMatchingSet = enquire.get_mset (0, K_DEFAULT_XAPIAN_MATCHING_SET_SIZE);
+      // results of the query. When the vocabulary sketch states that some
+      // of the words, or some of the pairs of contiguous words, are not
+      // indexed, the query cannot match, and the Xapian index is not searched
+      if (iVocabularySketch.mayMatch (lXapianQuery) == true) {
+        ioMatchingSet = enquire.get_mset (0,
+                                          K_DEFAULT_XAPIAN_MATCHING_SET_SIZE);
+      }
 
       // Display the results
       int nbMatches = ioMatchingSet.size();
@@ -410,9 +526,14 @@ namespace OPENTREP {
       const NbOfErrors_T& lAllowableEditDistance =
         calculateEditDistance (iQueryString);
       
-      // Let Xapian find a spelling correction (if any)
-      const std::string& lCorrectedString =
-        iDatabase.get_spelling_suggestion (iQueryString, lAllowableEditDistance);
+      // Let Xapian find a spelling correction (if any), along with its
+      // effective (Levenshtein) edit distance/error. Both are cached, as
+      // well as the absence of correction, for the whole process
+      NbOfErrors_T lEditDistance = 0;
+      const std::string& lCorrectedString = SpellingSuggestionCache::
+        instance().getSpellingSuggestion (iDatabase, iQueryString,
+                                          lAllowableEditDistance,
+                                          lEditDistance);
 
       // If the correction is no better than the original string, there is
       // no need to go further: there is no match.
@@ -433,10 +554,6 @@ namespace OPENTREP {
       assert (lCorrectedString.empty() == false
               && lCorrectedString != iQueryString);
 
-      // Calculate the effective (Levenshtein) edit distance/error
-      const NbOfErrors_T& lEditDistance =
-        Levenshtein::getDistance (iQueryString, lCorrectedString);
-
       /**
        * Since there is no match, we search on the corrected string.       
        *
@@ -518,8 +635,10 @@ namespace OPENTREP {
   }
 
   // //////////////////////////////////////////////////////////////////////
-  std::string Result::fullTextMatch (const Xapian::Database& iDatabase,
-                                     const TravelQuery_T& iQueryString) {
+  std::string Result::
+  fullTextMatch (const Xapian::Database& iDatabase,
+                 const VocabularySketch& iVocabularySketch,
+                 const TravelQuery_T& iQueryString) {
     std::string oMatchedString;
 
     // Catch any Xapian::Error exceptions thrown
@@ -535,7 +654,8 @@ namespace OPENTREP {
 
       Xapian::MSet lMatchingSet;
       if (isToBeAdded == true) {
-        oMatchedString = fullTextMatch (iDatabase, iQueryString, lMatchingSet);
+        oMatchedString = fullTextMatch (iDatabase, iVocabularySketch,
+                                        iQueryString, lMatchingSet);
       }
 
       // Create the corresponding documents (from the Xapian MSet object)
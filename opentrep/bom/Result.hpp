@@ -13,6 +13,7 @@
 #include <opentrep/OPENTREP_Types.hpp>
 #include <opentrep/bom/BomAbstract.hpp>
 #include <opentrep/bom/ScoreBoard.hpp>
+#include <opentrep/bom/LocationCache.hpp>
 
 namespace OPENTREP {
 
@@ -21,6 +22,7 @@ namespace OPENTREP {
   struct LocationKey;
   struct Location;
   class Place;
+  class VocabularySketch;
 
 
   // //////////////////// Type definitions /////////////////////
@@ -48,6 +50,7 @@ namespace OPENTREP {
   class Result : public BomAbstract {
     friend class FacResultHolder;
     friend class FacResult;
+    friend class BomArena;
   public:
     // ////////////////////// Getters /////////////////////
     /**
@@ -251,9 +254,11 @@ namespace OPENTREP {
      * lower percentage.
      *
      * @param const Xapian::Database& The Xapian index/database.
+     * @param const VocabularySketch& The vocabulary sketch of that index.
      * @param const TravelQuery_T& The query string.
      */
-    std::string fullTextMatch (const Xapian::Database&, const TravelQuery_T&);
+    std::string fullTextMatch (const Xapian::Database&,
+                               const VocabularySketch&, const TravelQuery_T&);
 
     /**
      * Parse the raw data, as stored by the given Xapian document, and
@@ -269,6 +274,11 @@ namespace OPENTREP {
      * Parse the raw data, as stored by a typical Xapian document, and
      * holding all the details of a POR (point of reference).
      *
+     * The data is either a raw POR line or, when the index has been built
+     * with the binary document format, a binary-encoded Location structure
+     * (see LocationSerialiser), or its text form, as stored within the
+     * SQL database; the format is detected from the data itself.
+     *
      * @param const RawDataString_T& The Xapian document data.
      * @return Location The Location structure holding all the details
      *                  of the place/POR (point of reference).
@@ -276,10 +286,35 @@ namespace OPENTREP {
     static Location retrieveLocation (const RawDataString_T&);
 
     /**
-     * Extract the primary key from the data of the given Xapian document.
+     * Get the Location structure held by the given Xapian document.
+     *
+     * Within a request (see LocationCache), the Xapian document is parsed,
+     * with retrieveLocation(), only at the first call; the same (immutable)
+     * Location structure is then returned by all the subsequent calls.
+     *
+     * @param const Xapian::Document& The Xapian document.
+     * @return LocationCache::LocationPtr_T The Location structure holding
+     *         all the details of the place/POR (point of reference).
+     */
+    static LocationCache::LocationPtr_T getLocation (const Xapian::Document&);
+
+    /**
+     * State whether the given Xapian document holds the ranking fields
+     * within its value slots (see K_XAPIAN_SLOT_GEONAMES_ID). That is
+     * the case for the Xapian indexes built since the version 2 of their
+     * format (see K_XAPIAN_INDEX_FORMAT_VERSION).
+     *
+     * @param const Xapian::Document& The Xapian document.
+     * @return bool Whether the value slots are filled.
+     */
+    static bool hasValueSlots (const Xapian::Document&);
+
+    /**
+     * Extract the primary key from the given Xapian document.
      *
      * The primary key is made of the IATA and ICAO codes, as well as of
-     * the Geonames ID. The retrieveLocation() is used to parse the Xapian
+     * the Geonames ID. It is read from the value slots of the document,
+     * if any; otherwise, the getLocation() is used to parse the Xapian
      * document raw data.
      *
      * @param Xapian::Document& The Xapian document.
@@ -289,9 +324,10 @@ namespace OPENTREP {
     static LocationKey getPrimaryKey (const Xapian::Document&);
 
     /**
-     * Extract the Envelope ID from the data of the given Xapian document.
+     * Extract the Envelope ID from the given Xapian document.
      *
-     * The retrieveLocation() is used to parse the Xapian document raw data.
+     * It is read from the value slot of the document, if any; otherwise,
+     * the getLocation() is used to parse the Xapian document raw data.
      *
      * @param Xapian::Document& The Xapian document.
      * @return Score_T& The Envelope ID of the place/POR (point of reference),
@@ -300,9 +336,10 @@ namespace OPENTREP {
     static Score_T getEnvelopeID (const Xapian::Document&);
 
     /**
-     * Extract the PageRank from the data of the given Xapian document.
+     * Extract the PageRank from the given Xapian document.
      *
-     * The retrieveLocation() is used to parse the Xapian document raw data.
+     * It is read from the value slot of the document, if any; otherwise,
+     * the getLocation() is used to parse the Xapian document raw data.
      *
      * @param Xapian::Document& The Xapian document.
      * @return PageRank_T& The PageRank of the place/POR (point of reference).
@@ -368,11 +405,17 @@ namespace OPENTREP {
      * matches, some with the highest matching percentage and some with a
      * lower percentage.
      *
+     * When the vocabulary sketch states that the query string cannot match
+     * as is (e.g., because of an unknown word), the Xapian index is not
+     * searched for it; only the spelling suggestion, if any, is searched.
+     *
      * @param const Xapian::Database& The Xapian index/database.
+     * @param const VocabularySketch& The vocabulary sketch of that index.
      * @param TravelQuery_T& The query string.
      * @param Xapian::MSet& The resulting matching set of Xapian documents
      */
-    std::string fullTextMatch (const Xapian::Database&, const TravelQuery_T&,
+    std::string fullTextMatch (const Xapian::Database&,
+                               const VocabularySketch&, const TravelQuery_T&,
                                Xapian::MSet&);
 
 
@@ -441,7 +484,9 @@ namespace OPENTREP {
   private:
     // /////////////// Attributes ////////////////
     /**
-     * Parent ResultHolder.
+     * Parent ResultHolder. A Result object may be shared by several
+     * ResultHolder objects (string partitions having the same word
+     * combination); the parent is then the first of those.
      */
     ResultHolder* _resultHolder;
 
@@ -24,6 +24,7 @@ namespace OPENTREP {
    */
   class ResultCombination : public BomAbstract {
     friend class FacResultCombination;
+    friend class BomArena;
   public:
     // ////////////// Getters /////////////
     /**
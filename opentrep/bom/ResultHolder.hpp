@@ -26,6 +26,7 @@ namespace OPENTREP {
   class ResultHolder : public BomAbstract {
     friend class FacResultCombination;
     friend class FacResultHolder;
+    friend class BomArena;
   public:
     // ////////////////////// Getters /////////////////////
     /**
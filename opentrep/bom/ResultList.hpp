@@ -6,6 +6,8 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <list>
+#include <map>
+#include <string>
 
 namespace OPENTREP {
 
@@ -17,5 +19,10 @@ namespace OPENTREP {
    */
   typedef std::list<Result*> ResultList_T;
 
+  /**
+   * (STL) map of Result objects, indexed by their query string.
+   */
+  typedef std::map<std::string, Result*> ResultMap_T;
+
 }
 #endif // __OPENTREP_BOM_RESULTLIST_HPP
@@ -0,0 +1,99 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+// Xapian
+#include <xapian.h>
+// OpenTrep
+#include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
+#include <opentrep/bom/Levenshtein.hpp>
+#include <opentrep/bom/SpellingSuggestionCache.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  SpellingSuggestionCache::
+  SpellingSuggestionCache (const NbOfDBEntries_T& iCapacity)
+    : _cache (DEFAULT_OPENTREP_SPELLING_SUGGESTION_CACHE_NB_OF_STRIPES,
+              iCapacity, 0) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SpellingSuggestionCache::~SpellingSuggestionCache() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SpellingSuggestionCache& SpellingSuggestionCache::instance() {
+    static SpellingSuggestionCache
+      lSpellingSuggestionCache (DEFAULT_OPENTREP_SPELLING_SUGGESTION_CACHE_SIZE);
+    return lSpellingSuggestionCache;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string SpellingSuggestionCache::
+  getSpellingSuggestion (const Xapian::Database& iDatabase,
+                         const std::string& iString,
+                         const NbOfErrors_T& iAllowableEditDistance,
+                         NbOfErrors_T& oEditDistance) {
+    std::string oCorrectedString;
+    oEditDistance = 0;
+
+    // The same string may be misspelled in several Xapian indexes (e.g.,
+    // of several deployments). Neither the UUID nor the edit distance
+    // contain any space
+    std::ostringstream oStr;
+    oStr << iDatabase.get_uuid() << " " << iAllowableEditDistance << " "
+         << iString;
+    const std::string lKey (oStr.str());
+
+    Suggestion_T lSuggestion;
+    if (_cache.find (lKey, lSuggestion) == true) {
+      oEditDistance = lSuggestion._editDistance;
+      return lSuggestion._correctedString;
+    }
+
+    // Let Xapian find a spelling correction (if any). The lock is not held
+    // in the meantime, so that the other queries are not delayed
+    oCorrectedString =
+      iDatabase.get_spelling_suggestion (iString, iAllowableEditDistance);
+
+    // A correction no better than the original string is no suggestion
+    if (oCorrectedString == iString) {
+      oCorrectedString.clear();
+    }
+
+    // Calculate the effective (Levenshtein) edit distance/error
+    if (oCorrectedString.empty() == false) {
+      oEditDistance =
+        Levenshtein::getBoundedDistance (iString, oCorrectedString, -1, false);
+    }
+
+    lSuggestion._correctedString = oCorrectedString;
+    lSuggestion._editDistance = oEditDistance;
+    _cache.insert (lKey, lSuggestion);
+    return oCorrectedString;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SpellingSuggestionCache::clear() {
+    _cache.clear();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SpellingSuggestionCache::reset (const NbOfDBEntries_T& iCapacity) {
+    // The suggestions never expire
+    _cache.reset (iCapacity, 0);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string SpellingSuggestionCache::describe() const {
+    std::ostringstream oStr;
+    oStr << getSize() << " spelling suggestions (out of " << getCapacity()
+         << ") in the cache, " << getNbOfHits() << " hits, "
+         << getNbOfMisses() << " misses, " << getNbOfEvictions()
+         << " evictions";
+    return oStr.str();
+  }
+
+}
@@ -0,0 +1,179 @@
+#ifndef __OPENTREP_BOM_SPELLINGSUGGESTIONCACHE_HPP
+#define __OPENTREP_BOM_SPELLINGSUGGESTIONCACHE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/basic/StripedLRUCache.hpp>
+
+// Forward declarations
+namespace Xapian {
+  class Database;
+}
+
+namespace OPENTREP {
+
+  /**
+   * @brief Process-wide, bounded cache of the spelling suggestions given
+   *        by Xapian (see Xapian::Database::get_spelling_suggestion()).
+   *
+   * Looking for a spelling suggestion is the most expensive Xapian call of
+   * a query, and it is made again for the same misspelled words (e.g.,
+   * "francicso", "janero", "reykyavki") within every partition of every
+   * query. The suggestions are therefore kept, keyed by the Xapian index
+   * (its UUID), the misspelled string and the allowable edit distance,
+   * along with the effective (Levenshtein) edit distance of the suggestion.
+   * The absence of suggestion is kept as well (negative entry).
+   *
+   * The suggestions are held by a striped LRU cache (see StripedLRUCache):
+   * the least recently used suggestions are evicted when the cache is full.
+   * It is emptied whenever the Xapian index is re-opened, be it explicitly
+   * (see OPENTREP_ServiceContext::resetXapianDatabase()) or after the index
+   * has been altered (see
+   * OPENTREP_ServiceContext::getXapianDatabaseHandler()).
+   */
+  class SpellingSuggestionCache {
+  public:
+    // //////////////// Getters ///////////////
+    /**
+     * Get the nominal maximum number of spelling suggestions held by the
+     * cache. As that capacity is rounded up for every stripe, the cache
+     * may actually hold up to one more suggestion per stripe (see
+     * StripedLRUCache).
+     */
+    NbOfDBEntries_T getCapacity() const {
+      return _cache.getCapacity();
+    }
+
+    /**
+     * Get the number of spelling suggestions held by the cache.
+     */
+    NbOfDBEntries_T getSize() const {
+      return _cache.getSize();
+    }
+
+    /**
+     * Get the number of look-ups found in the cache.
+     */
+    NbOfLookups_T getNbOfHits() const {
+      return _cache.getNbOfHits();
+    }
+
+    /**
+     * Get the number of look-ups not found in the cache (i.e., the number
+     * of calls to Xapian).
+     */
+    NbOfLookups_T getNbOfMisses() const {
+      return _cache.getNbOfMisses();
+    }
+
+    /**
+     * Get the number of spelling suggestions evicted from the cache.
+     */
+    NbOfLookups_T getNbOfEvictions() const {
+      return _cache.getNbOfEvictions();
+    }
+
+  public:
+    // //////////////// Business methods ///////////////
+    /**
+     * Get the cache shared by the whole process.
+     */
+    static SpellingSuggestionCache& instance();
+
+    /**
+     * Get the spelling suggestion of the given string, either from the
+     * cache or from the given Xapian index.
+     *
+     * @param const Xapian::Database& Xapian index.
+     * @param const std::string& The (possibly misspelled) string.
+     * @param const NbOfErrors_T& Allowable edit distance.
+     * @param NbOfErrors_T& Effective (Levenshtein) edit distance between
+     *        the string and its spelling suggestion (0 when there is no
+     *        suggestion).
+     * @return std::string The spelling suggestion, empty when there is
+     *         none (or when it is the same as the given string).
+     */
+    std::string getSpellingSuggestion (const Xapian::Database&,
+                                       const std::string&,
+                                       const NbOfErrors_T&, NbOfErrors_T&);
+
+    /**
+     * Remove all the spelling suggestions from the cache. The statistics
+     * are kept.
+     */
+    void clear();
+
+    /**
+     * Change the maximum number of spelling suggestions held by the cache.
+     * All the suggestions are removed.
+     *
+     * The cache may then hold up to that capacity plus one suggestion per
+     * stripe (the capacity of every stripe being rounded up), i.e., less
+     * than the capacity plus
+     * DEFAULT_OPENTREP_SPELLING_SUGGESTION_CACHE_NB_OF_STRIPES.
+     *
+     * @param const NbOfDBEntries_T& Maximum number of spelling suggestions
+     *        (0 meaning no caching at all).
+     */
+    void reset (const NbOfDBEntries_T&);
+
+  public:
+    // //////////////// Display methods ///////////////
+    /**
+     * Give the statistics of the cache (size, hits, misses, evictions).
+     */
+    std::string describe() const;
+
+  public:
+    // //////////////// Construction and destruction ///////////////
+    /**
+     * Main constructor.
+     *
+     * @param const NbOfDBEntries_T& Maximum number of spelling suggestions
+     *        held by the cache (0 meaning no caching at all).
+     */
+    SpellingSuggestionCache (const NbOfDBEntries_T&);
+
+    /**
+     * Destructor.
+     */
+    ~SpellingSuggestionCache();
+
+  private:
+    /**
+     * Default constructor. It should not be used.
+     */
+    SpellingSuggestionCache();
+
+    /**
+     * Copy constructor. It should not be used.
+     */
+    SpellingSuggestionCache (const SpellingSuggestionCache&);
+
+  private:
+    // //////////////// Type definitions ///////////////
+    /**
+     * Spelling suggestion (empty when there is none), along with its
+     * effective edit distance.
+     */
+    struct Suggestion_T {
+      std::string _correctedString;
+      NbOfErrors_T _editDistance;
+    };
+
+  private:
+    // /////////////////////// Attributes //////////////////////
+    /**
+     * Spelling suggestions, keyed by the Xapian index, the allowable edit
+     * distance and the misspelled string.
+     */
+    StripedLRUCache<Suggestion_T> _cache;
+  };
+
+}
+#endif // __OPENTREP_BOM_SPELLINGSUGGESTIONCACHE_HPP
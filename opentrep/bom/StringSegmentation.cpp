@@ -0,0 +1,214 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// OpenTrep
+#include <opentrep/basic/BasConst_General.hpp>
+#include <opentrep/basic/Utilities.hpp>
+#include <opentrep/bom/StringSegmentation.hpp>
+#include <opentrep/service/Logger.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  StringSegmentation::StringSegmentation (const std::string& iString)
+    : _initialString (iString), _bestWeight (0.0) {
+    init (iString);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  StringSegmentation::~StringSegmentation() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string StringSegmentation::describeKey() const {
+    std::ostringstream oStr;
+    oStr << "";
+    return oStr.str();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string StringSegmentation::describe() const {
+    std::ostringstream oStr;
+    oStr << describeKey();
+
+    //
+    oStr << "'" << _initialString << "' (" << _wordList.size() << " words)";
+
+    //
+    if (_bestSegmentation.empty() == false) {
+      oStr << " => " << _bestSegmentation << " at " << _bestWeight << "%";
+    }
+
+    return oStr.str();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void StringSegmentation::toStream (std::ostream& ioOut) const {
+    ioOut << describe();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void StringSegmentation::fromStream (std::istream& ioIn) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void StringSegmentation::init (const std::string& iPhrase) {
+    // Token-ise the given string
+    WordList_T lWordList;
+    tokeniseStringIntoWordList (iPhrase, lWordList);
+
+    // Cap the number of words (see basic/BasConst.cpp for the value of
+    // K_DEFAULT_MAXIMUM_NUMBER_OF_WORDS_IN_QUERY_SLICE)
+    const NbOfWords_T nbOfWords = lWordList.size();
+    if (nbOfWords > K_DEFAULT_MAXIMUM_NUMBER_OF_WORDS_IN_QUERY_SLICE) {
+      _initialString =
+        createStringFromWordList (lWordList,
+                                  K_DEFAULT_MAXIMUM_NUMBER_OF_WORDS_IN_QUERY_SLICE);
+
+      // DEBUG
+      OPENTREP_LOG_DEBUG ("The initial string ('" << iPhrase << "') has got "
+                          << nbOfWords << " words, and will be strip down to "
+                          << K_DEFAULT_MAXIMUM_NUMBER_OF_WORDS_IN_QUERY_SLICE
+                          << " words, giving: '" << _initialString << "'");
+    }
+
+    // Store the words into a vector, for a direct access by index
+    for (WordList_T::const_iterator itWord = lWordList.begin();
+         itWord != lWordList.end()
+           && _wordList.size() < K_DEFAULT_MAXIMUM_NUMBER_OF_WORDS_IN_QUERY_SLICE;
+         ++itWord) {
+      const std::string& lWord = *itWord;
+      _wordList.push_back (lWord);
+    }
+
+    // The weights of all the word combinations are null by default
+    const size_t lNbOfWords = _wordList.size();
+    _weightList.resize (lNbOfWords * lNbOfWords, 0.0);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  size_t StringSegmentation::getWeightIndex (const NbOfWords_T iBeginIdx,
+                                             const NbOfWords_T iEndIdx) const {
+    const size_t lNbOfWords = _wordList.size();
+    assert (iBeginIdx < iEndIdx && iEndIdx <= lNbOfWords);
+    return iBeginIdx * lNbOfWords + iEndIdx - 1;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string StringSegmentation::
+  getWordCombination (const NbOfWords_T iBeginIdx,
+                      const NbOfWords_T iEndIdx) const {
+    std::ostringstream oStr;
+    assert (iBeginIdx < iEndIdx && iEndIdx <= _wordList.size());
+
+    for (NbOfWords_T idx = iBeginIdx; idx != iEndIdx; ++idx) {
+      if (idx != iBeginIdx) {
+        oStr << " ";
+      }
+      oStr << _wordList[idx];
+    }
+
+    return oStr.str();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  const Percentage_T& StringSegmentation::
+  getWeight (const NbOfWords_T iBeginIdx, const NbOfWords_T iEndIdx) const {
+    return _weightList[getWeightIndex (iBeginIdx, iEndIdx)];
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void StringSegmentation::setWeight (const NbOfWords_T iBeginIdx,
+                                      const NbOfWords_T iEndIdx,
+                                      const Percentage_T& iWeight) {
+    _weightList[getWeightIndex (iBeginIdx, iEndIdx)] = iWeight;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  const StringSet& StringSegmentation::calculateBestSegmentation() {
+    _bestSegmentation.clear();
+    _bestWeight = 0.0;
+
+    const NbOfWords_T nbOfWords = _wordList.size();
+    if (nbOfWords == 0) {
+      return _bestSegmentation;
+    }
+
+    /**
+     * 1. For every suffix [idx, nbOfWords[ of the string, calculate the best
+     *    product of the (attenuated) weights of the word combinations,
+     *    as well as the end of the first word combination of the
+     *    corresponding segmentation.
+     *
+     *    The suffix starting at 0 is the whole string, for which only the
+     *    segmentations made of (strictly) more than one word combination
+     *    are considered here. The segmentation made of the whole string
+     *    is not attenuated, and is therefore taken into account separately.
+     *
+     *    The strict comparison, along with the browsing by increasing
+     *    end index, ensures that, among the segmentations having the same
+     *    weight, the first one in the StringPartition order is kept.
+     */
+    const Percentage_T lFactorDenominator = 100.0 * K_DEFAULT_ATTENUATION_FCTR;
+    WeightVector_T lBestSuffixWeightList (nbOfWords + 1, 0.0);
+    WordIndexVector_T lBestSuffixCutList (nbOfWords + 1, nbOfWords);
+    lBestSuffixWeightList[nbOfWords] = 1.0;
+
+    for (NbOfWords_T idx = nbOfWords; idx != 0; --idx) {
+      const NbOfWords_T lBeginIdx = idx - 1;
+      Percentage_T& lBestSuffixWeight = lBestSuffixWeightList[lBeginIdx];
+
+      for (NbOfWords_T lEndIdx = lBeginIdx + 1; lEndIdx <= nbOfWords;
+           ++lEndIdx) {
+        // The whole string is taken into account separately
+        if (lBeginIdx == 0 && lEndIdx == nbOfWords) {
+          continue;
+        }
+
+        const Percentage_T lWeight =
+          getWeight (lBeginIdx, lEndIdx) / lFactorDenominator
+          * lBestSuffixWeightList[lEndIdx];
+        if (lWeight > lBestSuffixWeight) {
+          lBestSuffixWeight = lWeight;
+          lBestSuffixCutList[lBeginIdx] = lEndIdx;
+        }
+      }
+    }
+
+    /**
+     * 2. Compare the best segmentation made of several word combinations
+     *    with the whole string. As the former comes first in the
+     *    StringPartition order, it is kept when both weights are the same.
+     */
+    const Percentage_T lWholeStringWeight = getWeight (0, nbOfWords);
+    const Percentage_T lBestSplitWeight = 100.0 * lBestSuffixWeightList[0];
+    if (nbOfWords >= 2 && lBestSplitWeight > 0.0
+        && lBestSplitWeight >= lWholeStringWeight) {
+      // Walk through the cuts, so as to re-build the best segmentation
+      for (NbOfWords_T lBeginIdx = 0; lBeginIdx != nbOfWords; ) {
+        const NbOfWords_T lEndIdx = lBestSuffixCutList[lBeginIdx];
+        assert (lEndIdx > lBeginIdx);
+        _bestSegmentation.push_back (getWordCombination (lBeginIdx, lEndIdx));
+        lBeginIdx = lEndIdx;
+      }
+      _bestWeight = lBestSplitWeight;
+
+    } else {
+      // The whole string is the best segmentation (even when its weight is
+      // null, i.e., when no segmentation matches at all)
+      _bestSegmentation.push_back (getWordCombination (0, nbOfWords));
+      _bestWeight = lWholeStringWeight;
+    }
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("    [seg] The best segmentation of '" << _initialString
+                        << "' is " << _bestSegmentation << ", with a weight of "
+                        << _bestWeight << "%");
+
+    return _bestSegmentation;
+  }
+
+}
@@ -0,0 +1,230 @@
+#ifndef __OPENTREP_BOM_STRINGSEGMENTATION_HPP
+#define __OPENTREP_BOM_STRINGSEGMENTATION_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/basic/StructAbstract.hpp>
+#include <opentrep/bom/StringSet.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Class finding the best segmentation of a string.
+   *
+   * A segmentation of a string is one of the ways to combine, serially,
+   * all the words of that string. For instance, {"rio", "de janeiro"}
+   * is a segmentation of "rio de janeiro" (see also StringPartition,
+   * which enumerates all of them).
+   *
+   * Every word combination (span of contiguous words, e.g., "de janeiro")
+   * is given a weight, i.e., the best combined weight of the corresponding
+   * full-text match (see Result::getBestCombinedWeight()). The weight of a
+   * segmentation is then calculated the same way as it is by
+   * ResultHolder::calculateCombinedWeights():
+   * <ul>
+   *   <li>for a single word combination, it is the weight of that latter;</li>
+   *   <li>for k>1 word combinations, it is the product of the weights
+   *       (as percentages), divided by K_DEFAULT_ATTENUATION_FCTR^k.</li>
+   * </ul>
+   *
+   * As that weight is a product of per-word-combination factors, the best
+   * segmentation is found by dynamic programming (Viterbi-like) over the
+   * O(n^2) word combinations, rather than by enumerating the 2^(n-1)
+   * partitions of the string. When several segmentations have the same
+   * weight, the one coming first in the StringPartition order is chosen
+   * (i.e., the one having the shortest first word combination, and so on),
+   * so that the outcome is the same as the one of the exhaustive
+   * enumeration.
+   */
+  struct StringSegmentation : public StructAbstract {
+  public:
+    // //////////////// Type definitions //////////////////
+    /**
+     * Vector of words, allowing a direct access by index.
+     */
+    typedef std::vector<std::string> WordVector_T;
+
+    /**
+     * Vector of weights, indexed by word combination (span).
+     */
+    typedef std::vector<Percentage_T> WeightVector_T;
+
+    /**
+     * Vector of word indices.
+     */
+    typedef std::vector<NbOfWords_T> WordIndexVector_T;
+
+  public:
+    // ///////////////// Getters ///////////////////
+    /**
+     * Get the initial string, that is, the string having been given
+     * to be segmented.
+     */
+    const std::string& getInitialString() const {
+      return _initialString;
+    }
+
+    /**
+     * Get the number of words of the string to be segmented.
+     */
+    NbOfWords_T getNbOfWords() const {
+      return _wordList.size();
+    }
+
+    /**
+     * Get the word combination made of the words between the two given
+     * indices, that is, in [iBeginIdx, iEndIdx[.
+     *
+     * For instance, with "rio de janeiro", (1, 3) gives "de janeiro".
+     */
+    std::string getWordCombination (const NbOfWords_T iBeginIdx,
+                                    const NbOfWords_T iEndIdx) const;
+
+    /**
+     * Get the weight of the word combination made of the words between
+     * the two given indices, that is, in [iBeginIdx, iEndIdx[.
+     */
+    const Percentage_T& getWeight (const NbOfWords_T iBeginIdx,
+                                   const NbOfWords_T iEndIdx) const;
+
+    /**
+     * Get the weight of the best segmentation, as calculated by
+     * calculateBestSegmentation().
+     */
+    const Percentage_T& getBestWeight() const {
+      return _bestWeight;
+    }
+
+    /**
+     * Get the best segmentation, as calculated by
+     * calculateBestSegmentation().
+     */
+    const StringSet& getBestSegmentation() const {
+      return _bestSegmentation;
+    }
+
+  public:
+    // ///////////////// Setters ///////////////////
+    /**
+     * Set the weight (as a percentage) of the word combination made of
+     * the words between the two given indices, that is, in
+     * [iBeginIdx, iEndIdx[.
+     */
+    void setWeight (const NbOfWords_T iBeginIdx, const NbOfWords_T iEndIdx,
+                    const Percentage_T& iWeight);
+
+  public:
+    // /////////// Business methods ///////////
+    /**
+     * Find the best segmentation, given the weights of all the word
+     * combinations (which must therefore have been set beforehand).
+     *
+     * When no segmentation has a strictly positive weight, the best
+     * segmentation is made of the whole string, with a null weight.
+     *
+     * @return const StringSet& The best segmentation.
+     */
+    const StringSet& calculateBestSegmentation();
+
+  private:
+    /**
+     * Initialise the list of words and the (null) weights.
+     *
+     * That method is called by the main constructor. It should not be called
+     * directly.
+     *
+     * @param const std::string& The string to be segmented.
+     */
+    void init (const std::string& iStringToBeSegmented);
+
+    /**
+     * Get the index of the weight of the given word combination
+     * within the vector of weights.
+     */
+    size_t getWeightIndex (const NbOfWords_T iBeginIdx,
+                           const NbOfWords_T iEndIdx) const;
+
+
+  public:
+    // /////////// Display support methods /////////
+    /**
+     * Dump the structure into an output stream.
+     *
+     * @param ostream& the output stream.
+     */
+    void toStream (std::ostream& ioOut) const;
+
+    /**
+     * Read a structure from an input stream.
+     *
+     * @param istream& the input stream.
+     */
+    void fromStream (std::istream& ioIn);
+
+    /**
+     * Get a string describing the whole key (differentiating two objects
+     * at any level).
+     */
+    std::string describeKey() const;
+
+    /**
+     * Get the serialised version of the structure.
+     */
+    std::string describe() const;
+
+
+  public:
+    // //////////////// Constructors and Destructors /////////////
+    /**
+     * Constructor.
+     *
+     * The string is capped to K_DEFAULT_MAXIMUM_NUMBER_OF_WORDS_IN_QUERY_SLICE
+     * words.
+     *
+     * @param const std::string& The string for which the segmentation
+     *        is sought
+     */
+    StringSegmentation (const std::string& iStringToBeSegmented);
+
+    /**
+     * Default destructor.
+     */
+    ~StringSegmentation();
+
+
+  public:
+    // //////////////// Attributes ///////////////
+    /**
+     * String to be segmented.
+     */
+    std::string _initialString;
+
+    /**
+     * Words of the string to be segmented.
+     */
+    WordVector_T _wordList;
+
+    /**
+     * Weights of all the word combinations.
+     */
+    WeightVector_T _weightList;
+
+    /**
+     * Best segmentation.
+     */
+    StringSet _bestSegmentation;
+
+    /**
+     * Weight of the best segmentation.
+     */
+    Percentage_T _bestWeight;
+  };
+
+}
+#endif // __OPENTREP_BOM_STRINGSEGMENTATION_HPP
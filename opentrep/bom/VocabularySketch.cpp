@@ -0,0 +1,322 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+// Boost
+#include <boost/filesystem.hpp>
+// OpenTrep
+#include <opentrep/OPENTREP_exceptions.hpp>
+#include <opentrep/basic/BasConst_General.hpp>
+#include <opentrep/basic/Utilities.hpp>
+#include <opentrep/bom/VocabularySketch.hpp>
+#include <opentrep/service/Logger.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * Tag of the first line of the vocabulary sketch files.
+   */
+  static const std::string
+  K_VOCABULARY_SKETCH_FILE_TAG ("opentrep_vocabulary_sketch");
+
+  // //////////////////////////////////////////////////////////////////////
+  VocabularySketch::VocabularySketch() : _isEnabled (false) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  VocabularySketch::~VocabularySketch() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string VocabularySketch::
+  getFilePath (const TravelDBFilePath_T& iTravelDBFilePath) {
+    const boost::filesystem::path lFilePath =
+      boost::filesystem::path (iTravelDBFilePath)
+      / K_XAPIAN_VOCABULARY_SKETCH_FILENAME;
+    return lFilePath.string();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  BloomFilter::HashValue_T VocabularySketch::
+  hashBigram (const std::string& iTerm1, const std::string& iTerm2) {
+    // As the terms have no space, the space separates them unambiguously
+    std::string lBigram;
+    lBigram.reserve (iTerm1.size() + 1 + iTerm2.size());
+    lBigram += iTerm1; lBigram += ' '; lBigram += iTerm2;
+    return BloomFilter::hash (lBigram);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void VocabularySketch::deriveTerms (const std::string& iPhrase,
+                                      TermList_T& ioTermList) {
+    WordList_T lWordList;
+    tokeniseStringIntoWordList (iPhrase, lWordList);
+    for (WordList_T::const_iterator itWord = lWordList.begin();
+         itWord != lWordList.end(); ++itWord) {
+      const std::string& lWord = *itWord;
+      ioTermList.push_back (Xapian::Unicode::tolower (lWord));
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool VocabularySketch::mayContainTerm (const std::string& iTerm) const {
+    if (_isEnabled == false) {
+      return true;
+    }
+    return _unigramFilter.mayContain (BloomFilter::hash (iTerm));
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool VocabularySketch::mayContainPhrase (const TermList_T& iTermList) const {
+    if (_isEnabled == false) {
+      return true;
+    }
+
+    // The unigrams are checked first, as an unknown word is the most
+    // frequent reason for a phrase not to match
+    for (TermList_T::const_iterator itTerm = iTermList.begin();
+         itTerm != iTermList.end(); ++itTerm) {
+      const std::string& lTerm = *itTerm;
+      if (_unigramFilter.mayContain (BloomFilter::hash (lTerm)) == false) {
+        return false;
+      }
+    }
+
+    // Then, every pair of successive terms
+    TermList_T::const_iterator itTerm = iTermList.begin();
+    TermList_T::const_iterator itNextTerm = iTermList.begin();
+    if (itNextTerm != iTermList.end()) {
+      ++itNextTerm;
+    }
+    for ( ; itNextTerm != iTermList.end(); ++itTerm, ++itNextTerm) {
+      const BloomFilter::HashValue_T& lBigramHash =
+        hashBigram (*itTerm, *itNextTerm);
+      if (_bigramFilter.mayContain (lBigramHash) == false) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool VocabularySketch::mayMatch (const Xapian::Query& iQuery) const {
+    if (_isEnabled == false) {
+      return true;
+    }
+
+    const Xapian::Query::op& lQueryType = iQuery.get_type();
+    if (lQueryType == Xapian::Query::LEAF_TERM) {
+      const Xapian::TermIterator itTerm = iQuery.get_terms_begin();
+      assert (itTerm != iQuery.get_terms_end());
+      return mayContainTerm (*itTerm);
+    }
+
+    // Any other query than a phrase (e.g., with boolean operators) may
+    // match, as far as the sketch knows
+    if (lQueryType != Xapian::Query::OP_PHRASE) {
+      return true;
+    }
+
+    // The phrase is checked only when it is made of plain terms
+    TermList_T lTermList;
+    const size_t lNbOfSubqueries = iQuery.get_num_subqueries();
+    for (size_t idx = 0; idx != lNbOfSubqueries; ++idx) {
+      const Xapian::Query& lSubquery = iQuery.get_subquery (idx);
+      if (lSubquery.get_type() != Xapian::Query::LEAF_TERM) {
+        return true;
+      }
+      lTermList.push_back (*lSubquery.get_terms_begin());
+    }
+
+    return mayContainPhrase (lTermList);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void VocabularySketch::addTerms (const TermList_T& iTermList) {
+    TermList_T::const_iterator itPreviousTerm = iTermList.end();
+    for (TermList_T::const_iterator itTerm = iTermList.begin();
+         itTerm != iTermList.end(); itPreviousTerm = itTerm, ++itTerm) {
+      const std::string& lTerm = *itTerm;
+      _unigramHashSet.insert (BloomFilter::hash (lTerm));
+
+      if (itPreviousTerm != iTermList.end()) {
+        _bigramHashSet.insert (hashBigram (*itPreviousTerm, lTerm));
+      }
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void VocabularySketch::finalise (const Percentage_T& iFalsePositiveRate) {
+    // Unigrams
+    _unigramFilter.reset (_unigramHashSet.size(), iFalsePositiveRate);
+    for (HashSet_T::const_iterator itHash = _unigramHashSet.begin();
+         itHash != _unigramHashSet.end(); ++itHash) {
+      _unigramFilter.insert (*itHash);
+    }
+    HashSet_T().swap (_unigramHashSet);
+
+    // Bigrams
+    _bigramFilter.reset (_bigramHashSet.size(), iFalsePositiveRate);
+    for (HashSet_T::const_iterator itHash = _bigramHashSet.begin();
+         itHash != _bigramHashSet.end(); ++itHash) {
+      _bigramFilter.insert (*itHash);
+    }
+    HashSet_T().swap (_bigramHashSet);
+
+    _isEnabled = true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void VocabularySketch::build (const Xapian::Database& iDatabase,
+                                const Percentage_T& iFalsePositiveRate) {
+    _xapianDatabaseUUID = iDatabase.get_uuid();
+
+    // Terms of a document, by position
+    typedef std::pair<Xapian::termpos, std::string> PositionedTerm_T;
+    std::vector<PositionedTerm_T> lPositionedTermList;
+
+    // Browse all the documents
+    for (Xapian::PostingIterator itDocID = iDatabase.postlist_begin ("");
+         itDocID != iDatabase.postlist_end (""); ++itDocID) {
+      const Xapian::docid& lDocID = *itDocID;
+      const Xapian::Document& lDocument = iDatabase.get_document (lDocID);
+
+      // Retrieve all the terms of the document, along with their positions
+      lPositionedTermList.clear();
+      for (Xapian::TermIterator itTerm = lDocument.termlist_begin();
+           itTerm != lDocument.termlist_end(); ++itTerm) {
+        const std::string& lTerm = *itTerm;
+        for (Xapian::PositionIterator itPosition =
+               itTerm.positionlist_begin();
+             itPosition != itTerm.positionlist_end(); ++itPosition) {
+          lPositionedTermList.push_back (PositionedTerm_T (*itPosition, lTerm));
+        }
+
+        // The terms having no position are indexed as well
+        _unigramHashSet.insert (BloomFilter::hash (lTerm));
+      }
+      std::sort (lPositionedTermList.begin(), lPositionedTermList.end());
+
+      // Add the sequences of terms at contiguous positions
+      TermList_T lTermList;
+      Xapian::termpos lPreviousPosition = 0;
+      for (std::vector<PositionedTerm_T>::const_iterator itPositionedTerm =
+             lPositionedTermList.begin();
+           itPositionedTerm != lPositionedTermList.end(); ++itPositionedTerm) {
+        const Xapian::termpos& lPosition = itPositionedTerm->first;
+        if (lTermList.empty() == false && lPosition != lPreviousPosition + 1) {
+          addTerms (lTermList);
+          lTermList.clear();
+        }
+        lTermList.push_back (itPositionedTerm->second);
+        lPreviousPosition = lPosition;
+      }
+      addTerms (lTermList);
+    }
+
+    finalise (iFalsePositiveRate);
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("Built the vocabulary sketch of the Xapian index ("
+                        << _xapianDatabaseUUID << "): " << describe());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void VocabularySketch::save (const std::string& iFilePath) const {
+    assert (_isEnabled == true);
+
+    std::ofstream lFile (iFilePath.c_str(),
+                         std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!lFile) {
+      std::ostringstream errorStr;
+      errorStr << "The vocabulary sketch file ('" << iFilePath
+               << "') cannot be created";
+      OPENTREP_LOG_ERROR (errorStr.str());
+      throw FileException (errorStr.str());
+    }
+
+    lFile << K_VOCABULARY_SKETCH_FILE_TAG << " "
+          << K_XAPIAN_VOCABULARY_SKETCH_FORMAT_VERSION << "\n"
+          << _xapianDatabaseUUID << "\n";
+    _unigramFilter.toStream (lFile);
+    _bigramFilter.toStream (lFile);
+    lFile.close();
+
+    if (!lFile) {
+      std::ostringstream errorStr;
+      errorStr << "The vocabulary sketch file ('" << iFilePath
+               << "') cannot be written";
+      OPENTREP_LOG_ERROR (errorStr.str());
+      throw FileException (errorStr.str());
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool VocabularySketch::load (const std::string& iFilePath,
+                               const Xapian::Database& iDatabase) {
+    _isEnabled = false;
+    _xapianDatabaseUUID = iDatabase.get_uuid();
+
+    std::ifstream lFile (iFilePath.c_str(), std::ios::in | std::ios::binary);
+    if (!lFile) {
+      OPENTREP_LOG_WARNING ("There is no vocabulary sketch ('" << iFilePath
+                            << "'); all the look-ups will be performed on the "
+                            << "Xapian index. Re-running opentrep-indexer "
+                            << "builds that sketch.");
+      return false;
+    }
+
+    // Check that the file has been built, by the same format version,
+    // for the same Xapian index
+    std::string lHeader;
+    std::string lXapianDatabaseUUID;
+    std::getline (lFile, lHeader);
+    std::getline (lFile, lXapianDatabaseUUID);
+    std::ostringstream lExpectedHeader;
+    lExpectedHeader << K_VOCABULARY_SKETCH_FILE_TAG << " "
+                    << K_XAPIAN_VOCABULARY_SKETCH_FORMAT_VERSION;
+    if (!lFile || lHeader != lExpectedHeader.str()
+        || lXapianDatabaseUUID != _xapianDatabaseUUID) {
+      OPENTREP_LOG_WARNING ("The vocabulary sketch ('" << iFilePath
+                            << "') has not been built for that version of "
+                            << "OpenTREP or for that Xapian index ("
+                            << _xapianDatabaseUUID << "); it is ignored.");
+      return false;
+    }
+
+    if (_unigramFilter.fromStream (lFile) == false
+        || _bigramFilter.fromStream (lFile) == false) {
+      OPENTREP_LOG_WARNING ("The vocabulary sketch ('" << iFilePath
+                            << "') is truncated; it is ignored.");
+      return false;
+    }
+
+    _isEnabled = true;
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("Loaded the vocabulary sketch of the Xapian index ("
+                        << _xapianDatabaseUUID << "): " << describe());
+
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string VocabularySketch::describe() const {
+    std::ostringstream oStr;
+    if (_isEnabled == false) {
+      oStr << "not enabled";
+      return oStr.str();
+    }
+    oStr << "unigrams: " << _unigramFilter.describe()
+         << "; bigrams: " << _bigramFilter.describe() << "; "
+         << (_unigramFilter.getSize() + _bigramFilter.getSize()) << " bytes";
+    return oStr.str();
+  }
+
+}
@@ -0,0 +1,225 @@
+#ifndef __OPENTREP_BOM_VOCABULARYSKETCH_HPP
+#define __OPENTREP_BOM_VOCABULARYSKETCH_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <list>
+#include <unordered_set>
+// Xapian
+#include <xapian.h>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/basic/BloomFilter.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Compact sketch of the vocabulary of a given Xapian index.
+   *
+   * The sketch is made of two Bloom filters:
+   * <ul>
+   *   <li>one for the indexed terms (unigrams), e.g., "san", "francisco";</li>
+   *   <li>one for the pairs of terms at contiguous positions within a Xapian
+   *       document (bigrams), e.g., "san francisco", i.e., the pairs which
+   *       a phrase query may match.</li>
+   * </ul>
+   * When the sketch states that a term, or a pair of contiguous terms, is
+   * not indexed, a phrase query made of them cannot match any document,
+   * and the Xapian index does not need to be searched. Otherwise, the
+   * answer is only a "maybe", to be confirmed by Xapian.
+   *
+   * The sketch is built by opentrep-indexer, once the Xapian index has
+   * been built, and stored within the directory of that latter (see
+   * K_XAPIAN_VOCABULARY_SKETCH_FILENAME), i.e., next to the Xapian index
+   * of the same deployment. It records the UUID of the Xapian index it has
+   * been built from, so that it is not used with another Xapian index.
+   *
+   * As long as the sketch is not enabled (e.g., when it could not be loaded),
+   * all the look-ups answer "maybe", so that everything is checked by Xapian.
+   * Once enabled, the sketch is immutable, and may therefore be shared by
+   * concurrent queries.
+   */
+  class VocabularySketch {
+  public:
+    // ////////////// Type definitions /////////////
+    /**
+     * List of (Xapian) terms.
+     */
+    typedef std::list<std::string> TermList_T;
+
+  public:
+    // ////////////// Getters /////////////
+    /**
+     * Whether the sketch may be used, i.e., whether it has been built or
+     * loaded for the Xapian index.
+     */
+    bool isEnabled() const {
+      return _isEnabled;
+    }
+
+    /**
+     * Get the UUID of the Xapian index the sketch has been built or loaded
+     * for. It is empty as long as the sketch has been neither built nor
+     * loaded.
+     */
+    const std::string& getXapianDatabaseUUID() const {
+      return _xapianDatabaseUUID;
+    }
+
+    /**
+     * Get the file-path of the sketch of the given Xapian index.
+     *
+     * @param const TravelDBFilePath_T& File-path of the Xapian index.
+     * @return std::string File-path of the sketch.
+     */
+    static std::string getFilePath (const TravelDBFilePath_T&);
+
+  public:
+    // ////////////// Look-up methods /////////////
+    /**
+     * Derive the Xapian terms of the given words, i.e., lower-case them,
+     * as the Xapian term generator does at indexing time.
+     *
+     * @param const std::string& String of words, separated by spaces.
+     * @param TermList_T& List of (Xapian) terms.
+     */
+    static void deriveTerms (const std::string&, TermList_T&);
+
+    /**
+     * Check whether the given term may be indexed.
+     *
+     * @param const std::string& (Xapian) term.
+     * @return bool False when the term is certainly not indexed.
+     */
+    bool mayContainTerm (const std::string&) const;
+
+    /**
+     * Check whether the given terms may appear, in that order and
+     * contiguously, within a Xapian document.
+     *
+     * @param const TermList_T& List of (Xapian) terms.
+     * @return bool False when no Xapian document may match the phrase.
+     */
+    bool mayContainPhrase (const TermList_T&) const;
+
+    /**
+     * Check whether the given Xapian query may match. Only the single-term
+     * and the phrase queries are checked; any other query may match.
+     *
+     * @param const Xapian::Query& Xapian query.
+     * @return bool False when no Xapian document may match the query.
+     */
+    bool mayMatch (const Xapian::Query&) const;
+
+  public:
+    // ////////////// Building methods /////////////
+    /**
+     * Add the terms of a sequence of terms at contiguous positions
+     * (e.g., "rio", "de", "janeiro"), i.e., those terms (unigrams) and
+     * every pair of successive terms (bigrams). The sketch is not enabled
+     * before finalise() is called.
+     *
+     * @param const TermList_T& Terms, in the order of their positions.
+     */
+    void addTerms (const TermList_T&);
+
+    /**
+     * Size the Bloom filters for the added terms, and fill them. The sketch
+     * is then enabled.
+     *
+     * @param const Percentage_T& Expected rate of false positives.
+     */
+    void finalise (const Percentage_T&);
+
+    /**
+     * Build the sketch from the positions of the terms of all the documents
+     * of the given Xapian index.
+     *
+     * @param const Xapian::Database& Xapian index.
+     * @param const Percentage_T& Expected rate of false positives.
+     */
+    void build (const Xapian::Database&, const Percentage_T&);
+
+    /**
+     * Store the sketch into the given file.
+     *
+     * @param const std::string& File-path of the sketch.
+     * @throw FileException When the file cannot be written.
+     */
+    void save (const std::string&) const;
+
+    /**
+     * Load the sketch of the given Xapian index from the given file.
+     * When the file does not exist, is of another format version, or has
+     * been built for another Xapian index (e.g., by an older version of
+     * opentrep-indexer), the sketch is not enabled.
+     *
+     * @param const std::string& File-path of the sketch.
+     * @param const Xapian::Database& Xapian index.
+     * @return bool Whether the sketch has been loaded (and is enabled).
+     */
+    bool load (const std::string&, const Xapian::Database&);
+
+  public:
+    // ////////////// Display methods /////////////
+    /**
+     * Give a short description of the sketch (items, bits and hashes of
+     * both Bloom filters).
+     */
+    std::string describe() const;
+
+  public:
+    /**
+     * Constructor. The sketch is empty, and not enabled.
+     */
+    VocabularySketch();
+
+    /**
+     * Destructor.
+     */
+    ~VocabularySketch();
+
+  private:
+    /**
+     * Hash of a pair of terms (bigram).
+     */
+    static BloomFilter::HashValue_T hashBigram (const std::string&,
+                                                const std::string&);
+
+  private:
+    // ////////////// Type definitions /////////////
+    /**
+     * Set of the hashes of the added items, used only until finalise()
+     * is called.
+     */
+    typedef std::unordered_set<BloomFilter::HashValue_T> HashSet_T;
+
+  private:
+    // ////////////// Attributes /////////////
+    /**
+     * Hashes of the added unigrams and bigrams.
+     */
+    HashSet_T _unigramHashSet;
+    HashSet_T _bigramHashSet;
+
+    /**
+     * Bloom filters of the unigrams and bigrams.
+     */
+    BloomFilter _unigramFilter;
+    BloomFilter _bigramFilter;
+
+    /**
+     * UUID of the Xapian index the sketch has been built or loaded for.
+     */
+    std::string _xapianDatabaseUUID;
+
+    /**
+     * Whether the sketch may be used.
+     */
+    bool _isEnabled;
+  };
+}
+#endif // __OPENTREP_BOM_VOCABULARYSKETCH_HPP
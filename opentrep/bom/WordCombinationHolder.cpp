@@ -5,18 +5,22 @@
 #include <cassert>
 #include <sstream>
 #include <set>
+#include <vector>
+#include <algorithm>
 // OpenTrep
+#include <opentrep/basic/BasConst_General.hpp>
 #include <opentrep/basic/Utilities.hpp>
-#include <opentrep/bom/Filter.hpp>
-#include <opentrep/bom/StringPartition.hpp>
+#include <opentrep/bom/StringSet.hpp>
 #include <opentrep/bom/WordCombinationHolder.hpp>
 #include <opentrep/service/Logger.hpp>
 
 namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
-  WordCombinationHolder::WordCombinationHolder (const std::string& iString) {
-    init (iString);
+  WordCombinationHolder::
+  WordCombinationHolder (const std::string& iString,
+                         const NbOfWords_T& iMaxSpan) {
+    init (iString, iMaxSpan);
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -84,89 +88,94 @@ namespace OPENTREP {
   }
 
   // //////////////////////////////////////////////////////////////////////
-  void WordCombinationHolder::init (const std::string& iPhrase) {
-    // Set of unique strings
+  void WordCombinationHolder::init (const std::string& iPhrase,
+                                    const NbOfWords_T& iMaxSpan) {
+    // Set of unique strings, so that no word combination is added twice
     typedef std::set<std::string> StringSet_T;
     StringSet_T lStringSet;
 
-    // 1. Derive all the partitions of the initial (full) string
-    const StringPartition lStringPartitionHolder (iPhrase);
-    const StringPartition::StringPartition_T& lStringPartition =
-      lStringPartitionHolder._partition;
+    // 0. Initialisation of the list of words, made of all the words of the
+    //    given string.
+    WordList_T lWordList;
+    tokeniseStringIntoWordList (iPhrase, lWordList);
+    const std::vector<std::string> lWordVector (lWordList.begin(),
+                                                lWordList.end());
+    const NbOfWords_T nbOfWords = lWordVector.size();
+
+    // 1. Add all the contiguous groups of words, from every word onwards.
+    //    As with the partitions (see StringPartition), only the first words
+    //    of the string are considered. See basic/BasCont.cpp for the value
+    //    of K_DEFAULT_MAXIMUM_NUMBER_OF_WORDS_IN_STRING
+    const NbOfWords_T nbOfCappedWords =
+      std::min (nbOfWords, K_DEFAULT_MAXIMUM_NUMBER_OF_WORDS_IN_STRING);
+    const NbOfWords_T lMaxSpan = (iMaxSpan == 0)? nbOfCappedWords : iMaxSpan;
+    for (NbOfWords_T idx_begin = 0; idx_begin != nbOfCappedWords; ++idx_begin) {
+      const NbOfWords_T idx_end =
+        std::min (nbOfCappedWords, static_cast<NbOfWords_T> (idx_begin
+                                                             + lMaxSpan));
+      std::string lWordCombination;
+      for (NbOfWords_T idx_word = idx_begin; idx_word != idx_end; ++idx_word) {
+        if (idx_word != idx_begin) {
+          lWordCombination += " ";
+        }
+        lWordCombination += lWordVector[idx_word];
 
-    // 2.1. For every word combination, add it if not already in the
-    //      list (STL set) of strings.
-    for (StringPartition::StringPartition_T::const_iterator itSet =
-           lStringPartition.begin(); itSet != lStringPartition.end(); ++itSet) {
-      const StringSet& itStringList = *itSet;
-      
-      const StringList_T& lStringList = itStringList._set;
-      for (StringList_T::const_iterator itWordCombination = lStringList.begin();
-           itWordCombination != lStringList.end(); ++itWordCombination) {
-        const std::string& lWordCombination = *itWordCombination;
-
-        // Check whether the (remaining) word combination should be filtered out
-        //const bool isToBeAdded= Filter::shouldKeep (iPhrase, lWordCombination);
-        const bool isToBeAdded = true;
-        if (isToBeAdded == true) {
-          lStringSet.insert (lWordCombination);
+        // Add the word combination, unless already added
+        const bool hasBeenInserted =
+          lStringSet.insert (lWordCombination).second;
+        if (hasBeenInserted == true) {
+          _list.push_back (lWordCombination);
         }
       }
-    }    
-
-    // 2.2. Convert the STL set into a STL list
-    for (StringSet_T::const_iterator itWordCombination = lStringSet.begin();
-         itWordCombination != lStringSet.end(); ++itWordCombination) {
-      const std::string& lWordCombination = *itWordCombination;
-
-      // Add that word combination in the list for indexation by Xapian.
-      // Note that if that word combination is already present in the list,
-      // it will not be added a second time (thanks to the STL list design).
-      _list.push_back (lWordCombination);
     }
 
-    // 3. Add the word combinations, made by removing all the possible groups
+    // 2. Add the word combinations, made by removing all the possible groups
     //    of continuous words inbetween the two extreme words (from left- and
     //    right-hand sides).
-    // 3.0. Initialisation of the list of words, made of all the words of the
-    //      given string.
-    WordList_T lWordList;
-    tokeniseStringIntoWordList (iPhrase, lWordList);
-    const short nbOfWords = lWordList.size();
-
-    // 3.1. If the string contains no more than two words, the job is finished.
-    if (nbOfWords <= 2) {
+    // 2.1. If the string contains no more than two words, or more words than
+    //      the maximum span, the job is finished.
+    if (nbOfWords <= 2 || (iMaxSpan != 0 && nbOfWords > iMaxSpan)) {
       return;
     }
 
-    // 3.2. Iteration on the number of words to remove in the middle of the
+    // 2.2. Derive the left-hand sides (the first idx_word words) and the
+    //      right-hand sides (the words from idx_word onwards) only once
+    std::vector<std::string> lLeftHandStringList (nbOfWords);
+    std::vector<std::string> lRightHandStringList (nbOfWords);
+    for (NbOfWords_T idx_word = 1; idx_word != nbOfWords; ++idx_word) {
+      lLeftHandStringList[idx_word] = lLeftHandStringList[idx_word-1];
+      if (idx_word != 1) {
+        lLeftHandStringList[idx_word] += " ";
+      }
+      lLeftHandStringList[idx_word] += lWordVector[idx_word-1];
+
+      const NbOfWords_T idx_rhs = nbOfWords - idx_word;
+      lRightHandStringList[idx_rhs] = lWordVector[idx_rhs];
+      if (idx_word != 1) {
+        lRightHandStringList[idx_rhs] += " ";
+        lRightHandStringList[idx_rhs] += lRightHandStringList[idx_rhs+1];
+      }
+    }
+
+    // 2.3. Iteration on the number of words to remove in the middle of the
     //      string, from 1 to (nbOfWords - 2)
-    for (short mdl_string_len = 1; mdl_string_len != nbOfWords-1;
+    for (NbOfWords_T mdl_string_len = 1; mdl_string_len != nbOfWords-1;
          ++mdl_string_len) {
 
-      // 3.2. Iteration on all the middle words of the given string,
+      // 2.4. Iteration on all the middle words of the given string,
       //      from 1 to (nbOfWords - mdl_string_len)
-      for (short idx_word=1; idx_word != nbOfWords-mdl_string_len; ++idx_word) {
-        // 3.2.1. Copy the first idx_word word(s)
-        const std::string& lLeftHandString =
-          createStringFromWordList (lWordList, idx_word);
-
-        // 3.2.2. Copy the last (nbOfWords - (idx_word + mdl_string_len)) words
-        const std::string& lRightHandString =
-          createStringFromWordList (lWordList,
-                                    idx_word + mdl_string_len,
-                                    false);
-
-        // 3.2.3. Concatenate both sub-strings
-        std::ostringstream lConcatenatedStr;
-        lConcatenatedStr << lLeftHandString << " " << lRightHandString;
-        const std::string& lConcatenatedString = lConcatenatedStr.str();
-
-        // 3.2.4. Add the concatenated string into the list, if not filtered out
-        // const bool isToBeAdded =
-        //   Filter::shouldKeep (iPhrase, lConcatenatedString);
-        const bool isToBeAdded = true;
-        if (isToBeAdded == true) {
+      for (NbOfWords_T idx_word = 1; idx_word != nbOfWords - mdl_string_len;
+           ++idx_word) {
+        // Concatenate the first idx_word word(s) and the last
+        // (nbOfWords - (idx_word + mdl_string_len)) words
+        const std::string lConcatenatedString =
+          lLeftHandStringList[idx_word] + " "
+          + lRightHandStringList[idx_word + mdl_string_len];
+
+        // Add the word combination, unless already added
+        const bool hasBeenInserted =
+          lStringSet.insert (lConcatenatedString).second;
+        if (hasBeenInserted == true) {
           _list.push_back (lConcatenatedString);
         }
       }
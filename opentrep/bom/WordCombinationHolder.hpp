@@ -22,23 +22,27 @@ namespace OPENTREP {
    * \note The 2- and 3-letter words (such as 'de' and 'san') are usually not
    *       to be indexed by Xapian. Idem with the 'airport' word.
    *
-   * A way to derive that list is simply by:
+   * The word combinations are enumerated directly, without duplicates:
    * <ol>
-   *   <li>Calculating all the partitions of the initial (full) string</li>
-   *   <li>Extract from those partitions all the unique word combinations</li>
-   *   <li>Add all the word combinations, obtained from removing any group
-   *       of words in the middle of the initial (full) string</li>
+   *   <li>All the contiguous groups of words (n-grams) of the initial (full)
+   *       string. They are the same as the ones found within all the
+   *       partitions of that string (see StringPartition), without the cost
+   *       of enumerating those partitions, the number of which is
+   *       exponential in the number of words</li>
+   *   <li>All the word combinations, obtained from removing any group
+   *       of words in the middle of the initial (full) string (skip-grams)</li>
    * </ol>
    *
    * For instance, "san francisco international airport" will give:
    * <ul>
-   *   <li>Derived from the partitions of the initial string:</li>
+   *   <li>Contiguous groups of words:</li>
    *   <li><ol>
    *     <li>"san francisco international airport"</li>
    *     <li>"san francisco international"</li>
    *     <li>"san francisco"</li>
    *     <li>"francisco international airport"</li>
    *     <li>"international airport"</li>
+   *     <li>...</li>
    *   </ol></li>
    *   <li>Added word combinations:</li>
    *   <li><ol>
@@ -47,6 +51,20 @@ namespace OPENTREP {
    *     <li>"san airport"</li>
    *   </ol></li>
    * </ul>
+   *
+   * The number of word combinations may be bounded by a maximum span,
+   * i.e., a maximum number of words of the initial string covered by
+   * a word combination, from its first word to its last one:
+   * <ul>
+   *   <li>The contiguous groups of words have at most that number
+   *       of words;</li>
+   *   <li>As the skip-grams always span the whole initial string, they
+   *       are added only when that latter has no more words than the
+   *       maximum span.</li>
+   * </ul>
+   * With a maximum span of 2, "san francisco international airport" gives
+   * only "san francisco", "francisco international", "international
+   * airport" and the four words on their own.
    */
   struct WordCombinationHolder : public StructAbstract {
     // //////////////// Type definitions //////////////////
@@ -78,9 +96,12 @@ namespace OPENTREP {
      *
      * That method is called by the main constructor. It should not be called
      * directly.
-     * @param const std::string& The string for which the partitions are sought
+     * @param const std::string& The string for which the word combinations
+     *        are sought.
+     * @param const NbOfWords_T& Maximum span of the word combinations
+     *        (0 meaning no maximum).
      */
-    void init (const std::string& iString);
+    void init (const std::string& iString, const NbOfWords_T& iMaxSpan);
 
 
   public:
@@ -115,8 +136,13 @@ namespace OPENTREP {
     // //////////////// Constructors and Destructors /////////////
     /**
      * Constructor.
+     *
+     * @param const std::string& The string for which the word combinations
+     *        are sought.
+     * @param const NbOfWords_T& Maximum span of the word combinations
+     *        (0 meaning no maximum).
      */
-    WordCombinationHolder (const std::string&);
+    WordCombinationHolder (const std::string&, const NbOfWords_T& iMaxSpan);
 
     /**
      * Default destructor.
@@ -0,0 +1,519 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+// Boost
+#include <boost/lexical_cast.hpp>
+#include <boost/date_time/gregorian/gregorian.hpp>
+// SOCI
+#include <soci/soci.h>
+#include <soci/sqlite3/soci-sqlite3.h>
+#include <soci/mysql/soci-mysql.h>
+#include <soci/postgresql/soci-postgresql.h>
+// MySQL
+#include <errmsg.h>
+// OpenTrep
+#include <opentrep/bom/Place.hpp>
+#include <opentrep/command/DBManager.hpp>
+#include <opentrep/command/DBBulkLoader.hpp>
+#include <opentrep/service/Logger.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * Columns of the optd_por table, in the order of the row buffers.
+   */
+  static const std::string K_OPTD_POR_COLUMNS ("pk, location_type, "
+                                               "iata_code, icao_code, "
+                                               "faa_code, unlocode_code, "
+                                               "uic_code, is_geonames, "
+                                               "geoname_id, envelope_id, "
+                                               "date_from, date_until, "
+                                               "serialised_place");
+
+  /**
+   * In-memory data streamed to the MySQL/MariaDB server, in place of
+   * the local file of load data local infile.
+   */
+  struct MySQLInfileData {
+    /** Serialised rows. */
+    const std::string* _rows;
+    /** Position of the next character to be streamed. */
+    std::size_t _position;
+  };
+
+  // //////////////////////////////////////////////////////////////////////
+  static int initMySQLInfile (void** ioHandle, const char* iFilename,
+                       void* iUserData) {
+    MySQLInfileData* lInfileData_ptr =
+      static_cast<MySQLInfileData*> (iUserData);
+    assert (lInfileData_ptr != NULL);
+    lInfileData_ptr->_position = 0;
+    *ioHandle = lInfileData_ptr;
+    return 0;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  static int readMySQLInfile (void* ioHandle, char* ioBuffer,
+                       unsigned int iBufferLength) {
+    MySQLInfileData* lInfileData_ptr = static_cast<MySQLInfileData*> (ioHandle);
+    assert (lInfileData_ptr != NULL && lInfileData_ptr->_rows != NULL);
+    const std::string& lRows = *lInfileData_ptr->_rows;
+
+    std::size_t lLength = lRows.size() - lInfileData_ptr->_position;
+    if (lLength > iBufferLength) {
+      lLength = iBufferLength;
+    }
+    std::memcpy (ioBuffer, lRows.data() + lInfileData_ptr->_position, lLength);
+    lInfileData_ptr->_position += lLength;
+    return static_cast<int> (lLength);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  static void endMySQLInfile (void* ioHandle) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  static int errorMySQLInfile (void* ioHandle, char* ioMessage,
+                        unsigned int iMessageLength) {
+    std::snprintf (ioMessage, iMessageLength,
+                   "The rows to be loaded cannot be streamed");
+    return CR_UNKNOWN_ERROR;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  static void appendTextField (const std::string& iField, std::string& ioRows) {
+    for (std::string::const_iterator itChar = iField.begin();
+         itChar != iField.end(); ++itChar) {
+      const char lChar = *itChar;
+      switch (lChar) {
+      case '\\': ioRows += "\\\\"; break;
+      case '\t': ioRows += "\\t"; break;
+      case '\n': ioRows += "\\n"; break;
+      case '\r': ioRows += "\\r"; break;
+      default: ioRows += lChar; break;
+      }
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SQLDBConnectionString_T DBBulkLoader::
+  completeSQLDBConnectionString (const DBType& iSQLDBType,
+                                 const SQLDBConnectionString_T& iSQLDBConnStr) {
+    const std::string& lSQLDBConnStr = iSQLDBConnStr;
+    if (!(iSQLDBType == DBType::MYSQL)
+        || lSQLDBConnStr.find ("local_infile") != std::string::npos) {
+      return iSQLDBConnStr;
+    }
+
+    // The MYSQL_OPT_LOCAL_INFILE option is taken into account only when
+    // set before connecting, which the SOCI MySQL backend does when given
+    // the local_infile parameter
+    const SQLDBConnectionString_T oSQLDBConnStr (lSQLDBConnStr
+                                                 + " local_infile=1");
+    return oSQLDBConnStr;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DBBulkLoader::DBBulkLoader (soci::session& ioSociSession,
+                              const DBType& iSQLDBType,
+                              const NbOfDBEntries_T& iBatchSize,
+                              const DocumentFormat& iDocumentFormat)
+    : _sociSession (ioSociSession), _sqlDBType (iSQLDBType),
+      _batchSize ((iBatchSize == 0) ? 1 : iBatchSize),
+      _documentFormat (iDocumentFormat),
+      _loadMethod (INSERT_STATEMENT), _insertStatement (NULL),
+      _isSQLDBPrepared (false), _sqliteSynchronous (2),
+      _sqliteJournalMode ("delete"), _nbOfLoadedRows (0) {
+
+    // Retrieve the enum, so that the switch-case statement works
+    const DBType::EN_DBType& dbType = _sqlDBType.getType();
+    switch (dbType) {
+    case DBType::PG: {
+      _loadMethod = PG_COPY;
+      break;
+    }
+    case DBType::MYSQL: {
+      _loadMethod = MYSQL_LOAD_DATA;
+      break;
+    }
+    case DBType::SQLITE3: {
+      _loadMethod = INSERT_STATEMENT;
+      break;
+    }
+    default: {
+      std::ostringstream errorStr;
+      errorStr << "Error: the POR cannot be loaded into the '"
+               << _sqlDBType.describe() << "' SQL database type";
+      OPENTREP_LOG_ERROR (errorStr.str());
+      throw SQLDatabaseException (errorStr.str());
+    }
+    }
+
+    prepareSQLDB();
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("Bulk loader of the POR: " << describe());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DBBulkLoader::~DBBulkLoader() {
+    delete _insertStatement; _insertStatement = NULL;
+
+    try {
+      restoreSQLDB();
+
+    } catch (std::exception const& lException) {
+      OPENTREP_LOG_ERROR ("Error when restoring the settings of the "
+                          << _sqlDBType.describe() << " database: "
+                          << lException.what());
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string DBBulkLoader::describe() const {
+    static const std::string lLoadMethodLabels[LAST_VALUE] =
+      { "prepared insert statement", "copy from stdin",
+        "load data local infile" };
+
+    std::ostringstream oStr;
+    oStr << _sqlDBType.describe() << " database; method: "
+         << lLoadMethodLabels[_loadMethod] << "; rows per transaction: "
+         << _batchSize << "; loaded rows: " << _nbOfLoadedRows;
+    return oStr.str();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DBBulkLoader::prepareSQLDB() {
+    try {
+
+      // Retrieve the enum, so that the switch-case statement works
+      const DBType::EN_DBType& dbType = _sqlDBType.getType();
+      switch (dbType) {
+      case DBType::SQLITE3: {
+        /**
+         * The database file is re-built from scratch: there is no need
+         * for it to be synchronised on disk after every transaction,
+         * nor for the journal to be written on disk.
+         */
+        _sociSession << "pragma synchronous", soci::into (_sqliteSynchronous);
+        _sociSession << "pragma journal_mode", soci::into (_sqliteJournalMode);
+        _sociSession << "pragma synchronous = off";
+        _sociSession << "pragma journal_mode = memory";
+        break;
+      }
+
+      case DBType::PG: {
+        // Do not wait for the WAL (write-ahead log) to be flushed on disk
+        // when committing every batch
+        _sociSession << "set synchronous_commit to off";
+        break;
+      }
+
+      default: {
+        break;
+      }
+      }
+
+    } catch (std::exception const& lException) {
+      std::ostringstream errorStr;
+      errorStr << "Error when preparing the " << _sqlDBType.describe()
+               << " database for the bulk load: " << lException.what();
+      OPENTREP_LOG_ERROR (errorStr.str());
+      throw SQLDatabaseException (errorStr.str());
+    }
+
+    _isSQLDBPrepared = true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DBBulkLoader::restoreSQLDB() {
+    if (_isSQLDBPrepared == false) {
+      return;
+    }
+    _isSQLDBPrepared = false;
+
+    // Retrieve the enum, so that the switch-case statement works
+    const DBType::EN_DBType& dbType = _sqlDBType.getType();
+    switch (dbType) {
+    case DBType::SQLITE3: {
+      std::ostringstream lSynchronousStr;
+      lSynchronousStr << "pragma synchronous = " << _sqliteSynchronous;
+      _sociSession << lSynchronousStr.str();
+      std::ostringstream lJournalModeStr;
+      lJournalModeStr << "pragma journal_mode = " << _sqliteJournalMode;
+      _sociSession << lJournalModeStr.str();
+      break;
+    }
+
+    case DBType::PG: {
+      _sociSession << "reset synchronous_commit";
+      break;
+    }
+
+    default: {
+      break;
+    }
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DBBulkLoader::addPlace (const Place& iPlace) {
+    std::lock_guard<std::mutex> lGuard (_mutex);
+
+    const LocationKey& lLocationKey = iPlace.getKey();
+    _pkList.push_back (lLocationKey.toString());
+    const IATAType& lIataType = iPlace.getIataType();
+    _locationTypeList.push_back (lIataType.getTypeAsString());
+    _iataCodeList.push_back (iPlace.getIataCode());
+    _icaoCodeList.push_back (iPlace.getIcaoCode());
+    _faaCodeList.push_back (iPlace.getFaaCode());
+
+    // Only the first UN/LOCODE and UIC codes are stored, as explained
+    // in DBManager::insertPlaceInDB()
+    const UNLOCodeList_T& lUNLOCodeList = iPlace.getUNLOCodeList();
+    std::string lUNLOCodeStr ("");
+    if (lUNLOCodeList.empty() == false) {
+      lUNLOCodeStr = static_cast<const std::string&> (lUNLOCodeList.front());
+    }
+    _unlocodeCodeList.push_back (lUNLOCodeStr);
+
+    const UICCodeList_T& lUICCodeList = iPlace.getUICCodeList();
+    int lUICCodeInt = 0;
+    if (lUICCodeList.empty() == false) {
+      lUICCodeInt = static_cast<int> (lUICCodeList.front());
+    }
+    _uicCodeList.push_back (lUICCodeInt);
+
+    _isGeonamesList.push_back ((iPlace.isGeonames())?"Y":"N");
+    _geonameIDList.push_back (boost::lexical_cast<std::string>
+                              (iPlace.getGeonamesID()));
+    _envelopeIDList.push_back (boost::lexical_cast<std::string>
+                               (iPlace.getEnvelopeID()));
+    _dateFromList.push_back (boost::gregorian::
+                             to_iso_extended_string (iPlace.getDateFrom()));
+    _dateUntilList.push_back (boost::gregorian::
+                              to_iso_extended_string (iPlace.getDateEnd()));
+    _serialisedPlaceList.push_back (DBManager::
+                                    getSerialisedPlace (iPlace,
+                                                        _documentFormat));
+
+    // Send the batch, when full
+    if (_pkList.size() >= _batchSize) {
+      flush();
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfDBEntries_T DBBulkLoader::finish() {
+    std::lock_guard<std::mutex> lGuard (_mutex);
+
+    flush();
+    restoreSQLDB();
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("The POR have been loaded: " << describe());
+
+    return _nbOfLoadedRows;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DBBulkLoader::clearRows() {
+    _pkList.clear(); _locationTypeList.clear();
+    _iataCodeList.clear(); _icaoCodeList.clear(); _faaCodeList.clear();
+    _unlocodeCodeList.clear(); _uicCodeList.clear();
+    _isGeonamesList.clear(); _geonameIDList.clear(); _envelopeIDList.clear();
+    _dateFromList.clear(); _dateUntilList.clear();
+    _serialisedPlaceList.clear();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DBBulkLoader::flush() {
+    const NbOfDBEntries_T lNbOfRows = _pkList.size();
+    if (lNbOfRows == 0) {
+      return;
+    }
+
+    try {
+
+      // Begin a transaction on the database
+      _sociSession.begin();
+
+      switch (_loadMethod) {
+      case PG_COPY: {
+        flushWithPGCopy();
+        break;
+      }
+      case MYSQL_LOAD_DATA: {
+        flushWithMySQLLoadData();
+        break;
+      }
+      default: {
+        flushWithInsertStatement();
+        break;
+      }
+      }
+
+      // Commit the transaction on the database
+      _sociSession.commit();
+
+    } catch (std::exception const& lException) {
+      std::ostringstream errorStr;
+      errorStr << "Error when loading " << lNbOfRows << " rows (after "
+               << _nbOfLoadedRows << " rows) into the "
+               << _sqlDBType.describe() << " database: "
+               << lException.what();
+      OPENTREP_LOG_ERROR (errorStr.str());
+      throw SQLDatabaseException (errorStr.str());
+    }
+
+    _nbOfLoadedRows += lNbOfRows;
+    clearRows();
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("Loaded " << lNbOfRows << " rows into the "
+                        << _sqlDBType.describe() << " database, "
+                        << _nbOfLoadedRows << " so far");
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DBBulkLoader::flushWithInsertStatement() {
+    // Prepare the statement only once, binding it to the row buffers. The
+    // whole batch is inserted at every execution of the statement
+    if (_insertStatement == NULL) {
+      _insertStatement = new soci::statement (_sociSession);
+      assert (_insertStatement != NULL);
+      *_insertStatement =
+        (_sociSession.prepare
+         << "insert into optd_por (" << K_OPTD_POR_COLUMNS << ") "
+         << "values (:pk, :location_type, :iata_code, :icao_code, :faa_code, "
+         << ":unlocode_code, :uic_code, :is_geonames, :geoname_id, "
+         << ":envelope_id, :date_from, :date_until, :serialised_place)",
+         soci::use (_pkList), soci::use (_locationTypeList),
+         soci::use (_iataCodeList), soci::use (_icaoCodeList),
+         soci::use (_faaCodeList), soci::use (_unlocodeCodeList),
+         soci::use (_uicCodeList), soci::use (_isGeonamesList),
+         soci::use (_geonameIDList), soci::use (_envelopeIDList),
+         soci::use (_dateFromList), soci::use (_dateUntilList),
+         soci::use (_serialisedPlaceList));
+    }
+    assert (_insertStatement != NULL);
+
+    _insertStatement->execute (true);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DBBulkLoader::serialiseRows (std::string& ioRows) const {
+    const NbOfDBEntries_T lNbOfRows = _pkList.size();
+    for (NbOfDBEntries_T idx = 0; idx != lNbOfRows; ++idx) {
+      appendTextField (_pkList[idx], ioRows); ioRows += '\t';
+      appendTextField (_locationTypeList[idx], ioRows); ioRows += '\t';
+      appendTextField (_iataCodeList[idx], ioRows); ioRows += '\t';
+      appendTextField (_icaoCodeList[idx], ioRows); ioRows += '\t';
+      appendTextField (_faaCodeList[idx], ioRows); ioRows += '\t';
+      appendTextField (_unlocodeCodeList[idx], ioRows); ioRows += '\t';
+      ioRows += boost::lexical_cast<std::string> (_uicCodeList[idx]);
+      ioRows += '\t';
+      appendTextField (_isGeonamesList[idx], ioRows); ioRows += '\t';
+      appendTextField (_geonameIDList[idx], ioRows); ioRows += '\t';
+      appendTextField (_envelopeIDList[idx], ioRows); ioRows += '\t';
+      appendTextField (_dateFromList[idx], ioRows); ioRows += '\t';
+      appendTextField (_dateUntilList[idx], ioRows); ioRows += '\t';
+      appendTextField (_serialisedPlaceList[idx], ioRows); ioRows += '\n';
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DBBulkLoader::flushWithPGCopy() {
+    std::string lRows;
+    serialiseRows (lRows);
+
+    // The copy protocol is not wrapped by SOCI: use the underlying
+    // libpq connection
+    soci::postgresql_session_backend* lBackend_ptr =
+      static_cast<soci::postgresql_session_backend*> (_sociSession.
+                                                      get_backend());
+    assert (lBackend_ptr != NULL);
+    PGconn* lConnection_ptr = lBackend_ptr->conn_;
+    assert (lConnection_ptr != NULL);
+
+    std::ostringstream lCopyStr;
+    lCopyStr << "copy optd_por (" << K_OPTD_POR_COLUMNS << ") from stdin";
+    PGresult* lResult_ptr = PQexec (lConnection_ptr, lCopyStr.str().c_str());
+    const bool isCopyStarted = (PQresultStatus (lResult_ptr) == PGRES_COPY_IN);
+    PQclear (lResult_ptr);
+    if (isCopyStarted == false) {
+      throw SQLDatabaseException (PQerrorMessage (lConnection_ptr));
+    }
+
+    const int lPutDataStatus =
+      PQputCopyData (lConnection_ptr, lRows.data(), lRows.size());
+    const char* lCopyError_ptr = (lPutDataStatus == 1) ? NULL :
+      "The rows could not be sent";
+    const int lPutEndStatus = PQputCopyEnd (lConnection_ptr, lCopyError_ptr);
+
+    // Retrieve the outcome of the copy
+    bool isCopySuccessful = (lPutDataStatus == 1 && lPutEndStatus == 1);
+    std::string lErrorMessage (PQerrorMessage (lConnection_ptr));
+    while ((lResult_ptr = PQgetResult (lConnection_ptr)) != NULL) {
+      if (PQresultStatus (lResult_ptr) != PGRES_COMMAND_OK) {
+        isCopySuccessful = false;
+        lErrorMessage = PQresultErrorMessage (lResult_ptr);
+      }
+      PQclear (lResult_ptr);
+    }
+
+    if (isCopySuccessful == false) {
+      throw SQLDatabaseException (lErrorMessage);
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DBBulkLoader::flushWithMySQLLoadData() {
+    std::string lRows;
+    serialiseRows (lRows);
+
+    // Stream the rows from memory, rather than from a local file
+    soci::mysql_session_backend* lBackend_ptr =
+      static_cast<soci::mysql_session_backend*> (_sociSession.get_backend());
+    assert (lBackend_ptr != NULL);
+    MYSQL* lConnection_ptr = lBackend_ptr->conn_;
+    assert (lConnection_ptr != NULL);
+    MySQLInfileData lInfileData;
+    lInfileData._rows = &lRows;
+    lInfileData._position = 0;
+    mysql_set_local_infile_handler (lConnection_ptr, initMySQLInfile,
+                                    readMySQLInfile, endMySQLInfile,
+                                    errorMySQLInfile, &lInfileData);
+
+    // The default field and line separators, as well as the default
+    // escape character, are the ones of serialiseRows()
+    std::ostringstream lLoadDataStr;
+    lLoadDataStr << "load data local infile 'optd_por' into table optd_por "
+                 << "character set utf8mb4 (" << K_OPTD_POR_COLUMNS << ")";
+
+    try {
+
+      _sociSession << lLoadDataStr.str();
+      mysql_set_local_infile_default (lConnection_ptr);
+
+    } catch (std::exception const& lException) {
+      mysql_set_local_infile_default (lConnection_ptr);
+
+      // When the loading of local data is not allowed, the rows can still
+      // be loaded with the prepared insert statement
+      OPENTREP_LOG_WARNING ("The rows cannot be loaded into the "
+                            << _sqlDBType.describe() << " database "
+                            << "with load data local infile ("
+                            << lException.what() << "). The prepared "
+                            << "insert statement is used instead");
+      _loadMethod = INSERT_STATEMENT;
+      flushWithInsertStatement();
+    }
+  }
+
+}
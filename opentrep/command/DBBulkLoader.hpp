@@ -0,0 +1,272 @@
+#ifndef __OPENTREP_CMD_DBBULKLOADER_HPP
+#define __OPENTREP_CMD_DBBULKLOADER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+#include <mutex>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/DBType.hpp>
+#include <opentrep/DocumentFormat.hpp>
+
+// Forward declarations
+namespace soci {
+  class session;
+  class statement;
+}
+
+namespace OPENTREP {
+
+  // Forward declarations
+  class Place;
+
+  /**
+   * @brief Bulk loader of the POR (points of reference) into the optd_por
+   *        table of the SQL database.
+   *
+   * The rows are buffered, and sent to the SQL database by batches, each
+   * batch within its own transaction, rather than within one transaction
+   * per row (see DBManager::insertPlaceInDB()). Every batch is sent with
+   * the fastest method supported by the SQL database:
+   * <ul>
+   *   <li>SQLite3: a single insert statement, prepared once, to which
+   *       the rows of the batch are bound as vectors. The synchronisation
+   *       of the database file and the journal are relaxed for the
+   *       duration of the load;</li>
+   *   <li>PostgreSQL: copy from stdin;</li>
+   *   <li>MySQL/MariaDB: load data local infile, streamed from memory.
+   *       The loading of local data has to be allowed by both the client
+   *       (see completeSQLDBConnectionString()) and the server; otherwise,
+   *       the prepared insert statement is used instead.</li>
+   * </ul>
+   *
+   * The table is expected to have been created, but not yet indexed
+   * (see DBManager::createSQLDBTables() and
+   * DBManager::createSQLDBIndexes()), so that the indexes are built only
+   * once, after the load.
+   */
+  class DBBulkLoader {
+  public:
+    // ////////////// Type definitions /////////////
+    /**
+     * Methods to send the rows to the SQL database.
+     */
+    typedef enum {
+      INSERT_STATEMENT = 0,
+      PG_COPY,
+      MYSQL_LOAD_DATA,
+      LAST_VALUE
+    } EN_LoadMethod;
+
+  public:
+    // ////////////////// Helpers ////////////////////
+    /**
+     * Complete the given connection string with the options required by
+     * the bulk load. With MySQL/MariaDB, the loading of local data
+     * (local_infile) has to be allowed by the client before connecting;
+     * the session given to the bulk loader should therefore be opened
+     * with the returned connection string. The other connection strings
+     * are returned unchanged.
+     *
+     * @param const DBType& SQL database type.
+     * @param const SQLDBConnectionString_T& Connection string.
+     * @return SQLDBConnectionString_T Completed connection string.
+     */
+    static SQLDBConnectionString_T
+    completeSQLDBConnectionString (const DBType&,
+                                   const SQLDBConnectionString_T&);
+
+  public:
+    // ////////////////// Getters ////////////////////
+    /**
+     * Get the number of rows loaded (i.e., committed) so far.
+     */
+    const NbOfDBEntries_T& getNbOfLoadedRows() const {
+      return _nbOfLoadedRows;
+    }
+
+  public:
+    // ////////////////// Business methods ////////////////////
+    /**
+     * Add the row corresponding to the given Place object. The buffered
+     * rows are sent to the SQL database when the batch is full.
+     *
+     * That method may be called concurrently, for instance by the threads
+     * building the Xapian shards (see IndexBuilder).
+     *
+     * @param const Place& The place to be inserted.
+     */
+    void addPlace (const Place&);
+
+    /**
+     * Send the remaining buffered rows, and restore the settings of the
+     * SQL database altered for the duration of the load.
+     *
+     * @return NbOfDBEntries_T Number of loaded rows.
+     */
+    NbOfDBEntries_T finish();
+
+  public:
+    // ///////// Display Methods //////////
+    /**
+     * Give a short description of the bulk loader.
+     */
+    std::string describe() const;
+
+  public:
+    // ////////////////// Constructors and Destructors ////////////////////
+    /**
+     * Main constructor. The settings of the SQL database are altered
+     * for the duration of the load.
+     *
+     * @param soci::session& SOCI session handler.
+     * @param const DBType& SQL database type (NODB is not allowed).
+     * @param const NbOfDBEntries_T& Number of rows per batch/transaction.
+     * @param const DocumentFormat& Format of the serialised places.
+     */
+    DBBulkLoader (soci::session&, const DBType&, const NbOfDBEntries_T&,
+                  const DocumentFormat&);
+
+    /**
+     * Destructor. The rows not sent yet are discarded.
+     */
+    ~DBBulkLoader();
+
+  private:
+    /**
+     * Default constructor. It should not be used.
+     */
+    DBBulkLoader();
+
+    /**
+     * Copy constructor. It should not be used.
+     */
+    DBBulkLoader (const DBBulkLoader&);
+
+  private:
+    // ////////////////// Internal methods ////////////////////
+    /**
+     * Alter the settings of the SQL database for the load.
+     */
+    void prepareSQLDB();
+
+    /**
+     * Restore the settings of the SQL database altered for the load.
+     */
+    void restoreSQLDB();
+
+    /**
+     * Send the buffered rows to the SQL database, within a transaction.
+     */
+    void flush();
+
+    /**
+     * Send the buffered rows thanks to the insert statement,
+     * prepared only once.
+     */
+    void flushWithInsertStatement();
+
+    /**
+     * Send the buffered rows thanks to copy from stdin (PostgreSQL).
+     */
+    void flushWithPGCopy();
+
+    /**
+     * Send the buffered rows thanks to load data local infile
+     * (MySQL/MariaDB).
+     */
+    void flushWithMySQLLoadData();
+
+    /**
+     * Serialise the buffered rows in the text format expected by both
+     * copy (PostgreSQL) and load data (MySQL/MariaDB): one line per row,
+     * tab-separated fields and back-slash escaped special characters.
+     *
+     * @param std::string& The serialised rows.
+     */
+    void serialiseRows (std::string&) const;
+
+    /**
+     * Empty the row buffers.
+     */
+    void clearRows();
+
+  private:
+    // /////////////////////// Attributes //////////////////////
+    /**
+     * SOCI session handler.
+     */
+    soci::session& _sociSession;
+
+    /**
+     * SQL database type.
+     */
+    const DBType _sqlDBType;
+
+    /**
+     * Number of rows per batch/transaction.
+     */
+    const NbOfDBEntries_T _batchSize;
+
+    /**
+     * Format of the serialised places (see DBManager::getSerialisedPlace()).
+     */
+    const DocumentFormat _documentFormat;
+
+    /**
+     * Method to send the rows to the SQL database.
+     */
+    EN_LoadMethod _loadMethod;
+
+    /**
+     * Insert statement, prepared once and bound to the row buffers
+     * (NULL when not prepared yet).
+     */
+    soci::statement* _insertStatement;
+
+    /**
+     * Whether the settings of the SQL database have been altered.
+     */
+    bool _isSQLDBPrepared;
+
+    /**
+     * SQLite3 settings to be restored after the load.
+     */
+    int _sqliteSynchronous;
+    std::string _sqliteJournalMode;
+
+    /**
+     * Number of rows loaded (i.e., committed) so far.
+     */
+    NbOfDBEntries_T _nbOfLoadedRows;
+
+    /**
+     * Mutex protecting the row buffers and the SOCI session, as the rows
+     * may be added by several threads.
+     */
+    std::mutex _mutex;
+
+    /**
+     * Row buffers, one per column of the optd_por table.
+     */
+    std::vector<std::string> _pkList;
+    std::vector<std::string> _locationTypeList;
+    std::vector<std::string> _iataCodeList;
+    std::vector<std::string> _icaoCodeList;
+    std::vector<std::string> _faaCodeList;
+    std::vector<std::string> _unlocodeCodeList;
+    std::vector<int> _uicCodeList;
+    std::vector<std::string> _isGeonamesList;
+    std::vector<std::string> _geonameIDList;
+    std::vector<std::string> _envelopeIDList;
+    std::vector<std::string> _dateFromList;
+    std::vector<std::string> _dateUntilList;
+    std::vector<std::string> _serialisedPlaceList;
+  };
+
+}
+#endif // __OPENTREP_CMD_DBBULKLOADER_HPP
@@ -0,0 +1,214 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// SOCI
+#include <soci/soci.h>
+#include <soci/sqlite3/soci-sqlite3.h>
+#include <soci/mysql/soci-mysql.h>
+#include <soci/postgresql/soci-postgresql.h>
+// OpenTrep
+#include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
+#include <opentrep/command/DBConnection.hpp>
+#include <opentrep/command/FileManager.hpp>
+#include <opentrep/service/Logger.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  DBConnection::DBConnection (soci::session& ioSociSession,
+                              const DBType& iSQLDBType,
+                              const SQLDBConnectionString_T& iSQLDBConnStr)
+    : _sociSession (&ioSociSession), _sqlDBType (iSQLDBType),
+      _sqlDBConnectionString (iSQLDBConnStr), _isOpened (false),
+      _isValid (false), _nbOfOpenings (0), _uicCodeBuffer (0),
+      _geonamesIDBuffer (0) {
+    for (unsigned short idx = 0; idx != LAST_VALUE; ++idx) {
+      _statementList[idx] = NULL;
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DBConnection::~DBConnection() {
+    try {
+      close();
+
+    } catch (std::exception const& lException) {
+      OPENTREP_LOG_ERROR ("Error when closing the connection to the SQL "
+                          << "database: " << lException.what());
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  soci::session& DBConnection::getSession() const {
+    assert (_sociSession != NULL && _isOpened == true);
+    return *_sociSession;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  soci::statement* DBConnection::
+  findStatement (const EN_StatementType& iStatementType) const {
+    assert (iStatementType < LAST_VALUE);
+    return _statementList[iStatementType];
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DBConnection::addStatement (const EN_StatementType& iStatementType,
+                                   soci::statement& ioStatement) {
+    assert (iStatementType < LAST_VALUE);
+    delete _statementList[iStatementType];
+    _statementList[iStatementType] = &ioStatement;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DBConnection::resetStatements() {
+    for (unsigned short idx = 0; idx != LAST_VALUE; ++idx) {
+      delete _statementList[idx]; _statementList[idx] = NULL;
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DBConnection::close() {
+    // The statements have to be released before the session
+    resetStatements();
+
+    if (_isOpened == true) {
+      _isOpened = false;
+      assert (_sociSession != NULL);
+      _sociSession->close();
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DBConnection::open() {
+    // Release the previous connection, if any. A failure to release it
+    // (e.g., when the SQL database server has been restarted) is expected
+    try {
+      close();
+
+    } catch (std::exception const& lException) {
+      OPENTREP_LOG_DEBUG ("The previous connection to the SQL database "
+                          << "could not be properly closed: "
+                          << lException.what());
+    }
+
+    // Retrieve the enum, so that the switch-case statement works
+    const DBType::EN_DBType& dbType = _sqlDBType.getType();
+
+    // Check that the directory hosting the SQLite database exists, as
+    // SQLite would otherwise create an empty database
+    if (dbType == DBType::SQLITE3) {
+      const bool existSQLDBDir =
+        FileManager::checkSQLiteDirectory (_sqlDBConnectionString);
+      if (existSQLDBDir == false) {
+        std::ostringstream errorStr;
+        errorStr << "Error when trying to connect to the '"
+                 << _sqlDBConnectionString << "' SQLite3 database; the "
+                 << "directory hosting that database does not exist or "
+                 << "is not readable";
+        OPENTREP_LOG_ERROR (errorStr.str());
+        throw SQLDatabaseImpossibleConnectionException (errorStr.str());
+      }
+    }
+
+    assert (_sociSession != NULL);
+    try {
+
+      switch (dbType) {
+      case DBType::SQLITE3: {
+        _sociSession->open (soci::sqlite3, _sqlDBConnectionString);
+        break;
+      }
+      case DBType::MYSQL: {
+        _sociSession->open (soci::mysql, _sqlDBConnectionString);
+        break;
+      }
+      case DBType::PG: {
+        _sociSession->open (soci::postgresql, _sqlDBConnectionString);
+        break;
+      }
+      default: {
+        std::ostringstream errorStr;
+        errorStr << "Error: no connection can be opened on the '"
+                 << _sqlDBType.describe() << "' SQL database type";
+        throw SQLDatabaseImpossibleConnectionException (errorStr.str());
+      }
+      }
+
+    } catch (SQLDatabaseImpossibleConnectionException const& lException) {
+      OPENTREP_LOG_ERROR (lException.what());
+      throw;
+
+    } catch (std::exception const& lException) {
+      std::ostringstream errorStr;
+      errorStr << "Error when trying to connect to the '"
+               << _sqlDBConnectionString << "' " << _sqlDBType.describe()
+               << " database: " << lException.what();
+      OPENTREP_LOG_ERROR (errorStr.str());
+      throw SQLDatabaseImpossibleConnectionException (errorStr.str());
+    }
+
+    _isOpened = true;
+    _isValid = true;
+    ++_nbOfOpenings;
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("Opened the connection to the "
+                        << _sqlDBType.describe() << " database ("
+                        << _sqlDBConnectionString << "): " << describe());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DBConnection::checkHealth() {
+    const std::chrono::steady_clock::time_point lNow =
+      std::chrono::steady_clock::now();
+
+    if (_isOpened == false || _isValid == false) {
+      open();
+
+    } else {
+      // Check only the connections having been idle for a while, so that
+      // the busy ones do not pay for an additional round trip
+      const std::chrono::seconds lIdleTime =
+        std::chrono::duration_cast<std::chrono::seconds> (lNow - _lastUseTime);
+      const std::chrono::seconds
+        lHealthCheckInterval (DEFAULT_OPENTREP_SQL_DB_HEALTH_CHECK_INTERVAL);
+      if (lIdleTime >= lHealthCheckInterval) {
+        try {
+
+          int lOne = 0;
+          *_sociSession << "select 1", soci::into (lOne);
+
+        } catch (std::exception const& lException) {
+          OPENTREP_LOG_NOTIFICATION ("The connection to the "
+                                     << _sqlDBType.describe()
+                                     << " database has been lost ("
+                                     << lException.what()
+                                     << "). It is re-opened");
+          open();
+        }
+      }
+    }
+
+    _lastUseTime = lNow;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string DBConnection::describe() const {
+    NbOfDBEntries_T lNbOfStatements = 0;
+    for (unsigned short idx = 0; idx != LAST_VALUE; ++idx) {
+      if (_statementList[idx] != NULL) {
+        ++lNbOfStatements;
+      }
+    }
+
+    std::ostringstream oStr;
+    oStr << "opened: " << _isOpened << "; valid: " << _isValid
+         << "; number of openings: " << _nbOfOpenings
+         << "; number of prepared statements: " << lNbOfStatements;
+    return oStr.str();
+  }
+
+}
@@ -0,0 +1,249 @@
+#ifndef __OPENTREP_CMD_DBCONNECTION_HPP
+#define __OPENTREP_CMD_DBCONNECTION_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <chrono>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/DBType.hpp>
+
+// Forward declarations
+namespace soci {
+  class session;
+  class statement;
+}
+
+namespace OPENTREP {
+
+  /**
+   * @brief Connection to the SQL database, as held by the pool of
+   *        connections (see DBConnectionPool).
+   *
+   * Besides the SOCI session, it holds the SQL statements already
+   * prepared on that session, one per kind of look up, so that they are
+   * parsed only once, whatever the number of look ups. The parameter and
+   * the result of those statements are bound to the buffers of the
+   * connection, which are therefore re-used by all the look ups.
+   *
+   * A connection is used by a single thread at a time, namely the one
+   * having leased it from the pool (see DBConnectionLease).
+   */
+  class DBConnection {
+    friend class DBConnectionPool;
+  public:
+    // ////////////// Type definitions /////////////
+    /**
+     * Kinds of look up, for which a SQL statement is prepared.
+     */
+    typedef enum {
+      SELECT_ON_IATA_CODE = 0,
+      SELECT_ON_ICAO_CODE,
+      SELECT_ON_FAA_CODE,
+      SELECT_ON_UNLO_CODE,
+      SELECT_ON_UIC_CODE,
+      SELECT_ON_GEONAMES_ID,
+      LAST_VALUE
+    } EN_StatementType;
+
+  public:
+    // ////////////////// Getters ////////////////////
+    /**
+     * Get the (opened) SOCI session.
+     */
+    soci::session& getSession() const;
+
+    /**
+     * Get the SQL statement already prepared for the given kind of look up.
+     *
+     * @param const EN_StatementType& Kind of look up.
+     * @return soci::statement* The prepared statement, or NULL when it
+     *         has not been prepared yet on that connection.
+     */
+    soci::statement* findStatement (const EN_StatementType&) const;
+
+    /**
+     * Get the buffer, bound to the prepared statements, holding the code
+     * (IATA, ICAO, FAA or UN/LOCODE) to be looked up.
+     */
+    std::string& getCodeBuffer() {
+      return _codeBuffer;
+    }
+
+    /**
+     * Get the buffer, bound to the prepared statements, holding the UIC
+     * code to be looked up.
+     */
+    UICCode_T& getUICCodeBuffer() {
+      return _uicCodeBuffer;
+    }
+
+    /**
+     * Get the buffer, bound to the prepared statements, holding the
+     * Geonames ID to be looked up.
+     */
+    GeonamesID_T& getGeonamesIDBuffer() {
+      return _geonamesIDBuffer;
+    }
+
+    /**
+     * Get the buffer, bound to the prepared statements, receiving the
+     * serialised place (raw POR line) of every fetched row.
+     */
+    std::string& getSerialisedPlaceBuffer() {
+      return _serialisedPlaceBuffer;
+    }
+
+    /**
+     * Get the number of times the connection has been (re-)opened.
+     */
+    const NbOfDBEntries_T& getNbOfOpenings() const {
+      return _nbOfOpenings;
+    }
+
+  public:
+    // ////////////////// Setters ////////////////////
+    /**
+     * Store the SQL statement just prepared, on that connection, for the
+     * given kind of look up. The connection takes the ownership of
+     * the statement.
+     *
+     * @param const EN_StatementType& Kind of look up.
+     * @param soci::statement& Prepared statement (allocated on the heap).
+     */
+    void addStatement (const EN_StatementType&, soci::statement&);
+
+    /**
+     * State that the connection failed, for instance because the SQL
+     * database server has been restarted. The connection is re-opened,
+     * and the statements are prepared again, when it is leased next time.
+     */
+    void invalidate() {
+      _isValid = false;
+    }
+
+  public:
+    // ///////// Display Methods //////////
+    /**
+     * Give a short description of the connection.
+     */
+    std::string describe() const;
+
+  private:
+    // ////////////////// Connection management ////////////////////
+    /**
+     * Make sure that the connection is usable, before it is handed over
+     * to the thread having leased it:
+     * <ul>
+     *   <li>a connection never opened, or invalidated, is (re-)opened;</li>
+     *   <li>a connection idle for more than the health-check interval
+     *       is checked with a trivial SQL request, and re-opened if that
+     *       request fails.</li>
+     * </ul>
+     *
+     * @throw SQLDatabaseImpossibleConnectionException When the connection
+     *        cannot be (re-)opened.
+     */
+    void checkHealth();
+
+    /**
+     * (Re-)open the connection. The statements previously prepared,
+     * if any, are released.
+     */
+    void open();
+
+    /**
+     * Close the connection, if opened, and release the statements
+     * prepared on it.
+     */
+    void close();
+
+    /**
+     * Release the statements prepared on the connection.
+     */
+    void resetStatements();
+
+  private:
+    // ////////////////// Constructors and Destructors ////////////////////
+    /**
+     * Main constructor. The connection is not opened at that stage.
+     *
+     * @param soci::session& SOCI session, owned by the pool of connections.
+     * @param const DBType& SQL database type.
+     * @param const SQLDBConnectionString_T& SQL database connection string.
+     */
+    DBConnection (soci::session&, const DBType&,
+                  const SQLDBConnectionString_T&);
+
+    /**
+     * Default constructor. It should not be used.
+     */
+    DBConnection();
+
+    /**
+     * Copy constructor. It should not be used.
+     */
+    DBConnection (const DBConnection&);
+
+    /**
+     * Destructor. The connection is closed.
+     */
+    ~DBConnection();
+
+  private:
+    // /////////////////////// Attributes //////////////////////
+    /**
+     * SOCI session (owned by the SOCI pool of connections).
+     */
+    soci::session* _sociSession;
+
+    /**
+     * SQL database type.
+     */
+    const DBType _sqlDBType;
+
+    /**
+     * SQL database connection string.
+     */
+    const SQLDBConnectionString_T _sqlDBConnectionString;
+
+    /**
+     * Whether the SOCI session is opened.
+     */
+    bool _isOpened;
+
+    /**
+     * Whether the SOCI session is still usable (see invalidate()).
+     */
+    bool _isValid;
+
+    /**
+     * Number of times the connection has been (re-)opened.
+     */
+    NbOfDBEntries_T _nbOfOpenings;
+
+    /**
+     * Time of the last lease of the connection.
+     */
+    std::chrono::steady_clock::time_point _lastUseTime;
+
+    /**
+     * SQL statements prepared on the connection, for every kind of look up
+     * (NULL when not prepared yet).
+     */
+    soci::statement* _statementList[LAST_VALUE];
+
+    /**
+     * Buffers bound to the prepared statements.
+     */
+    std::string _codeBuffer;
+    UICCode_T _uicCodeBuffer;
+    GeonamesID_T _geonamesIDBuffer;
+    std::string _serialisedPlaceBuffer;
+  };
+
+}
+#endif // __OPENTREP_CMD_DBCONNECTION_HPP
@@ -0,0 +1,147 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// SOCI
+#include <soci/soci.h>
+// OpenTrep
+#include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
+#include <opentrep/command/DBConnection.hpp>
+#include <opentrep/command/DBConnectionPool.hpp>
+#include <opentrep/service/Logger.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  DBConnectionPool::
+  DBConnectionPool (const DBType& iSQLDBType,
+                    const SQLDBConnectionString_T& iSQLDBConnStr,
+                    const std::size_t iPoolSize)
+    : _sqlDBType (iSQLDBType), _sqlDBConnectionString (iSQLDBConnStr),
+      _sociConnectionPool (NULL) {
+
+    // There is no connection to be pooled without SQL database
+    if (iSQLDBType == DBType::NODB || iPoolSize == 0) {
+      std::ostringstream errorStr;
+      errorStr << "No pool of " << iPoolSize << " connections can be created "
+               << "on the " << iSQLDBType.describe() << " database ("
+               << iSQLDBConnStr << ")" << std::endl
+               << "Hint: launch the 'opentrep-dbmgr' program and "
+               << "see the 'tutorial' command.";
+      OPENTREP_LOG_ERROR (errorStr.str());
+      throw SQLDatabaseImpossibleConnectionException (errorStr.str());
+    }
+
+    // The SOCI sessions are created, but not opened
+    _sociConnectionPool = new soci::connection_pool (iPoolSize);
+    assert (_sociConnectionPool != NULL);
+
+    _dbConnectionList.reserve (iPoolSize);
+    for (std::size_t idx = 0; idx != iPoolSize; ++idx) {
+      soci::session& lSociSession = _sociConnectionPool->at (idx);
+      DBConnection* lDBConnection_ptr =
+        new DBConnection (lSociSession, iSQLDBType, iSQLDBConnStr);
+      assert (lDBConnection_ptr != NULL);
+      _dbConnectionList.push_back (lDBConnection_ptr);
+    }
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("Created a pool of connections to the "
+                        << iSQLDBType.describe() << " database ("
+                        << iSQLDBConnStr << "): " << describe());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DBConnectionPool::~DBConnectionPool() {
+    // The connections (and their statements) have to be released before
+    // the SOCI sessions they wrap
+    for (std::vector<DBConnection*>::iterator itDBConnection =
+           _dbConnectionList.begin();
+         itDBConnection != _dbConnectionList.end(); ++itDBConnection) {
+      DBConnection* lDBConnection_ptr = *itDBConnection;
+      delete lDBConnection_ptr; lDBConnection_ptr = NULL;
+    }
+    _dbConnectionList.clear();
+
+    delete _sociConnectionPool; _sociConnectionPool = NULL;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::size_t DBConnectionPool::lease() {
+    assert (_sociConnectionPool != NULL);
+
+    // Wait for a connection to be available, at most for the time-out
+    std::size_t oPosition = 0;
+    const int lTimeOut = DEFAULT_OPENTREP_SQL_DB_POOL_LEASE_TIMEOUT;
+    const bool hasBeenLeased =
+      _sociConnectionPool->try_lease (oPosition, lTimeOut);
+    if (hasBeenLeased == false) {
+      std::ostringstream errorStr;
+      errorStr << "None of the " << getSize() << " connections to the "
+               << _sqlDBType.describe() << " database ("
+               << _sqlDBConnectionString << ") has been given back within "
+               << lTimeOut << " ms";
+      OPENTREP_LOG_ERROR (errorStr.str());
+      throw SQLDatabaseImpossibleConnectionException (errorStr.str());
+    }
+
+    // Make sure that the connection is usable. If not, it is given back,
+    // so that it may be re-opened at the next lease
+    DBConnection& lDBConnection = getDBConnection (oPosition);
+    try {
+      lDBConnection.checkHealth();
+
+    } catch (...) {
+      lDBConnection.invalidate();
+      _sociConnectionPool->give_back (oPosition);
+      throw;
+    }
+
+    return oPosition;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DBConnectionPool::giveBack (const std::size_t iPosition) {
+    assert (_sociConnectionPool != NULL);
+    _sociConnectionPool->give_back (iPosition);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DBConnection& DBConnectionPool::
+  getDBConnection (const std::size_t iPosition) const {
+    assert (iPosition < _dbConnectionList.size());
+    DBConnection* lDBConnection_ptr = _dbConnectionList[iPosition];
+    assert (lDBConnection_ptr != NULL);
+    return *lDBConnection_ptr;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string DBConnectionPool::describe() const {
+    std::ostringstream oStr;
+    oStr << getSize() << " connections";
+    unsigned short idx = 0;
+    for (std::vector<DBConnection*>::const_iterator itDBConnection =
+           _dbConnectionList.begin();
+         itDBConnection != _dbConnectionList.end(); ++itDBConnection, ++idx) {
+      const DBConnection* lDBConnection_ptr = *itDBConnection;
+      assert (lDBConnection_ptr != NULL);
+      oStr << "; [" << idx << "] " << lDBConnection_ptr->describe();
+    }
+    return oStr.str();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DBConnectionLease::DBConnectionLease (DBConnectionPool& ioDBConnectionPool)
+    : _dbConnectionPool (ioDBConnectionPool),
+      _position (ioDBConnectionPool.lease()),
+      _dbConnection (ioDBConnectionPool.getDBConnection (_position)) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DBConnectionLease::~DBConnectionLease() {
+    _dbConnectionPool.giveBack (_position);
+  }
+
+}
@@ -0,0 +1,203 @@
+#ifndef __OPENTREP_CMD_DBCONNECTIONPOOL_HPP
+#define __OPENTREP_CMD_DBCONNECTIONPOOL_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/DBType.hpp>
+
+// Forward declarations
+namespace soci {
+  class connection_pool;
+}
+
+namespace OPENTREP {
+
+  // Forward declarations
+  class DBConnection;
+
+  /**
+   * @brief Bounded pool of connections to the SQL database.
+   *
+   * The connections are opened lazily, i.e., when they are leased for the
+   * first time, and are then kept opened, along with the SQL statements
+   * prepared on them (see DBConnection), so that the look ups do not pay
+   * for the connection (e.g., TCP handshake and authentication with
+   * MySQL/MariaDB and PostgreSQL) nor for the parsing of the statements.
+   *
+   * The pool is thread-safe: when all the connections are leased, the
+   * calling thread waits for one of them to be given back, at most for
+   * the lease time-out.
+   */
+  class DBConnectionPool {
+  public:
+    // ////////////////// Getters ////////////////////
+    /**
+     * Get the SQL database type.
+     */
+    const DBType& getSQLDBType() const {
+      return _sqlDBType;
+    }
+
+    /**
+     * Get the SQL database connection string.
+     */
+    const SQLDBConnectionString_T& getSQLDBConnectionString() const {
+      return _sqlDBConnectionString;
+    }
+
+    /**
+     * Get the number of connections of the pool.
+     */
+    std::size_t getSize() const {
+      return _dbConnectionList.size();
+    }
+
+  public:
+    // ////////////////// Lease management ////////////////////
+    /**
+     * Lease a connection, which is checked (see DBConnection::checkHealth())
+     * before being handed over. The connection has to be given back
+     * thanks to the giveBack() method; DBConnectionLease does it
+     * automatically.
+     *
+     * @return std::size_t Position of the leased connection within the pool.
+     * @throw SQLDatabaseImpossibleConnectionException When no connection
+     *        has been given back within the lease time-out, or when
+     *        the connection cannot be (re-)opened.
+     */
+    std::size_t lease();
+
+    /**
+     * Give back the connection at the given position.
+     *
+     * @param const std::size_t Position of the connection within the pool.
+     */
+    void giveBack (const std::size_t);
+
+    /**
+     * Get the connection at the given position. That connection must have
+     * been leased by the calling thread.
+     *
+     * @param const std::size_t Position of the connection within the pool.
+     */
+    DBConnection& getDBConnection (const std::size_t) const;
+
+  public:
+    // ///////// Display Methods //////////
+    /**
+     * Give a short description of the pool.
+     */
+    std::string describe() const;
+
+  public:
+    // ////////////////// Constructors and Destructors ////////////////////
+    /**
+     * Main constructor. No connection is opened at that stage.
+     *
+     * @param const DBType& SQL database type (NODB is not allowed).
+     * @param const SQLDBConnectionString_T& SQL database connection string.
+     * @param const std::size_t Number of connections of the pool.
+     */
+    DBConnectionPool (const DBType&, const SQLDBConnectionString_T&,
+                      const std::size_t);
+
+    /**
+     * Destructor. All the connections are closed; none of them should
+     * still be leased.
+     */
+    ~DBConnectionPool();
+
+  private:
+    /**
+     * Default constructor. It should not be used.
+     */
+    DBConnectionPool();
+
+    /**
+     * Copy constructor. It should not be used.
+     */
+    DBConnectionPool (const DBConnectionPool&);
+
+  private:
+    // /////////////////////// Attributes //////////////////////
+    /**
+     * SQL database type.
+     */
+    const DBType _sqlDBType;
+
+    /**
+     * SQL database connection string.
+     */
+    const SQLDBConnectionString_T _sqlDBConnectionString;
+
+    /**
+     * SOCI pool, owning the SOCI sessions and managing their leases.
+     */
+    soci::connection_pool* _sociConnectionPool;
+
+    /**
+     * Connections, wrapping the SOCI sessions of the pool (at the same
+     * positions).
+     */
+    std::vector<DBConnection*> _dbConnectionList;
+  };
+
+
+  /**
+   * @brief Lease of a connection of the pool, given back when the lease
+   *        goes out of scope (including when an exception is thrown).
+   */
+  class DBConnectionLease {
+  public:
+    /**
+     * Get the leased connection.
+     */
+    DBConnection& getDBConnection() const {
+      return _dbConnection;
+    }
+
+  public:
+    /**
+     * Main constructor. A connection is leased from the given pool.
+     *
+     * @param DBConnectionPool& Pool of connections.
+     */
+    DBConnectionLease (DBConnectionPool&);
+
+    /**
+     * Destructor. The connection is given back to the pool.
+     */
+    ~DBConnectionLease();
+
+  private:
+    /**
+     * Copy constructor. It should not be used.
+     */
+    DBConnectionLease (const DBConnectionLease&);
+
+  private:
+    // /////////////////////// Attributes //////////////////////
+    /**
+     * Pool of connections.
+     */
+    DBConnectionPool& _dbConnectionPool;
+
+    /**
+     * Position of the leased connection within the pool.
+     */
+    const std::size_t _position;
+
+    /**
+     * Leased connection.
+     */
+    DBConnection& _dbConnection;
+  };
+
+}
+#endif // __OPENTREP_CMD_DBCONNECTIONPOOL_HPP
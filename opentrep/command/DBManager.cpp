@@ -4,6 +4,8 @@
 // STL
 #include <cassert>
 #include <sstream>
+#include <algorithm>
+#include <map>
 // Boost
 #include <boost/lexical_cast.hpp>
 #include <boost/date_time/gregorian/gregorian.hpp>
@@ -21,10 +23,12 @@
 #include <opentrep/bom/World.hpp>
 #include <opentrep/bom/Place.hpp>
 #include <opentrep/bom/Result.hpp>
+#include <opentrep/bom/LocationSerialiser.hpp>
 #include <opentrep/bom/PORFileHelper.hpp>
 #include <opentrep/bom/PORParserHelper.hpp>
 #include <opentrep/factory/FacPlace.hpp>
 #include <opentrep/dbadaptor/DbaPlace.hpp>
+#include <opentrep/command/DBConnection.hpp>
 #include <opentrep/command/DBManager.hpp>
 #include <opentrep/command/FileManager.hpp>
 #include <opentrep/service/Logger.hpp>
@@ -335,23 +339,101 @@ namespace OPENTREP {
         return oCreationSuccessful;
       }
       
-    } catch (soci::mysql_soci_error const& lSociException) {
+    } catch (std::exception const& lException) {
       std::ostringstream errorStr;
       errorStr << "SOCI-related error when trying to connect to the "
                << "PostgreSQL database ('" << iSQLDBConnStr
-               << "'). SOCI error message: " << lSociException.what();
+               << "'). SOCI error message: " << lException.what();
       OPENTREP_LOG_ERROR (errorStr.str());
       std::cerr << errorStr.str() << std::endl;
       oCreationSuccessful = false;
       return oCreationSuccessful;
     }
     assert (lSociSession_ptr != NULL);
-    // soci::session& lSociSession = *lSociSession_ptr;
+    soci::session& lSociSession = *lSociSession_ptr;
 
-    //
-    // TODO - Adapt the remaining of the MySQL function
-    //
+    /**
+     * SQL DDL (Data Definition Language) queries:
+     * -------------------------------------------
+     -- The role may already exist, for instance when it owns the database
+     -- of the other deployment: it is then just altered
+     create role trep with login createdb password 'trep';
+     alter role trep with login createdb password 'trep';
 
+     -- <N> is the deployment number. Neither of those queries may run
+     -- within a transaction
+     drop database if exists trep_trep<N>;
+     create database trep_trep<N> with owner trep
+     encoding 'UTF8' template template0;
+    */
+
+    try {
+      // Create the 'trep' role
+      std::ostringstream lSQLCreateTrepStr;
+      lSQLCreateTrepStr << "create role " << DEFAULT_OPENTREP_PG_DB_USER
+                        << " with login createdb password '"
+                        << DEFAULT_OPENTREP_PG_DB_PASSWD << "';";
+      lSociSession << lSQLCreateTrepStr.str();
+      
+    } catch (std::exception const& lException) {
+      std::ostringstream issueStr;
+      issueStr << "Issue when trying to create PostgreSQL '"
+               << DEFAULT_OPENTREP_PG_DB_USER << "' user. "
+               << "Most probably the user existed before. " << std::endl
+               << "SOCI error message: " << lException.what() << std::endl
+               << "The database user will just be altered";
+      OPENTREP_LOG_DEBUG (issueStr.str());
+      std::cout << issueStr.str() << std::endl;
+    }
+
+    try {
+      // Make sure that the 'trep' role has got the expected attributes
+      std::ostringstream lSQLAlterTrepStr;
+      lSQLAlterTrepStr << "alter role " << DEFAULT_OPENTREP_PG_DB_USER
+                       << " with login createdb password '"
+                       << DEFAULT_OPENTREP_PG_DB_PASSWD << "';";
+      lSociSession << lSQLAlterTrepStr.str();
+
+      // Drop the 'trep_trep' database, if existing
+      std::ostringstream lSQLDropDBStr;
+      lSQLDropDBStr << "drop database if exists "
+                    << DEFAULT_OPENTREP_PG_DB_DBNAME << iDeploymentNumber
+                    << ";";
+      lSociSession << lSQLDropDBStr.str();
+      
+      // Create the 'trep_trep' database, owned by the 'trep' role, so that
+      // the latter may create the tables within it
+      std::ostringstream lSQLCreateDBStr;
+      lSQLCreateDBStr << "create database "
+                      << DEFAULT_OPENTREP_PG_DB_DBNAME << iDeploymentNumber
+                      << " with owner " << DEFAULT_OPENTREP_PG_DB_USER
+                      << " encoding 'UTF8' template template0;";
+      lSociSession << lSQLCreateDBStr.str();
+      
+    } catch (std::exception const& lException) {
+      std::ostringstream errorStr;
+      errorStr << "SOCI-related error when trying to create PostgreSQL "
+               << "'" << DEFAULT_OPENTREP_PG_DB_USER << "' user and '"
+               << DEFAULT_OPENTREP_PG_DB_DBNAME << iDeploymentNumber
+               << "' database. Error message: " << lException.what();
+      OPENTREP_LOG_ERROR (errorStr.str());
+      std::cerr << errorStr.str() << std::endl;
+      oCreationSuccessful = false;
+    }
+
+    // Release the connection to the administration database
+    delete lSociSession_ptr; lSociSession_ptr = NULL;
+
+    if (oCreationSuccessful == false) {
+      return oCreationSuccessful;
+    }
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("The '" << DEFAULT_OPENTREP_PG_DB_USER
+                        << "' user and '" << DEFAULT_OPENTREP_PG_DB_DBNAME
+                        << iDeploymentNumber
+                        << "' database have been created in PostgreSQL ('"
+                        << iSQLDBConnStr << "')");
     //
     return oCreationSuccessful;
   }
@@ -680,7 +762,59 @@ namespace OPENTREP {
     }
 
     case DBType::PG: {
-      // TODO
+      // DEBUG
+      OPENTREP_LOG_DEBUG ("Create the optd_por table in the PostgreSQL database");
+        
+      try {
+
+        /**
+         * SQL DDL (Data Definition Language) queries:
+         * -------------------------------------------
+           drop table if exists optd_por;
+           create table optd_por (
+           pk varchar(20) NOT NULL,
+           location_type varchar(4) default NULL,
+           iata_code varchar(3) default NULL,
+           icao_code varchar(4) default NULL,
+           faa_code varchar(4) default NULL,
+           unlocode_code varchar(5) default NULL,
+           uic_code integer default NULL,
+           is_geonames varchar(1) default NULL,
+           geoname_id integer default NULL,
+           envelope_id integer default NULL,
+           date_from date default NULL,
+           date_until date default NULL,
+           serialised_place text default NULL);
+        */
+
+        ioSociSession << "drop table if exists optd_por;";
+        std::ostringstream lSQLTableCreationStr;
+        lSQLTableCreationStr << "create table optd_por (";
+        lSQLTableCreationStr << "pk varchar(20) NOT NULL, ";
+        lSQLTableCreationStr << "location_type varchar(4) default NULL, ";
+        lSQLTableCreationStr << "iata_code varchar(3) default NULL, ";
+        lSQLTableCreationStr << "icao_code varchar(4) default NULL, ";
+        lSQLTableCreationStr << "faa_code varchar(4) default NULL, ";
+        lSQLTableCreationStr << "unlocode_code varchar(5) default NULL, ";
+        lSQLTableCreationStr << "uic_code integer default NULL, ";
+        lSQLTableCreationStr << "is_geonames varchar(1) default NULL, ";
+        lSQLTableCreationStr << "geoname_id integer default NULL, ";
+        lSQLTableCreationStr << "envelope_id integer default NULL, ";
+        lSQLTableCreationStr << "date_from date default NULL, ";
+        lSQLTableCreationStr << "date_until date default NULL, ";
+        lSQLTableCreationStr << "serialised_place text default NULL);";
+        ioSociSession << lSQLTableCreationStr.str();
+
+      } catch (std::exception const& lException) {
+        std::ostringstream errorStr;
+        errorStr << "Error when trying to create PostgreSQL tables: "
+                 << lException.what();
+        OPENTREP_LOG_ERROR (errorStr.str());
+        throw SQLDatabaseTableCreationException (errorStr.str());
+      }
+
+      // DEBUG
+      OPENTREP_LOG_DEBUG ("The optd_por table has been created in the PostgreSQL database");
       break;
     }      
 
@@ -707,7 +841,7 @@ namespace OPENTREP {
            envelope_id int(11) default NULL,
            date_from date default NULL,
            date_until date default NULL,
-           serialised_place varchar(12000) default NULL);
+           serialised_place mediumtext default NULL);
         */
 
         ioSociSession << "drop table if exists optd_por;";
@@ -725,7 +859,7 @@ namespace OPENTREP {
         lSQLTableCreationStr << "envelope_id int(11) default NULL, ";
         lSQLTableCreationStr << "date_from date default NULL, ";
         lSQLTableCreationStr << "date_until date default NULL, ";
-        lSQLTableCreationStr << "serialised_place varchar(12000) default NULL); ";
+        lSQLTableCreationStr << "serialised_place mediumtext default NULL); ";
         ioSociSession << lSQLTableCreationStr.str();
 
       } catch (std::exception const& lException) {
@@ -819,8 +953,54 @@ namespace OPENTREP {
     }
 
     case DBType::PG: {
-      // TODO
-      
+      // DEBUG
+      OPENTREP_LOG_DEBUG ("Create the indices for the PostgreSQL database");
+        
+      try {
+
+        /**
+         * SQL DDL (Data Definition Language) queries for PostgreSQL:
+         * ----------------------------------------------------------
+         create unique index optd_por_pk on optd_por (pk);
+         create index optd_por_iata_code on optd_por (iata_code);
+         create index optd_por_iata_date on optd_por (iata_code, date_from, date_until);
+         create index optd_por_icao_code on optd_por (icao_code);
+         create index optd_por_geonameid on optd_por (geoname_id);
+         create index optd_por_unlocode_code on optd_por (unlocode_code);
+         create index optd_por_uic_code on optd_por (uic_code);
+         analyze optd_por;
+        */
+
+        ioSociSession
+          << "create unique index optd_por_pk on optd_por (pk);";
+        ioSociSession
+          << "create index optd_por_iata_code on optd_por (iata_code);";
+        ioSociSession
+          << "create index optd_por_iata_date on optd_por (iata_code, date_from, date_until);";
+        ioSociSession
+          << "create index optd_por_icao_code on optd_por (icao_code);";
+        ioSociSession
+          << "create index optd_por_geonameid on optd_por (geoname_id);";
+        ioSociSession
+          << "create index optd_por_unlocode_code on optd_por (unlocode_code);";
+        ioSociSession
+          << "create index optd_por_uic_code on optd_por (uic_code);";
+
+        // The statistics of the freshly loaded table are needed by the
+        // planner to pick up the indexes
+        ioSociSession << "analyze optd_por;";
+
+      } catch (std::exception const& lException) {
+        std::ostringstream errorStr;
+        errorStr << "Error when trying to create PostgreSQL indices: "
+                 << lException.what();
+        OPENTREP_LOG_ERROR (errorStr.str());
+        throw SQLDatabaseIndexCreationException (errorStr.str());
+      }
+
+      // DEBUG
+      OPENTREP_LOG_DEBUG ("The indices have been created "
+                          "for the PostgreSQL database");
       break;
     }
       
@@ -941,8 +1121,6 @@ namespace OPENTREP {
                            soci::use (iIataCode),
                            soci::into (ioSerialisedPlaceStr));
 
-      // Execute the SQL query
-      ioSelectStatement.execute();
 
     } catch (std::exception const& lException) {
       std::ostringstream errorStr;
@@ -973,8 +1151,6 @@ namespace OPENTREP {
                            soci::use (iIcaoCode),
                            soci::into (ioSerialisedPlaceStr));
 
-      // Execute the SQL query
-      ioSelectStatement.execute();
 
     } catch (std::exception const& lException) {
       std::ostringstream errorStr;
@@ -1005,8 +1181,6 @@ namespace OPENTREP {
                            soci::use (iFaaCode),
                            soci::into (ioSerialisedPlaceStr));
 
-      // Execute the SQL query
-      ioSelectStatement.execute();
 
     } catch (std::exception const& lException) {
       std::ostringstream errorStr;
@@ -1037,8 +1211,6 @@ namespace OPENTREP {
                            soci::use (iUNLOCode),
                            soci::into (ioSerialisedPlaceStr));
 
-      // Execute the SQL query
-      ioSelectStatement.execute();
 
     } catch (std::exception const& lException) {
       std::ostringstream errorStr;
@@ -1069,8 +1241,6 @@ namespace OPENTREP {
                            soci::use (iUICCode),
                            soci::into (ioSerialisedPlaceStr));
 
-      // Execute the SQL query
-      ioSelectStatement.execute();
 
     } catch (std::exception const& lException) {
       std::ostringstream errorStr;
@@ -1101,8 +1271,6 @@ namespace OPENTREP {
                            soci::use (iGeonameID),
                            soci::into (ioSerialisedPlaceStr));
 
-      // Execute the SQL query
-      ioSelectStatement.execute();
 
     } catch (std::exception const& lException) {
       std::ostringstream errorStr;
@@ -1114,6 +1282,82 @@ namespace OPENTREP {
     }
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  soci::statement& DBManager::
+  getSelectBlobStatement (DBConnection& ioDBConnection,
+                          const DBConnection::EN_StatementType& iStmtType) {
+    // Re-use the statement, when already prepared on that connection
+    soci::statement* oSelectStatement_ptr =
+      ioDBConnection.findStatement (iStmtType);
+    if (oSelectStatement_ptr != NULL) {
+      return *oSelectStatement_ptr;
+    }
+
+    // Prepare the statement, binding it to the buffers of the connection
+    soci::session& lSociSession = ioDBConnection.getSession();
+    oSelectStatement_ptr = new soci::statement (lSociSession);
+    assert (oSelectStatement_ptr != NULL);
+    soci::statement& lSelectStatement = *oSelectStatement_ptr;
+    std::string& lSerialisedPlaceStr =
+      ioDBConnection.getSerialisedPlaceBuffer();
+
+    try {
+
+      switch (iStmtType) {
+      case DBConnection::SELECT_ON_IATA_CODE: {
+        prepareSelectBlobOnIataCodeStatement (lSociSession, lSelectStatement,
+                                              ioDBConnection.getCodeBuffer(),
+                                              lSerialisedPlaceStr);
+        break;
+      }
+      case DBConnection::SELECT_ON_ICAO_CODE: {
+        prepareSelectBlobOnIcaoCodeStatement (lSociSession, lSelectStatement,
+                                              ioDBConnection.getCodeBuffer(),
+                                              lSerialisedPlaceStr);
+        break;
+      }
+      case DBConnection::SELECT_ON_FAA_CODE: {
+        prepareSelectBlobOnFaaCodeStatement (lSociSession, lSelectStatement,
+                                             ioDBConnection.getCodeBuffer(),
+                                             lSerialisedPlaceStr);
+        break;
+      }
+      case DBConnection::SELECT_ON_UNLO_CODE: {
+        prepareSelectBlobOnUNLOCodeStatement (lSociSession, lSelectStatement,
+                                              ioDBConnection.getCodeBuffer(),
+                                              lSerialisedPlaceStr);
+        break;
+      }
+      case DBConnection::SELECT_ON_UIC_CODE: {
+        prepareSelectBlobOnUICCodeStatement (lSociSession, lSelectStatement,
+                                             ioDBConnection.getUICCodeBuffer(),
+                                             lSerialisedPlaceStr);
+        break;
+      }
+      case DBConnection::SELECT_ON_GEONAMES_ID: {
+        prepareSelectBlobOnPlaceGeoIDStatement (lSociSession, lSelectStatement,
+                                                ioDBConnection.
+                                                getGeonamesIDBuffer(),
+                                                lSerialisedPlaceStr);
+        break;
+      }
+      default: {
+        assert (false);
+        break;
+      }
+      }
+
+    } catch (...) {
+      delete oSelectStatement_ptr; oSelectStatement_ptr = NULL;
+      throw;
+    }
+
+    // The connection takes the ownership of the statement
+    ioDBConnection.addStatement (iStmtType, lSelectStatement);
+
+    return lSelectStatement;
+  }
+
   // //////////////////////////////////////////////////////////////////////
   bool DBManager::iterateOnStatement (soci::statement& ioStatement,
                                       const std::string& iSerialisedPlaceStr) {
@@ -1135,9 +1379,21 @@ namespace OPENTREP {
     return hasStillData;
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  std::string DBManager::getSerialisedPlace (const Place& iPlace,
+                                             const DocumentFormat& iFormat) {
+    if (iFormat == DocumentFormat::BINARY) {
+      const std::string& lData =
+        LocationSerialiser::serialise (iPlace.getLocation());
+      return LocationSerialiser::encodeAsText (lData);
+    }
+    return iPlace.getRawDataString();
+  }
+
   // //////////////////////////////////////////////////////////////////////
   void DBManager::insertPlaceInDB (soci::session& ioSociSession,
-                                   const Place& iPlace) {
+                                   const Place& iPlace,
+                                   const DocumentFormat& iDocumentFormat) {
   
     try {
     
@@ -1161,7 +1417,8 @@ namespace OPENTREP {
         boost::gregorian::to_iso_extended_string (iPlace.getDateFrom());
       const std::string lDateEnd =
         boost::gregorian::to_iso_extended_string (iPlace.getDateEnd());
-      const std::string lRawDataString (iPlace.getRawDataString());
+      const std::string lRawDataString (getSerialisedPlace (iPlace,
+                                                            iDocumentFormat));
 
       /**
        * Sometimes, there are several UN/LOCODE codes for a single POR,
@@ -1354,7 +1611,7 @@ namespace OPENTREP {
   }
 
   // //////////////////////////////////////////////////////////////////////
-  NbOfDBEntries_T DBManager::getPORByIATACode (soci::session& ioSociSession,
+  NbOfDBEntries_T DBManager::getPORByIATACode (DBConnection& ioDBConnection,
                                                const IATACode_T& iIataCode,
                                                LocationList_T& ioLocationList,
                                                const bool iUniqueEntry) {
@@ -1369,13 +1626,15 @@ namespace OPENTREP {
       const std::string& lCode = static_cast<const std::string&> (iIataCode);
       const std::string lCodeUpper = boost::algorithm::to_upper_copy (lCode);
       
-      // Prepare the SQL request corresponding to the select statement
-      soci::statement lSelectStatement (ioSociSession);
-      std::string lPlaceRawDataString;
-      DBManager::prepareSelectBlobOnIataCodeStatement (ioSociSession,
-                                                       lSelectStatement,
-                                                       lCodeUpper,
-                                                       lPlaceRawDataString);
+      // Retrieve the SQL select statement, prepared only once per
+      // connection, and execute it on the given key
+      soci::statement& lSelectStatement =
+        getSelectBlobStatement (ioDBConnection,
+                                DBConnection::SELECT_ON_IATA_CODE);
+      ioDBConnection.getCodeBuffer() = lCodeUpper;
+      lSelectStatement.execute();
+      const std::string& lPlaceRawDataString =
+        ioDBConnection.getSerialisedPlaceBuffer();
 
       /**
        * Retrieve the details of the place, as well as the alternate
@@ -1411,6 +1670,9 @@ namespace OPENTREP {
       }
       
     } catch (std::exception const& lException) {
+      // The connection may have been lost: it is re-opened at its next lease
+      ioDBConnection.invalidate();
+
       std::ostringstream errorStr;
       errorStr << "Error when trying to retrieve a POR for " << iIataCode
                << " from the SQL database: " << lException.what();
@@ -1468,7 +1730,7 @@ namespace OPENTREP {
   }
 
   // //////////////////////////////////////////////////////////////////////
-  NbOfDBEntries_T DBManager::getPORByICAOCode (soci::session& ioSociSession,
+  NbOfDBEntries_T DBManager::getPORByICAOCode (DBConnection& ioDBConnection,
                                                const ICAOCode_T& iIcaoCode,
                                                LocationList_T& ioLocationList) {
     NbOfDBEntries_T oNbOfEntries = 0;
@@ -1481,13 +1743,15 @@ namespace OPENTREP {
       const std::string& lCode = static_cast<const std::string&> (iIcaoCode);
       const std::string lCodeUpper = boost::algorithm::to_upper_copy (lCode);
       
-      // Prepare the SQL request corresponding to the select statement
-      soci::statement lSelectStatement (ioSociSession);
-      std::string lPlaceRawDataString;
-      DBManager::prepareSelectBlobOnIcaoCodeStatement (ioSociSession,
-                                                       lSelectStatement,
-                                                       lCodeUpper,
-                                                       lPlaceRawDataString);
+      // Retrieve the SQL select statement, prepared only once per
+      // connection, and execute it on the given key
+      soci::statement& lSelectStatement =
+        getSelectBlobStatement (ioDBConnection,
+                                DBConnection::SELECT_ON_ICAO_CODE);
+      ioDBConnection.getCodeBuffer() = lCodeUpper;
+      lSelectStatement.execute();
+      const std::string& lPlaceRawDataString =
+        ioDBConnection.getSerialisedPlaceBuffer();
 
       /**
        * Retrieve the details of the place, as well as the alternate
@@ -1522,6 +1786,9 @@ namespace OPENTREP {
       }
       
     } catch (std::exception const& lException) {
+      // The connection may have been lost: it is re-opened at its next lease
+      ioDBConnection.invalidate();
+
       std::ostringstream errorStr;
       errorStr << "Error when trying to retrieve a POR for " << iIcaoCode
                << " from the SQL database: " << lException.what();
@@ -1534,7 +1801,7 @@ namespace OPENTREP {
   }
 
   // //////////////////////////////////////////////////////////////////////
-  NbOfDBEntries_T DBManager::getPORByFAACode (soci::session& ioSociSession,
+  NbOfDBEntries_T DBManager::getPORByFAACode (DBConnection& ioDBConnection,
                                               const FAACode_T& iFaaCode,
                                               LocationList_T& ioLocationList) {
     NbOfDBEntries_T oNbOfEntries = 0;
@@ -1547,13 +1814,15 @@ namespace OPENTREP {
       const std::string& lCode = static_cast<const std::string&> (iFaaCode);
       const std::string lCodeUpper = boost::algorithm::to_upper_copy (lCode);
       
-      // Prepare the SQL request corresponding to the select statement
-      soci::statement lSelectStatement (ioSociSession);
-      std::string lPlaceRawDataString;
-      DBManager::prepareSelectBlobOnFaaCodeStatement (ioSociSession,
-                                                      lSelectStatement,
-                                                      lCodeUpper,
-                                                      lPlaceRawDataString);
+      // Retrieve the SQL select statement, prepared only once per
+      // connection, and execute it on the given key
+      soci::statement& lSelectStatement =
+        getSelectBlobStatement (ioDBConnection,
+                                DBConnection::SELECT_ON_FAA_CODE);
+      ioDBConnection.getCodeBuffer() = lCodeUpper;
+      lSelectStatement.execute();
+      const std::string& lPlaceRawDataString =
+        ioDBConnection.getSerialisedPlaceBuffer();
 
       /**
        * Retrieve the details of the place, as well as the alternate
@@ -1588,6 +1857,9 @@ namespace OPENTREP {
       }
       
     } catch (std::exception const& lException) {
+      // The connection may have been lost: it is re-opened at its next lease
+      ioDBConnection.invalidate();
+
       std::ostringstream errorStr;
       errorStr << "Error when trying to retrieve a POR for " << iFaaCode
                << " from the SQL database: " << lException.what();
@@ -1600,7 +1872,7 @@ namespace OPENTREP {
   }
 
   // //////////////////////////////////////////////////////////////////////
-  NbOfDBEntries_T DBManager::getPORByUNLOCode (soci::session& ioSociSession,
+  NbOfDBEntries_T DBManager::getPORByUNLOCode (DBConnection& ioDBConnection,
                                                const UNLOCode_T& iUNLOCode,
                                                LocationList_T& ioLocationList,
                                                const bool iUniqueEntry) {
@@ -1615,13 +1887,15 @@ namespace OPENTREP {
       const std::string& lCode = static_cast<const std::string&> (iUNLOCode);
       const std::string lCodeUpper = boost::algorithm::to_upper_copy (lCode);
       
-      // Prepare the SQL request corresponding to the select statement
-      soci::statement lSelectStatement (ioSociSession);
-      std::string lPlaceRawDataString;
-      DBManager::prepareSelectBlobOnUNLOCodeStatement (ioSociSession,
-                                                       lSelectStatement,
-                                                       lCodeUpper,
-                                                       lPlaceRawDataString);
+      // Retrieve the SQL select statement, prepared only once per
+      // connection, and execute it on the given key
+      soci::statement& lSelectStatement =
+        getSelectBlobStatement (ioDBConnection,
+                                DBConnection::SELECT_ON_UNLO_CODE);
+      ioDBConnection.getCodeBuffer() = lCodeUpper;
+      lSelectStatement.execute();
+      const std::string& lPlaceRawDataString =
+        ioDBConnection.getSerialisedPlaceBuffer();
 
       /**
        * Retrieve the details of the place, as well as the alternate
@@ -1657,6 +1931,9 @@ namespace OPENTREP {
       }
       
     } catch (std::exception const& lException) {
+      // The connection may have been lost: it is re-opened at its next lease
+      ioDBConnection.invalidate();
+
       std::ostringstream errorStr;
       errorStr << "Error when trying to retrieve a POR for " << iUNLOCode
                << " from the SQL database: " << lException.what();
@@ -1707,20 +1984,22 @@ namespace OPENTREP {
   }
 
   // //////////////////////////////////////////////////////////////////////
-  NbOfDBEntries_T DBManager::getPORByUICCode (soci::session& ioSociSession,
+  NbOfDBEntries_T DBManager::getPORByUICCode (DBConnection& ioDBConnection,
                                               const UICCode_T& iUICCode,
                                               LocationList_T& ioLocationList) {
     NbOfDBEntries_T oNbOfEntries = 0;
 
     try {
 
-      // Prepare the SQL request corresponding to the select statement
-      soci::statement lSelectStatement (ioSociSession);
-      std::string lPlaceRawDataString;
-      DBManager::prepareSelectBlobOnUICCodeStatement (ioSociSession,
-                                                      lSelectStatement,
-                                                      iUICCode,
-                                                      lPlaceRawDataString);
+      // Retrieve the SQL select statement, prepared only once per
+      // connection, and execute it on the given key
+      soci::statement& lSelectStatement =
+        getSelectBlobStatement (ioDBConnection,
+                                DBConnection::SELECT_ON_UIC_CODE);
+      ioDBConnection.getUICCodeBuffer() = iUICCode;
+      lSelectStatement.execute();
+      const std::string& lPlaceRawDataString =
+        ioDBConnection.getSerialisedPlaceBuffer();
 
       /**
        * Retrieve the details of the place, as well as the alternate
@@ -1758,6 +2037,9 @@ namespace OPENTREP {
       }
       
     } catch (std::exception const& lException) {
+      // The connection may have been lost: it is re-opened at its next lease
+      ioDBConnection.invalidate();
+
       std::ostringstream errorStr;
       errorStr << "Error when trying to retrieve a POR for " << iUICCode
                << " from the SQL database: " << lException.what();
@@ -1770,20 +2052,22 @@ namespace OPENTREP {
   }
 
   // //////////////////////////////////////////////////////////////////////
-  NbOfDBEntries_T DBManager::getPORByGeonameID (soci::session& ioSociSession,
+  NbOfDBEntries_T DBManager::getPORByGeonameID (DBConnection& ioDBConnection,
                                                 const GeonamesID_T& iGeonameID,
                                                 LocationList_T& ioLocationList) {
     NbOfDBEntries_T oNbOfEntries = 0;
 
     try {
 
-      // Prepare the SQL request corresponding to the select statement
-      soci::statement lSelectStatement (ioSociSession);
-      std::string lPlaceRawDataString;
-      DBManager::prepareSelectBlobOnPlaceGeoIDStatement (ioSociSession,
-                                                         lSelectStatement,
-                                                         iGeonameID,
-                                                         lPlaceRawDataString);
+      // Retrieve the SQL select statement, prepared only once per
+      // connection, and execute it on the given key
+      soci::statement& lSelectStatement =
+        getSelectBlobStatement (ioDBConnection,
+                                DBConnection::SELECT_ON_GEONAMES_ID);
+      ioDBConnection.getGeonamesIDBuffer() = iGeonameID;
+      lSelectStatement.execute();
+      const std::string& lPlaceRawDataString =
+        ioDBConnection.getSerialisedPlaceBuffer();
 
       /**
        * Retrieve the details of the place, as well as the alternate
@@ -1820,6 +2104,9 @@ namespace OPENTREP {
       }
       
     } catch (std::exception const& lException) {
+      // The connection may have been lost: it is re-opened at its next lease
+      ioDBConnection.invalidate();
+
       std::ostringstream errorStr;
       errorStr << "Error when trying to retrieve a POR for " << iGeonameID
                << " from the SQL database: " << lException.what();
@@ -1831,4 +2118,278 @@ namespace OPENTREP {
     return oNbOfEntries;
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  std::string DBManager::getKey (const DBConnection::EN_StatementType& iKeyType,
+                                 const Location& iLocation) {
+    std::string oKey ("");
+
+    switch (iKeyType) {
+    case DBConnection::SELECT_ON_IATA_CODE: {
+      oKey = static_cast<const std::string&> (iLocation.getIataCode());
+      break;
+    }
+    case DBConnection::SELECT_ON_ICAO_CODE: {
+      oKey = static_cast<const std::string&> (iLocation.getIcaoCode());
+      break;
+    }
+    case DBConnection::SELECT_ON_UNLO_CODE: {
+      // Only the first UN/LOCODE code is stored in the SQL database
+      // (see insertPlaceInDB())
+      const UNLOCodeList_T& lUNLOCodeList = iLocation.getUNLOCodeList();
+      if (lUNLOCodeList.empty() == false) {
+        oKey = static_cast<const std::string&> (lUNLOCodeList.front());
+      }
+      break;
+    }
+    case DBConnection::SELECT_ON_GEONAMES_ID: {
+      oKey = boost::lexical_cast<std::string> (iLocation.getGeonamesID());
+      break;
+    }
+    default: {
+      assert (false);
+      break;
+    }
+    }
+
+    return oKey;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfDBEntries_T DBManager::
+  getPORByKeyList (DBConnection& ioDBConnection,
+                   const DBConnection::EN_StatementType& iKeyType,
+                   const WordList_T& iKeyList,
+                   LocationListList_T& ioLocationListList,
+                   const bool iUniqueEntry) {
+    NbOfDBEntries_T oNbOfEntries = 0;
+    ioLocationListList.clear();
+    ioLocationListList.resize (iKeyList.size());
+
+    // Retrieve the name of the column holding the key, and the way the POR
+    // with the highest Page Rank is selected, when a unique entry is
+    // expected. As with getPORByIATACode(), the last of the POR having the
+    // same Page Rank value, possibly zero, is selected for an IATA code.
+    // As with getPORByUNLOCode(), the first one is selected for a UN/LOCODE
+    // code, and a POR with a zero Page Rank value is never selected
+    std::string lColumnName ("");
+    bool lIsLastOfEqualPRSelected = true;
+    switch (iKeyType) {
+    case DBConnection::SELECT_ON_IATA_CODE: {
+      lColumnName = "iata_code";
+      break;
+    }
+    case DBConnection::SELECT_ON_ICAO_CODE: {
+      lColumnName = "icao_code";
+      break;
+    }
+    case DBConnection::SELECT_ON_UNLO_CODE: {
+      lColumnName = "unlocode_code";
+      lIsLastOfEqualPRSelected = false;
+      break;
+    }
+    case DBConnection::SELECT_ON_GEONAMES_ID: {
+      lColumnName = "geoname_id";
+      break;
+    }
+    default: {
+      assert (false);
+      break;
+    }
+    }
+
+    // Convert the keys into uppercase (as the codes are stored uppercase
+    // in the database), and bind every distinct key only once
+    std::vector<std::string> lUpperKeyList;
+    std::vector<std::string> lBoundKeyList;
+    for (WordList_T::const_iterator itKey = iKeyList.begin();
+         itKey != iKeyList.end(); ++itKey) {
+      const std::string lKeyUpper = boost::algorithm::to_upper_copy (*itKey);
+      lUpperKeyList.push_back (lKeyUpper);
+      if (std::find (lBoundKeyList.begin(), lBoundKeyList.end(), lKeyUpper)
+          == lBoundKeyList.end()) {
+        lBoundKeyList.push_back (lKeyUpper);
+      }
+    }
+
+    if (lBoundKeyList.empty() == true) {
+      return oNbOfEntries;
+    }
+
+    // Locations retrieved from the SQL database, grouped by key
+    typedef std::map<std::string, LocationList_T> LocationListMap_T;
+    LocationListMap_T lLocationListMap;
+
+    try {
+
+      /**
+         select serialised_place from optd_por
+         where iata_code in (:key0, :key1, ...);
+      */
+      std::ostringstream lSQLSelectStr;
+      lSQLSelectStr << "select serialised_place from optd_por where "
+                    << lColumnName << " in (";
+      for (std::size_t idx = 0; idx != lBoundKeyList.size(); ++idx) {
+        if (idx != 0) {
+          lSQLSelectStr << ", ";
+        }
+        lSQLSelectStr << ":key" << idx;
+      }
+      lSQLSelectStr << ")";
+
+      // The number of bound keys varying from one call to another, the SQL
+      // statement is prepared for that call only
+      soci::session& lSociSession = ioDBConnection.getSession();
+      soci::statement lSelectStatement (lSociSession);
+      std::string lPlaceRawDataString;
+      lSelectStatement.exchange (soci::into (lPlaceRawDataString));
+      for (std::vector<std::string>::const_iterator itKey =
+             lBoundKeyList.begin(); itKey != lBoundKeyList.end(); ++itKey) {
+        lSelectStatement.exchange (soci::use (*itKey));
+      }
+      lSelectStatement.alloc();
+      lSelectStatement.prepare (lSQLSelectStr.str());
+      lSelectStatement.define_and_bind();
+      lSelectStatement.execute();
+
+      /**
+       * Retrieve the details of the places, and group them by key.
+       */
+      bool hasStillData = true;
+      while (hasStillData == true) {
+        hasStillData = iterateOnStatement (lSelectStatement,
+                                           lPlaceRawDataString);
+
+        if (hasStillData == true) {
+          // Parse the POR details and create the corresponding
+          // Location structure
+          const RawDataString_T lPlaceRawData (lPlaceRawDataString);
+          const Location& lLocation = Result::retrieveLocation (lPlaceRawData);
+          const std::string& lKey = getKey (iKeyType, lLocation);
+          lLocationListMap[lKey].push_back (lLocation);
+
+          // Debug
+          OPENTREP_LOG_DEBUG ("[" << lKey << "] " << lLocation);
+        }
+      }
+
+    } catch (std::exception const& lException) {
+      // The connection may have been lost: it is re-opened at its next lease
+      ioDBConnection.invalidate();
+
+      std::ostringstream errorStr;
+      errorStr << "Error when trying to retrieve the POR for the "
+               << lBoundKeyList.size() << " keys (" << lColumnName
+               << ") from the SQL database: " << lException.what();
+      OPENTREP_LOG_ERROR (errorStr.str());
+      throw SQLDatabaseException (errorStr.str());
+    }
+
+    // Dispatch the retrieved Location structures per key, in the order
+    // of the given keys
+    LocationListList_T::iterator itLocationList = ioLocationListList.begin();
+    std::vector<std::string>::const_iterator itKeyUpper =
+      lUpperKeyList.begin();
+    for (WordList_T::const_iterator itKey = iKeyList.begin();
+         itKey != iKeyList.end(); ++itKey, ++itKeyUpper, ++itLocationList) {
+      const std::string& lKey = *itKey;
+      LocationList_T& lKeyLocationList = *itLocationList;
+
+      LocationListMap_T::const_iterator itLocationListMap =
+        lLocationListMap.find (*itKeyUpper);
+      if (itLocationListMap == lLocationListMap.end()) {
+        continue;
+      }
+      const LocationList_T& lLocationList = itLocationListMap->second;
+
+      // Store (a pointer on) the Location structure with the highest
+      // Page Rank (see above for the equal and zero Page Rank values)
+      const Location* lHighestPRLocation_ptr = NULL;
+      PageRank_T lHighestPRValue = 0.0;
+      for (LocationList_T::const_iterator itLoc = lLocationList.begin();
+           itLoc != lLocationList.end(); ++itLoc) {
+        const Location& lLocation = *itLoc;
+        const PageRank_T& lPRValue = lLocation.getPageRank();
+        const bool isHigherPR = (lIsLastOfEqualPRSelected == true) ?
+          (lPRValue >= lHighestPRValue) : (lPRValue > lHighestPRValue);
+        if (isHigherPR == true) {
+          lHighestPRLocation_ptr = &lLocation;
+          lHighestPRValue = lPRValue;
+        }
+
+        // Add the Location structure now, only when a unique solution
+        // is not expected
+        if (iUniqueEntry == false) {
+          lKeyLocationList.push_back (lLocation);
+          lKeyLocationList.back().setCorrectedKeywords (lKey);
+          ++oNbOfEntries;
+        }
+      }
+
+      // Add the Location structure with the highest Page Rank value
+      if (iUniqueEntry == true && lHighestPRLocation_ptr != NULL) {
+        lKeyLocationList.push_back (*lHighestPRLocation_ptr);
+        lKeyLocationList.back().setCorrectedKeywords (lKey);
+        ++oNbOfEntries;
+
+        // DEBUG
+        OPENTREP_LOG_DEBUG ("Kept the location with the highest PageRank "
+                            << "value (" << lHighestPRValue << ") for '"
+                            << lKey << "': "
+                            << lHighestPRLocation_ptr->getKey());
+      }
+    }
+
+    //
+    return oNbOfEntries;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfDBEntries_T DBManager::
+  getPORByIATACodeList (DBConnection& ioDBConnection,
+                        const IATACodeList_T& iIataCodeList,
+                        LocationListList_T& ioLocationListList,
+                        const bool iUniqueEntry) {
+    const WordList_T lKeyList (iIataCodeList.begin(), iIataCodeList.end());
+    return getPORByKeyList (ioDBConnection, DBConnection::SELECT_ON_IATA_CODE,
+                            lKeyList, ioLocationListList, iUniqueEntry);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfDBEntries_T DBManager::
+  getPORByICAOCodeList (DBConnection& ioDBConnection,
+                        const ICAOCodeList_T& iIcaoCodeList,
+                        LocationListList_T& ioLocationListList) {
+    const WordList_T lKeyList (iIcaoCodeList.begin(), iIcaoCodeList.end());
+    const bool lUniqueEntry = false;
+    return getPORByKeyList (ioDBConnection, DBConnection::SELECT_ON_ICAO_CODE,
+                            lKeyList, ioLocationListList, lUniqueEntry);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfDBEntries_T DBManager::
+  getPORByUNLOCodeList (DBConnection& ioDBConnection,
+                        const UNLOCodeList_T& iUNLOCodeList,
+                        LocationListList_T& ioLocationListList,
+                        const bool iUniqueEntry) {
+    const WordList_T lKeyList (iUNLOCodeList.begin(), iUNLOCodeList.end());
+    return getPORByKeyList (ioDBConnection, DBConnection::SELECT_ON_UNLO_CODE,
+                            lKeyList, ioLocationListList, iUniqueEntry);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfDBEntries_T DBManager::
+  getPORByGeonameIDList (DBConnection& ioDBConnection,
+                         const GeonamesIDList_T& iGeonameIDList,
+                         LocationListList_T& ioLocationListList) {
+    WordList_T lKeyList;
+    for (GeonamesIDList_T::const_iterator itGeonameID = iGeonameIDList.begin();
+         itGeonameID != iGeonameIDList.end(); ++itGeonameID) {
+      lKeyList.push_back (boost::lexical_cast<std::string> (*itGeonameID));
+    }
+    const bool lUniqueEntry = false;
+    return getPORByKeyList (ioDBConnection,
+                            DBConnection::SELECT_ON_GEONAMES_ID,
+                            lKeyList, ioLocationListList, lUniqueEntry);
+  }
+
 }
@@ -4,11 +4,15 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// STL
+#include <vector>
 // OpenTrep
 #include <opentrep/OPENTREP_Types.hpp>
 #include <opentrep/Location.hpp>
 #include <opentrep/DBType.hpp>
+#include <opentrep/DocumentFormat.hpp>
 #include <opentrep/bom/PlaceList.hpp>
+#include <opentrep/command/DBConnection.hpp>
 
 // Forward declarations
 namespace soci {
@@ -21,6 +25,11 @@ namespace OPENTREP {
   // Forward declarations
   struct PlaceKey;
 
+  /**
+   * List of lists of (geographical) locations, one per code of a batched
+   * look up, in the same order as those codes.
+   */
+  typedef std::vector<LocationList_T> LocationListList_T;
 
   /**
    * @brief Class wrapping the access to an underlying SQL database.
@@ -149,14 +158,15 @@ namespace OPENTREP {
      * the city. If so required (by setting the corresponding parameter),
      * the entry having the greatest Page Rank will be returned.
      *
-     * @param const SQLDBConnectionString_T& Connection string to the SQL DB.
+     * @param DBConnection& Pooled connection to the SQL database, on which
+     *        the SQL statement is prepared only once.
      * @param const IATACode_T& The IATA code (key) of the POR to be retrieved.
      * @param LocationList_T& List of (geographical) locations, if any,
      *                        matching the given key.
      * @param const bool States whether a unique entry should be returned.
      * @return NbOfDBEntries_T Number of documents of the SQL database.
      */
-    static NbOfDBEntries_T getPORByIATACode (soci::session&, const IATACode_T&,
+    static NbOfDBEntries_T getPORByIATACode (DBConnection&, const IATACode_T&,
                                              LocationList_T&,
                                              const bool iUniqueEntry);
 
@@ -164,33 +174,36 @@ namespace OPENTREP {
      * Get the POR (point of reference), from the SQL database, corresponding
      * to the given ICAO code.
      *
-     * @param const SQLDBConnectionString_T& Connection string to the SQL DB.
+     * @param DBConnection& Pooled connection to the SQL database, on which
+     *        the SQL statement is prepared only once.
      * @param const ICAOCode_T& The ICAO code (key) of the POR to be retrieved.
      * @param LocationList_T& List of (geographical) locations, if any,
      *                        matching the given key.
      * @return NbOfDBEntries_T Number of documents of the SQL database.
      */
-    static NbOfDBEntries_T getPORByICAOCode (soci::session&, const ICAOCode_T&,
+    static NbOfDBEntries_T getPORByICAOCode (DBConnection&, const ICAOCode_T&,
                                              LocationList_T&);
 
     /**
      * Get the POR (point of reference), from the SQL database, corresponding
      * to the given FAA code.
      *
-     * @param const SQLDBConnectionString_T& Connection string to the SQL DB.
+     * @param DBConnection& Pooled connection to the SQL database, on which
+     *        the SQL statement is prepared only once.
      * @param const FAACode_T& The FAA code (key) of the POR to be retrieved.
      * @param LocationList_T& List of (geographical) locations, if any,
      *                        matching the given key.
      * @return NbOfDBEntries_T Number of documents of the SQL database.
      */
-    static NbOfDBEntries_T getPORByFAACode (soci::session&, const FAACode_T&,
+    static NbOfDBEntries_T getPORByFAACode (DBConnection&, const FAACode_T&,
                                             LocationList_T&);
 
     /**
      * Get the POR (point of reference), from the SQL database, corresponding
      * to the given UN/LOCODE code.
      *
-     * @param const SQLDBConnectionString_T& Connection string to the SQL DB.
+     * @param DBConnection& Pooled connection to the SQL database, on which
+     *        the SQL statement is prepared only once.
      * @param const UNLOCode_T& The UN/LOCODE code (key) of the POR to be
                                 retrieved.
      * @param LocationList_T& List of (geographical) locations, if any,
@@ -198,7 +211,7 @@ namespace OPENTREP {
      * @param const bool States whether a unique entry should be returned.
      * @return NbOfDBEntries_T Number of documents of the SQL database.
      */
-    static NbOfDBEntries_T getPORByUNLOCode (soci::session&, const UNLOCode_T&,
+    static NbOfDBEntries_T getPORByUNLOCode (DBConnection&, const UNLOCode_T&,
                                              LocationList_T&,
                                              const bool iUniqueEntry);
 
@@ -206,38 +219,131 @@ namespace OPENTREP {
      * Get the POR (point of reference), from the SQL database, corresponding
      * to the given UIC code.
      *
-     * @param const SQLDBConnectionString_T& Connection string to the SQL DB.
+     * @param DBConnection& Pooled connection to the SQL database, on which
+     *        the SQL statement is prepared only once.
      * @param const UICCode_T& The UIC code (key) of the POR to be retrieved.
      * @param LocationList_T& List of (geographical) locations, if any,
      *                        matching the given key.
      * @return NbOfDBEntries_T Number of documents of the SQL database.
      */
-    static NbOfDBEntries_T getPORByUICCode (soci::session&, const UICCode_T&,
+    static NbOfDBEntries_T getPORByUICCode (DBConnection&, const UICCode_T&,
                                             LocationList_T&);
 
     /**
      * Get the POR (point of reference), from the SQL database, corresponding
      * to the given IATA code.
      *
-     * @param const SQLDBConnectionString_T& Connection string to the SQL DB.
+     * @param DBConnection& Pooled connection to the SQL database, on which
+     *        the SQL statement is prepared only once.
      * @param const GeonamesID_T& The GeonameID (key) of the POR
      *                            to be retrieved.
      * @param LocationList_T& List of (geographical) locations, if any,
      *                        matching the given key.
      * @return NbOfDBEntries_T Number of documents of the SQL database.
      */
-    static NbOfDBEntries_T getPORByGeonameID (soci::session&,
+    static NbOfDBEntries_T getPORByGeonameID (DBConnection&,
                                               const GeonamesID_T&,
                                               LocationList_T&);
 
+    /**
+     * Get the POR (point of reference), from the SQL database, corresponding
+     * to every IATA code of the given list, thanks to a single SQL request
+     * (where iata_code in (...)), instead of one per code.
+     *
+     * The retrieved POR are dispatched per code: the i-th list of locations
+     * corresponds to the i-th code. As for getPORByIATACode(), and if so
+     * required, only the entry having the greatest Page Rank is kept
+     * for every code.
+     *
+     * @param DBConnection& Pooled connection to the SQL database.
+     * @param const IATACodeList_T& The IATA codes (keys) of the POR to be
+     *                              retrieved.
+     * @param LocationListList_T& Lists of (geographical) locations, if any,
+     *                            matching every given key. It is resized
+     *                            to the number of keys.
+     * @param const bool States whether a unique entry should be returned
+     *                   for every key.
+     * @return NbOfDBEntries_T Number of retrieved documents, for all the keys.
+     */
+    static NbOfDBEntries_T getPORByIATACodeList (DBConnection&,
+                                                 const IATACodeList_T&,
+                                                 LocationListList_T&,
+                                                 const bool iUniqueEntry);
+
+    /**
+     * Get the POR (point of reference), from the SQL database, corresponding
+     * to every ICAO code of the given list, thanks to a single SQL request.
+     * See getPORByIATACodeList() for more details.
+     *
+     * @param DBConnection& Pooled connection to the SQL database.
+     * @param const ICAOCodeList_T& The ICAO codes (keys) of the POR to be
+     *                              retrieved.
+     * @param LocationListList_T& Lists of (geographical) locations, if any,
+     *                            matching every given key.
+     * @return NbOfDBEntries_T Number of retrieved documents, for all the keys.
+     */
+    static NbOfDBEntries_T getPORByICAOCodeList (DBConnection&,
+                                                 const ICAOCodeList_T&,
+                                                 LocationListList_T&);
+
+    /**
+     * Get the POR (point of reference), from the SQL database, corresponding
+     * to every UN/LOCODE code of the given list, thanks to a single SQL
+     * request. See getPORByIATACodeList() for more details.
+     *
+     * @param DBConnection& Pooled connection to the SQL database.
+     * @param const UNLOCodeList_T& The UN/LOCODE codes (keys) of the POR
+     *                              to be retrieved.
+     * @param LocationListList_T& Lists of (geographical) locations, if any,
+     *                            matching every given key.
+     * @param const bool States whether a unique entry should be returned
+     *                   for every key.
+     * @return NbOfDBEntries_T Number of retrieved documents, for all the keys.
+     */
+    static NbOfDBEntries_T getPORByUNLOCodeList (DBConnection&,
+                                                 const UNLOCodeList_T&,
+                                                 LocationListList_T&,
+                                                 const bool iUniqueEntry);
+
+    /**
+     * Get the POR (point of reference), from the SQL database, corresponding
+     * to every Geonames ID of the given list, thanks to a single SQL
+     * request. See getPORByIATACodeList() for more details.
+     *
+     * @param DBConnection& Pooled connection to the SQL database.
+     * @param const GeonamesIDList_T& The Geonames IDs (keys) of the POR
+     *                                to be retrieved.
+     * @param LocationListList_T& Lists of (geographical) locations, if any,
+     *                            matching every given key.
+     * @return NbOfDBEntries_T Number of retrieved documents, for all the keys.
+     */
+    static NbOfDBEntries_T getPORByGeonameIDList (DBConnection&,
+                                                  const GeonamesIDList_T&,
+                                                  LocationListList_T&);
+
     /**
      * Insert into the SQL database the document
      * corresponding to the given Place object.
      *
      * @param soci::session& SOCI session handler.
      * @param const Place& The place to be inserted.
+     * @param const DocumentFormat& Format of the serialised place.
+     */
+    static void insertPlaceInDB (soci::session&, const Place&,
+                                 const DocumentFormat&);
+
+    /**
+     * Get the serialised place, to be stored within the serialised_place
+     * column of the SQL database: either the raw POR line or the text form
+     * of the binary-encoded Location structure (see LocationSerialiser).
+     * Both are decoded by Result::retrieveLocation().
+     *
+     * @param const Place& The place to be serialised.
+     * @param const DocumentFormat& Format of the serialised place.
+     * @return std::string The serialised place.
      */
-    static void insertPlaceInDB (soci::session&, const Place&);
+    static std::string getSerialisedPlace (const Place&,
+                                           const DocumentFormat&);
 
     /**
      * Update the Xapian document ID field of the database row
@@ -288,7 +394,23 @@ namespace OPENTREP {
     
   private:
     /**
-     * Prepare (parse and put in cache) the SQL statement.
+     * Get the SQL select statement for the given kind of look up,
+     * as prepared on the given connection. When not prepared yet, it is
+     * prepared, bound to the buffers of the connection, and stored by
+     * that latter.
+     *
+     * @param DBConnection& Pooled connection to the SQL database.
+     * @param const DBConnection::EN_StatementType& Kind of look up.
+     * @return soci::statement& The prepared (not executed) statement.
+     */
+    static soci::statement&
+    getSelectBlobStatement (DBConnection&,
+                            const DBConnection::EN_StatementType&);
+
+    /**
+     * Prepare (parse and put in cache) the SQL statement. The statement
+     * is not executed, so that it may be executed for several codes,
+     * by changing the value of the bound code.
      *
      * @param soci::session& SOCI session handler.
      * @param soci::statement& SOCI SQL statement handler.
@@ -360,6 +482,44 @@ namespace OPENTREP {
                                             const GeonamesID_T&,
                                             std::string& ioSerialisedPlaceStr);
 
+    /**
+     * Get the POR (point of reference), from the SQL database, corresponding
+     * to every key of the given list, thanks to a single SQL request
+     * (e.g., where iata_code in (:key0, :key1, ...)). The retrieved POR are
+     * then dispatched per key, in the order of the given list.
+     *
+     * As the number of keys varies from one call to another, that SQL
+     * statement is not kept by the connection.
+     *
+     * @param DBConnection& Pooled connection to the SQL database.
+     * @param const DBConnection::EN_StatementType& Kind of look up, i.e.,
+     *        IATA, ICAO, UN/LOCODE code or Geonames ID.
+     * @param const WordList_T& The keys of the POR to be retrieved.
+     * @param LocationListList_T& Lists of (geographical) locations, if any,
+     *                            matching every given key.
+     * @param const bool States whether a unique entry should be returned
+     *                   for every key. The POR with the highest Page Rank
+     *                   is then selected the same way as by the look up on
+     *                   a single key (e.g., getPORByIATACode() or
+     *                   getPORByUNLOCode()).
+     * @return NbOfDBEntries_T Number of retrieved documents, for all the keys.
+     */
+    static NbOfDBEntries_T
+    getPORByKeyList (DBConnection&, const DBConnection::EN_StatementType&,
+                     const WordList_T&, LocationListList_T&,
+                     const bool iUniqueEntry);
+
+    /**
+     * Get the key, of the given kind, of the given location, in the same
+     * format as the one stored in the SQL database.
+     *
+     * @param const DBConnection::EN_StatementType& Kind of look up.
+     * @param const Location& The location.
+     * @return std::string The key of the location.
+     */
+    static std::string getKey (const DBConnection::EN_StatementType&,
+                               const Location&);
+
 
   private:
     /**
@@ -5,7 +5,16 @@
 #include <cassert>
 #include <string>
 #include <vector>
+#include <memory>
 #include <exception>
+#include <map>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <sstream>
 // Boost
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
@@ -19,7 +28,10 @@
 // Xapian
 #include <xapian.h>
 // OpenTrep
+#include <opentrep/basic/BasConst_General.hpp>
+#include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
 #include <opentrep/basic/OTransliterator.hpp>
+#include <opentrep/basic/NormalisationCache.hpp>
 #include <opentrep/basic/Utilities.hpp>
 #include <opentrep/bom/StringPartition.hpp>
 #include <opentrep/bom/WordCombinationHolder.hpp>
@@ -27,26 +39,30 @@
 #include <opentrep/bom/Place.hpp>
 #include <opentrep/bom/PORFileHelper.hpp>
 #include <opentrep/bom/PORParserHelper.hpp>
+#include <opentrep/bom/VocabularySketch.hpp>
+#include <opentrep/bom/LocationSerialiser.hpp>
 #include <opentrep/factory/FacPlace.hpp>
 #include <opentrep/factory/FacXapianDB.hpp>
 #include <opentrep/command/FileManager.hpp>
 #include <opentrep/command/DBManager.hpp>
+#include <opentrep/command/DBBulkLoader.hpp>
 #include <opentrep/command/IndexBuilder.hpp>
 #include <opentrep/service/Logger.hpp>
 
 namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
-  void addToXapian (const Place& iPlace, Xapian::Document& ioDocument,
-                    Xapian::WritableDatabase& ioDatabase) {
+  void addTermsToDocument (const Place& iPlace, Xapian::Document& ioDocument) {
     /**
      * Build a Xapian TermGenerator:
      * http://xapian.org/docs/apidoc/html/classXapian_1_1TermGenerator.html
      * It is an helper to insert terms into the Xapian index for the given
-     * document.
+     * document. As the spelling terms are added separately (see
+     * addSpellingsToXapian()), the TermGenerator does not need to be
+     * attached to the Xapian database, and may therefore be used by any
+     * indexing thread.
      */
     Xapian::TermGenerator lTermGenerator;
-    lTermGenerator.set_database (ioDatabase);
     lTermGenerator.set_document (ioDocument);
 
     // DEBUG
@@ -72,43 +88,129 @@ namespace OPENTREP {
       }
     }
 
-    // Spelling terms
-    const Place::StringSet_T& lSpellingSet = iPlace.getSpellingSet();
-    for (Place::StringSet_T::const_iterator itTerm = lSpellingSet.begin();
-         itTerm != lSpellingSet.end(); ++itTerm) {
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("Added terms for '" << iPlace.describeKey()
+                        << "': " << iPlace.describeSets()
+                        << " into " << ioDocument.get_description());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void addSpellingsToXapian (const Place::StringSet_T& iSpellingSet,
+                             Xapian::WritableDatabase& ioDatabase) {
+    for (Place::StringSet_T::const_iterator itTerm = iSpellingSet.begin();
+         itTerm != iSpellingSet.end(); ++itTerm) {
       const std::string& lTerm = *itTerm;
       ioDatabase.add_spelling (lTerm);
     }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void reportProgress (const NbOfDBEntries_T& iNbOfEntries,
+                       const NbOfDBEntries_T& iNbOfEntriesInPORFile) {
+    // The progress may be reported by several indexing threads (see the
+    // sharded indexation)
+    static std::mutex lProgressMutex;
+    std::lock_guard<std::mutex> lGuard (lProgressMutex);
+
+    std::cout.imbue (std::locale (std::locale::classic(), new NumSep));
+    std::cout << "Number of actually parsed records: " << iNbOfEntries
+              << ", out of " << iNbOfEntriesInPORFile
+              << " records in the POR data file so far" << std::endl;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void reportNormalisationStatistics (const NormalisationCache& iCache) {
+    // The statistics are reported by every indexing thread
+    static std::mutex lStatisticsMutex;
+    std::lock_guard<std::mutex> lGuard (lStatisticsMutex);
+
+    std::cout << "Unicode normalisations: " << iCache.describe() << std::endl;
 
     // DEBUG
-    OPENTREP_LOG_DEBUG ("Added terms for '" << iPlace.describeKey()
-                        << "': " << iPlace.describeSets()
-                        << " into " << ioDocument.get_description());
+    OPENTREP_LOG_DEBUG ("Unicode normalisations: " << iCache.describe());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void IndexBuilder::buildDocument (Xapian::Document& ioDocument,
+                                    Place& ioPlace,
+                                    const DocumentFormat& iDocumentFormat,
+                                    const NbOfWords_T& iMaxWordCombinationSpan,
+                                    NormalisationCache& ioNormalisationCache) {
+    const Location& lLocation = ioPlace.getLocation();
+    if (iDocumentFormat == DocumentFormat::BINARY) {
+      // The Xapian document data is the compact binary encoding of the
+      // Location structure, which the search process decodes much faster
+      // than it would parse the raw POR line
+      ioDocument.set_data (LocationSerialiser::serialise (lLocation));
+
+    } else {
+      // Retrieve the raw data string, to be stored as is within
+      // the Xapian document
+      const RawDataString_T& lRawDataString = ioPlace.getRawDataString();
+
+      // The Xapian document data is indeed the same as the one of the
+      // OPTD-maintained list of POR (points of reference), allowing the
+      // search process to use exactly the same parser as the indexation
+      // process
+      ioDocument.set_data (lRawDataString);
+    }
+
+    // The fields used by the ranking rules and by the dictionary of codes
+    // are also stored within value slots, so that the search process does
+    // not need to parse the document data in order to get them
+    const LocationKey& lLocationKey = lLocation.getKey();
+    const IATAType& lIataType = lLocationKey.getIataType();
+    const GeonamesID_T& lGeonamesID = lLocationKey.getGeonamesID();
+    const EnvelopeID_T& lEnvelopeID = lLocation.getEnvelopeID();
+    const PageRank_T& lPageRank = lLocation.getPageRank();
+    ioDocument.add_value (K_XAPIAN_SLOT_IATA_CODE, lLocationKey.getIataCode());
+    ioDocument.add_value (K_XAPIAN_SLOT_LOCATION_TYPE,
+                          lIataType.getTypeAsString());
+    ioDocument.add_value (K_XAPIAN_SLOT_GEONAMES_ID,
+                          Xapian::sortable_serialise (lGeonamesID));
+    ioDocument.add_value (K_XAPIAN_SLOT_ENVELOPE_ID,
+                          Xapian::sortable_serialise (lEnvelopeID));
+    ioDocument.add_value (K_XAPIAN_SLOT_PAGE_RANK,
+                          Xapian::sortable_serialise (lPageRank));
+    ioDocument.add_value (K_XAPIAN_SLOT_LATITUDE,
+                          Xapian::sortable_serialise (lLocation.getLatitude()));
+    ioDocument.add_value (K_XAPIAN_SLOT_LONGITUDE,
+                          Xapian::sortable_serialise(lLocation.getLongitude()));
+    ioDocument.add_value (K_XAPIAN_SLOT_ICAO_CODE, lLocation.getIcaoCode());
+
+    std::ostringstream lUNLOCodeListStr;
+    const UNLOCodeList_T& lUNLOCodeList = lLocation.getUNLOCodeList();
+    for (UNLOCodeList_T::const_iterator itUNLOCode = lUNLOCodeList.begin();
+         itUNLOCode != lUNLOCodeList.end(); ++itUNLOCode) {
+      if (itUNLOCode != lUNLOCodeList.begin()) {
+        lUNLOCodeListStr << " ";
+      }
+      lUNLOCodeListStr << *itUNLOCode;
+    }
+    ioDocument.add_value (K_XAPIAN_SLOT_UNLOCODE_LIST, lUNLOCodeListStr.str());
+
+    // Build the (STL) sets of terms to be added to the Xapian index and
+    // spelling dictionary
+    ioPlace.buildIndexSets (iMaxWordCombinationSpan, ioNormalisationCache);
+
+    // Add the (STL) sets of terms to the Xapian document
+    addTermsToDocument (ioPlace, ioDocument);
   }
 
   // //////////////////////////////////////////////////////////////////////
   void IndexBuilder::addDocumentToIndex(Xapian::WritableDatabase& ioDatabase,
                                         Place& ioPlace,
-                                        const OTransliterator& iTransliterator) {
+                                        const DocumentFormat& iDocumentFormat,
+                                        const NbOfWords_T& iMaxWordCombinationSpan,
+                                        NormalisationCache& ioNormalisationCache) {
 
-    // Create an empty Xapian document
+    // Create and fill a Xapian document
     Xapian::Document lDocument;
-    
-    // Retrieve the raw data string, to be stored as is within
-    // the Xapian document
-    const RawDataString_T& lRawDataString = ioPlace.getRawDataString();
-
-    // The Xapian document data is indeed the same as the one of the
-    // OPTD-maintained list of POR (points of reference), allowing the search
-    // process to use exactly the same parser as the indexation process
-    lDocument.set_data (lRawDataString);
-      
-    // Build the (STL) sets of terms to be added to the Xapian index and
-    // spelling dictionary
-    ioPlace.buildIndexSets (iTransliterator);
+    buildDocument (lDocument, ioPlace, iDocumentFormat,
+                   iMaxWordCombinationSpan, ioNormalisationCache);
 
-    // Add the (STL) sets of terms to the Xapian index and spelling dictionary
-    addToXapian (ioPlace, lDocument, ioDatabase);
+    // Add the spelling terms to the Xapian spelling dictionary
+    addSpellingsToXapian (ioPlace.getSpellingSet(), ioDatabase);
 
     // Add the document to the database
     const Xapian::docid& lDocID = ioDatabase.add_document (lDocument);
@@ -121,15 +223,25 @@ namespace OPENTREP {
   // //////////////////////////////////////////////////////////////////////
   NbOfDBEntries_T IndexBuilder::
   buildSearchIndex (Xapian::WritableDatabase* ioXapianDB_ptr,
-                    const DBType& iSQLDBType, soci::session* ioSociSessionPtr,
+                    DBBulkLoader* ioDBBulkLoader_ptr,
                     std::istream& iPORFileStream,
                     const shouldIndexNonIATAPOR_T& iIncludeNonIATAPOR,
+                    const NbOfDBEntries_T& iFirstLine,
+                    const NbOfDBEntries_T& iNbOfLines,
+                    Place& ioPlace,
+                    const DocumentFormat& iDocumentFormat,
+                    const NbOfWords_T& iMaxWordCombinationSpan,
                     const OTransliterator& iTransliterator) {
     NbOfDBEntries_T oNbOfEntries = 0;
     NbOfDBEntries_T oNbOfEntriesInPORFile = 0;
+    NbOfDBEntries_T lNbOfRetainedLines = 0;
+
+    // Cache of the Unicode normalisations, private to the current thread
+    NormalisationCache
+      lNormalisationCache (iTransliterator,
+                           DEFAULT_OPENTREP_NORMALISATION_CACHE_SIZE);
 
     // Open the file to be parsed
-    Place& lPlace = FacPlace::instance().create();
     std::string itReadLine;
     while (std::getline (iPORFileStream, itReadLine)) {
 
@@ -157,12 +269,24 @@ namespace OPENTREP {
           continue;
         }
       }
+
+      // Only the given range of (retained) lines is indexed: the lines
+      // before are skipped, and the lines after are not even read
+      const NbOfDBEntries_T lLineRank = lNbOfRetainedLines++;
+      if (lLineRank < iFirstLine) {
+        ++oNbOfEntriesInPORFile;
+        continue;
+      }
+      if (lLineRank - iFirstLine >= iNbOfLines) {
+        break;
+      }
       
-      // Initialise the parser
-      PORStringParser lStringParser (itReadLine);
+      // Retrieve the parser of the current thread, the grammar of which
+      // is built only once for all the lines
+      PORLineParser& lLineParser = PORLineParser::getThreadParser();
 
       // Parse the string
-      const Location& lLocation = lStringParser.generateLocation();
+      const Location& lLocation = lLineParser.parse (itReadLine);
 
       // DEBUG
       /*
@@ -180,24 +304,27 @@ namespace OPENTREP {
       }
       
       // Fill the Place object with the Location structure.
-      lPlace.setLocation (lLocation);
+      ioPlace.setLocation (lLocation);
 
       // Add the document, associated to the Place object, to the Xapian index,
       // if required
       if (ioXapianDB_ptr != NULL) {
-        IndexBuilder::addDocumentToIndex (*ioXapianDB_ptr, lPlace,
-                                          iTransliterator);
+        IndexBuilder::addDocumentToIndex (*ioXapianDB_ptr, ioPlace,
+                                          iDocumentFormat,
+                                          iMaxWordCombinationSpan,
+                                          lNormalisationCache);
       }
 
-      // Add the document to the SQL database, if required
-      if (ioSociSessionPtr != NULL) {
-        DBManager::insertPlaceInDB (*ioSociSessionPtr, lPlace);
+      // Add the document to the SQL database, if required. The rows are
+      // actually sent to the SQL database by batches
+      if (ioDBBulkLoader_ptr != NULL) {
+        ioDBBulkLoader_ptr->addPlace (ioPlace);
       }
 
       // DEBUG
       /*
         OPENTREP_LOG_DEBUG ("[AFT-ADD] " << lLocationKey
-        << ", Place: " << lPlace);
+        << ", Place: " << ioPlace);
       */
 
       // Iteration
@@ -205,23 +332,698 @@ namespace OPENTREP {
       
       // Progress status
       if (oNbOfEntries % 1000 == 0) {
-        std::cout.imbue( std::locale (std::locale::classic(), new NumSep));
-        std::cout << "Number of actually parsed records: " << oNbOfEntries
-                  << ", out of " << oNbOfEntriesInPORFile
-                  << " records in the POR data file so far" << std::endl;
+        reportProgress (oNbOfEntries, oNbOfEntriesInPORFile);
       }
 
       // DEBUG
-      OPENTREP_LOG_DEBUG ("[" << oNbOfEntries << "] " << lPlace);
+      OPENTREP_LOG_DEBUG ("[" << oNbOfEntries << "] " << ioPlace);
 
       // Reset for next turn
-      lPlace.resetMatrix();
-      lPlace.resetIndexSets();
+      ioPlace.resetMatrix();
+      ioPlace.resetIndexSets();
+    }
+
+    // Statistics of the Unicode normalisations
+    if (ioXapianDB_ptr != NULL) {
+      reportNormalisationStatistics (lNormalisationCache);
+    }
+
+    return oNbOfEntries;
+  }
+
+  /**
+   * POR parsed by an indexing worker thread, along with its Xapian document
+   * and spelling terms, waiting to be written by the writer thread.
+   */
+  struct IndexingRecord {
+    Location _location;
+    Xapian::Document _document;
+    Place::StringSet_T _spellingSet;
+  };
+
+  /**
+   * Batch of consecutive lines of the POR data file, going through the
+   * indexing pipeline: filled by the reader thread, parsed by one of the
+   * worker threads and written by the writer thread.
+   */
+  struct IndexingBatch {
+    IndexingBatch (const unsigned long iSeqNumber)
+      : _seqNumber (iSeqNumber), _nbOfSkippedLines (0) {
+    }
+
+    /** Rank of the batch within the POR data file. */
+    const unsigned long _seqNumber;
+
+    /** Lines to be parsed. */
+    std::vector<std::string> _lineList;
+
+    /** Number of lines skipped by the reader (non-IATA POR). */
+    NbOfDBEntries_T _nbOfSkippedLines;
+
+    /** Parsed POR, in the order of the lines. */
+    std::vector<IndexingRecord> _recordList;
+  };
+
+  /**
+   * State shared by the threads of the indexing pipeline. All the
+   * attributes are protected by the mutex.
+   */
+  struct IndexingPipeline {
+    typedef std::unique_ptr<IndexingBatch> BatchPtr_T;
+
+    IndexingPipeline (const unsigned long iMaxNbOfBatchesInFlight)
+      : _maxNbOfBatchesInFlight (iMaxNbOfBatchesInFlight),
+        _nbOfBatchesInFlight (0), _nbOfBatches (0),
+        _isInputComplete (false), _isAborted (false) {
+    }
+
+    /**
+     * Stop all the threads of the pipeline, keeping the first reported
+     * exception, so that it be re-thrown by the calling thread.
+     */
+    void abort (std::exception_ptr iException) {
+      {
+        std::lock_guard<std::mutex> lGuard (_mutex);
+        if (_exception == NULL) {
+          _exception = iException;
+        }
+        _isAborted = true;
+      }
+      _batchToParseCondition.notify_all();
+      _batchToWriteCondition.notify_all();
+      _roomCondition.notify_all();
+    }
+
+    std::mutex _mutex;
+
+    /** Signalled when there is a batch to be parsed (or no more). */
+    std::condition_variable _batchToParseCondition;
+
+    /** Signalled when a batch has been parsed (or no more will be). */
+    std::condition_variable _batchToWriteCondition;
+
+    /** Signalled when a batch has been written. */
+    std::condition_variable _roomCondition;
+
+    /** Batches read, waiting for a worker thread. */
+    std::deque<BatchPtr_T> _batchToParseList;
+
+    /** Batches parsed, waiting for the writer, by rank. */
+    std::map<unsigned long, BatchPtr_T> _batchToWriteMap;
+
+    /** Maximal number of batches read but not yet written. */
+    const unsigned long _maxNbOfBatchesInFlight;
+
+    /** Number of batches read but not yet written. */
+    unsigned long _nbOfBatchesInFlight;
+
+    /** Number of batches read so far. */
+    unsigned long _nbOfBatches;
+
+    /** Whether the whole POR data file has been read. */
+    bool _isInputComplete;
+
+    /** Whether the pipeline has been stopped on error. */
+    bool _isAborted;
+
+    /** First exception thrown by any of the threads. */
+    std::exception_ptr _exception;
+  };
+
+  // //////////////////////////////////////////////////////////////////////
+  void readPORBatches (IndexingPipeline& ioPipeline,
+                       std::istream& iPORFileStream,
+                       const shouldIndexNonIATAPOR_T& iIncludeNonIATAPOR) {
+    try {
+      const unsigned int lBatchSize = DEFAULT_OPENTREP_INDEXING_BATCH_SIZE;
+      unsigned long lSeqNumber = 0;
+      IndexingPipeline::BatchPtr_T lBatch_ptr (new IndexingBatch (lSeqNumber));
+      lBatch_ptr->_lineList.reserve (lBatchSize);
+
+      bool isEndOfFile = false;
+      while (isEndOfFile == false) {
+        std::string itReadLine;
+        isEndOfFile = !std::getline (iPORFileStream, itReadLine);
+
+        if (isEndOfFile == false) {
+          // Same filter on the IATA code as the single-threaded version
+          // of IndexBuilder::buildSearchIndex()
+          if (!iIncludeNonIATAPOR) {
+            const unsigned short lFirstSeparatorPos =
+              itReadLine.find_first_of ("^");
+            if (lFirstSeparatorPos != 3) {
+              ++lBatch_ptr->_nbOfSkippedLines;
+              continue;
+            }
+          }
+          lBatch_ptr->_lineList.push_back (itReadLine);
+
+          if (lBatch_ptr->_lineList.size() < lBatchSize) {
+            continue;
+          }
+        }
+
+        // The last batch is usually not full
+        if (lBatch_ptr->_lineList.empty() == true
+            && lBatch_ptr->_nbOfSkippedLines == 0) {
+          break;
+        }
+
+        // Hand the batch over to the worker threads, once there is room
+        // for it within the pipeline
+        {
+          std::unique_lock<std::mutex> lLock (ioPipeline._mutex);
+          ioPipeline._roomCondition.wait (lLock, [&ioPipeline]() {
+              return (ioPipeline._isAborted
+                      || ioPipeline._nbOfBatchesInFlight
+                      < ioPipeline._maxNbOfBatchesInFlight);
+            });
+          if (ioPipeline._isAborted) {
+            return;
+          }
+          ++ioPipeline._nbOfBatchesInFlight;
+          ++ioPipeline._nbOfBatches;
+          ioPipeline._batchToParseList.push_back (std::move (lBatch_ptr));
+        }
+        ioPipeline._batchToParseCondition.notify_one();
+
+        lBatch_ptr.reset (new IndexingBatch (++lSeqNumber));
+        lBatch_ptr->_lineList.reserve (lBatchSize);
+      }
+
+      // Let the worker and writer threads know that no more batch will come
+      {
+        std::lock_guard<std::mutex> lGuard (ioPipeline._mutex);
+        ioPipeline._isInputComplete = true;
+      }
+      ioPipeline._batchToParseCondition.notify_all();
+      ioPipeline._batchToWriteCondition.notify_all();
+
+    } catch (...) {
+      ioPipeline.abort (std::current_exception());
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void parsePORBatches (IndexingPipeline& ioPipeline, Place& ioPlace,
+                        const bool iShouldBuildDocuments,
+                        const DocumentFormat& iDocumentFormat,
+                        const NbOfWords_T& iMaxWordCombinationSpan,
+                        const OTransliterator& iTransliterator) {
+    try {
+      // Retrieve the parser of the current thread, the grammar of which
+      // is built only once for all the lines
+      PORLineParser& lLineParser = PORLineParser::getThreadParser();
+
+      // Cache of the Unicode normalisations, private to the current thread
+      NormalisationCache
+        lNormalisationCache (iTransliterator,
+                             DEFAULT_OPENTREP_NORMALISATION_CACHE_SIZE);
+
+      while (true) {
+        // Wait for a batch to be parsed
+        IndexingPipeline::BatchPtr_T lBatch_ptr;
+        {
+          std::unique_lock<std::mutex> lLock (ioPipeline._mutex);
+          ioPipeline._batchToParseCondition.wait (lLock, [&ioPipeline]() {
+              return (ioPipeline._isAborted
+                      || ioPipeline._batchToParseList.empty() == false
+                      || ioPipeline._isInputComplete);
+            });
+          if (ioPipeline._isAborted
+              || ioPipeline._batchToParseList.empty() == true) {
+            break;
+          }
+          lBatch_ptr = std::move (ioPipeline._batchToParseList.front());
+          ioPipeline._batchToParseList.pop_front();
+        }
+        assert (lBatch_ptr != NULL);
+
+        lBatch_ptr->_recordList.reserve (lBatch_ptr->_lineList.size());
+        for (std::vector<std::string>::const_iterator itLine =
+               lBatch_ptr->_lineList.begin();
+             itLine != lBatch_ptr->_lineList.end(); ++itLine) {
+          // Parse the string
+          const Location& lLocation = lLineParser.parse (*itLine);
+
+          // The POR not available are skipped, as with a single thread
+          const std::string& lCommonName = lLocation.getCommonName();
+          if (lCommonName == "NotAvailable") {
+            continue;
+          }
+
+          lBatch_ptr->_recordList.push_back (IndexingRecord());
+          IndexingRecord& lRecord = lBatch_ptr->_recordList.back();
+          lRecord._location = lLocation;
+
+          // Build the Xapian document, if required
+          if (iShouldBuildDocuments) {
+            ioPlace.setLocation (lLocation);
+            IndexBuilder::buildDocument (lRecord._document, ioPlace,
+                                         iDocumentFormat,
+                                         iMaxWordCombinationSpan,
+                                         lNormalisationCache);
+            lRecord._spellingSet = ioPlace.getSpellingSet();
+
+            // Reset for next turn
+            ioPlace.resetMatrix();
+            ioPlace.resetIndexSets();
+          }
+        }
+        lBatch_ptr->_lineList.clear();
+
+        // Hand the batch over to the writer thread
+        {
+          std::lock_guard<std::mutex> lGuard (ioPipeline._mutex);
+          const unsigned long lSeqNumber = lBatch_ptr->_seqNumber;
+          ioPipeline._batchToWriteMap[lSeqNumber] = std::move (lBatch_ptr);
+        }
+        ioPipeline._batchToWriteCondition.notify_one();
+      }
+
+      // Statistics of the Unicode normalisations
+      if (iShouldBuildDocuments) {
+        reportNormalisationStatistics (lNormalisationCache);
+      }
+
+    } catch (...) {
+      ioPipeline.abort (std::current_exception());
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfDBEntries_T IndexBuilder::
+  buildSearchIndex (Xapian::WritableDatabase* ioXapianDB_ptr,
+                    DBBulkLoader* ioDBBulkLoader_ptr,
+                    std::istream& iPORFileStream,
+                    const shouldIndexNonIATAPOR_T& iIncludeNonIATAPOR,
+                    const NbOfThreads_T& iNbOfThreads,
+                    const DocumentFormat& iDocumentFormat,
+                    const NbOfWords_T& iMaxWordCombinationSpan,
+                    const OTransliterator& iTransliterator) {
+    NbOfDBEntries_T oNbOfEntries = 0;
+    NbOfDBEntries_T oNbOfEntriesInPORFile = 0;
+    assert (iNbOfThreads >= 1);
+
+    // Every worker thread is given its own Place object (for the building
+    // of the term sets) and clone of the Unicode transliterator. Both are
+    // created here, by the calling thread
+    std::vector<Place*> lWorkerPlaceList;
+    std::vector<std::unique_ptr<OTransliterator> > lWorkerTransliteratorList;
+    for (NbOfThreads_T idx = 0; idx != iNbOfThreads; ++idx) {
+      Place& lWorkerPlace = FacPlace::instance().create();
+      lWorkerPlaceList.push_back (&lWorkerPlace);
+      lWorkerTransliteratorList.emplace_back (new OTransliterator
+                                              (iTransliterator));
+    }
+
+    // Place object used by the writer for the SQL database
+    Place& lPlace = FacPlace::instance().create();
+
+    // Enough batches in flight for the worker threads never to starve,
+    // while bounding the memory used by the pipeline
+    const unsigned long lMaxNbOfBatchesInFlight = 4 * iNbOfThreads;
+    IndexingPipeline lPipeline (lMaxNbOfBatchesInFlight);
+    const bool lShouldBuildDocuments = (ioXapianDB_ptr != NULL);
+
+    std::vector<std::thread> lThreadList;
+    try {
+      lThreadList.push_back (std::thread (readPORBatches,
+                                          std::ref (lPipeline),
+                                          std::ref (iPORFileStream),
+                                          iIncludeNonIATAPOR));
+      for (NbOfThreads_T idx = 0; idx != iNbOfThreads; ++idx) {
+        Place& lWorkerPlace = *lWorkerPlaceList[idx];
+        const OTransliterator& lWorkerTransliterator =
+          *lWorkerTransliteratorList[idx];
+        lThreadList.push_back (std::thread (parsePORBatches,
+                                            std::ref (lPipeline),
+                                            std::ref (lWorkerPlace),
+                                            lShouldBuildDocuments,
+                                            std::cref (iDocumentFormat),
+                                            iMaxWordCombinationSpan,
+                                            std::cref (lWorkerTransliterator)));
+      }
+
+      // The calling thread is the writer: it takes the batches in the order
+      // of the POR data file, so that the Xapian document IDs do not depend
+      // on the number of threads
+      unsigned long lSeqNumber = 0;
+      while (true) {
+        IndexingPipeline::BatchPtr_T lBatch_ptr;
+        {
+          std::unique_lock<std::mutex> lLock (lPipeline._mutex);
+          lPipeline._batchToWriteCondition.wait (lLock, [&]() {
+              return (lPipeline._isAborted
+                      || lPipeline._batchToWriteMap.count (lSeqNumber) != 0
+                      || (lPipeline._isInputComplete
+                          && lSeqNumber == lPipeline._nbOfBatches));
+            });
+          if (lPipeline._isAborted) {
+            break;
+          }
+          std::map<unsigned long, IndexingPipeline::BatchPtr_T>::iterator
+            itBatch = lPipeline._batchToWriteMap.find (lSeqNumber);
+          if (itBatch == lPipeline._batchToWriteMap.end()) {
+            // All the batches have been written
+            break;
+          }
+          lBatch_ptr = std::move (itBatch->second);
+          lPipeline._batchToWriteMap.erase (itBatch);
+          --lPipeline._nbOfBatchesInFlight;
+        }
+        lPipeline._roomCondition.notify_one();
+        assert (lBatch_ptr != NULL);
+
+        oNbOfEntriesInPORFile += lBatch_ptr->_nbOfSkippedLines;
+
+        for (std::vector<IndexingRecord>::iterator itRecord =
+               lBatch_ptr->_recordList.begin();
+             itRecord != lBatch_ptr->_recordList.end(); ++itRecord) {
+          IndexingRecord& lRecord = *itRecord;
+
+          // Fill the Place object with the Location structure.
+          lPlace.setLocation (lRecord._location);
+
+          // Add the document, associated to the Place object, to the Xapian
+          // index, if required
+          if (ioXapianDB_ptr != NULL) {
+            addSpellingsToXapian (lRecord._spellingSet, *ioXapianDB_ptr);
+            const Xapian::docid& lDocID =
+              ioXapianDB_ptr->add_document (lRecord._document);
+            lPlace.setDocID (lDocID);
+          }
+
+          // Add the document to the SQL database, if required. The rows are
+          // actually sent to the SQL database by batches
+          if (ioDBBulkLoader_ptr != NULL) {
+            ioDBBulkLoader_ptr->addPlace (lPlace);
+          }
+
+          // Iteration
+          ++oNbOfEntries; ++oNbOfEntriesInPORFile;
+      
+          // Progress status
+          if (oNbOfEntries % 1000 == 0) {
+            reportProgress (oNbOfEntries, oNbOfEntriesInPORFile);
+          }
+
+          // DEBUG
+          OPENTREP_LOG_DEBUG ("[" << oNbOfEntries << "] " << lPlace);
+        }
+
+        ++lSeqNumber;
+      }
+
+    } catch (...) {
+      lPipeline.abort (std::current_exception());
+    }
+
+    // Wait for the reader and worker threads to complete
+    for (std::vector<std::thread>::iterator itThread = lThreadList.begin();
+         itThread != lThreadList.end(); ++itThread) {
+      std::thread& lThread = *itThread;
+      if (lThread.joinable() == true) {
+        lThread.join();
+      }
+    }
+
+    // Report the first error, if any, thrown by any of the threads
+    if (lPipeline._exception != NULL) {
+      std::rethrow_exception (lPipeline._exception);
+    }
+
+    return oNbOfEntries;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfDBEntries_T
+  countPORLines (const PORFilePath_T& iPORFilePath,
+                 const shouldIndexNonIATAPOR_T& iIncludeNonIATAPOR) {
+    NbOfDBEntries_T oNbOfLines = 0;
+
+    const PORFileHelper lPORFileHelper (iPORFilePath);
+    std::istream& lPORFileStream = lPORFileHelper.getFileStreamRef();
+    std::string itReadLine;
+    while (std::getline (lPORFileStream, itReadLine)) {
+      // Same filter on the IATA code as IndexBuilder::buildSearchIndex()
+      if (!iIncludeNonIATAPOR) {
+        const unsigned short lFirstSeparatorPos =
+          itReadLine.find_first_of ("^");
+        if (lFirstSeparatorPos != 3) {
+          continue;
+        }
+      }
+      ++oNbOfLines;
+    }
+
+    return oNbOfLines;
+  }
+
+  /**
+   * Compactor merging the Xapian shards, and reporting its progress
+   * in the logs.
+   */
+  class XapianShardCompactor : public Xapian::Compactor {
+  public:
+    void set_status (const std::string& iTable, const std::string& iStatus) {
+      // DEBUG
+      OPENTREP_LOG_DEBUG ("Compaction of the Xapian shards, '" << iTable
+                          << "' table: " << iStatus);
+    }
+  };
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfDBEntries_T IndexBuilder::
+  buildShardedSearchIndex (const PORFilePath_T& iPORFilePath,
+                           const TravelDBFilePath_T& iTravelIndexFilePath,
+                           DBBulkLoader* ioDBBulkLoader_ptr,
+                           const shouldIndexNonIATAPOR_T& iIncludeNonIATAPOR,
+                           const NbOfShards_T& iNbOfShards,
+                           const DocumentFormat& iDocumentFormat,
+                           const NbOfWords_T& iMaxWordCombinationSpan,
+                           const OTransliterator& iTransliterator) {
+    NbOfDBEntries_T oNbOfEntries = 0;
+    assert (iNbOfShards >= 1);
+
+    /**
+     * The POR file is split into as many contiguous ranges of lines as
+     * shards. As the compaction numbers the documents of the shards one
+     * shard after the other, the Xapian document IDs are then the same as
+     * when the whole POR file is indexed into a single Xapian database.
+     */
+    const NbOfDBEntries_T lNbOfLines =
+      countPORLines (iPORFilePath, iIncludeNonIATAPOR);
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("The " << lNbOfLines << " POR lines of '"
+                        << iPORFilePath << "' will be indexed into "
+                        << iNbOfShards << " Xapian shards");
+
+    // Every shard is given its own Xapian database, Place object and clone
+    // of the Unicode transliterator, all created here, by the calling thread
+    std::vector<std::string> lShardFilePathList;
+    std::vector<Xapian::WritableDatabase*> lShardDBList;
+    std::vector<Place*> lShardPlaceList;
+    std::vector<std::unique_ptr<OTransliterator> > lShardTransliteratorList;
+    for (NbOfShards_T idx = 0; idx != iNbOfShards; ++idx) {
+      std::ostringstream oShardFilePath;
+      oShardFilePath << iTravelIndexFilePath
+                     << DEFAULT_OPENTREP_XAPIAN_SHARD_SUFFIX << idx;
+      const std::string lShardFilePath (oShardFilePath.str());
+      FileManager::recreateXapianDirectory (lShardFilePath);
+
+      const TravelDBFilePath_T lShardDBFilePath (lShardFilePath);
+      Xapian::WritableDatabase* lShardDB_ptr =
+        FacXapianDB::instance().create (lShardDBFilePath, Xapian::DB_CREATE);
+      assert (lShardDB_ptr != NULL);
+      lShardDB_ptr->begin_transaction();
+
+      lShardFilePathList.push_back (lShardFilePath);
+      lShardDBList.push_back (lShardDB_ptr);
+      Place& lShardPlace = FacPlace::instance().create();
+      lShardPlaceList.push_back (&lShardPlace);
+      lShardTransliteratorList.emplace_back (new OTransliterator
+                                             (iTransliterator));
+    }
+
+    // Index every shard within its own thread, each one reading the POR
+    // file on its own
+    std::vector<NbOfDBEntries_T> lNbOfEntriesList (iNbOfShards, 0);
+    std::vector<std::exception_ptr> lExceptionList (iNbOfShards);
+    std::vector<std::thread> lThreadList;
+    for (NbOfShards_T idx = 0; idx != iNbOfShards; ++idx) {
+      const unsigned long long lTotalNbOfLines = lNbOfLines;
+      const NbOfDBEntries_T lFirstLine = (lTotalNbOfLines * idx) / iNbOfShards;
+      const NbOfDBEntries_T lEndLine =
+        (lTotalNbOfLines * (idx + 1)) / iNbOfShards;
+
+      lThreadList.push_back (std::thread ([&, idx, lFirstLine, lEndLine]() {
+            try {
+              const PORFileHelper lPORFileHelper (iPORFilePath);
+              std::istream& lPORFileStream = lPORFileHelper.getFileStreamRef();
+              lNbOfEntriesList[idx] =
+                buildSearchIndex (lShardDBList[idx], ioDBBulkLoader_ptr,
+                                  lPORFileStream, iIncludeNonIATAPOR,
+                                  lFirstLine, lEndLine - lFirstLine,
+                                  *lShardPlaceList[idx], iDocumentFormat,
+                                  iMaxWordCombinationSpan,
+                                  *lShardTransliteratorList[idx]);
+
+            } catch (...) {
+              lExceptionList[idx] = std::current_exception();
+            }
+          }));
+    }
+
+    // Wait for all the shards to be indexed
+    for (std::vector<std::thread>::iterator itThread = lThreadList.begin();
+         itThread != lThreadList.end(); ++itThread) {
+      std::thread& lThread = *itThread;
+      lThread.join();
+    }
+
+    // Report the first error, if any, thrown by any of the threads
+    for (std::vector<std::exception_ptr>::const_iterator itException =
+           lExceptionList.begin(); itException != lExceptionList.end();
+         ++itException) {
+      const std::exception_ptr& lException = *itException;
+      if (lException != NULL) {
+        std::rethrow_exception (lException);
+      }
+    }
+
+    // Commit and close the shards
+    for (NbOfShards_T idx = 0; idx != iNbOfShards; ++idx) {
+      Xapian::WritableDatabase* lShardDB_ptr = lShardDBList[idx];
+      assert (lShardDB_ptr != NULL);
+      lShardDB_ptr->set_metadata (K_XAPIAN_INDEX_FORMAT_VERSION_KEY,
+                                  K_XAPIAN_INDEX_FORMAT_VERSION);
+      lShardDB_ptr->commit_transaction();
+      lShardDB_ptr->close();
+
+      // DEBUG
+      OPENTREP_LOG_DEBUG ("The Xapian shard #" << idx << " ('"
+                          << lShardFilePathList[idx] << "') has indexed "
+                          << lNbOfEntriesList[idx] << " entries.");
+
+      oNbOfEntries += lNbOfEntriesList[idx];
+    }
+
+    /**
+     * Merge the shards into the Xapian database/index. The spelling
+     * dictionaries are merged as well, the frequencies of the spelling
+     * terms being summed up, as if all the POR had been indexed within
+     * the same Xapian database. The same goes for the metadata.
+     */
+    FileManager::recreateXapianDirectory (iTravelIndexFilePath);
+
+    Xapian::Database lShardsDB;
+    for (std::vector<std::string>::const_iterator itShardFilePath =
+           lShardFilePathList.begin();
+         itShardFilePath != lShardFilePathList.end(); ++itShardFilePath) {
+      const std::string& lShardFilePath = *itShardFilePath;
+      lShardsDB.add_database (Xapian::Database (lShardFilePath));
+    }
+    XapianShardCompactor lCompactor;
+    lShardsDB.compact (iTravelIndexFilePath,
+                       Xapian::Compactor::FULL | Xapian::DBCOMPACT_MULTIPASS,
+                       0, lCompactor);
+    lShardsDB.close();
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("The " << iNbOfShards << " Xapian shards have been "
+                        << "compacted into the Xapian index / database ('"
+                        << iTravelIndexFilePath << "'), which has indexed "
+                        << oNbOfEntries << " entries.");
+
+    // The shards are no longer needed
+    for (std::vector<std::string>::const_iterator itShardFilePath =
+           lShardFilePathList.begin();
+         itShardFilePath != lShardFilePathList.end(); ++itShardFilePath) {
+      const std::string& lShardFilePath = *itShardFilePath;
+      boost::filesystem::remove_all (boost::filesystem::path (lShardFilePath));
     }
 
     return oNbOfEntries;
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  void reportIndexStatistics (const TravelDBFilePath_T& iTravelIndexFilePath,
+                              const NbOfWords_T& iMaxWordCombinationSpan) {
+    // Open the (just built) Xapian database, in read-only mode
+    const Xapian::Database lXapianDatabase (iTravelIndexFilePath);
+
+    // Number of documents
+    const Xapian::doccount lNbOfDocuments = lXapianDatabase.get_doccount();
+
+    // Number of distinct terms
+    NbOfDBEntries_T lNbOfTerms = 0;
+    for (Xapian::TermIterator itTerm = lXapianDatabase.allterms_begin();
+         itTerm != lXapianDatabase.allterms_end(); ++itTerm) {
+      ++lNbOfTerms;
+    }
+
+    // Number of words within the spelling table
+    NbOfDBEntries_T lNbOfSpellings = 0;
+    for (Xapian::TermIterator itSpelling = lXapianDatabase.spellings_begin();
+         itSpelling != lXapianDatabase.spellings_end(); ++itSpelling) {
+      ++lNbOfSpellings;
+    }
+
+    // Size, on disk, of the files of the Xapian database
+    boost::uintmax_t lIndexSize = 0;
+    const boost::filesystem::path lIndexPath (iTravelIndexFilePath);
+    for (boost::filesystem::directory_iterator itFile (lIndexPath);
+         itFile != boost::filesystem::directory_iterator(); ++itFile) {
+      if (boost::filesystem::is_regular_file (itFile->status())) {
+        lIndexSize += boost::filesystem::file_size (itFile->path());
+      }
+    }
+
+    std::ostringstream oStr;
+    oStr.imbue (std::locale (std::locale::classic(), new NumSep));
+    oStr << "Xapian index (maximum span of word combinations: ";
+    if (iMaxWordCombinationSpan == 0) {
+      oStr << "none";
+    } else {
+      oStr << iMaxWordCombinationSpan;
+    }
+    oStr << "): " << lNbOfDocuments << " documents, " << lNbOfTerms
+         << " terms, " << lNbOfSpellings << " spelling words, "
+         << lIndexSize << " bytes";
+
+    std::cout << oStr.str() << std::endl;
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG (oStr.str());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void buildVocabularySketch (const TravelDBFilePath_T& iTravelIndexFilePath) {
+    // Open the (just built) Xapian database, in read-only mode
+    const Xapian::Database lXapianDatabase (iTravelIndexFilePath);
+
+    // Build the sketch from the positions of the indexed terms, and store
+    // it within the directory of the Xapian database
+    const Percentage_T& lFalsePositiveRate =
+      DEFAULT_OPENTREP_VOCABULARY_SKETCH_FALSE_POSITIVE_RATE;
+    VocabularySketch lVocabularySketch;
+    lVocabularySketch.build (lXapianDatabase, lFalsePositiveRate);
+    const std::string& lSketchFilePath =
+      VocabularySketch::getFilePath (iTravelIndexFilePath);
+    lVocabularySketch.save (lSketchFilePath);
+
+    std::ostringstream oStr;
+    oStr << "Vocabulary sketch ('" << lSketchFilePath << "'): "
+         << lVocabularySketch.describe();
+
+    std::cout << oStr.str() << std::endl;
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG (oStr.str());
+  }
+
   // //////////////////////////////////////////////////////////////////////
   NbOfDBEntries_T IndexBuilder::
   buildSearchIndex (const PORFilePath_T& iPORFilePath,
@@ -231,9 +1033,15 @@ namespace OPENTREP {
                     const shouldIndexNonIATAPOR_T& iIncludeNonIATAPOR,
                     const shouldIndexPORInXapian_T& iShouldIndexPORInXapian,
                     const shouldAddPORInSQLDB_T& iShouldAddPORInSQLDB,
+                    const NbOfDBEntries_T& iSQLDBBatchSize,
+                    const NbOfThreads_T& iNbOfThreads,
+                    const NbOfShards_T& iNbOfShards,
+                    const DocumentFormat& iDocumentFormat,
+                    const NbOfWords_T& iMaxWordCombinationSpan,
                     const OTransliterator& iTransliterator) {
     NbOfDBEntries_T oNbOfEntries = 0;
     soci::session* lSociSession_ptr = NULL;
+    std::unique_ptr<DBBulkLoader> lDBBulkLoader_ptr;
     Xapian::WritableDatabase* lXapianDatabase_ptr = NULL;
     
     /**
@@ -243,8 +1051,13 @@ namespace OPENTREP {
      * b. Create the Xapian database (index). As the directory has been fully
      * cleaned, deleted and re-created, that Xapian database (index) is empty
      * c. Start a transaction for Xapian
+     *
+     * When the POR are indexed into shards, the Xapian database (index)
+     * is created only at the end, by the compaction of the shards.
      */
-    if (iShouldIndexPORInXapian) {
+    const bool lShouldShardXapian = (iShouldIndexPORInXapian
+                                     && iNbOfShards > 1);
+    if (iShouldIndexPORInXapian && lShouldShardXapian == false) {
       // Delete and recreate the directory, and its full content,
       // hosting the Xapian index / database
       FileManager::recreateXapianDirectory (iTravelIndexFilePath);
@@ -297,9 +1110,13 @@ namespace OPENTREP {
        *            3. Connection to the SQL Database
        */
       if (!(iSQLDBType == DBType::NODB)) {
-        // Connection to the database
+        // Connection to the database, with the options required by the
+        // bulk loader
+        const SQLDBConnectionString_T& lSQLDBConnStr =
+          DBBulkLoader::completeSQLDBConnectionString (iSQLDBType,
+                                                       iSQLDBConnStr);
         lSociSession_ptr =
-          DBManager::initSQLDBSession (iSQLDBType, iSQLDBConnStr);
+          DBManager::initSQLDBSession (iSQLDBType, lSQLDBConnStr);
         
         if (lSociSession_ptr == NULL) {
           std::ostringstream errorStr;
@@ -310,8 +1127,15 @@ namespace OPENTREP {
         }
         assert (lSociSession_ptr != NULL);
         
-        // Creation of the POR table
+        // Creation of the POR table. The indexes are created only once
+        // all the POR have been loaded
         DBManager::createSQLDBTables (*lSociSession_ptr);
+
+        // Bulk loader, sending the POR by batches
+        lDBBulkLoader_ptr.reset (new DBBulkLoader (*lSociSession_ptr,
+                                                   iSQLDBType,
+                                                   iSQLDBBatchSize,
+                                                   iDocumentFormat));
       }
     }
     
@@ -321,23 +1145,73 @@ namespace OPENTREP {
     // DEBUG
     OPENTREP_LOG_DEBUG ("Parsing POR input file: " << iPORFilePath);
 
-    // Get a reference on the file stream corresponding to the POR file.
-    const PORFileHelper lPORFileHelper (iPORFilePath);
-    std::istream& lPORFileStream = lPORFileHelper.getFileStreamRef();
+    if (lShouldShardXapian) {
+      // Index the POR into Xapian shards, in parallel, and then merge
+      // (compact) them into the Xapian database/index
+      oNbOfEntries = buildShardedSearchIndex (iPORFilePath,
+                                              iTravelIndexFilePath,
+                                              lDBBulkLoader_ptr.get(),
+                                              iIncludeNonIATAPOR, iNbOfShards,
+                                              iDocumentFormat,
+                                              iMaxWordCombinationSpan,
+                                              iTransliterator);
+
+    } else {
+      // Number of worker threads parsing the POR and building their Xapian
+      // documents. By default, there are as many as hardware threads
+      NbOfThreads_T lNbOfThreads = iNbOfThreads;
+      if (lNbOfThreads == 0) {
+        lNbOfThreads = std::thread::hardware_concurrency();
+      }
+      if (lNbOfThreads == 0) {
+        lNbOfThreads = 1;
+      }
 
-    // Browse the input POR (point of reference) data file,
-    // parse every of its rows, and put the result in the Xapian database/index
-    // and, if needed, within the SQL database.
-    oNbOfEntries = buildSearchIndex (lXapianDatabase_ptr, iSQLDBType,
-                                     lSociSession_ptr, lPORFileStream,
-                                     iIncludeNonIATAPOR, iTransliterator);
+      // DEBUG
+      OPENTREP_LOG_DEBUG ("Number of indexing worker threads: "
+                          << lNbOfThreads);
+
+      // Get a reference on the file stream corresponding to the POR file.
+      const PORFileHelper lPORFileHelper (iPORFilePath);
+      std::istream& lPORFileStream = lPORFileHelper.getFileStreamRef();
+
+      // Browse the input POR (point of reference) data file,
+      // parse every of its rows, and put the result in the Xapian
+      // database/index and, if needed, within the SQL database.
+      if (lNbOfThreads == 1) {
+        Place& lPlace = FacPlace::instance().create();
+        const NbOfDBEntries_T lNbOfLines =
+          std::numeric_limits<NbOfDBEntries_T>::max();
+        oNbOfEntries = buildSearchIndex (lXapianDatabase_ptr,
+                                         lDBBulkLoader_ptr.get(),
+                                         lPORFileStream, iIncludeNonIATAPOR,
+                                         0, lNbOfLines, lPlace,
+                                         iDocumentFormat,
+                                         iMaxWordCombinationSpan,
+                                         iTransliterator);
+
+      } else {
+        oNbOfEntries = buildSearchIndex (lXapianDatabase_ptr,
+                                         lDBBulkLoader_ptr.get(),
+                                         lPORFileStream, iIncludeNonIATAPOR,
+                                         lNbOfThreads, iDocumentFormat,
+                                         iMaxWordCombinationSpan,
+                                         iTransliterator);
+      }
+    }
 
     /**
      *            5. Commit the transactions of the Xapian database (index).
      *
      */
-    if (iShouldIndexPORInXapian) {
+    if (lXapianDatabase_ptr != NULL) {
       assert (lXapianDatabase_ptr != NULL);
+
+      // Record the version of the format of the index, so that the search
+      // process knows that the documents hold the value slots
+      lXapianDatabase_ptr->set_metadata (K_XAPIAN_INDEX_FORMAT_VERSION_KEY,
+                                         K_XAPIAN_INDEX_FORMAT_VERSION);
+
       lXapianDatabase_ptr->commit_transaction();
 
       // DEBUG
@@ -351,17 +1225,42 @@ namespace OPENTREP {
      *       the Boost Unit Test framework, that latter kills the process.
      *       When called from within GDB, all is fine.
      */
-    if (iShouldIndexPORInXapian) {
-      assert (lXapianDatabase_ptr != NULL);
+    if (lXapianDatabase_ptr != NULL) {
       lXapianDatabase_ptr->close();
     }
 
+    /**
+     *            6.1. Report the size of the Xapian database (index),
+     *                 which depends on the span of the word combinations.
+     */
+    if (iShouldIndexPORInXapian) {
+      reportIndexStatistics (iTravelIndexFilePath, iMaxWordCombinationSpan);
+    }
+
+    /**
+     *            6.2. Build the vocabulary sketch of the Xapian database
+     *                 (index), stored within the directory of that latter,
+     *                 so that the search processes may spare the full-text
+     *                 searches which cannot match.
+     */
+    if (iShouldIndexPORInXapian) {
+      buildVocabularySketch (iTravelIndexFilePath);
+    }
+
 
     if (iShouldAddPORInSQLDB) {
       /**
-       *            7. Index the SQL database
+       *            7. Load the remaining POR, and index the SQL database
        */
       if (!(iSQLDBType == DBType::NODB)) {
+        assert (lDBBulkLoader_ptr != NULL);
+        const NbOfDBEntries_T lNbOfLoadedRows = lDBBulkLoader_ptr->finish();
+        lDBBulkLoader_ptr.reset();
+
+        // DEBUG
+        OPENTREP_LOG_DEBUG ("The SQL database has been filled with "
+                            << lNbOfLoadedRows << " entries.");
+
         assert (lSociSession_ptr != NULL);
         DBManager::createSQLDBIndexes (*lSociSession_ptr);
       }
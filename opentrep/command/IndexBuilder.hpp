@@ -6,6 +6,7 @@
 // //////////////////////////////////////////////////////////////////////
 // OpenTrep
 #include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/DocumentFormat.hpp>
 
 /**
  * Forward declarations
@@ -13,6 +14,7 @@
 // Xapian
 namespace Xapian {
   class WritableDatabase;
+  class Document;
 }
 
 // SOCI (for SQL database)
@@ -26,42 +28,143 @@ namespace OPENTREP {
   // Forward declarations
   class Place;
   class OTransliterator;
+  class NormalisationCache;
+  class DBBulkLoader;
 
   /**
    * @brief Command wrapping the travel request process.
    */
   class IndexBuilder {
     friend class OPENTREP_Service;
-  private:
+  public:
+    /**
+     * Build the Xapian document corresponding to a Place object: data,
+     * value slots and (indexed) terms. The document is not added to any
+     * Xapian database, and the spelling terms are left within the Place
+     * object, so that this method may be called by any indexing thread.
+     *
+     * @param Xapian::Document& Xapian document to be filled.
+     * @param Place& Place object instance.
+     * @param const DocumentFormat& Format of the document data.
+     * @param const NbOfWords_T& Maximum number of words spanned by the
+     *        indexed word combinations (0 meaning no limit).
+     * @param NormalisationCache& Cache of the Unicode normalisations,
+     *        private to the calling thread.
+     */
+    static void buildDocument (Xapian::Document&, Place&,
+                               const DocumentFormat&, const NbOfWords_T&,
+                               NormalisationCache&);
 
+  private:
     /**
      * Add a document, corresponding to a Place object, to the Xapian index.
      *
      * @param Xapian::WritableDatabase& Xapian database.
      * @param Place& Place object instance.
-     * @param const OTransliterator& Unicode transliterator.
+     * @param const DocumentFormat& Format of the document data.
+     * @param const NbOfWords_T& Maximum number of words spanned by the
+     *        indexed word combinations (0 meaning no limit).
+     * @param NormalisationCache& Cache of the Unicode normalisations,
+     *        private to the calling thread.
      */
     static void addDocumentToIndex (Xapian::WritableDatabase&,
-                                    Place&, const OTransliterator&);
+                                    Place&, const DocumentFormat&,
+                                    const NbOfWords_T&,
+                                    NormalisationCache&);
 
     /**
-     * Build Xapian database.
+     * Build Xapian database, with a single thread.
      *
      * @param Xapian::WritableDatabase* Handle on the Xapian database/index
      *                                  It is NULL when no use of Xapian.
-     * @param const DBType& SQL database type (can be no database at all).
-     * @param soci::session* SOCI session handler. It can be NULL when there
-     *                       is no use of SQL DB.
+     * @param DBBulkLoader* Bulk loader into the SQL database. It can be NULL
+     *                      when there is no use of SQL DB.
+     * @param std::ifstream& File stream for the POR data file.
+     * @param const shouldIndexNonIATAPOR_T& Whether all POR should be indexed.
+     * @param const NbOfDBEntries_T& Rank of the first line to be indexed,
+     *        among the lines retained by the filter on the IATA code.
+     * @param const NbOfDBEntries_T& Number of lines to be indexed, from
+     *        that first one (the remaining lines are not read).
+     * @param Place& Place object, filled in turn with every POR.
+     * @param const DocumentFormat& Format of the Xapian document data.
+     * @param const NbOfWords_T& Maximum number of words spanned by the
+     *        indexed word combinations (0 meaning no limit).
+     * @param const OTransliterator& Unicode transliterator.
+     */
+    static NbOfDBEntries_T buildSearchIndex (Xapian::WritableDatabase*,
+                                             DBBulkLoader*,
+                                             std::istream& iPORFileStream,
+                                             const shouldIndexNonIATAPOR_T&,
+                                             const NbOfDBEntries_T& iFirstLine,
+                                             const NbOfDBEntries_T& iNbOfLines,
+                                             Place&,
+                                             const DocumentFormat&,
+                                             const NbOfWords_T&,
+                                             const OTransliterator&);
+
+    /**
+     * Build Xapian database, with a pipeline of threads:
+     * <ul>
+     *   <li>a reader thread, splitting the POR data file into batches
+     *       of lines;</li>
+     *   <li>worker threads, parsing those lines and building the
+     *       corresponding Xapian documents, each with its own clone of the
+     *       Unicode transliterator;</li>
+     *   <li>the calling thread, as the single writer, adding the documents
+     *       to the Xapian database and the POR to the SQL database, in the
+     *       order of the POR data file.</li>
+     * </ul>
+     * As the documents are added in the same order as with a single thread,
+     * the Xapian document IDs are the same whatever the number of threads.
+     *
+     * @param Xapian::WritableDatabase* Handle on the Xapian database/index
+     *                                  It is NULL when no use of Xapian.
+     * @param DBBulkLoader* Bulk loader into the SQL database. It can be NULL
+     *                      when there is no use of SQL DB.
      * @param std::ifstream& File stream for the POR data file.
      * @param const shouldIndexNonIATAPOR_T& Whether all POR should be indexed.
+     * @param const NbOfThreads_T& Number of worker threads (at least 1).
+     * @param const DocumentFormat& Format of the Xapian document data.
+     * @param const NbOfWords_T& Maximum number of words spanned by the
+     *        indexed word combinations (0 meaning no limit).
      * @param const OTransliterator& Unicode transliterator.
      */
     static NbOfDBEntries_T buildSearchIndex (Xapian::WritableDatabase*,
-                                             const DBType&, soci::session*,
+                                             DBBulkLoader*,
                                              std::istream& iPORFileStream,
                                              const shouldIndexNonIATAPOR_T&,
+                                             const NbOfThreads_T&,
+                                             const DocumentFormat&,
+                                             const NbOfWords_T&,
                                              const OTransliterator&);
 
+    /**
+     * Build Xapian database, by shards: the POR file is split into as many
+     * contiguous ranges of lines as shards, which are indexed in parallel,
+     * each one by its own thread and into its own (partial) Xapian
+     * database. The shards are then merged (compacted) into the Xapian
+     * database. As the compaction numbers the documents of the shards one
+     * after the other, the Xapian document IDs are the same as when the
+     * POR are indexed into a single Xapian database.
+     *
+     * @param const PORFilePath_T& File-path of the POR file.
+     * @param const TravelDBFilePath_T& File-path of the Xapian database.
+     * @param DBBulkLoader* Bulk loader into the SQL database. It can be NULL
+     *                      when there is no use of SQL DB.
+     * @param const shouldIndexNonIATAPOR_T& Whether all POR should be indexed.
+     * @param const NbOfShards_T& Number of shards.
+     * @param const DocumentFormat& Format of the Xapian document data.
+     * @param const NbOfWords_T& Maximum number of words spanned by the
+     *        indexed word combinations (0 meaning no limit).
+     * @param const OTransliterator& Unicode transliterator.
+     */
+    static NbOfDBEntries_T
+    buildShardedSearchIndex (const PORFilePath_T&, const TravelDBFilePath_T&,
+                             DBBulkLoader*, const shouldIndexNonIATAPOR_T&,
+                             const NbOfShards_T&, const DocumentFormat&,
+                             const NbOfWords_T&,
+                             const OTransliterator&);
+
     /**
      * Build Xapian database.
      *
@@ -72,6 +175,16 @@ namespace OPENTREP {
      * @param const shouldIndexNonIATAPOR_T& Whether all POR should be indexed.
      * @param const shouldIndexPORInXapian_T& Whether Xapian should be used.
      * @param const shouldAddPORInSQLDB_T& Whether the SQL DB should be used.
+     * @param const NbOfDBEntries_T& Number of rows loaded into the SQL DB
+     *                               within a single transaction.
+     * @param const NbOfThreads_T& Number of indexing worker threads
+     *                             (0 meaning one per hardware thread).
+     * @param const NbOfShards_T& Number of Xapian shards (0 or 1 meaning
+     *                            no shard). With shards, the number of
+     *                            indexing worker threads is not used.
+     * @param const DocumentFormat& Format of the Xapian document data.
+     * @param const NbOfWords_T& Maximum number of words spanned by the
+     *        indexed word combinations (0 meaning no limit).
      * @param const OTransliterator& Unicode transliterator.
      */
     static NbOfDBEntries_T buildSearchIndex (const PORFilePath_T&,
@@ -81,6 +194,11 @@ namespace OPENTREP {
                                              const shouldIndexNonIATAPOR_T&,
                                              const shouldIndexPORInXapian_T&,
                                              const shouldAddPORInSQLDB_T&,
+                                             const NbOfDBEntries_T&,
+                                             const NbOfThreads_T&,
+                                             const NbOfShards_T&,
+                                             const DocumentFormat&,
+                                             const NbOfWords_T&,
                                              const OTransliterator&);
 
   private:
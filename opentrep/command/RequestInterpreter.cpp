@@ -8,7 +8,6 @@
 #include <vector>
 #include <exception>
 // Boost
-#include <boost/filesystem.hpp>
 #include <boost/regex.hpp>
 // SOCI
 #include <soci/soci.h>
@@ -23,13 +22,18 @@
 #include <opentrep/bom/Result.hpp>
 #include <opentrep/bom/PlaceHolder.hpp>
 #include <opentrep/bom/QuerySlices.hpp>
-#include <opentrep/bom/StringPartition.hpp>
+#include <opentrep/bom/StringSegmentation.hpp>
+#include <opentrep/bom/LocationCache.hpp>
+#include <opentrep/bom/CodeDictionary.hpp>
+#include <opentrep/bom/VocabularySketch.hpp>
+#include <opentrep/factory/BomArena.hpp>
 #include <opentrep/factory/FacPlaceHolder.hpp>
 #include <opentrep/factory/FacPlace.hpp>
 #include <opentrep/factory/FacResultCombination.hpp>
 #include <opentrep/factory/FacResultHolder.hpp>
 #include <opentrep/factory/FacResult.hpp>
 #include <opentrep/command/DBManager.hpp>
+#include <opentrep/command/DBConnectionPool.hpp>
 #include <opentrep/command/RequestInterpreter.hpp>
 #include <opentrep/service/Logger.hpp>
 
@@ -93,12 +97,10 @@ namespace OPENTREP {
       }
       assert (hasFullTextMatched == true);
 
-      // Retrieve the Xapian document data (string)
-      const std::string& lDocDataStr = lResult_ptr->getBestDocData();
-      const RawDataString_T& lDocData = RawDataString_T (lDocDataStr);
-
-      // Parse the POR details and create the corresponding Location structure
-      const Location& lLocation = Result::retrieveLocation (lDocData);
+      // Retrieve the POR details of the best matching Xapian document.
+      // That document has already been parsed while being scored.
+      const Xapian::Document& lXapianDoc = lResult_ptr->getBestXapianDocument();
+      const Location& lLocation = *Result::getLocation (lXapianDoc);
 
       // Instanciate an empty place object, which will be filled from the
       // rows retrieved from the database.
@@ -116,20 +118,28 @@ namespace OPENTREP {
   }
   
   /**
-   * For all the elements (StringSet) of the string partitions, derived
-   * from the given travel query, perform a Xapian-based full-text match.
+   * For all the word combinations (e.g., "rio", "rio de", "de janeiro")
+   * of the given query slice, perform a Xapian-based full-text match.
    * Each Xapian-based full-text match gives (potentially) a full set of
    * matches, some with the highest matching percentage and some with a
    * lower percentage.
    *
-   * @param TravelQuery_T& The query string.
+   * There are only O(n^2) word combinations for n words, whereas there
+   * are 2^(n-1) string partitions. Hence, the string partitions are no
+   * longer enumerated: the best one is found by dynamic programming over
+   * the weights of the word combinations (see StringSegmentation), and
+   * a ResultHolder object is created for that latter only.
+   *
+   * @param const TravelQuery_T& The query slice.
    * @param const Xapian::Database& The Xapian index/database.
+   * @param const VocabularySketch& The vocabulary sketch of that index.
    * @param ResultCombination& List of ResultHolder objects.
    * @param WordList_T& List of non-matched words of the query string.
    */
   // //////////////////////////////////////////////////////////////////////
-  void searchString (const StringPartition& iStringPartition,
+  void searchString (const TravelQuery_T& iQuerySlice,
                      const Xapian::Database& iDatabase,
+                     const VocabularySketch& iVocabularySketch,
                      ResultCombination& ioResultCombination,
                      WordList_T& ioWordList) {
 
@@ -139,30 +149,37 @@ namespace OPENTREP {
       // Set of unknown words (just to eliminate the duplicates)
       WordSet_T lWordSet;
 
-      // Browse the partitions
-      for (StringPartition::StringPartition_T::const_iterator itSet =
-             iStringPartition._partition.begin();
-           itSet != iStringPartition._partition.end(); ++itSet) {
-        const StringSet& lStringSet = *itSet;
-
-        // DEBUG
-        OPENTREP_LOG_DEBUG ("  ==========");
-        OPENTREP_LOG_DEBUG ("  String set: " << lStringSet);
-
-        // Create a ResultHolder object.
-        ResultHolder& lResultHolder =
-          FacResultHolder::instance().create (lStringSet.describe(), iDatabase);
+      // Result objects, indexed by their query string, already full-text
+      // matched for the current query slice
+      ResultMap_T lResultMap;
 
-        // Add the ResultHolder object to the dedicated list.
-        FacResultCombination::initLinkWithResultHolder (ioResultCombination,
-                                                        lResultHolder);
+      // Word combinations of the query slice, along with their weights
+      StringSegmentation lStringSegmentation (iQuerySlice);
+      const NbOfWords_T nbOfWords = lStringSegmentation.getNbOfWords();
 
-        // Browse through all the word combinations of the partition
-        for (StringSet::StringSet_T::const_iterator itString =
-               lStringSet._set.begin();
-             itString != lStringSet._set.end(); ++itString) {
+      /**
+       * 1. Browse all the word combinations, i.e., all the spans of
+       *    contiguous words, of the query slice. The single words are
+       *    browsed from left to right, so that the unmatched words are
+       *    reported in the order of the query slice.
+       */
+      for (NbOfWords_T lBeginIdx = 0; lBeginIdx != nbOfWords; ++lBeginIdx) {
+        for (NbOfWords_T lEndIdx = lBeginIdx + 1; lEndIdx <= nbOfWords;
+             ++lEndIdx) {
           //
-          const std::string lQueryString (*itString);
+          const std::string& lQueryString =
+            lStringSegmentation.getWordCombination (lBeginIdx, lEndIdx);
+
+          // Check whether that word combination has already been matched
+          // (e.g., "de" in "rio de janeiro de")
+          ResultMap_T::const_iterator itResult = lResultMap.find (lQueryString);
+          if (itResult != lResultMap.end()) {
+            const Result* lResult_ptr = itResult->second;
+            assert (lResult_ptr != NULL);
+            lStringSegmentation.setWeight (lBeginIdx, lEndIdx,
+                                           lResult_ptr->getBestCombinedWeight());
+            continue;
+          }
 
           // DEBUG
           OPENTREP_LOG_DEBUG ("    --------");
@@ -171,31 +188,80 @@ namespace OPENTREP {
           // Create an empty Result object
           Result& lResult = FacResult::instance().create (lQueryString,
                                                           iDatabase);
-      
-          // Add the Result object to the dedicated list.
-          FacResultHolder::initLinkWithResult (lResultHolder, lResult);
+
+          // Register the Result object, for the other word combinations
+          lResultMap.insert (ResultMap_T::value_type (lQueryString, &lResult));
 
           // Perform the Xapian-based full-text match: the set of
-          // matching documents is filled.
+          // matching documents is filled. The words unknown by the
+          // vocabulary sketch are not searched in the Xapian index.
           const std::string& lMatchedString =
-            lResult.fullTextMatch (iDatabase, lQueryString);
+            lResult.fullTextMatch (iDatabase, iVocabularySketch, lQueryString);
 
           // When a single-word string is unmatched/unknown by/from Xapian,
           // add it to the dedicated list (i.e., ioWordList).
           if (lMatchedString.empty() == true) {
             OPENTREP::addUnmatchedWord (lQueryString, ioWordList, lWordSet);
           }
+
+          // Calculate/set all the weights for all the matching documents
+          lResult.calculateEnvelopeWeights();
+          lResult.calculateCodeMatches();
+          lResult.calculatePageRanks();
+          lResult.calculateHeuristicWeights();
+          lResult.calculateCombinedWeights();
+
+          // Store the weight of the word combination
+          lStringSegmentation.setWeight (lBeginIdx, lEndIdx,
+                                         lResult.getBestCombinedWeight());
         }
+      }
 
-        // DEBUG
-        OPENTREP_LOG_DEBUG (std::endl
-                            << "========================================="
-                            << std::endl << "Result holder: "
-                            << lResultHolder.toString() << std::endl
-                            << "========================================="
-                            << std::endl << std::endl);
+      /**
+       * 2. Find the best string partition (segmentation) of the query slice
+       */
+      const StringSet& lStringSet =
+        lStringSegmentation.calculateBestSegmentation();
+
+      // DEBUG
+      OPENTREP_LOG_DEBUG ("  ==========");
+      OPENTREP_LOG_DEBUG ("  String set: " << lStringSet);
+
+      /**
+       * 3. Create the ResultHolder object for the best string partition,
+       *    and link it with the Result objects of its word combinations.
+       */
+      ResultHolder& lResultHolder =
+        FacResultHolder::instance().create (lStringSet.describe(), iDatabase);
+
+      // Add the ResultHolder object to the dedicated list.
+      FacResultCombination::initLinkWithResultHolder (ioResultCombination,
+                                                      lResultHolder);
+
+      // Browse through all the word combinations of the partition
+      for (StringSet::StringSet_T::const_iterator itString =
+             lStringSet._set.begin();
+           itString != lStringSet._set.end(); ++itString) {
+        const std::string& lQueryString = *itString;
+
+        // Retrieve the (already full-text matched) Result object
+        ResultMap_T::const_iterator itResult = lResultMap.find (lQueryString);
+        assert (itResult != lResultMap.end());
+        Result* lResult_ptr = itResult->second;
+        assert (lResult_ptr != NULL);
+
+        // Add the Result object to the dedicated list.
+        FacResultHolder::initLinkWithResult (lResultHolder, *lResult_ptr);
       }
 
+      // DEBUG
+      OPENTREP_LOG_DEBUG (std::endl
+                          << "========================================="
+                          << std::endl << "Result holder: "
+                          << lResultHolder.toString() << std::endl
+                          << "========================================="
+                          << std::endl << std::endl);
+
       // DEBUG
       OPENTREP_LOG_DEBUG ("*********************");
 
@@ -319,12 +385,155 @@ namespace OPENTREP {
     return oLocation;
   }
   
+  /**
+   * Add, to the given list, the location held by the given Xapian document.
+   */
+  // //////////////////////////////////////////////////////////////////////
+  void addLocationFromDocument (const Xapian::Database& iXapianDatabase,
+                                const Xapian::docid& iDocID,
+                                const std::string& iCode,
+                                LocationList_T& ioLocationList) {
+    const Xapian::Document& lDocument = iXapianDatabase.get_document (iDocID);
+    Location lLocation = *Result::getLocation (lDocument);
+    lLocation.setCorrectedKeywords (iCode);
+    ioLocationList.push_back (lLocation);
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("[" << iCode << "] " << lLocation);
+  }
+
+  /**
+   * Return the list of locations/places corresponding to the given
+   * IATA/ICAO/UNLOCODE codes or Geonames IDs, as found in the in-memory
+   * dictionary of codes. Neither the SQL database nor the full-text
+   * search is used.
+   *
+   * @param const Xapian::Database& Xapian database/index.
+   * @param const CodeDictionary& Dictionary of the codes of that index.
+   * @param const WordList_T& List of IATA/ICAO/UNLOCODE codes or Geonames ID
+   *        (e.g., "sna 5391989 6299418 los chi cnshg lso rek lfmn iev mow").
+   * @param LocationList_T& The matching (geographical) locations, if any,
+   *                        are added to that list.
+   * @return NbOfMatches_T Number of matches.
+   */
+  // //////////////////////////////////////////////////////////////////////
+  NbOfMatches_T getLocationList (const Xapian::Database& iXapianDatabase,
+                                 const CodeDictionary& iCodeDictionary,
+                                 const WordList_T& iCodeList,
+                                 LocationList_T& ioLocationList) {
+    NbOfMatches_T oNbOfMatches = 0;
+
+    // The regular expressions are compiled only once, and may be used
+    // concurrently
+    static const boost::regex lIATACodeExp ("^[[:alpha:]]{3}$");
+    static const boost::regex lICAOCodeExp ("^([[:alpha:]]|[[:digit:]]){4}$");
+    static const boost::regex
+      lUNLOCodeExp ("^[[:alpha:]]{2}([[:alpha:]]|[[:digit:]]){3}$");
+    static const boost::regex lGeoIDCodeExp ("^[[:digit:]]{1,12}$");
+
+    // Browse the list of words/items
+    for (WordList_T::const_iterator itWord = iCodeList.begin();
+         itWord != iCodeList.end(); ++itWord) {
+      const std::string& lWord = *itWord;
+
+      // IATA code: only the POR having the highest PageRank value is kept
+      if (regex_match (lWord, lIATACodeExp) == true) {
+        Xapian::docid lDocID = 0;
+        if (iCodeDictionary.findIataCode (lWord, lDocID) == true) {
+          addLocationFromDocument (iXapianDatabase, lDocID, lWord,
+                                   ioLocationList);
+          ++oNbOfMatches;
+        }
+        continue;
+      }
+
+      // ICAO code: all the POR are kept
+      if (regex_match (lWord, lICAOCodeExp) == true) {
+        const CodeDictionary::DocIDList_T& lDocIDList =
+          iCodeDictionary.findIcaoCode (lWord);
+        for (CodeDictionary::DocIDList_T::const_iterator itDocID =
+               lDocIDList.begin(); itDocID != lDocIDList.end(); ++itDocID) {
+          addLocationFromDocument (iXapianDatabase, *itDocID, lWord,
+                                   ioLocationList);
+          ++oNbOfMatches;
+        }
+        continue;
+      }
+
+      // UN/LOCODE code: only the POR having the highest PageRank value
+      // is kept
+      if (regex_match (lWord, lUNLOCodeExp) == true) {
+        Xapian::docid lDocID = 0;
+        if (iCodeDictionary.findUNLOCode (lWord, lDocID) == true) {
+          addLocationFromDocument (iXapianDatabase, lDocID, lWord,
+                                   ioLocationList);
+          ++oNbOfMatches;
+        }
+        continue;
+      }
+
+      // Geonames ID: all the POR are kept
+      if (regex_match (lWord, lGeoIDCodeExp) == true) {
+        try {
+          // Convert the character string into a number
+          const GeonamesID_T lGeonamesID =
+            boost::lexical_cast<GeonamesID_T> (lWord);
+
+          const CodeDictionary::DocIDList_T& lDocIDList =
+            iCodeDictionary.findGeonamesID (lGeonamesID);
+          for (CodeDictionary::DocIDList_T::const_iterator itDocID =
+                 lDocIDList.begin(); itDocID != lDocIDList.end(); ++itDocID) {
+            addLocationFromDocument (iXapianDatabase, *itDocID, lWord,
+                                     ioLocationList);
+            ++oNbOfMatches;
+          }
+
+        } catch (boost::bad_lexical_cast& eCast) {
+          OPENTREP_LOG_ERROR ("The Geoname ID ('" << lWord
+                              << "') cannot be understood.");
+        }
+      }
+    }
+
+    return oNbOfMatches;
+  }
+
+  /**
+   * Move the lists of locations, retrieved for a given kind of code,
+   * to the lists of locations of the corresponding words.
+   *
+   * @param const std::vector<std::size_t>& Positions, within the query,
+   *        of the words corresponding to that kind of code.
+   * @param LocationListList_T& Lists of locations, one per such word.
+   * @param LocationListList_T& Lists of locations, one per word of
+   *        the query.
+   */
+  // //////////////////////////////////////////////////////////////////////
+  void dispatchLocationLists (const std::vector<std::size_t>& iWordIdxList,
+                              LocationListList_T& ioLocationListList,
+                              LocationListList_T& ioWordLocationListList) {
+    assert (iWordIdxList.size() == ioLocationListList.size());
+    LocationListList_T::iterator itLocationList = ioLocationListList.begin();
+    for (std::vector<std::size_t>::const_iterator itWordIdx =
+           iWordIdxList.begin(); itWordIdx != iWordIdxList.end();
+         ++itWordIdx, ++itLocationList) {
+      const std::size_t& lWordIdx = *itWordIdx;
+      assert (lWordIdx < ioWordLocationListList.size());
+      LocationList_T& lWordLocationList = ioWordLocationListList[lWordIdx];
+      lWordLocationList.splice (lWordLocationList.end(), *itLocationList);
+    }
+  }
+
   /**
    * Return the list of locations/places corresponding
    * to the given IATA/ICAO/UNLOCODE codes or Geonames IDs.
    *
-   * @param const DBType& SQL database type (can be no database at all).
-   * @param const SQLDBConnectionString_T& SQL DB connection string.
+   * A single connection is leased from the pool for all the codes, and
+   * a single SQL request is performed per kind of code (e.g., one for all
+   * the IATA codes), rather than one per code. The matching locations are
+   * then added in the order of the codes within the query.
+   *
+   * @param DBConnectionPool& Pool of connections to the SQL database.
    * @param const WordList_T& List of IATA/ICAO/UNLOCODE codes or Geonames ID
    *        (e.g., "sna 5391989 6299418 los chi cnshg lso rek lfmn iev mow").
    * @param LocationList_T& The matching (geographical) locations, if any,
@@ -333,89 +542,65 @@ namespace OPENTREP {
    * @return NbOfMatches_T Number of matches.
    */
   // //////////////////////////////////////////////////////////////////////
-  NbOfMatches_T getLocationList (const DBType& iSQLDBType,
-                                 const SQLDBConnectionString_T& iSQLDBConnStr,
+  NbOfMatches_T getLocationList (DBConnectionPool& ioDBConnectionPool,
                                  const WordList_T& iCodeList,
                                  LocationList_T& ioLocationList,
                                  WordList_T& ioWordList) {
     NbOfMatches_T oNbOfMatches = 0;
 
-    // Connect to the SQL database/file
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (iSQLDBType, iSQLDBConnStr);
-    if (lSociSession_ptr == NULL) {
-      std::ostringstream oStr;
-      oStr << "The " << iSQLDBType.describe()
-           << " database is not accessible. Connection string: "
-           << iSQLDBConnStr << std::endl
-           << "Hint: launch the 'opentrep-dbmgr' program and "
-           << "see the 'tutorial' command.";
-      OPENTREP_LOG_ERROR (oStr.str());
-      throw SQLDatabaseImpossibleConnectionException (oStr.str());
-    }
-    assert (lSociSession_ptr != NULL);
-
-    // Browse the list of words/items
+    // The regular expressions are compiled only once, and may be used
+    // concurrently
+    static const boost::regex lIATACodeExp ("^[[:alpha:]]{3}$");
+    static const boost::regex lICAOCodeExp ("^([[:alpha:]]|[[:digit:]]){4}$");
+    static const boost::regex
+      lUNLOCodeExp ("^[[:alpha:]]{2}([[:alpha:]]|[[:digit:]]){3}$");
+    static const boost::regex lGeoIDCodeExp ("^[[:digit:]]{1,12}$");
+
+    // Sort the words/items per kind of code, keeping track of their
+    // positions within the query
+    IATACodeList_T lIATACodeList;
+    std::vector<std::size_t> lIATACodeIdxList;
+    ICAOCodeList_T lICAOCodeList;
+    std::vector<std::size_t> lICAOCodeIdxList;
+    UNLOCodeList_T lUNLOCodeList;
+    std::vector<std::size_t> lUNLOCodeIdxList;
+    GeonamesIDList_T lGeonamesIDList;
+    std::vector<std::size_t> lGeonamesIDIdxList;
+
+    std::size_t idx = 0;
     for (WordList_T::const_iterator itWord = iCodeList.begin();
-         itWord != iCodeList.end(); ++itWord) {
+         itWord != iCodeList.end(); ++itWord, ++idx) {
       const std::string& lWord = *itWord;
 
       // Check for IATA code: alpha{3}
-      const boost::regex lIATACodeExp ("^[[:alpha:]]{3}$");
-      const bool lMatchesWithIATACode = regex_match (lWord, lIATACodeExp);
-      if (lMatchesWithIATACode == true) {
-        // Perform the select statement on the underlying SQL database
-        const IATACode_T lIATACode (lWord);
-        const bool lUniqueEntry = true;
-        const NbOfDBEntries_T& lNbOfEntries =
-          DBManager::getPORByIATACode (*lSociSession_ptr, lIATACode,
-                                       ioLocationList, lUniqueEntry);
-        oNbOfMatches += lNbOfEntries;
+      if (regex_match (lWord, lIATACodeExp) == true) {
+        lIATACodeList.push_back (IATACode_T (lWord));
+        lIATACodeIdxList.push_back (idx);
         continue;
       }
 
       // Check for ICAO code: (alpha|digit){4}
-      const boost::regex lICAOCodeExp ("^([[:alpha:]]|[[:digit:]]){4}$");
-      const bool lMatchesWithICAOCode = regex_match (lWord, lICAOCodeExp);
-      if (lMatchesWithICAOCode == true) {
-        // Perform the select statement on the underlying SQL database
-        const ICAOCode_T lICAOCode (lWord);
-        const NbOfDBEntries_T& lNbOfEntries =
-          DBManager::getPORByICAOCode (*lSociSession_ptr, lICAOCode,
-                                       ioLocationList);
-        oNbOfMatches += lNbOfEntries;
+      if (regex_match (lWord, lICAOCodeExp) == true) {
+        lICAOCodeList.push_back (ICAOCode_T (lWord));
+        lICAOCodeIdxList.push_back (idx);
         continue;
       }
 
       // Check for UN/LOCODE code: alpha{2}(alpha|digit){3}
-      const boost::regex
-        lUNLOCodeExp ("^[[:alpha:]]{2}([[:alpha:]]|[[:digit:]]){3}$");
-      const bool lMatchesWithUNLOCode = regex_match (lWord, lUNLOCodeExp);
-      if (lMatchesWithUNLOCode == true) {
-        // Perform the select statement on the underlying SQL database
-        const UNLOCode_T lUNLOCode (lWord);
-        const bool lUniqueEntry = true;
-        const NbOfDBEntries_T& lNbOfEntries =
-          DBManager::getPORByUNLOCode (*lSociSession_ptr, lUNLOCode,
-                                       ioLocationList, lUniqueEntry);
-        oNbOfMatches += lNbOfEntries;
+      if (regex_match (lWord, lUNLOCodeExp) == true) {
+        lUNLOCodeList.push_back (UNLOCode_T (lWord));
+        lUNLOCodeIdxList.push_back (idx);
         continue;
-      }      
+      }
 
       // Check for Geonames ID: digit{1,12}
-      const boost::regex lGeoIDCodeExp ("^[[:digit:]]{1,12}$");
-      const bool lMatchesWithGeoID = regex_match (lWord, lGeoIDCodeExp);
-      if (lMatchesWithGeoID == true) {
+      if (regex_match (lWord, lGeoIDCodeExp) == true) {
         try {
           // Convert the character string into a number
           const GeonamesID_T lGeonamesID =
             boost::lexical_cast<GeonamesID_T> (lWord);
-          
-          // Perform the select statement on the underlying SQL database
-          const NbOfDBEntries_T& lNbOfEntries =
-            DBManager::getPORByGeonameID (*lSociSession_ptr, lGeonamesID,
-                                          ioLocationList);
-          oNbOfMatches += lNbOfEntries;
+          lGeonamesIDList.push_back (lGeonamesID);
+          lGeonamesIDIdxList.push_back (idx);
 
         } catch (boost::bad_lexical_cast& eCast) {
           OPENTREP_LOG_ERROR ("The Geoname ID ('" << lWord
@@ -424,14 +609,71 @@ namespace OPENTREP {
       }
     }
 
+    // Lease a connection to the SQL database/file. It is given back to
+    // the pool when leaving that function
+    DBConnectionLease lDBConnectionLease (ioDBConnectionPool);
+    DBConnection& lDBConnection = lDBConnectionLease.getDBConnection();
+
+    // Perform a single select statement on the underlying SQL database
+    // per kind of code. Only the POR having the highest PageRank value
+    // is kept for the IATA and UN/LOCODE codes
+    LocationListList_T lWordLocationListList (iCodeList.size());
+    const bool lUniqueEntry = true;
+
+    if (lIATACodeList.empty() == false) {
+      LocationListList_T lLocationListList;
+      oNbOfMatches += DBManager::getPORByIATACodeList (lDBConnection,
+                                                       lIATACodeList,
+                                                       lLocationListList,
+                                                       lUniqueEntry);
+      dispatchLocationLists (lIATACodeIdxList, lLocationListList,
+                             lWordLocationListList);
+    }
+
+    if (lICAOCodeList.empty() == false) {
+      LocationListList_T lLocationListList;
+      oNbOfMatches += DBManager::getPORByICAOCodeList (lDBConnection,
+                                                       lICAOCodeList,
+                                                       lLocationListList);
+      dispatchLocationLists (lICAOCodeIdxList, lLocationListList,
+                             lWordLocationListList);
+    }
+
+    if (lUNLOCodeList.empty() == false) {
+      LocationListList_T lLocationListList;
+      oNbOfMatches += DBManager::getPORByUNLOCodeList (lDBConnection,
+                                                       lUNLOCodeList,
+                                                       lLocationListList,
+                                                       lUniqueEntry);
+      dispatchLocationLists (lUNLOCodeIdxList, lLocationListList,
+                             lWordLocationListList);
+    }
+
+    if (lGeonamesIDList.empty() == false) {
+      LocationListList_T lLocationListList;
+      oNbOfMatches += DBManager::getPORByGeonameIDList (lDBConnection,
+                                                        lGeonamesIDList,
+                                                        lLocationListList);
+      dispatchLocationLists (lGeonamesIDIdxList, lLocationListList,
+                             lWordLocationListList);
+    }
+
+    // Add the locations in the order of the words/items of the query
+    for (LocationListList_T::iterator itLocationList =
+           lWordLocationListList.begin();
+         itLocationList != lWordLocationListList.end(); ++itLocationList) {
+      ioLocationList.splice (ioLocationList.end(), *itLocationList);
+    }
+
     return oNbOfMatches;
   }
 
   // //////////////////////////////////////////////////////////////////////
   NbOfMatches_T RequestInterpreter::
-  interpretTravelRequest (const TravelDBFilePath_T& iTravelDBFilePath,
-                          const DBType& iSQLDBType,
-                          const SQLDBConnectionString_T& iSQLDBConnStr,
+  interpretTravelRequest (const Xapian::Database& iXapianDatabase,
+                          const CodeDictionary& iCodeDictionary,
+                          const VocabularySketch& iVocabularySketch,
+                          DBConnectionPool* ioDBConnectionPool_ptr,
                           const TravelQuery_T& iTravelQuery,
                           LocationList_T& ioLocationList,
                           WordList_T& ioWordList,
@@ -441,24 +683,16 @@ namespace OPENTREP {
     // Sanity check
     assert (iTravelQuery.empty() == false);
 
-    // Check whether the file-path to the Xapian database/index exists
-    // and is a directory.
-    boost::filesystem::path lTravelDBFilePath (iTravelDBFilePath.begin(),
-                                               iTravelDBFilePath.end());
-    if (!(boost::filesystem::exists (lTravelDBFilePath)
-          && boost::filesystem::is_directory (lTravelDBFilePath))) {
-      std::ostringstream oStr;
-      oStr << "The file-path to the Xapian database/index ('"
-           << iTravelDBFilePath << "') does not exist or is not a directory. ";
-      oStr << "That usually means that the OpenTREP indexer (opentrep-indexer) "
-           << "has not been launched yet, or that it has operated "
-           << "on a different Xapian database/index file-path.";
-      OPENTREP_LOG_ERROR (oStr.str());
-      throw FileNotFoundException (oStr.str());
-    }
+    // All the BOM objects (e.g., Result, ResultHolder, ResultCombination,
+    // Place, PlaceHolder) created for that travel request are allocated
+    // from that arena, and released in bulk when the request has been
+    // interpreted (or when an exception is thrown).
+    BomArena lBomArena;
 
-    // Open the Xapian database
-    Xapian::Database lXapianDatabase (iTravelDBFilePath);
+    // The Location structures parsed from the Xapian documents are kept,
+    // for the duration of that travel request, so that every document be
+    // parsed only once, whatever the number of times it is scored.
+    LocationCache lLocationCache;
 
     // DEBUG
     OPENTREP_LOG_DEBUG (std::endl
@@ -466,7 +700,8 @@ namespace OPENTREP {
       
     // First, cut the travel query in slices and calculate all the partitions
     // for each of those query slices
-    QuerySlices lQuerySlices (lXapianDatabase, iTravelQuery, iTransliterator);
+    QuerySlices lQuerySlices (iXapianDatabase, iVocabularySketch,
+                              iTravelQuery, iTransliterator);
 
     // DEBUG
     OPENTREP_LOG_DEBUG ("+=+=+=+=+=+=+=+=+=+=+=+=+=+=+");
@@ -479,13 +714,11 @@ namespace OPENTREP {
     OPENTREP_LOG_DEBUG ("Query slices: `" << lQuerySlices << "'");
 
     // Browse the travel query slices
-    const StringPartitionList_T& lStringPartitionList =
-      lQuerySlices.getStringPartitionList();
-    for (StringPartitionList_T::const_iterator itSlice =
-           lStringPartitionList.begin();
-         itSlice != lStringPartitionList.end(); ++itSlice) {
-      StringPartition lStringPartition = *itSlice;
-      const std::string& lTravelQuerySlice = lStringPartition.getInitialString();
+    const StringSet& lQuerySliceList = lQuerySlices.getQuerySliceList();
+    for (StringSet::StringSet_T::const_iterator itSlice =
+           lQuerySliceList._set.begin();
+         itSlice != lQuerySliceList._set.end(); ++itSlice) {
+      const std::string& lTravelQuerySlice = *itSlice;
 
       /**
        * 0. Initialisation
@@ -498,7 +731,6 @@ namespace OPENTREP {
       // DEBUG
       OPENTREP_LOG_DEBUG ("+++++++++++++++++++++");
       OPENTREP_LOG_DEBUG ("Travel query slice: `" << lTravelQuerySlice << "'");
-      OPENTREP_LOG_DEBUG ("Partitions: " << lStringPartition);
 
 
       /**
@@ -510,22 +742,42 @@ namespace OPENTREP {
         areAllCodeOrGeoID (lTravelQuerySlice, lCodeList);
 
       NbOfMatches_T lNbOfMatches = 0;
-      if (areAllWordsCodes == true && !(iSQLDBType == DBType::NODB)) {
+      if (areAllWordsCodes == true) {
         /**
          * All the words/items of the travel query are either
          * IATA/ICAO/UNLOCODE codes or Geonames ID. The corresponding details
-         * will be retrieved directly from the underlying database,
-         * if existing. The Xapian database/index is not used.
+         * are retrieved directly from the in-memory dictionary of codes,
+         * whatever the SQL database type. The full-text search is not used.
+         */
+        // DEBUG
+        OPENTREP_LOG_DEBUG ("The travel query string (" << lTravelQuerySlice
+                            << ") is made only of IATA/ICAO/UNLOCODE codes "
+                            << "or Geonames ID. The in-memory dictionary of "
+                            << "codes will be used");
+
+        lNbOfMatches = getLocationList (iXapianDatabase, iCodeDictionary,
+                                        lCodeList, ioLocationList);
+      }
+
+      if (lNbOfMatches == 0 && areAllWordsCodes == true
+          && ioDBConnectionPool_ptr != NULL) {
+        /**
+         * None of the codes is known by the Xapian index. The corresponding
+         * details are retrieved from the underlying SQL database, if
+         * existing (it may have been filled from another POR file).
+         * The Xapian database/index is not used.
          */
         // DEBUG
         OPENTREP_LOG_DEBUG ("The travel query string (" << lTravelQuerySlice
                             << ") is made only of IATA/ICAO/UNLOCODE codes "
-                            << "or Geonames ID. The " << iSQLDBType.describe()
-                            << " SQL database (" << iSQLDBConnStr
+                            << "or Geonames ID. The "
+                            << ioDBConnectionPool_ptr->getSQLDBType().describe()
+                            << " SQL database ("
+                            << ioDBConnectionPool_ptr->getSQLDBConnectionString()
                             << ") will be used. "
                             << "The Xapian database/index will not be used");
 
-        lNbOfMatches = getLocationList (iSQLDBType, iSQLDBConnStr, lCodeList,
+        lNbOfMatches = getLocationList (*ioDBConnectionPool_ptr, lCodeList,
                                         ioLocationList, ioWordList);
       }
 
@@ -541,7 +793,7 @@ namespace OPENTREP {
          * The Xapian database/index must therefore be used.
          */
         // DEBUG
-        if (iSQLDBType == DBType::NODB) {
+        if (ioDBConnectionPool_ptr == NULL) {
           OPENTREP_LOG_DEBUG ("No SQL database may be used. "
                               << "The Xapian database will be used instead");
         } else {
@@ -552,11 +804,12 @@ namespace OPENTREP {
         }
 
         /**
-         * 1.1. Perform all the full-text matches, and fill accordingly the
-         *      list of Result instances.
+         * 1.1. Perform all the full-text matches, fill accordingly the
+         *      list of Result instances, and find the best string partition.
          */
-        OPENTREP::searchString (lTravelQuerySlice, lXapianDatabase,
-                                lResultCombination, ioWordList);
+        OPENTREP::searchString (lTravelQuerySlice, iXapianDatabase,
+                                iVocabularySketch, lResultCombination,
+                                ioWordList);
 
         /**
          * 1.2. Calculate/set all the weights for all the matching documents
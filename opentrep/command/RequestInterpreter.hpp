@@ -8,10 +8,18 @@
 #include <opentrep/OPENTREP_Types.hpp>
 #include <opentrep/LocationList.hpp>
 
+// Forward declarations
+namespace Xapian {
+  class Database;
+}
+
 namespace OPENTREP {
 
   // Forward declarations
   class OTransliterator;
+  class CodeDictionary;
+  class VocabularySketch;
+  class DBConnectionPool;
 
   /**
    * @brief Command wrapping the travel request process.
@@ -37,9 +45,20 @@ namespace OPENTREP {
      * including a full-text search on the underlying Xapian index (named
      * "database"). A list of locations/places is returned.
      *
-     * @param const TravelDBFilePath_T& Filepath to the Xapian database.
-     * @param const DBType& SQL database type (can be no database at all).
-     * @param const SQLDBConnectionString_T& SQL DB connection string.
+     * When the query is made only of codes (IATA, ICAO, UN/LOCODE) and
+     * Geonames IDs, the matching locations are retrieved from the given
+     * dictionary of codes (and, failing that, from the SQL database, through
+     * a connection leased from the given pool), rather than with
+     * a full-text search.
+     *
+     * @param const Xapian::Database& Xapian database/index (already opened).
+     * @param const CodeDictionary& In-memory dictionary of the codes of
+     *        that Xapian database/index.
+     * @param const VocabularySketch& Vocabulary sketch of that Xapian
+     *        database/index, sparing the full-text searches which cannot
+     *        match (e.g., because of unknown words).
+     * @param DBConnectionPool* Pool of connections to the SQL database
+     *        (NULL when there is no SQL database).
      * @param const std::string& (Travel-related) query string (e.g.,
      *        "sna francicso rio de janero lso angles reykyavki nce iev mow").
      * @param LocationList_T& List of (geographical) locations, if any,
@@ -48,9 +67,10 @@ namespace OPENTREP {
      * @param const OTransliterator& Unicode transliterator.
      * @return NbOfMatches_T Number of matches.
      */
-    static NbOfMatches_T interpretTravelRequest (const TravelDBFilePath_T&,
-                                                 const DBType&,
-                                                 const SQLDBConnectionString_T&,
+    static NbOfMatches_T interpretTravelRequest (const Xapian::Database&,
+                                                 const CodeDictionary&,
+                                                 const VocabularySketch&,
+                                                 DBConnectionPool*,
                                                  const TravelQuery_T&,
                                                  LocationList_T&, WordList_T&,
                                                  const OTransliterator&);
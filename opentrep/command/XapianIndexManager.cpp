@@ -8,7 +8,6 @@
 #include <vector>
 #include <exception>
 // Boost
-#include <boost/filesystem.hpp>
 #include <boost/random/random_device.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 // Xapian
@@ -22,37 +21,13 @@
 
 namespace OPENTREP {
 
-  // //////////////////////////////////////////////////////////////////////
-  boost::filesystem::path
-  checkTravelDBFilePath (const TravelDBFilePath_T& iTravelDBFilePath) {
-    boost::filesystem::path oTravelDBFilePath (iTravelDBFilePath.begin(),
-                                               iTravelDBFilePath.end());
-    if (!(boost::filesystem::exists (oTravelDBFilePath)
-          && boost::filesystem::is_directory (oTravelDBFilePath))) {
-      std::ostringstream oStr;
-      oStr << "The file-path to the Xapian database/index ('"
-           << iTravelDBFilePath << "') does not exist or is not a directory.";
-      OPENTREP_LOG_ERROR (oStr.str());
-      throw FileNotFoundException (oStr.str());
-    }
-
-    return oTravelDBFilePath;
-  }
-
   // //////////////////////////////////////////////////////////////////////
   NbOfDBEntries_T XapianIndexManager::
-  getSize (const TravelDBFilePath_T& iTravelDBFilePath) {
+  getSize (const Xapian::Database& iXapianDatabase) {
     NbOfDBEntries_T oNbOfDBEntries = 0;
 
-    // Check whether the file-path to the Xapian database/index exists
-    // and is a directory.
-    checkTravelDBFilePath (iTravelDBFilePath);
-
-    // Open the Xapian database
-    Xapian::Database lXapianDatabase (iTravelDBFilePath);
-
     // Retrieve the actual number of documents indexed by the Xapian database
-    const Xapian::doccount& lDocCount = lXapianDatabase.get_doccount();
+    const Xapian::doccount& lDocCount = iXapianDatabase.get_doccount();
 
     //
     oNbOfDBEntries = static_cast<const NbOfDBEntries_T> (lDocCount);
@@ -62,20 +37,13 @@ namespace OPENTREP {
   
   // //////////////////////////////////////////////////////////////////////
   NbOfMatches_T XapianIndexManager::
-  drawRandomLocations (const TravelDBFilePath_T& iTravelDBFilePath,
+  drawRandomLocations (const Xapian::Database& iXapianDatabase,
                        const NbOfMatches_T& iNbOfDraws,
                        LocationList_T& ioLocationList) {
     NbOfMatches_T oNbOfMatches = 0;
 
-    // Check whether the file-path to the Xapian database/index exists
-    // and is a directory.
-    checkTravelDBFilePath (iTravelDBFilePath);
-
-    // Open the Xapian database
-    Xapian::Database lXapianDatabase (iTravelDBFilePath);
-
     // Retrieve the number of documents indexed by the database
-    const NbOfDBEntries_T& lTotalNbOfDocs = getSize (iTravelDBFilePath);
+    const NbOfDBEntries_T& lTotalNbOfDocs = getSize (iXapianDatabase);
 
     // No need to go further when the Xapian database (index) is empty
     if (lTotalNbOfDocs == 0) {
@@ -96,7 +64,7 @@ namespace OPENTREP {
       Xapian::docid lDocID = static_cast<Xapian::docid> (lRandomNbInt);
 
       // Retrieve the document from the Xapian database/index
-      Xapian::termcount lDocLength = lXapianDatabase.get_doclength (lDocID);
+      Xapian::termcount lDocLength = iXapianDatabase.get_doclength (lDocID);
 
       unsigned short currentNbOfIterations = 0;
       while (lDocLength == 0 && currentNbOfIterations <= 100) {
@@ -110,7 +78,7 @@ namespace OPENTREP {
         lDocID = static_cast<Xapian::docid> (lRandomNbInt);
 
         // Retrieve the document from the Xapian database/index
-        lDocLength = lXapianDatabase.get_doclength (lDocID);
+        lDocLength = iXapianDatabase.get_doclength (lDocID);
       }
 
       // Bad luck: no document ID can be generated so that it corresponds to
@@ -123,7 +91,7 @@ namespace OPENTREP {
 
       } else {
         // Retrieve the actual document.
-	const Xapian::Document lDoc = lXapianDatabase.get_document (lDocID);
+	const Xapian::Document lDoc = iXapianDatabase.get_document (lDocID);
         const std::string& lDocDataStr = lDoc.get_data();
         const RawDataString_T& lDocData = RawDataString_T (lDocDataStr);
 
@@ -8,6 +8,11 @@
 #include <opentrep/OPENTREP_Types.hpp>
 #include <opentrep/LocationList.hpp>
 
+// Forward declarations
+namespace Xapian {
+  class Database;
+}
+
 namespace OPENTREP {
 
   /**
@@ -21,20 +26,20 @@ namespace OPENTREP {
      * Give the number of documents indexed by the Xapian index
      * (named "database").
      *
-     * @param const TravelDBFilePath_T& Filepath to the Xapian database.
+     * @param const Xapian::Database& Xapian database/index (already opened).
      * @return NbOfDBEntries_T Number of entries in the database.
      */
-    static NbOfDBEntries_T getSize (const TravelDBFilePath_T&);
+    static NbOfDBEntries_T getSize (const Xapian::Database&);
 
     /**
      * Randomly draw a given number of documents from the Xapian index
      * (named "database").
      *
-     * @param const TravelDBFilePath_T& Filepath to the Xapian database.
+     * @param const Xapian::Database& Xapian database/index (already opened).
      * @param LocationList_T& List of Location structures randomly picked-up.
      * @return const NbOfMatches_T& Number of locations to randomly pick-up.
      */
-    static NbOfMatches_T drawRandomLocations (const TravelDBFilePath_T&,
+    static NbOfMatches_T drawRandomLocations (const Xapian::Database&,
                                               const NbOfMatches_T& iNbOfDraws,
                                               LocationList_T&);
 
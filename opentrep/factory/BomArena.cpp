@@ -0,0 +1,61 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// C
+#include <cassert>
+// OpenTrep
+#include <opentrep/bom/BomAbstract.hpp>
+#include <opentrep/factory/BomArena.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * Size of the first block of memory of the arena (e.g., 64 kB). That
+   * block is big enough for the BOM objects of most of the travel requests;
+   * bigger blocks are allocated afterwards, if needed.
+   */
+  static const std::size_t K_BOM_ARENA_INITIAL_SIZE (64 * 1024);
+
+  thread_local BomArena* BomArena::_currentArena = NULL;
+
+  // //////////////////////////////////////////////////////////////////////
+  BomArena::BomArena()
+    : _previousArena (_currentArena),
+      _memoryResource (K_BOM_ARENA_INITIAL_SIZE) {
+    _currentArena = this;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  BomArena::~BomArena() {
+    clean();
+
+    // Arenas are scoped: the one being destroyed is the current one
+    assert (_currentArena == this);
+    _currentArena = _previousArena;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void BomArena::push_back (BomAbstract* ioBom_ptr) {
+    assert (ioBom_ptr != NULL);
+    _bomList.push_back (ioBom_ptr);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void BomArena::clean() {
+    // Destroy the BOM objects, in the reverse order of their creation.
+    // As they have been constructed in place, only their destructors are
+    // called: the memory is given back below, all at once.
+    for (BomList_T::reverse_iterator itBom = _bomList.rbegin();
+         itBom != _bomList.rend(); ++itBom) {
+      BomAbstract* lBom_ptr = *itBom;
+      assert (lBom_ptr != NULL);
+
+      lBom_ptr->~BomAbstract();
+    }
+    _bomList.clear();
+
+    // Release all the memory in bulk
+    _memoryResource.release();
+  }
+
+}
@@ -0,0 +1,154 @@
+#ifndef __OPENTREP_FAC_BOMARENA_HPP
+#define __OPENTREP_FAC_BOMARENA_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstddef>
+#include <vector>
+#include <new>
+#include <memory_resource>
+// OpenTrep
+#include <opentrep/factory/FacBomAbstract.hpp>
+
+namespace OPENTREP {
+
+  // Forward declarations
+  class BomAbstract;
+
+  /**
+   * @brief Arena (memory pool) for the BOM objects of a single request.
+   *
+   * As long as a BomArena object is alive, it is the current arena of
+   * the thread which has created it. The request-scoped factories (e.g.,
+   * FacResult, FacResultHolder, FacResultCombination, FacPlace and
+   * FacPlaceHolder) then allocate the BOM objects from that arena, rather
+   * than adding them to the process-lifetime pool of the factory
+   * (FacBomAbstract::_pool).
+   *
+   * When the arena goes out of scope (typically, when the travel request
+   * has been interpreted, or when an exception has been thrown), all the
+   * BOM objects allocated from it are destroyed, and the memory is
+   * released in bulk.
+   *
+   * Arenas may be nested: the previous current arena of the thread is
+   * restored when the nested one goes out of scope.
+   */
+  class BomArena {
+  public:
+    // ////////////// Type definitions /////////////
+    /** List of the BOM objects allocated from the arena. */
+    typedef std::vector<BomAbstract*> BomList_T;
+
+  public:
+    /**
+     * Get the current arena of the calling thread.
+     *
+     * @return BomArena* The current arena, or NULL when there is none.
+     */
+    static BomArena* getCurrent() {
+      return _currentArena;
+    }
+
+    /**
+     * Allocate (uninitialised) memory for a BOM object of the given type.
+     * The object must then be constructed in place (with a placement new),
+     * and registered with the push_back() method.
+     */
+    template <typename BOM>
+    void* allocate() {
+      // Make room beforehand, so that the registration cannot fail. The
+      // capacity is doubled, so that the BOM list is re-allocated only
+      // a logarithmic number of times
+      if (_bomList.size() == _bomList.capacity()) {
+        _bomList.reserve (2 * _bomList.capacity() + 1);
+      }
+      return _memoryResource.allocate (sizeof (BOM), alignof (BOM));
+    }
+
+    /**
+     * Register a BOM object, constructed within the memory given by
+     * allocate(), so that it be destroyed along with the arena.
+     */
+    void push_back (BomAbstract*);
+
+    /**
+     * Create a BOM object of the given type, with the given arguments of
+     * its constructor. The object is allocated from the current arena of
+     * the calling thread, if any. Otherwise, it is allocated on the heap
+     * and added to the Bom pool of the given (calling) factory.
+     *
+     * The BOM class must grant friendship to BomArena, so that its
+     * (private) constructors be reachable.
+     */
+    template <typename BOM, typename... Args>
+    static BOM& create (FacBomAbstract& ioFactory, const Args&... iArgs) {
+      BOM* oBom_ptr = NULL;
+
+      BomArena* lBomArena_ptr = getCurrent();
+      if (lBomArena_ptr != NULL) {
+        void* lMemory_ptr = lBomArena_ptr->allocate<BOM>();
+        oBom_ptr = new (lMemory_ptr) BOM (iArgs...);
+        lBomArena_ptr->push_back (oBom_ptr);
+
+      } else {
+        oBom_ptr = new BOM (iArgs...);
+        ioFactory.addToPool (oBom_ptr);
+      }
+      assert (oBom_ptr != NULL);
+
+      return *oBom_ptr;
+    }
+
+    /**
+     * Get the number of BOM objects allocated from the arena.
+     */
+    std::size_t size() const {
+      return _bomList.size();
+    }
+
+    /**
+     * Destroy all the BOM objects allocated from the arena, and release
+     * the corresponding memory.
+     */
+    void clean();
+
+  public:
+    /**
+     * Constructor. The new arena becomes the current arena of the
+     * calling thread.
+     */
+    BomArena();
+
+    /**
+     * Destructor. All the BOM objects allocated from the arena are
+     * destroyed, and the previous arena (if any) becomes again the current
+     * arena of the calling thread.
+     */
+    ~BomArena();
+
+  private:
+    /** Arenas are neither copyable nor assignable. */
+    BomArena (const BomArena&);
+    BomArena& operator= (const BomArena&);
+
+  private:
+    /** Current arena of the thread. */
+    static thread_local BomArena* _currentArena;
+
+    /** Arena being the current one when this one was created. */
+    BomArena* _previousArena;
+
+    /**
+     * Memory resource, from which the BOM objects are allocated. The
+     * memory is given back only when the arena is cleaned.
+     */
+    std::pmr::monotonic_buffer_resource _memoryResource;
+
+    /** BOM objects allocated from the arena, in order of creation. */
+    BomList_T _bomList;
+  };
+}
+#endif // __OPENTREP_FAC_BOMARENA_HPP
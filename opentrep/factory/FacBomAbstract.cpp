@@ -32,6 +32,13 @@ namespace OPENTREP {
     _pool.clear();
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  void FacBomAbstract::addToPool (BomAbstract* ioBomAbstract_ptr) {
+    assert (ioBomAbstract_ptr != NULL);
+    std::lock_guard<std::mutex> lGuard (_poolMutex);
+    _pool.push_back (ioBomAbstract_ptr);
+  }
+
   // //////////////////////////////////////////////////////////////////////
   std::size_t FacBomAbstract::getID (const BomAbstract* iBomAbstract_ptr) {
     const void* lPtr = iBomAbstract_ptr;
@@ -7,6 +7,7 @@
 // STL
 #include <string>
 #include <vector>
+#include <mutex>
 
 namespace OPENTREP {
 
@@ -16,6 +17,7 @@ namespace OPENTREP {
   /** Base class for Factory layer. */
   class FacBomAbstract {
     friend class FacSupervisor;
+    friend class BomArena;
   public:
 
     /** Define the list (pool) of Bom objects. */
@@ -44,6 +46,10 @@ namespace OPENTREP {
     /** Destructor. */
     virtual ~FacBomAbstract();
 
+    /** Add a newly instantiated Bom object to the pool. The additions
+        made by concurrent threads are serialised. */
+    void addToPool (BomAbstract*);
+
   private:
     /** Destroyed all the object instantiated by this factory. */
     void clean();
@@ -51,6 +57,9 @@ namespace OPENTREP {
   protected:
     /** List of instantiated Business Objects*/
     BomPool_T _pool;
+
+    /** Mutex serialising the additions to the pool. */
+    std::mutex _poolMutex;
   };
 }
 #endif // __OPENTREP_FAC_FACBOMABSTRACT_HPP
@@ -11,7 +11,8 @@
 
 namespace OPENTREP {
 
-  FacOpenTrepServiceContext* FacOpenTrepServiceContext::_instance = NULL;
+  std::atomic<FacOpenTrepServiceContext*>
+  FacOpenTrepServiceContext::_instance (NULL);
 
   // //////////////////////////////////////////////////////////////////////
   FacOpenTrepServiceContext::~FacOpenTrepServiceContext() {
@@ -20,14 +21,25 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   FacOpenTrepServiceContext& FacOpenTrepServiceContext::instance() {
+    // Once the factory has been created, it is given without any lock
+    FacOpenTrepServiceContext* lInstance_ptr = _instance;
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
+    }
+
+    // Otherwise, its creation is serialised
+    std::lock_guard<std::recursive_mutex>
+      lGuard (FacSupervisor::getInstanceMutex());
+
+    lInstance_ptr = _instance;
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacOpenTrepServiceContext();
+      assert (lInstance_ptr != NULL);
 
-    if (_instance == NULL) {
-      _instance = new FacOpenTrepServiceContext();
-      assert (_instance != NULL);
-      
-      FacSupervisor::instance().registerServiceFactory (_instance);
+      FacSupervisor::instance().registerServiceFactory (lInstance_ptr);
+      _instance = lInstance_ptr;
     }
-    return *_instance;
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -43,7 +55,7 @@ namespace OPENTREP {
     assert (aOPENTREP_ServiceContext_ptr != NULL);
 
     // The new object is added to the Bom pool
-    _pool.push_back (aOPENTREP_ServiceContext_ptr);
+    addToPool (aOPENTREP_ServiceContext_ptr);
 
     return *aOPENTREP_ServiceContext_ptr;
   }
@@ -68,7 +80,7 @@ namespace OPENTREP {
     assert (aOPENTREP_ServiceContext_ptr != NULL);
 
     // The new object is added to the Service pool
-    _pool.push_back (aOPENTREP_ServiceContext_ptr);
+    addToPool (aOPENTREP_ServiceContext_ptr);
 
     return *aOPENTREP_ServiceContext_ptr;
   }
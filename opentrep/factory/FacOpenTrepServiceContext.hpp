@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// STL
+#include <atomic>
 // OpenTrep
 #include <opentrep/DBType.hpp>
 #include <opentrep/factory/FacServiceAbstract.hpp>
@@ -91,7 +93,7 @@ namespace OPENTREP {
     /**
      * The unique instance.
      */
-    static FacOpenTrepServiceContext* _instance;
+    static std::atomic<FacOpenTrepServiceContext*> _instance;
   };
 
 }
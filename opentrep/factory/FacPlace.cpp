@@ -5,12 +5,13 @@
 #include <cassert>
 // OpenTrep
 #include <opentrep/bom/Place.hpp>
+#include <opentrep/factory/BomArena.hpp>
 #include <opentrep/factory/FacSupervisor.hpp>
 #include <opentrep/factory/FacPlace.hpp>
 
 namespace OPENTREP {
 
-  FacPlace* FacPlace::_instance = NULL;
+  std::atomic<FacPlace*> FacPlace::_instance (NULL);
 
   // //////////////////////////////////////////////////////////////////////
   FacPlace::FacPlace() {
@@ -27,66 +28,45 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   FacPlace& FacPlace::instance() {
+    // Once the factory has been created, it is given without any lock
+    FacPlace* lInstance_ptr = _instance;
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
+    }
 
-    if (_instance == NULL) {
-      _instance = new FacPlace();
-      assert (_instance != NULL);
-      
-      FacSupervisor::instance().registerBomFactory (_instance);
+    // Otherwise, its creation is serialised
+    std::lock_guard<std::recursive_mutex>
+      lGuard (FacSupervisor::getInstanceMutex());
+
+    lInstance_ptr = _instance;
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacPlace();
+      assert (lInstance_ptr != NULL);
+
+      FacSupervisor::instance().registerBomFactory (lInstance_ptr);
+      _instance = lInstance_ptr;
     }
-    return *_instance;
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
   Place& FacPlace::create() {
-    Place* oPlace_ptr = NULL;
-
-    oPlace_ptr = new Place();
-    assert (oPlace_ptr != NULL);
-
-    // The new object is added to the Bom pool
-    _pool.push_back (oPlace_ptr);
-
-    return *oPlace_ptr;
+    return BomArena::create<Place> (*this);
   }
 
   // //////////////////////////////////////////////////////////////////////
   Place& FacPlace::create (const LocationKey& iLocationKey) {
-    Place* oPlace_ptr = NULL;
-
-    oPlace_ptr = new Place (iLocationKey);
-    assert (oPlace_ptr != NULL);
-
-    // The new object is added to the Bom pool
-    _pool.push_back (oPlace_ptr);
-
-    return *oPlace_ptr;
+    return BomArena::create<Place> (*this, iLocationKey);
   }
 
   // //////////////////////////////////////////////////////////////////////
   Place& FacPlace::create (const Location& iLocation) {
-    Place* oPlace_ptr = NULL;
-
-    oPlace_ptr = new Place (iLocation);
-    assert (oPlace_ptr != NULL);
-
-    // The new object is added to the Bom pool
-    _pool.push_back (oPlace_ptr);
-
-    return *oPlace_ptr;
+    return BomArena::create<Place> (*this, iLocation);
   }
 
   // //////////////////////////////////////////////////////////////////////
   Place& FacPlace::clone (const Place& iPlace) {
-    Place* oPlace_ptr = NULL;
-
-    oPlace_ptr = new Place (iPlace);
-    assert (oPlace_ptr != NULL);
-
-    // The new object is added to the Bom pool
-    _pool.push_back (oPlace_ptr);
-
-    return *oPlace_ptr;
+    return BomArena::create<Place> (*this, iPlace);
   }
   
   // //////////////////////////////////////////////////////////////////////
@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// STL
+#include <atomic>
 // OpenTrep
 #include <opentrep/factory/FacBomAbstract.hpp>
 
@@ -109,7 +111,7 @@ namespace OPENTREP {
     /**
      * The unique instance.
      */
-    static FacPlace* _instance;
+    static std::atomic<FacPlace*> _instance;
   };
 }
 #endif // __OPENTREP_FAC_FACPLACE_HPP
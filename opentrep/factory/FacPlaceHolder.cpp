@@ -6,13 +6,14 @@
 // OPENTREP
 #include <opentrep/bom/PlaceHolder.hpp>
 #include <opentrep/bom/Place.hpp>
+#include <opentrep/factory/BomArena.hpp>
 #include <opentrep/factory/FacSupervisor.hpp>
 #include <opentrep/factory/FacPlaceHolder.hpp>
 #include <opentrep/service/Logger.hpp>
 
 namespace OPENTREP {
 
-  FacPlaceHolder* FacPlaceHolder::_instance = NULL;
+  std::atomic<FacPlaceHolder*> FacPlaceHolder::_instance (NULL);
 
   // //////////////////////////////////////////////////////////////////////
   FacPlaceHolder::FacPlaceHolder () {
@@ -29,27 +30,30 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   FacPlaceHolder& FacPlaceHolder::instance () {
+    // Once the factory has been created, it is given without any lock
+    FacPlaceHolder* lInstance_ptr = _instance;
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
+    }
 
-    if (_instance == NULL) {
-      _instance = new FacPlaceHolder();
-      assert (_instance != NULL);
-      
-      FacSupervisor::instance().registerBomFactory (_instance);
+    // Otherwise, its creation is serialised
+    std::lock_guard<std::recursive_mutex>
+      lGuard (FacSupervisor::getInstanceMutex());
+
+    lInstance_ptr = _instance;
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacPlaceHolder();
+      assert (lInstance_ptr != NULL);
+
+      FacSupervisor::instance().registerBomFactory (lInstance_ptr);
+      _instance = lInstance_ptr;
     }
-    return *_instance;
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
   PlaceHolder& FacPlaceHolder::create () {
-    PlaceHolder* oPlaceHolder_ptr = NULL;
-
-    oPlaceHolder_ptr = new PlaceHolder ();
-    assert (oPlaceHolder_ptr != NULL);
-
-    // The new object is added to the Bom pool
-    _pool.push_back (oPlaceHolder_ptr);
-
-    return *oPlaceHolder_ptr;
+    return BomArena::create<PlaceHolder> (*this);
   }
 
   // //////////////////////////////////////////////////////////////////////
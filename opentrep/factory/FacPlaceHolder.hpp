@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// STL
+#include <atomic>
 // OPENTREP
 #include <opentrep/factory/FacBomAbstract.hpp>
 
@@ -49,7 +51,7 @@ namespace OPENTREP {
 
   private:
     /** The unique instance.*/
-    static FacPlaceHolder* _instance;
+    static std::atomic<FacPlaceHolder*> _instance;
 
   };
 }
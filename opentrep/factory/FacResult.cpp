@@ -5,12 +5,13 @@
 #include <cassert>
 // OpenTrep
 #include <opentrep/bom/Result.hpp>
+#include <opentrep/factory/BomArena.hpp>
 #include <opentrep/factory/FacSupervisor.hpp>
 #include <opentrep/factory/FacResult.hpp>
 
 namespace OPENTREP {
 
-  FacResult* FacResult::_instance = NULL;
+  std::atomic<FacResult*> FacResult::_instance (NULL);
 
   // //////////////////////////////////////////////////////////////////////
   FacResult::FacResult () {
@@ -27,28 +28,31 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   FacResult& FacResult::instance () {
+    // Once the factory has been created, it is given without any lock
+    FacResult* lInstance_ptr = _instance;
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
+    }
+
+    // Otherwise, its creation is serialised
+    std::lock_guard<std::recursive_mutex>
+      lGuard (FacSupervisor::getInstanceMutex());
+
+    lInstance_ptr = _instance;
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacResult();
+      assert (lInstance_ptr != NULL);
 
-    if (_instance == NULL) {
-      _instance = new FacResult();
-      assert (_instance != NULL);
-      
-      FacSupervisor::instance().registerBomFactory (_instance);
+      FacSupervisor::instance().registerBomFactory (lInstance_ptr);
+      _instance = lInstance_ptr;
     }
-    return *_instance;
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
   Result& FacResult::create (const TravelQuery_T& iQueryString,
                              const Xapian::Database& iXapianDatabase) {
-    Result* oResult_ptr = NULL;
-
-    oResult_ptr = new Result (iQueryString, iXapianDatabase);
-    assert (oResult_ptr != NULL);
-
-    // The new object is added to the Bom pool
-    _pool.push_back (oResult_ptr);
-
-    return *oResult_ptr;
+    return BomArena::create<Result> (*this, iQueryString, iXapianDatabase);
   }
 
 }
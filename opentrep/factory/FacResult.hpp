@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// STL
+#include <atomic>
 // OpenTrep
 #include <opentrep/factory/FacBomAbstract.hpp>
 
@@ -59,7 +61,7 @@ namespace OPENTREP {
     /**
      * The unique instance.
      */
-    static FacResult* _instance;
+    static std::atomic<FacResult*> _instance;
   };
 }
 #endif // __OPENTREP_FAC_FACRESULT_HPP
@@ -6,13 +6,14 @@
 // OpenTrep
 #include <opentrep/bom/ResultCombination.hpp>
 #include <opentrep/bom/ResultHolder.hpp>
+#include <opentrep/factory/BomArena.hpp>
 #include <opentrep/factory/FacSupervisor.hpp>
 #include <opentrep/factory/FacResultCombination.hpp>
 #include <opentrep/service/Logger.hpp>
 
 namespace OPENTREP {
 
-  FacResultCombination* FacResultCombination::_instance = NULL;
+  std::atomic<FacResultCombination*> FacResultCombination::_instance (NULL);
 
   // //////////////////////////////////////////////////////////////////////
   FacResultCombination::FacResultCombination() {
@@ -29,28 +30,31 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   FacResultCombination& FacResultCombination::instance() {
+    // Once the factory has been created, it is given without any lock
+    FacResultCombination* lInstance_ptr = _instance;
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
+    }
 
-    if (_instance == NULL) {
-      _instance = new FacResultCombination();
-      assert (_instance != NULL);
-      
-      FacSupervisor::instance().registerBomFactory (_instance);
+    // Otherwise, its creation is serialised
+    std::lock_guard<std::recursive_mutex>
+      lGuard (FacSupervisor::getInstanceMutex());
+
+    lInstance_ptr = _instance;
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacResultCombination();
+      assert (lInstance_ptr != NULL);
+
+      FacSupervisor::instance().registerBomFactory (lInstance_ptr);
+      _instance = lInstance_ptr;
     }
-    return *_instance;
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
   ResultCombination& FacResultCombination::
   create (const TravelQuery_T& iQueryString) {
-    ResultCombination* oResultCombination_ptr = NULL;
-
-    oResultCombination_ptr = new ResultCombination (iQueryString);
-    assert (oResultCombination_ptr != NULL);
-
-    // The new object is added to the Bom pool
-    _pool.push_back (oResultCombination_ptr);
-
-    return *oResultCombination_ptr;
+    return BomArena::create<ResultCombination> (*this, iQueryString);
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// STL
+#include <atomic>
 // OpenTREP
 #include <opentrep/factory/FacBomAbstract.hpp>
 #include <opentrep/OPENTREP_Types.hpp>
@@ -76,7 +78,7 @@ namespace OPENTREP {
     /**
      * The unique instance.
      */
-    static FacResultCombination* _instance;
+    static std::atomic<FacResultCombination*> _instance;
   };
 }
 #endif // __OPENTREP_FAC_FACRESULTCOMBINATION_HPP
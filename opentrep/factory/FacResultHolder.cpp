@@ -6,13 +6,14 @@
 // OPENTREP
 #include <opentrep/bom/ResultHolder.hpp>
 #include <opentrep/bom/Result.hpp>
+#include <opentrep/factory/BomArena.hpp>
 #include <opentrep/factory/FacSupervisor.hpp>
 #include <opentrep/factory/FacResultHolder.hpp>
 #include <opentrep/service/Logger.hpp>
 
 namespace OPENTREP {
 
-  FacResultHolder* FacResultHolder::_instance = NULL;
+  std::atomic<FacResultHolder*> FacResultHolder::_instance (NULL);
 
   // //////////////////////////////////////////////////////////////////////
   FacResultHolder::FacResultHolder () {
@@ -29,35 +30,42 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   FacResultHolder& FacResultHolder::instance () {
+    // Once the factory has been created, it is given without any lock
+    FacResultHolder* lInstance_ptr = _instance;
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
+    }
 
-    if (_instance == NULL) {
-      _instance = new FacResultHolder();
-      assert (_instance != NULL);
-      
-      FacSupervisor::instance().registerBomFactory (_instance);
+    // Otherwise, its creation is serialised
+    std::lock_guard<std::recursive_mutex>
+      lGuard (FacSupervisor::getInstanceMutex());
+
+    lInstance_ptr = _instance;
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacResultHolder();
+      assert (lInstance_ptr != NULL);
+
+      FacSupervisor::instance().registerBomFactory (lInstance_ptr);
+      _instance = lInstance_ptr;
     }
-    return *_instance;
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
   ResultHolder& FacResultHolder::create (const TravelQuery_T& iQueryString,
                                          const Xapian::Database& iDatabase) {
-    ResultHolder* oResultHolder_ptr = NULL;
-
-    oResultHolder_ptr = new ResultHolder (iQueryString, iDatabase);
-    assert (oResultHolder_ptr != NULL);
-
-    // The new object is added to the Bom pool
-    _pool.push_back (oResultHolder_ptr);
-
-    return *oResultHolder_ptr;
+    return BomArena::create<ResultHolder> (*this, iQueryString, iDatabase);
   }
 
   // //////////////////////////////////////////////////////////////////////
   void FacResultHolder::initLinkWithResult (ResultHolder& ioResultHolder,
                                           Result& ioResult) {
-      // Link the ResultHolder to the Result, and vice versa
-      ioResult._resultHolder = &ioResultHolder;
+      // Link the ResultHolder to the Result, and vice versa. As the Result
+      // may be shared by several ResultHolder objects, only the first
+      // one is kept as the parent.
+      if (ioResult._resultHolder == NULL) {
+        ioResult._resultHolder = &ioResultHolder;
+      }
       
       // Add the Result to the ResultHolder internal list (of Result objects)
       ioResultHolder._resultList.push_back (&ioResult);
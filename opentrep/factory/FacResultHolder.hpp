@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// STL
+#include <atomic>
 // OpenTREP
 #include <opentrep/factory/FacBomAbstract.hpp>
 #include <opentrep/OPENTREP_Types.hpp>
@@ -56,7 +58,7 @@ namespace OPENTREP {
 
   private:
     /** The unique instance.*/
-    static FacResultHolder* _instance;
+    static std::atomic<FacResultHolder*> _instance;
 
   };
 }
@@ -28,4 +28,11 @@ namespace OPENTREP {
     _pool.clear();
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  void FacServiceAbstract::addToPool (ServiceAbstract* ioService_ptr) {
+    assert (ioService_ptr != NULL);
+    std::lock_guard<std::mutex> lGuard (_poolMutex);
+    _pool.push_back (ioService_ptr);
+  }
+
 }
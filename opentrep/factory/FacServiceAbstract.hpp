@@ -6,6 +6,7 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <vector>
+#include <mutex>
 
 namespace OPENTREP {
 
@@ -29,9 +30,16 @@ namespace OPENTREP {
     /** Default Constructor.
         <br>This constructor is protected to ensure the class is abstract. */
     FacServiceAbstract() {}
+
+    /** Add a newly instantiated Service object to the pool. The additions
+        made by concurrent threads are serialised. */
+    void addToPool (ServiceAbstract*);
     
     /** List of instantiated Business Objects*/
     ServicePool_T _pool;
+
+    /** Mutex serialising the additions to the pool. */
+    std::mutex _poolMutex;
   };
     
 }
@@ -10,20 +10,38 @@
 
 namespace OPENTREP {
 
-  FacSupervisor* FacSupervisor::_instance = NULL;
+  std::atomic<FacSupervisor*> FacSupervisor::_instance (NULL);
 
   // //////////////////////////////////////////////////////////////////////
   FacSupervisor::FacSupervisor () :
     _facXapianDB (NULL), _logger (NULL) {
   }
     
+  // //////////////////////////////////////////////////////////////////////
+  std::recursive_mutex& FacSupervisor::getInstanceMutex() {
+    // Initialised (in a thread-safe way) at the first call
+    static std::recursive_mutex lInstanceMutex;
+    return lInstanceMutex;
+  }
+
   // //////////////////////////////////////////////////////////////////////
   FacSupervisor& FacSupervisor::instance() {
-    if (_instance == NULL) {
-      _instance = new FacSupervisor();
+    // Once the supervisor has been created, it is given without any lock
+    FacSupervisor* lInstance_ptr = _instance;
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
+    }
+
+    // Otherwise, its creation is serialised
+    std::lock_guard<std::recursive_mutex> lGuard (getInstanceMutex());
+
+    lInstance_ptr = _instance;
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacSupervisor();
+      _instance = lInstance_ptr;
     }
-    assert (_instance != NULL);
-    return *_instance;
+    assert (lInstance_ptr != NULL);
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -100,13 +118,17 @@ namespace OPENTREP {
   
   // //////////////////////////////////////////////////////////////////////
   void FacSupervisor::cleanFactory () {
-	if (_instance != NULL) {
-		_instance->cleanBomLayer();
-		_instance->cleanServiceLayer();
-        _instance->cleanFacXapianDB();
-		_instance->cleanLoggerService();
+    // The instance is detached first, so that its destructor, which calls
+    // that method in turn, does not delete it again
+    std::lock_guard<std::recursive_mutex> lGuard (getInstanceMutex());
+    FacSupervisor* lInstance_ptr = _instance.exchange (NULL);
+	if (lInstance_ptr != NULL) {
+		lInstance_ptr->cleanBomLayer();
+		lInstance_ptr->cleanServiceLayer();
+        lInstance_ptr->cleanFacXapianDB();
+		lInstance_ptr->cleanLoggerService();
 	}
-    delete _instance; _instance = NULL;
+    delete lInstance_ptr; lInstance_ptr = NULL;
   }
 
 }
@@ -6,6 +6,8 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <vector>
+#include <mutex>
+#include <atomic>
 
 namespace OPENTREP {
 
@@ -34,6 +36,21 @@ namespace OPENTREP {
      */
     static FacSupervisor& instance();
 
+    /**
+     * Get the mutex serialising the lazy instantiations of the singletons
+     * (FacSupervisor itself, the concrete factories and the Logger), so that
+     * concurrent first calls to their instance() methods create only one
+     * object. The mutex is recursive, as those methods call each other.
+     * It is not taken once the singletons have been created.
+     *
+     * The registration methods below are called only while that mutex is
+     * held, so that the lists of factories are changed by only one thread
+     * at a time.
+     *
+     * @return std::recursive_mutex&
+     */
+    static std::recursive_mutex& getInstanceMutex();
+
     /**
      * Register a newly instantiated concrete factory for the Bom layer.
      * When a concrete Factory is firstly instantiated,
@@ -124,7 +141,7 @@ namespace OPENTREP {
     /**
      * The unique instance.
      */
-    static FacSupervisor* _instance;
+    static std::atomic<FacSupervisor*> _instance;
 
     /**
      * FacXapianDB (singleton) instance.
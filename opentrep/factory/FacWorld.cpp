@@ -15,7 +15,7 @@
 
 namespace OPENTREP {
 
-  FacWorld* FacWorld::_instance = NULL;
+  std::atomic<FacWorld*> FacWorld::_instance (NULL);
 
   // //////////////////////////////////////////////////////////////////////
   FacWorld::~FacWorld () {
@@ -24,14 +24,25 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   FacWorld& FacWorld::instance () {
+    // Once the factory has been created, it is given without any lock
+    FacWorld* lInstance_ptr = _instance;
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
+    }
 
-    if (_instance == NULL) {
-      _instance = new FacWorld();
-      assert (_instance != NULL);
-      
-      FacSupervisor::instance().registerBomFactory (_instance);
+    // Otherwise, its creation is serialised
+    std::lock_guard<std::recursive_mutex>
+      lGuard (FacSupervisor::getInstanceMutex());
+
+    lInstance_ptr = _instance;
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacWorld();
+      assert (lInstance_ptr != NULL);
+
+      FacSupervisor::instance().registerBomFactory (lInstance_ptr);
+      _instance = lInstance_ptr;
     }
-    return *_instance;
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -42,7 +53,7 @@ namespace OPENTREP {
     assert (oWorld_ptr != NULL);
 
     // The new object is added to the Bom pool
-    _pool.push_back (oWorld_ptr);
+    addToPool (oWorld_ptr);
 
     return *oWorld_ptr;
   }
@@ -94,7 +105,7 @@ namespace OPENTREP {
     assert (oWorld_ptr != NULL);
 
     // The new object is added to the Bom pool
-    _pool.push_back (oWorld_ptr);
+    addToPool (oWorld_ptr);
 
     return *oWorld_ptr;
   }
@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// STL
+#include <atomic>
 // OpenTrep
 #include <opentrep/factory/FacBomAbstract.hpp>
 
@@ -50,7 +52,7 @@ namespace OPENTREP {
 
   private:
     /** The unique instance.*/
-    static FacWorld* _instance;
+    static std::atomic<FacWorld*> _instance;
 
   };
 }
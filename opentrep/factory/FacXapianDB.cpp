@@ -13,7 +13,7 @@
 
 namespace OPENTREP {
 
-  FacXapianDB* FacXapianDB::_instance = NULL;
+  std::atomic<FacXapianDB*> FacXapianDB::_instance (NULL);
 
   // //////////////////////////////////////////////////////////////////////
   FacXapianDB::~FacXapianDB() {
@@ -37,12 +37,25 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   FacXapianDB& FacXapianDB::instance() {
-    if (_instance == NULL) {
-      _instance = new FacXapianDB();
-      FacSupervisor::instance().registerXapianDBFactory (_instance);
+    // Once the factory has been created, it is given without any lock
+    FacXapianDB* lInstance_ptr = _instance;
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
     }
-    assert (_instance != NULL);
-    return *_instance;
+
+    // Otherwise, its creation is serialised
+    std::lock_guard<std::recursive_mutex>
+      lGuard (FacSupervisor::getInstanceMutex());
+
+    lInstance_ptr = _instance;
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacXapianDB();
+      assert (lInstance_ptr != NULL);
+
+      FacSupervisor::instance().registerXapianDBFactory (lInstance_ptr);
+      _instance = lInstance_ptr;
+    }
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -63,6 +76,7 @@ namespace OPENTREP {
       
 
     // The new object is added to the Service pool
+    std::lock_guard<std::mutex> lGuard (_poolMutex);
     _pool.push_back (oXapianDatabase_ptr);
 
     return oXapianDatabase_ptr;
@@ -5,7 +5,9 @@
 // Import section
 // //////////////////////////////////////////////////////////////////////
 // STL
+#include <atomic>
 #include <vector>
+#include <mutex>
 // OpenTrep
 #include <opentrep/OPENTREP_Types.hpp>
 
@@ -74,13 +76,18 @@ namespace OPENTREP {
     /**
      * The unique instance.
      */
-    static FacXapianDB* _instance;
+    static std::atomic<FacXapianDB*> _instance;
 
     /**
      * List of instantiated Xapian DB objects
      */
     XapianDBPool_T _pool;
 
+    /**
+     * Mutex serialising the additions to the pool.
+     */
+    std::mutex _poolMutex;
+
   };
 
 }
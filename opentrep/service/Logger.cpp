@@ -10,7 +10,7 @@
 
 namespace OPENTREP {
 
-    Logger* Logger::_instance = NULL;
+    std::atomic<Logger*> Logger::_instance (NULL);
   
     // //////////////////////////////////////////////////////////////////////
     Logger::Logger () : _logStream (&std::cout) {
@@ -30,6 +30,7 @@ namespace OPENTREP {
     // //////////////////////////////////////////////////////////////////////
     Logger::~Logger () {
       _logStream = NULL;
+      _instance = NULL;
     }
 
     // //////////////////////////////////////////////////////////////////////
@@ -39,6 +40,7 @@ namespace OPENTREP {
 
     // //////////////////////////////////////////////////////////////////////
     std::ostream& Logger::getLogStream() {
+      std::lock_guard<std::mutex> lGuard (_streamMutex);
       assert (_logStream != NULL);
       return *_logStream;
     }
@@ -46,20 +48,33 @@ namespace OPENTREP {
     // //////////////////////////////////////////////////////////////////////
     void Logger::setLogParameters (const LOG::EN_LogLevel iLogLevel, 
                                    std::ostream& ioLogStream) {
+      std::lock_guard<std::mutex> lGuard (_streamMutex);
       _level = iLogLevel;
       _logStream = &ioLogStream;
     }
 
     // //////////////////////////////////////////////////////////////////////
     Logger& Logger::instance() {
-      if (_instance == NULL) {
-        _instance = new Logger (LOG::DEBUG, std::cout);
+      // Once the logger has been created, it is given without any lock
+      Logger* lInstance_ptr = _instance;
+      if (lInstance_ptr != NULL) {
+        return *lInstance_ptr;
+      }
+
+      // Otherwise, its creation is serialised
+      std::lock_guard<std::recursive_mutex>
+        lGuard (FacSupervisor::getInstanceMutex());
+
+      lInstance_ptr = _instance;
+      if (lInstance_ptr == NULL) {
+        lInstance_ptr = new Logger (LOG::DEBUG, std::cout);
         
-        assert (_instance != NULL);
+        assert (lInstance_ptr != NULL);
 
-        FacSupervisor::instance().registerLoggerService (_instance);
+        FacSupervisor::instance().registerLoggerService (lInstance_ptr);
+        _instance = lInstance_ptr;
       }
-      return *_instance;
+      return *lInstance_ptr;
     }
 
 }
@@ -8,15 +8,20 @@
 #include <cassert>
 #include <sstream>
 #include <string>
+#include <mutex>
+#include <atomic>
 // Boost Date-Time
 #include <boost/date_time.hpp>
 // OpenTREP
 #include <opentrep/OPENTREP_Types.hpp>
 
 // /////////////// LOG MACROS /////////////////
+// The log element is formatted only when its level is not filtered out
 #define OPENTREP_LOG_CORE(iLevel, iToBeLogged) \
-  { std::ostringstream ostr; ostr << iToBeLogged; \
-    OPENTREP::Logger::instance().log (iLevel, __LINE__, __FILE__, ostr.str()); }
+  { if (iLevel <= OPENTREP::Logger::instance().getLogLevel()) { \
+      std::ostringstream ostr; ostr << iToBeLogged; \
+      OPENTREP::Logger::instance().log (iLevel, __LINE__, __FILE__, \
+                                        ostr.str()); } }
 
 #define OPENTREP_LOG_CRITICAL(iToBeLogged) \
   OPENTREP_LOG_CORE (OPENTREP::LOG::CRITICAL, iToBeLogged)
@@ -58,13 +63,15 @@ namespace OPENTREP {
     void log (const LOG::EN_LogLevel iLevel, const int iLineNumber,
               const std::string& iFileName, const T& iToBeLogged) {
       if (iLevel <= _level) {
-        assert (_logStream != NULL);
-        
         // Get the current time in UTC Timezone
 	boost::posix_time::ptime lTimeUTC =
           boost::posix_time::second_clock::universal_time();
 
-        // Add some context and write down the log element
+        // Add some context and write down the log element. The log entries
+        // of concurrent threads are serialised, so as not to be interleaved.
+        // The stream may be changed in the meantime (see setLogParameters())
+        std::lock_guard<std::mutex> lGuard (_streamMutex);
+        assert (_logStream != NULL);
         *_logStream << "[" << lTimeUTC << "][" << iFileName << "#"
                     << iLineNumber << "]:" << iToBeLogged << std::endl;
       }
@@ -107,19 +114,25 @@ namespace OPENTREP {
     
   private:
     /**
-     * Log level.
+     * Log level. It is read, without any lock, by every log entry.
      */
-    LOG::EN_LogLevel _level;
+    std::atomic<LOG::EN_LogLevel> _level;
     
     /**
      * Stream dedicated to the logs.
      */
     std::ostream* _logStream;
+
+    /**
+     * Mutex serialising the writings into the log stream, as well as the
+     * changes of that stream.
+     */
+    std::mutex _streamMutex;
     
     /**
      * Singleton/Instance object.
      */
-    static Logger* _instance;
+    static std::atomic<Logger*> _instance;
   };
   
 }
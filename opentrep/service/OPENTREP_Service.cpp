@@ -9,6 +9,8 @@
 #include <boost/date_time/posix_time/ptime.hpp>
 // SOCI
 #include <soci/soci.h>
+// Xapian
+#include <xapian.h>
 // OpenTrep
 #include <opentrep/Location.hpp>
 #include <opentrep/CityDetails.hpp>
@@ -16,6 +18,8 @@
 #include <opentrep/basic/BasChronometer.hpp>
 #include <opentrep/factory/FacWorld.hpp>
 #include <opentrep/command/DBManager.hpp>
+#include <opentrep/command/DBConnection.hpp>
+#include <opentrep/command/DBConnectionPool.hpp>
 #include <opentrep/command/FileManager.hpp>
 #include <opentrep/command/IndexBuilder.hpp>
 #include <opentrep/command/XapianIndexManager.hpp>
@@ -82,13 +86,17 @@ namespace OPENTREP {
   SQLDBConnectionString_T
   getSQLConnStr (const DBType& iSQLDBType,
                  const SQLDBConnectionString_T& iSQLDBConnStr) {
-    // When the SQL database is MariaDB/MySQL and the connection string
-    // is equal to the default SQLite one, override it
+    // When the SQL database is MariaDB/MySQL or PostgreSQL and the
+    // connection string is equal to the default SQLite one, override it
     std::string oSQLDBConnStr =
       static_cast<const std::string> (iSQLDBConnStr);
     if (iSQLDBType == DBType::MYSQL
         && oSQLDBConnStr == DEFAULT_OPENTREP_SQLITE_DB_FILEPATH) {
       oSQLDBConnStr = DEFAULT_OPENTREP_MYSQL_CONN_STRING;
+
+    } else if (iSQLDBType == DBType::PG
+               && oSQLDBConnStr == DEFAULT_OPENTREP_SQLITE_DB_FILEPATH) {
+      oSQLDBConnStr = DEFAULT_OPENTREP_PG_CONN_STRING;
     }
     return SQLDBConnectionString_T (oSQLDBConnStr);
   }
@@ -217,13 +225,13 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the Xapian database name (directorty of the index)
-    const TravelDBFilePath_T& lTravelDBFilePath =
-      lOPENTREP_ServiceContext.getTravelDBFilePath();
+    // Retrieve the (already opened) Xapian database/index
+    const Xapian::Database& lXapianDatabase =
+      lOPENTREP_ServiceContext.getXapianDatabaseHandler();
       
     // Delegate the query execution to the dedicated command
     BasChronometer lIndexSizeChronometer; lIndexSizeChronometer.start();
-    oNbOfEntries = XapianIndexManager::getSize (lTravelDBFilePath);
+    oNbOfEntries = XapianIndexManager::getSize (lXapianDatabase);
     const double lIndexSizeMeasure = lIndexSizeChronometer.elapsed();
       
     // DEBUG
@@ -247,13 +255,13 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext= *_opentrepServiceContext;
 
-    // Retrieve the Xapian database name (directorty of the index)
-    const TravelDBFilePath_T& lTravelDBFilePath =
-      lOPENTREP_ServiceContext.getTravelDBFilePath();
+    // Retrieve the (already opened) Xapian database/index
+    const Xapian::Database& lXapianDatabase =
+      lOPENTREP_ServiceContext.getXapianDatabaseHandler();
       
     // Delegate the query execution to the dedicated command
     BasChronometer lRandomGetChronometer; lRandomGetChronometer.start();
-    oNbOfMatches = XapianIndexManager::drawRandomLocations (lTravelDBFilePath,
+    oNbOfMatches = XapianIndexManager::drawRandomLocations (lXapianDatabase,
                                                             iNbOfDraws,
                                                             ioLocationList);
     const double lRandomGetMeasure = lRandomGetChronometer.elapsed();
@@ -298,6 +306,10 @@ namespace OPENTREP {
     const DeploymentNumber_T& lDeploymentNumber =
       lOPENTREP_ServiceContext.getDeploymentNumber();
 
+    // The SQL database is about to be re-created: release the pooled
+    // connections to it, if any
+    lOPENTREP_ServiceContext.resetSQLDBConnectionPool();
+
     // Delegate the database creation to the dedicated command
     BasChronometer lDBCreationChronometer;
     lDBCreationChronometer.start();
@@ -361,6 +373,10 @@ namespace OPENTREP {
     const SQLDBConnectionString_T& lSQLDBConnectionString =
       lOPENTREP_ServiceContext.getSQLDBConnectionString();
       
+    // The SQL database tables are about to be re-created: release the pooled
+    // connections to them, if any
+    lOPENTREP_ServiceContext.resetSQLDBConnectionPool();
+
     // Delegate the database creation to the dedicated command
     BasChronometer lDBCreationChronometer;
     lDBCreationChronometer.start();
@@ -411,6 +427,10 @@ namespace OPENTREP {
     const SQLDBConnectionString_T& lSQLDBConnectionString =
       lOPENTREP_ServiceContext.getSQLDBConnectionString();
       
+    // The SQL database tables are about to be re-created: release the pooled
+    // connections to them, if any
+    lOPENTREP_ServiceContext.resetSQLDBConnectionPool();
+
     // Delegate the database creation to the dedicated command
     BasChronometer lDBCreationChronometer;
     lDBCreationChronometer.start();
@@ -459,6 +479,10 @@ namespace OPENTREP {
     // Store back the toggled flag
     lOPENTREP_ServiceContext.setDeploymentNumber (oDeploymentNumber);
 
+    // Load the dictionary of codes of the Xapian database/index of that
+    // deployment, if already built
+    lOPENTREP_ServiceContext.loadCodeDictionary();
+
     // DEBUG
     OPENTREP_LOG_DEBUG ("The new deployment number/version is: "
                         << oDeploymentNumber << " - "
@@ -557,6 +581,100 @@ namespace OPENTREP {
 
     return oShouldAddPORInSQLDB;
   }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::setDocumentFormat (const DocumentFormat& iFormat) {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // Store the format
+    lOPENTREP_ServiceContext.setDocumentFormat (iFormat);
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("The new format of the Xapian documents is: "
+                        << iFormat.describe() << " - "
+                        << lOPENTREP_ServiceContext.display());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::
+  setSQLDBBulkLoadBatchSize (const NbOfDBEntries_T& iBatchSize) {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // Store the number of rows per transaction
+    lOPENTREP_ServiceContext.setSQLDBBulkLoadBatchSize (iBatchSize);
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("The new number of rows per SQL DB load transaction "
+                        << "is: " << iBatchSize << " - "
+                        << lOPENTREP_ServiceContext.display());
+  }
+  
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::
+  setNbOfIndexingThreads (const NbOfThreads_T& iNbOfThreads) {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // Store the number of worker threads of the indexing pipeline
+    lOPENTREP_ServiceContext.setNbOfIndexingThreads (iNbOfThreads);
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("The new number of indexing threads is: "
+                        << iNbOfThreads << " - "
+                        << lOPENTREP_ServiceContext.display());
+  }
+  
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::
+  setNbOfIndexingShards (const NbOfShards_T& iNbOfShards) {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // Store the number of Xapian shards
+    lOPENTREP_ServiceContext.setNbOfIndexingShards (iNbOfShards);
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("The new number of indexing shards is: "
+                        << iNbOfShards << " - "
+                        << lOPENTREP_ServiceContext.display());
+  }
+  
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::
+  setMaxWordCombinationSpan (const NbOfWords_T& iMaxSpan) {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // Store the maximum span of the word combinations
+    lOPENTREP_ServiceContext.setMaxWordCombinationSpan (iMaxSpan);
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("The new maximum span of the word combinations is: "
+                        << iMaxSpan << " - "
+                        << lOPENTREP_ServiceContext.display());
+  }
   
   // //////////////////////////////////////////////////////////////////////
   NbOfDBEntries_T OPENTREP_Service::getNbOfPORFromDB() {
@@ -569,29 +687,24 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the SQL database type
-    const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
-      
-    // Retrieve the SQL database connection string
-    const SQLDBConnectionString_T& lSQLDBConnectionString =
-      lOPENTREP_ServiceContext.getSQLDBConnectionString();
+    // Retrieve the pool of connections to the SQL database
+    const OPENTREP_ServiceContext::DBConnectionPoolPtr_T&
+      lDBConnectionPool_ptr = lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+    assert (lDBConnectionPool_ptr != NULL);
       
     // Delegate the database look up to the dedicated command
     BasChronometer lDBListChronometer;
     lDBListChronometer.start();
 
-    // Connect to the SQLite3/MySQL database
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (lSQLDBType, lSQLDBConnectionString);
-    assert (lSociSession_ptr != NULL);
-    soci::session& lSociSession = *lSociSession_ptr;
-      
-    // Get the number of POR stored within the SQLite3/MySQL database
-    nbOfMatches = DBManager::displayCount (lSociSession);
+    {
+      // Lease a connection to the SQLite3/MySQL database. It is given back
+      // to the pool at the end of the block
+      DBConnectionLease lDBConnectionLease (*lDBConnectionPool_ptr);
+      DBConnection& lDBConnection = lDBConnectionLease.getDBConnection();
 
-    // Release the SQL database connection
-    DBManager::terminateSQLDBSession (lSQLDBType, lSQLDBConnectionString,
-                                      lSociSession);
+      // Get the number of POR stored within the SQLite3/MySQL database
+      nbOfMatches = DBManager::displayCount (lDBConnection.getSession());
+    }
 
     const double lDBListMeasure = lDBListChronometer.elapsed();
       
@@ -616,31 +729,26 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the SQL database type
-    const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
-      
-    // Retrieve the SQL database connection string
-    const SQLDBConnectionString_T& lSQLDBConnectionString =
-      lOPENTREP_ServiceContext.getSQLDBConnectionString();
+    // Retrieve the pool of connections to the SQL database
+    const OPENTREP_ServiceContext::DBConnectionPoolPtr_T&
+      lDBConnectionPool_ptr = lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+    assert (lDBConnectionPool_ptr != NULL);
       
     // Delegate the database look up to the dedicated command
     BasChronometer lDBListChronometer;
     lDBListChronometer.start();
 
-    // Connect to the SQLite3/MySQL database
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (lSQLDBType, lSQLDBConnectionString);
-    assert (lSociSession_ptr != NULL);
-    soci::session& lSociSession = *lSociSession_ptr;
-      
-    // Get the list of POR corresponding to the given IATA code
-    const bool lUniqueEntry = false;
-    nbOfMatches = DBManager::getPORByIATACode (lSociSession, iIataCode,
-                                               ioLocationList, lUniqueEntry);
+    {
+      // Lease a connection to the SQLite3/MySQL database. It is given back
+      // to the pool at the end of the block
+      DBConnectionLease lDBConnectionLease (*lDBConnectionPool_ptr);
+      DBConnection& lDBConnection = lDBConnectionLease.getDBConnection();
 
-    // Release the SQL database connection
-    DBManager::terminateSQLDBSession (lSQLDBType, lSQLDBConnectionString,
-                                      lSociSession);
+      // Get the list of POR corresponding to the given IATA code
+      const bool lUniqueEntry = false;
+      nbOfMatches = DBManager::getPORByIATACode (lDBConnection, iIataCode,
+                                                 ioLocationList, lUniqueEntry);
+    }
 
     const double lDBListMeasure = lDBListChronometer.elapsed();
       
@@ -665,30 +773,25 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the SQL database type
-    const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
-      
-    // Retrieve the SQL database connection string
-    const SQLDBConnectionString_T& lSQLDBConnectionString =
-      lOPENTREP_ServiceContext.getSQLDBConnectionString();
+    // Retrieve the pool of connections to the SQL database
+    const OPENTREP_ServiceContext::DBConnectionPoolPtr_T&
+      lDBConnectionPool_ptr = lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+    assert (lDBConnectionPool_ptr != NULL);
       
     // Delegate the database look up to the dedicated command
     BasChronometer lDBListChronometer;
     lDBListChronometer.start();
 
-    // Connect to the SQLite3/MySQL database
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (lSQLDBType, lSQLDBConnectionString);
-    assert (lSociSession_ptr != NULL);
-    soci::session& lSociSession = *lSociSession_ptr;
-      
-    // Get the list of POR corresponding to the given ICAO code
-    nbOfMatches =
-      DBManager::getPORByICAOCode (lSociSession, iIcaoCode, ioLocationList);
+    {
+      // Lease a connection to the SQLite3/MySQL database. It is given back
+      // to the pool at the end of the block
+      DBConnectionLease lDBConnectionLease (*lDBConnectionPool_ptr);
+      DBConnection& lDBConnection = lDBConnectionLease.getDBConnection();
 
-    // Release the SQL database connection
-    DBManager::terminateSQLDBSession (lSQLDBType, lSQLDBConnectionString,
-                                      lSociSession);
+      // Get the list of POR corresponding to the given ICAO code
+      nbOfMatches =
+        DBManager::getPORByICAOCode (lDBConnection, iIcaoCode, ioLocationList);
+    }
 
     const double lDBListMeasure = lDBListChronometer.elapsed();
       
@@ -713,30 +816,25 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the SQL database type
-    const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
-      
-    // Retrieve the SQL database connection string
-    const SQLDBConnectionString_T& lSQLDBConnectionString =
-      lOPENTREP_ServiceContext.getSQLDBConnectionString();
+    // Retrieve the pool of connections to the SQL database
+    const OPENTREP_ServiceContext::DBConnectionPoolPtr_T&
+      lDBConnectionPool_ptr = lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+    assert (lDBConnectionPool_ptr != NULL);
       
     // Delegate the database look up to the dedicated command
     BasChronometer lDBListChronometer;
     lDBListChronometer.start();
 
-    // Connect to the SQLite3/MySQL database
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (lSQLDBType, lSQLDBConnectionString);
-    assert (lSociSession_ptr != NULL);
-    soci::session& lSociSession = *lSociSession_ptr;
-      
-    // Get the list of POR corresponding to the given FAA code
-    nbOfMatches =
-      DBManager::getPORByFAACode (lSociSession, iFaaCode, ioLocationList);
+    {
+      // Lease a connection to the SQLite3/MySQL database. It is given back
+      // to the pool at the end of the block
+      DBConnectionLease lDBConnectionLease (*lDBConnectionPool_ptr);
+      DBConnection& lDBConnection = lDBConnectionLease.getDBConnection();
 
-    // Release the SQL database connection
-    DBManager::terminateSQLDBSession (lSQLDBType, lSQLDBConnectionString,
-                                      lSociSession);
+      // Get the list of POR corresponding to the given FAA code
+      nbOfMatches =
+        DBManager::getPORByFAACode (lDBConnection, iFaaCode, ioLocationList);
+    }
 
     const double lDBListMeasure = lDBListChronometer.elapsed();
       
@@ -761,32 +859,27 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the SQL database type
-    const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
-      
-    // Retrieve the SQL database connection string
-    const SQLDBConnectionString_T& lSQLDBConnectionString =
-      lOPENTREP_ServiceContext.getSQLDBConnectionString();
+    // Retrieve the pool of connections to the SQL database
+    const OPENTREP_ServiceContext::DBConnectionPoolPtr_T&
+      lDBConnectionPool_ptr = lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+    assert (lDBConnectionPool_ptr != NULL);
       
     // Delegate the database look up to the dedicated command
     BasChronometer lDBListChronometer;
     lDBListChronometer.start();
 
-    // Connect to the SQLite3/MySQL database
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (lSQLDBType, lSQLDBConnectionString);
-    assert (lSociSession_ptr != NULL);
-    soci::session& lSociSession = *lSociSession_ptr;
-      
-    // Get the list of POR corresponding to the given UN/LOCODE code
-    const bool lUniqueEntry = false;
-    nbOfMatches =
-      DBManager::getPORByUNLOCode (lSociSession, iUNLOCode, ioLocationList,
-                                   lUniqueEntry);
-
-    // Release the SQL database connection
-    DBManager::terminateSQLDBSession (lSQLDBType, lSQLDBConnectionString,
-                                      lSociSession);
+    {
+      // Lease a connection to the SQLite3/MySQL database. It is given back
+      // to the pool at the end of the block
+      DBConnectionLease lDBConnectionLease (*lDBConnectionPool_ptr);
+      DBConnection& lDBConnection = lDBConnectionLease.getDBConnection();
+
+      // Get the list of POR corresponding to the given UN/LOCODE code
+      const bool lUniqueEntry = false;
+      nbOfMatches =
+        DBManager::getPORByUNLOCode (lDBConnection, iUNLOCode, ioLocationList,
+                                     lUniqueEntry);
+    }
 
     const double lDBListMeasure = lDBListChronometer.elapsed();
       
@@ -810,30 +903,25 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the SQL database type
-    const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
-      
-    // Retrieve the SQL database connection string
-    const SQLDBConnectionString_T& lSQLDBConnectionString =
-      lOPENTREP_ServiceContext.getSQLDBConnectionString();
+    // Retrieve the pool of connections to the SQL database
+    const OPENTREP_ServiceContext::DBConnectionPoolPtr_T&
+      lDBConnectionPool_ptr = lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+    assert (lDBConnectionPool_ptr != NULL);
       
     // Delegate the database look up to the dedicated command
     BasChronometer lDBListChronometer;
     lDBListChronometer.start();
 
-    // Connect to the SQLite3/MySQL database
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (lSQLDBType, lSQLDBConnectionString);
-    assert (lSociSession_ptr != NULL);
-    soci::session& lSociSession = *lSociSession_ptr;
-      
-    // Get the list of POR corresponding to the given UIC code
-    nbOfMatches =
-      DBManager::getPORByUICCode (lSociSession, iUICCode, ioLocationList);
+    {
+      // Lease a connection to the SQLite3/MySQL database. It is given back
+      // to the pool at the end of the block
+      DBConnectionLease lDBConnectionLease (*lDBConnectionPool_ptr);
+      DBConnection& lDBConnection = lDBConnectionLease.getDBConnection();
 
-    // Release the SQL database connection
-    DBManager::terminateSQLDBSession (lSQLDBType, lSQLDBConnectionString,
-                                      lSociSession);
+      // Get the list of POR corresponding to the given UIC code
+      nbOfMatches =
+        DBManager::getPORByUICCode (lDBConnection, iUICCode, ioLocationList);
+    }
 
     const double lDBListMeasure = lDBListChronometer.elapsed();
       
@@ -858,30 +946,26 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the SQL database type
-    const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
-      
-    // Retrieve the SQL database connection string
-    const SQLDBConnectionString_T& lSQLDBConnectionString =
-      lOPENTREP_ServiceContext.getSQLDBConnectionString();
+    // Retrieve the pool of connections to the SQL database
+    const OPENTREP_ServiceContext::DBConnectionPoolPtr_T&
+      lDBConnectionPool_ptr = lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+    assert (lDBConnectionPool_ptr != NULL);
       
     // Delegate the database look up to the dedicated command
     BasChronometer lDBListChronometer;
     lDBListChronometer.start();
 
-    // Connect to the SQLite3/MySQL database
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (lSQLDBType, lSQLDBConnectionString);
-    assert (lSociSession_ptr != NULL);
-    soci::session& lSociSession = *lSociSession_ptr;
-      
-    // Get the list of POR corresponding to the given Geoname ID
-    nbOfMatches =
-      DBManager::getPORByGeonameID (lSociSession, iGeonameID, ioLocationList);
+    {
+      // Lease a connection to the SQLite3/MySQL database. It is given back
+      // to the pool at the end of the block
+      DBConnectionLease lDBConnectionLease (*lDBConnectionPool_ptr);
+      DBConnection& lDBConnection = lDBConnectionLease.getDBConnection();
 
-    // Release the SQL database connection
-    DBManager::terminateSQLDBSession (lSQLDBType, lSQLDBConnectionString,
-                                      lSociSession);
+      // Get the list of POR corresponding to the given Geoname ID
+      nbOfMatches =
+        DBManager::getPORByGeonameID (lDBConnection, iGeonameID,
+                                      ioLocationList);
+    }
 
     const double lDBListMeasure = lDBListChronometer.elapsed();
       
@@ -930,10 +1014,36 @@ namespace OPENTREP {
     const OPENTREP::shouldAddPORInSQLDB_T& lShouldAddPORInSQLDB =
       lOPENTREP_ServiceContext.getShouldAddPORInSQLDB();
 
+    // Retrieve the number of rows loaded into the SQL database within
+    // a single transaction
+    const NbOfDBEntries_T& lSQLDBBatchSize =
+      lOPENTREP_ServiceContext.getSQLDBBulkLoadBatchSize();
+
+    // Retrieve the number of worker threads of the indexing pipeline
+    const NbOfThreads_T& lNbOfIndexingThreads =
+      lOPENTREP_ServiceContext.getNbOfIndexingThreads();
+
+    // Retrieve the number of Xapian shards
+    const NbOfShards_T& lNbOfIndexingShards =
+      lOPENTREP_ServiceContext.getNbOfIndexingShards();
+
+    // Retrieve the maximum span of the word combinations
+    const NbOfWords_T& lMaxWordCombinationSpan =
+      lOPENTREP_ServiceContext.getMaxWordCombinationSpan();
+
+    // Retrieve the format of the data of the Xapian documents
+    const DocumentFormat& lDocumentFormat =
+      lOPENTREP_ServiceContext.getDocumentFormat();
+
     // Retrieve the Unicode transliterator
     const OTransliterator& lTransliterator =
       lOPENTREP_ServiceContext.getTransliterator();
       
+    // The Xapian database/index and, possibly, the SQL database are about
+    // to be re-built: release the read-only handles on them, if any
+    lOPENTREP_ServiceContext.resetXapianDatabase();
+    lOPENTREP_ServiceContext.resetSQLDBConnectionPool();
+
     // Delegate the index building to the dedicated command
     BasChronometer lInsertIntoXapianAndSQLDBChronometer;
     lInsertIntoXapianAndSQLDBChronometer.start();
@@ -944,9 +1054,20 @@ namespace OPENTREP {
                                                    lIncludeNonIATAPOR,
                                                    lShouldIndexPORInXapian,
                                                    lShouldAddPORInSQLDB,
+                                                   lSQLDBBatchSize,
+                                                   lNbOfIndexingThreads,
+                                                   lNbOfIndexingShards,
+                                                   lDocumentFormat,
+                                                   lMaxWordCombinationSpan,
                                                    lTransliterator);
     const double lInsertIntoXapianAndSQLDBMeasure =
       lInsertIntoXapianAndSQLDBChronometer.elapsed();
+
+    // Load the dictionary of codes of the re-built Xapian database/index,
+    // for the next queries
+    if (lShouldIndexPORInXapian == true) {
+      lOPENTREP_ServiceContext.loadCodeDictionary();
+    }
       
     // DEBUG
     OPENTREP_LOG_DEBUG ("Built Xapian database/index and filled SQL database: "
@@ -970,9 +1091,10 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext= *_opentrepServiceContext;
 
-    // Retrieve the Unicode transliterator
+    // Retrieve the Unicode transliterator dedicated to the current thread,
+    // as the ICU transliterators cannot be shared by concurrent queries
     const OTransliterator& lTransliterator =
-      lOPENTREP_ServiceContext.getTransliterator();
+      lOPENTREP_ServiceContext.getThreadTransliterator();
       
     // Get the date-time for the present time
     boost::posix_time::ptime lNowDateTime =
@@ -994,46 +1116,85 @@ namespace OPENTREP {
       throw TravelRequestEmptyException (errorStr.str());
     }
     
-    // Retrieve the Xapian database name (directorty of the index)
-    const TravelDBFilePath_T& lTravelDBFilePath =
-      lOPENTREP_ServiceContext.getTravelDBFilePath();
-
-    // Check whether the Xapian database/index is existing
-    const bool lExistXapianDBDir = checkXapianDBOnFileSystem (lTravelDBFilePath);
-    if (lExistXapianDBDir == false) {
-      std::ostringstream errorStr;
-      errorStr << "The file-path to the Xapian database/index ('"
-               << lTravelDBFilePath << "') does not exist or is not a "
-               << "directory." << std::endl;
-      errorStr << "That usually means that the OpenTREP indexer "
-               << "(opentrep-indexer) has not been launched yet, "
-               << "or that it has operated on a different Xapian "
-               << "database/index file-path, for instance with a different "
-               << "deployment number";
-      OPENTREP_LOG_ERROR (errorStr.str());
-      throw XapianTravelDatabaseWrongPathnameException (errorStr.str());
-      return nbOfMatches;
-    }
+    // Retrieve the Xapian database/index of the current thread. It is opened
+    // only once, and then re-used (and refreshed if needed) by all the
+    // subsequent queries of that thread. An exception is thrown when
+    // the Xapian database/index does not exist.
+    const Xapian::Database& lXapianDatabase =
+      lOPENTREP_ServiceContext.getXapianDatabaseHandler();
       
-    // Retrieve the SQL database type
+    // Retrieve the in-memory dictionary of the codes of that Xapian
+    // database/index. It has been loaded beforehand, and is shared by all
+    // the threads
+    const OPENTREP_ServiceContext::CodeDictionaryPtr_T& lCodeDictionary_ptr =
+      lOPENTREP_ServiceContext.getCodeDictionary (lXapianDatabase);
+    assert (lCodeDictionary_ptr != NULL);
+
+    // Retrieve the vocabulary sketch of that Xapian database/index, built
+    // by opentrep-indexer. It is loaded only at the first query, and then
+    // shared by all the threads
+    const OPENTREP_ServiceContext::VocabularySketchPtr_T&
+      lVocabularySketch_ptr =
+      lOPENTREP_ServiceContext.getVocabularySketch (lXapianDatabase);
+    assert (lVocabularySketch_ptr != NULL);
+
+    // Look for the results of the same travel query within the cache,
+    // if enabled, for the current deployment and Xapian index
+    QueryResultCache& lQueryResultCache =
+      lOPENTREP_ServiceContext.getQueryResultCache();
+    const bool isQueryResultCacheEnabled = lQueryResultCache.isEnabled();
+    std::string lQueryResultCacheKey;
+    if (isQueryResultCacheEnabled == true) {
+      const DeploymentNumber_T& lDeploymentNumber =
+        lOPENTREP_ServiceContext.getDeploymentNumber();
+      lQueryResultCacheKey =
+        QueryResultCache::buildKey (lDeploymentNumber,
+                                    lXapianDatabase.get_uuid(),
+                                    iTravelQuery);
+
+      if (lQueryResultCache.find (lQueryResultCacheKey, ioLocationList,
+                                  ioWordList, nbOfMatches) == true) {
+        // DEBUG
+        OPENTREP_LOG_DEBUG ("Match query found in the cache: "
+                            << nbOfMatches << " matches");
+        return nbOfMatches;
+      }
+    }
+
+    // Retrieve the pool of connections to the SQL database, if any. No
+    // connection is opened at that stage
+    OPENTREP_ServiceContext::DBConnectionPoolPtr_T lDBConnectionPool_ptr;
     const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
+    if (!(lSQLDBType == DBType::NODB)) {
+      lDBConnectionPool_ptr = lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+      assert (lDBConnectionPool_ptr != NULL);
+    }
       
-    // Retrieve the SQL database connection string
-    const SQLDBConnectionString_T& lSQLDBConnString =
-      lOPENTREP_ServiceContext.getSQLDBConnectionString();
-      
-    // Delegate the query execution to the dedicated command
+    // Delegate the query execution to the dedicated command. The results
+    // are collected apart, so that they may be stored in the cache as is
+    LocationList_T lLocationList;
+    WordList_T lWordList;
     BasChronometer lRequestInterpreterChronometer;
     lRequestInterpreterChronometer.start();
     nbOfMatches =
-      RequestInterpreter::interpretTravelRequest (lTravelDBFilePath,
-                                                  lSQLDBType, lSQLDBConnString,
+      RequestInterpreter::interpretTravelRequest (lXapianDatabase,
+                                                  *lCodeDictionary_ptr,
+                                                  *lVocabularySketch_ptr,
+                                                  lDBConnectionPool_ptr.get(),
                                                   iTravelQuery,
-                                                  ioLocationList, ioWordList,
+                                                  lLocationList, lWordList,
                                                   lTransliterator);
     const double lRequestInterpreterMeasure =
       lRequestInterpreterChronometer.elapsed();
 
+    // Store the results in the cache, if enabled
+    if (isQueryResultCacheEnabled == true) {
+      lQueryResultCache.insert (lQueryResultCacheKey, lLocationList,
+                                lWordList, nbOfMatches);
+    }
+    ioLocationList.splice (ioLocationList.end(), lLocationList);
+    ioWordList.splice (ioWordList.end(), lWordList);
+
     // DEBUG
     OPENTREP_LOG_DEBUG ("Match query on Xapian database (index): "
                         << lRequestInterpreterMeasure << " - "
@@ -1041,5 +1202,73 @@ namespace OPENTREP {
       
     return nbOfMatches;
   }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::
+  setQueryResultCacheLimits (const NbOfDBEntries_T& iCapacity,
+                             const NbOfSeconds_T& iTimeToLive) {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // Re-size the cache of the query results
+    QueryResultCache& lQueryResultCache =
+      lOPENTREP_ServiceContext.getQueryResultCache();
+    lQueryResultCache.reset (iCapacity, iTimeToLive);
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("The new limits of the query result cache are: "
+                        << iCapacity << " travel queries, time-to-live of "
+                        << iTimeToLive << "s - "
+                        << lOPENTREP_ServiceContext.display());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::clearQueryResultCache() {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // Empty the cache of the query results
+    QueryResultCache& lQueryResultCache =
+      lOPENTREP_ServiceContext.getQueryResultCache();
+    lQueryResultCache.clear();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfLookups_T OPENTREP_Service::getNbOfQueryResultCacheHits() const {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // Retrieve the statistics of the cache of the query results
+    const QueryResultCache& lQueryResultCache =
+      lOPENTREP_ServiceContext.getQueryResultCache();
+    return lQueryResultCache.getNbOfHits();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfLookups_T OPENTREP_Service::getNbOfQueryResultCacheMisses() const {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // Retrieve the statistics of the cache of the query results
+    const QueryResultCache& lQueryResultCache =
+      lOPENTREP_ServiceContext.getQueryResultCache();
+    return lQueryResultCache.getNbOfMisses();
+  }
   
 }
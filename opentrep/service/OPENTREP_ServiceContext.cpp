@@ -7,11 +7,23 @@
 #include <istream>
 #include <ostream>
 #include <sstream>
+#include <thread>
+#include <future>
+#include <exception>
+// Xapian
+#include <xapian.h>
 // OpenTrep
 #include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
 #include <opentrep/basic/Utilities.hpp>
 #include <opentrep/bom/World.hpp>
+#include <opentrep/bom/CodeDictionary.hpp>
+#include <opentrep/bom/VocabularySketch.hpp>
+#include <opentrep/bom/SpellingSuggestionCache.hpp>
+#include <opentrep/command/FileManager.hpp>
+#include <opentrep/command/DBConnectionPool.hpp>
+#include <opentrep/service/ThreadResourceRegistry.hpp>
 #include <opentrep/service/OPENTREP_ServiceContext.hpp>
+#include <opentrep/service/Logger.hpp>
 
 namespace OPENTREP {
 
@@ -70,6 +82,24 @@ namespace OPENTREP {
 
       // Store the newly formed SQL connection string
       _sqlDBConnectionString = lSQLDBConnStr;
+
+    } else if (_sqlDBType == DBType::PG) {
+      /**
+       * Parse the connection string. Typically, it is
+       * 'dbname=trep_trep user=trep password=trep'
+       */
+      const StringMap_T& lStrMap =
+        parsePGConnectionString (_sqlDBConnectionStringWPfxDBName);
+
+      /**
+       * Recompose the connection string
+       * 'dbname=trep_trep0 password=trep user=trep'
+       */
+      const SQLDBConnectionString_T& lSQLDBConnStr =
+        buildPGConnectionString (lStrMap, _deploymentNumber);
+
+      // Store the newly formed SQL connection string
+      _sqlDBConnectionString = lSQLDBConnStr;
     }
 
     /**
@@ -79,6 +109,11 @@ namespace OPENTREP {
     oStr << _travelDBFilePathPrefix;
     oStr << _deploymentNumber;
     _travelDBFilePath = TravelDBFilePath_T (oStr.str());
+
+    // The Xapian database/index, if already opened, may no longer be
+    // the right one. Nor may the connections to the SQL database
+    resetXapianDatabase();
+    resetSQLDBConnectionPool();
   }
   
   // //////////////////////////////////////////////////////////////////////
@@ -93,7 +128,13 @@ namespace OPENTREP {
       _sqlDBConnectionString (DEFAULT_OPENTREP_SQLITE_DB_FILEPATH),
       _shouldIndexNonIATAPOR (DEFAULT_OPENTREP_INCLUDE_NONIATA_POR),
       _shouldIndexPORInXapian (DEFAULT_OPENTREP_INDEX_IN_XAPIAN),
-      _shouldAddPORInSQLDB (DEFAULT_OPENTREP_ADD_IN_DB) {
+      _shouldAddPORInSQLDB (DEFAULT_OPENTREP_ADD_IN_DB),
+      _documentFormat (DEFAULT_OPENTREP_DOCUMENT_FORMAT),
+      _sqlDBBulkLoadBatchSize (DEFAULT_OPENTREP_SQL_DB_BULK_LOAD_BATCH_SIZE),
+      _nbOfIndexingThreads (DEFAULT_OPENTREP_NB_OF_INDEXING_THREADS),
+      _nbOfIndexingShards (DEFAULT_OPENTREP_NB_OF_INDEXING_SHARDS),
+      _maxWordCombinationSpan (DEFAULT_OPENTREP_MAX_WORD_COMBINATION_SPAN),
+      _threadResourceRegistry (ThreadResourceRegistry::create()) {
     assert (false);
   }
 
@@ -112,8 +153,17 @@ namespace OPENTREP {
       _sqlDBConnectionString (iSQLDBConnStr),
       _shouldIndexNonIATAPOR (DEFAULT_OPENTREP_INCLUDE_NONIATA_POR),
       _shouldIndexPORInXapian (DEFAULT_OPENTREP_INDEX_IN_XAPIAN),
-      _shouldAddPORInSQLDB (DEFAULT_OPENTREP_ADD_IN_DB) {
+      _shouldAddPORInSQLDB (DEFAULT_OPENTREP_ADD_IN_DB),
+      _documentFormat (DEFAULT_OPENTREP_DOCUMENT_FORMAT),
+      _sqlDBBulkLoadBatchSize (DEFAULT_OPENTREP_SQL_DB_BULK_LOAD_BATCH_SIZE),
+      _nbOfIndexingThreads (DEFAULT_OPENTREP_NB_OF_INDEXING_THREADS),
+      _nbOfIndexingShards (DEFAULT_OPENTREP_NB_OF_INDEXING_SHARDS),
+      _maxWordCombinationSpan (DEFAULT_OPENTREP_MAX_WORD_COMBINATION_SPAN),
+      _threadResourceRegistry (ThreadResourceRegistry::create()) {
     updateXapianAndSQLDBConnectionWithDeploymentNumber();
+
+    // The first query should not have to wait for the dictionary of codes
+    loadCodeDictionary();
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -134,14 +184,317 @@ namespace OPENTREP {
       _sqlDBConnectionString (iSQLDBConnStr),
       _shouldIndexNonIATAPOR (iShouldIndexNonIATAPOR),
       _shouldIndexPORInXapian (iShouldIdxPORInXapian),
-      _shouldAddPORInSQLDB (iShouldAddPORInSQLDB) {
+      _shouldAddPORInSQLDB (iShouldAddPORInSQLDB),
+      _documentFormat (DEFAULT_OPENTREP_DOCUMENT_FORMAT),
+      _sqlDBBulkLoadBatchSize (DEFAULT_OPENTREP_SQL_DB_BULK_LOAD_BATCH_SIZE),
+      _nbOfIndexingThreads (DEFAULT_OPENTREP_NB_OF_INDEXING_THREADS),
+      _nbOfIndexingShards (DEFAULT_OPENTREP_NB_OF_INDEXING_SHARDS),
+      _maxWordCombinationSpan (DEFAULT_OPENTREP_MAX_WORD_COMBINATION_SPAN),
+      _threadResourceRegistry (ThreadResourceRegistry::create()) {
     updateXapianAndSQLDBConnectionWithDeploymentNumber();
   }
 
   // //////////////////////////////////////////////////////////////////////
   OPENTREP_ServiceContext::~OPENTREP_ServiceContext() {
+    resetSQLDBConnectionPool();
+    resetXapianDatabase();
+    resetThreadTransliterators();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_ServiceContext::
+  setTransliterator (const OTransliterator& iTransliterator) {
+    _transliterator = iTransliterator;
+
+    // The transliterators of the threads are cloned again from the new one,
+    // at their next call to getThreadTransliterator()
+    resetThreadTransliterators();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_ServiceContext::resetThreadTransliterators() {
+    assert (_threadResourceRegistry != NULL);
+    _threadResourceRegistry->resetTransliterators();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  const OTransliterator& OPENTREP_ServiceContext::getThreadTransliterator() {
+    assert (_threadResourceRegistry != NULL);
+    const std::thread::id lThreadID = std::this_thread::get_id();
+
+    OTransliterator* lTransliterator_ptr =
+      _threadResourceRegistry->findTransliterator (lThreadID);
+    if (lTransliterator_ptr != NULL) {
+      return *lTransliterator_ptr;
+    }
+
+    // The copy constructor of OTransliterator clones the ICU transliterators,
+    // so that the new one shares nothing with the main one. Only the calling
+    // thread may create its own transliterator, so that there is no race
+    lTransliterator_ptr = new OTransliterator (_transliterator);
+    assert (lTransliterator_ptr != NULL);
+    _threadResourceRegistry->
+      setCallingThreadTransliterator (lTransliterator_ptr);
+    return *lTransliterator_ptr;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_ServiceContext::resetXapianDatabase() {
+    assert (_threadResourceRegistry != NULL);
+    _threadResourceRegistry->resetXapianDatabases();
+
+    // The queries still using the dictionary of codes keep their own
+    // handle on it
+    std::lock_guard<std::mutex> lDictionaryGuard (_codeDictionaryMutex);
+    _codeDictionary.reset();
+
+    // Same for the vocabulary sketch
+    std::lock_guard<std::mutex> lSketchGuard (_vocabularySketchMutex);
+    _vocabularySketch.reset();
+
+    // The cached query results may no longer be those of the Xapian index
+    _queryResultCache.clear();
+
+    // Same for the cached spelling suggestions
+    SpellingSuggestionCache::instance().clear();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Xapian::Database& OPENTREP_ServiceContext::getXapianDatabaseHandler() {
+    /**
+     * Only the accesses to the map of handles are serialised. The handle of
+     * the calling thread is then used (re-opened or opened) without any
+     * lock, as no other thread can use it.
+     */
+    assert (_threadResourceRegistry != NULL);
+    const std::thread::id lThreadID = std::this_thread::get_id();
+    Xapian::Database* lXapianDatabase_ptr =
+      _threadResourceRegistry->findXapianDatabase (lThreadID);
+
+    if (lXapianDatabase_ptr != NULL) {
+      try {
+        /**
+         * Bring the handle up to date with the latest revision of the
+         * Xapian index. When the index has not changed since the handle
+         * was opened, that is just a cheap check of the revision number.
+         */
+        lXapianDatabase_ptr->reopen();
+        return *lXapianDatabase_ptr;
+
+      } catch (const Xapian::Error& error) {
+        /**
+         * The Xapian index can no longer be read through the current
+         * handle, typically because its directory has been removed and
+         * re-created by opentrep-indexer. A brand new handle is opened below.
+         */
+        OPENTREP_LOG_DEBUG ("The Xapian database/index ('" << _travelDBFilePath
+                            << "') has been altered (" << error.get_msg()
+                            << "); it is re-opened");
+        _threadResourceRegistry->setCallingThreadXapianDatabase (NULL);
+        lXapianDatabase_ptr = NULL;
+
+        // The cached results and spelling suggestions, keyed by the UUID
+        // of the former index, would never be used again
+        _queryResultCache.clear();
+        SpellingSuggestionCache::instance().clear();
+      }
+    }
+    assert (lXapianDatabase_ptr == NULL);
+
+    // Check whether the Xapian database/index is existing
+    const bool lExistXapianDBDir =
+      FileManager::checkXapianDBOnFileSystem (_travelDBFilePath);
+    if (lExistXapianDBDir == false) {
+      std::ostringstream errorStr;
+      errorStr << "The file-path to the Xapian database/index ('"
+               << _travelDBFilePath << "') does not exist or is not a "
+               << "directory." << std::endl;
+      errorStr << "That usually means that the OpenTREP indexer "
+               << "(opentrep-indexer) has not been launched yet, "
+               << "or that it has operated on a different Xapian "
+               << "database/index file-path, for instance with a different "
+               << "deployment number";
+      OPENTREP_LOG_ERROR (errorStr.str());
+      throw XapianTravelDatabaseWrongPathnameException (errorStr.str());
+    }
+
+    // Open the Xapian database
+    try {
+      lXapianDatabase_ptr = new Xapian::Database (_travelDBFilePath);
+
+    } catch (const Xapian::Error& error) {
+      std::ostringstream errorStr;
+      errorStr << "Error when trying to open the Xapian database/index ('"
+               << _travelDBFilePath << "'): " << error.get_msg();
+      OPENTREP_LOG_ERROR (errorStr.str());
+      throw XapianDatabaseFailureException (errorStr.str());
+    }
+    assert (lXapianDatabase_ptr != NULL);
+    _threadResourceRegistry->
+      setCallingThreadXapianDatabase (lXapianDatabase_ptr);
+
+    return *lXapianDatabase_ptr;
   }
   
+  // //////////////////////////////////////////////////////////////////////
+  OPENTREP_ServiceContext::CodeDictionaryPtr_T OPENTREP_ServiceContext::
+  getCodeDictionary (const Xapian::Database& iXapianDatabase) {
+    const std::string& lXapianDatabaseUUID = iXapianDatabase.get_uuid();
+
+    std::promise<CodeDictionaryPtr_T> lLoadingPromise;
+    std::shared_future<CodeDictionaryPtr_T> lLoadingFuture;
+    bool isLoader = false;
+    {
+      std::lock_guard<std::mutex> lGuard (_codeDictionaryMutex);
+
+      // Re-use the dictionary, as long as the Xapian index has not been
+      // re-built since it was loaded
+      if (_codeDictionary != NULL
+          && _codeDictionary->getXapianDatabaseUUID() == lXapianDatabaseUUID) {
+        return _codeDictionary;
+      }
+
+      // When the dictionary of that Xapian index is already being loaded
+      // by another thread, wait for it (below) rather than loading it twice
+      if (_loadingCodeDictionaryUUID == lXapianDatabaseUUID) {
+        lLoadingFuture = _loadingCodeDictionary;
+
+      } else if (_loadingCodeDictionaryUUID.empty() == true) {
+        isLoader = true;
+        _loadingCodeDictionaryUUID = lXapianDatabaseUUID;
+        _loadingCodeDictionary = lLoadingPromise.get_future().share();
+      }
+    }
+
+    if (lLoadingFuture.valid() == true) {
+      return lLoadingFuture.get();
+    }
+
+    // (Re-)load the dictionary, without holding the lock, so that the
+    // queries on the current dictionary are not delayed. The queries still
+    // using the previous one, if any, keep their own handle on it
+    std::shared_ptr<CodeDictionary> lCodeDictionary_ptr =
+      std::make_shared<CodeDictionary>();
+    try {
+      lCodeDictionary_ptr->load (iXapianDatabase);
+
+    } catch (...) {
+      if (isLoader == true) {
+        std::lock_guard<std::mutex> lGuard (_codeDictionaryMutex);
+        _loadingCodeDictionaryUUID.clear();
+        _loadingCodeDictionary = std::shared_future<CodeDictionaryPtr_T>();
+        lLoadingPromise.set_exception (std::current_exception());
+      }
+      throw;
+    }
+
+    // The dictionary is shared only when it is the one of the Xapian index
+    // currently on the file-system. A thread still holding a handle on a
+    // former Xapian index gets its own dictionary, which therefore never
+    // replaces the one of a newer index
+    const bool isLatest = isLatestXapianDatabase (lXapianDatabaseUUID);
+    {
+      std::lock_guard<std::mutex> lGuard (_codeDictionaryMutex);
+      if (isLoader == true) {
+        _loadingCodeDictionaryUUID.clear();
+        _loadingCodeDictionary = std::shared_future<CodeDictionaryPtr_T>();
+      }
+      if (isLatest == true) {
+        _codeDictionary = lCodeDictionary_ptr;
+      }
+    }
+    if (isLoader == true) {
+      lLoadingPromise.set_value (lCodeDictionary_ptr);
+    }
+
+    return lCodeDictionary_ptr;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool OPENTREP_ServiceContext::
+  isLatestXapianDatabase (const std::string& iXapianDatabaseUUID) const {
+    try {
+      const Xapian::Database lXapianDatabase (_travelDBFilePath);
+      return (lXapianDatabase.get_uuid() == iXapianDatabaseUUID);
+
+    } catch (const Xapian::Error& error) {
+      OPENTREP_LOG_DEBUG ("The Xapian database/index ('" << _travelDBFilePath
+                          << "') cannot be opened (" << error.get_msg()
+                          << ")");
+    }
+    return false;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_ServiceContext::loadCodeDictionary() {
+    // There is nothing to load as long as the Xapian database/index
+    // has not been built
+    const bool lExistXapianDBDir =
+      FileManager::checkXapianDBOnFileSystem (_travelDBFilePath);
+    if (lExistXapianDBDir == false) {
+      return;
+    }
+
+    // The Xapian handle is only used for the loading, so that the calling
+    // thread is not given any
+    try {
+      const Xapian::Database lXapianDatabase (_travelDBFilePath);
+      getCodeDictionary (lXapianDatabase);
+
+    } catch (const Xapian::Error& error) {
+      OPENTREP_LOG_DEBUG ("The dictionary of codes of the Xapian "
+                          << "database/index ('" << _travelDBFilePath
+                          << "') cannot be loaded (" << error.get_msg()
+                          << "); it will be loaded by the first query");
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  OPENTREP_ServiceContext::VocabularySketchPtr_T OPENTREP_ServiceContext::
+  getVocabularySketch (const Xapian::Database& iXapianDatabase) {
+    std::lock_guard<std::mutex> lGuard (_vocabularySketchMutex);
+
+    // Re-use the sketch, as long as the Xapian index has not been
+    // re-built since it was loaded
+    const std::string& lXapianDatabaseUUID = iXapianDatabase.get_uuid();
+    if (_vocabularySketch != NULL
+        && _vocabularySketch->getXapianDatabaseUUID() == lXapianDatabaseUUID) {
+      return _vocabularySketch;
+    }
+
+    // (Re-)load the sketch from the directory of the Xapian index. When
+    // it cannot be loaded, it is kept anyway (though not enabled), so that
+    // the loading is not attempted again for the same Xapian index
+    std::shared_ptr<VocabularySketch> lVocabularySketch_ptr =
+      std::make_shared<VocabularySketch>();
+    const std::string& lSketchFilePath =
+      VocabularySketch::getFilePath (_travelDBFilePath);
+    lVocabularySketch_ptr->load (lSketchFilePath, iXapianDatabase);
+    _vocabularySketch = lVocabularySketch_ptr;
+
+    return _vocabularySketch;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_ServiceContext::resetSQLDBConnectionPool() {
+    std::lock_guard<std::mutex> lGuard (_sqlDBConnectionPoolMutex);
+    _sqlDBConnectionPool.reset();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  OPENTREP_ServiceContext::DBConnectionPoolPtr_T OPENTREP_ServiceContext::
+  getSQLDBConnectionPool() {
+    std::lock_guard<std::mutex> lGuard (_sqlDBConnectionPoolMutex);
+
+    if (_sqlDBConnectionPool == NULL) {
+      _sqlDBConnectionPool =
+        std::make_shared<DBConnectionPool> (_sqlDBType, _sqlDBConnectionString,
+                                            DEFAULT_OPENTREP_SQL_DB_POOL_SIZE);
+    }
+
+    return _sqlDBConnectionPool;
+  }
+
   // //////////////////////////////////////////////////////////////////////
   World& OPENTREP_ServiceContext::getWorldHandler() const {
     assert (_world != NULL);
@@ -165,6 +518,15 @@ namespace OPENTREP {
          << "; should include non-IATA POR: " << _shouldIndexNonIATAPOR
          << "; should index POR in Xapian: " << _shouldIndexPORInXapian
          << "; should insert POR into the SQL DB: " << _shouldAddPORInSQLDB
+         << "; format of the Xapian documents: " << _documentFormat.describe()
+         << "; rows per SQL DB load transaction: " << _sqlDBBulkLoadBatchSize
+         << "; indexing threads: " << _nbOfIndexingThreads
+         << "; indexing shards: " << _nbOfIndexingShards
+         << "; maximum span of word combinations: " << _maxWordCombinationSpan
+         << "; query result cache size: " << _queryResultCache.getCapacity()
+         << " (time-to-live: " << _queryResultCache.getTimeToLive()
+         << "s, hits: " << _queryResultCache.getNbOfHits()
+         << ", misses: " << _queryResultCache.getNbOfMisses() << ")"
          << std::endl;
     return oStr.str();
   }
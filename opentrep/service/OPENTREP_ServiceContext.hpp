@@ -6,27 +6,61 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <string>
+#include <memory>
+#include <mutex>
+#include <future>
 // OpenTrep
 #include <opentrep/OPENTREP_Types.hpp>
 #include <opentrep/DBType.hpp>
+#include <opentrep/DocumentFormat.hpp>
 #include <opentrep/basic/OTransliterator.hpp>
+#include <opentrep/basic/QueryResultCache.hpp>
 #include <opentrep/service/ServiceAbstract.hpp>
 
 // Forward declarations
 namespace soci {
   class session;
 }
+namespace Xapian {
+  class Database;
+}
 
 namespace OPENTREP {
 
   // Forward declarations
   class World;
+  class CodeDictionary;
+  class VocabularySketch;
+  class DBConnectionPool;
+  class ThreadResourceRegistry;
   
   /**
    * @brief Class holding the context of the OpenTrep services.
    */
   class OPENTREP_ServiceContext : public ServiceAbstract {
     friend class FacOpenTrepServiceContext;
+  public:
+    // ////////////// Type definitions /////////////
+    /**
+     * Shared handle on the registry of the per-thread resources.
+     */
+    typedef std::shared_ptr<ThreadResourceRegistry> ThreadResourceRegistryPtr_T;
+
+    /**
+     * Shared handle on an immutable dictionary of codes.
+     */
+    typedef std::shared_ptr<const CodeDictionary> CodeDictionaryPtr_T;
+
+    /**
+     * Shared handle on an immutable vocabulary sketch.
+     */
+    typedef std::shared_ptr<const VocabularySketch> VocabularySketchPtr_T;
+
+    /**
+     * Shared handle on a pool of connections to the SQL database.
+     */
+    typedef std::shared_ptr<DBConnectionPool> DBConnectionPoolPtr_T;
+
   public:
     // /////////////////// Getters //////////////////////
     /**
@@ -97,13 +131,166 @@ namespace OPENTREP {
       return _shouldAddPORInSQLDB;
     }
     
+    /**
+     * Get the format of the data of the Xapian documents.
+     */
+    const DocumentFormat& getDocumentFormat() const {
+      return _documentFormat;
+    }
+    
+    /**
+     * Get the number of rows loaded into the SQL database within a single
+     * transaction.
+     */
+    const NbOfDBEntries_T& getSQLDBBulkLoadBatchSize() const {
+      return _sqlDBBulkLoadBatchSize;
+    }
+    
+    /**
+     * Get the number of worker threads of the indexing pipeline.
+     */
+    const NbOfThreads_T& getNbOfIndexingThreads() const {
+      return _nbOfIndexingThreads;
+    }
+    
+    /**
+     * Get the number of Xapian shards built in parallel at indexing time.
+     */
+    const NbOfShards_T& getNbOfIndexingShards() const {
+      return _nbOfIndexingShards;
+    }
+    
+    /**
+     * Get the maximum span of the word combinations indexed for the
+     * alternate names.
+     */
+    const NbOfWords_T& getMaxWordCombinationSpan() const {
+      return _maxWordCombinationSpan;
+    }
+    
     /**
      * Get the Unicode transliterator.
+     *
+     * As the underlying ICU transliterators cannot be used concurrently,
+     * that transliterator must not be used by the queries (see
+     * getThreadTransliterator() instead).
      */
     const OTransliterator& getTransliterator() const {
       return _transliterator;
     }
 
+    /**
+     * Get the Unicode transliterator dedicated to the calling thread.
+     *
+     * That transliterator is cloned from the main one (see
+     * getTransliterator()) at the first call made by any given thread,
+     * and then re-used by all the subsequent queries of that thread. It is
+     * deleted when the thread exits.
+     */
+    const OTransliterator& getThreadTransliterator();
+
+    /**
+     * Get the (read-only) Xapian database/index dedicated to the calling
+     * thread.
+     *
+     * As Xapian::Database objects cannot be shared between threads, every
+     * thread is given its own handle. That handle is opened only once,
+     * at the first call made by the thread, and is then re-used by all
+     * the subsequent queries of that thread. It is closed when the thread
+     * exits (see ThreadResourceRegistry).
+     * When the Xapian index has been modified on the file-system since
+     * the last call (e.g., it has been re-built by opentrep-indexer),
+     * the handle is refreshed (and, if needed, re-opened). When it has to
+     * be re-opened, the cached query results and spelling suggestions
+     * (see SpellingSuggestionCache) are emptied.
+     *
+     * If the directory of the Xapian index does not exist, a
+     * XapianTravelDatabaseWrongPathnameException exception is thrown.
+     */
+    Xapian::Database& getXapianDatabaseHandler();
+
+    /**
+     * Get the in-memory dictionary of the codes (IATA, ICAO, UN/LOCODE)
+     * and Geonames IDs of the given Xapian database/index.
+     *
+     * The dictionary is normally loaded beforehand (see
+     * loadCodeDictionary()), and then shared by all the threads. It is
+     * loaded again, by that method, only when the Xapian index has been
+     * re-built in the meantime (i.e., when its UUID has changed), or when
+     * it could not be loaded beforehand.
+     *
+     * That loading is performed without holding any lock, so that the
+     * queries on the current dictionary are not delayed; the threads
+     * needing the same new dictionary wait for a single loading. The new
+     * dictionary replaces the shared one only when it is the one of the
+     * Xapian index currently on the file-system, so that a thread still
+     * holding a handle on a former index never brings its dictionary back.
+     *
+     * @param const Xapian::Database& Xapian database/index of the calling
+     *        thread (see getXapianDatabaseHandler()).
+     * @return CodeDictionaryPtr_T Shared handle on the dictionary.
+     */
+    CodeDictionaryPtr_T getCodeDictionary (const Xapian::Database&);
+
+    /**
+     * Whether the given UUID is the one of the Xapian database/index
+     * currently on the file-system.
+     *
+     * @param const std::string& UUID of a Xapian database/index.
+     * @return bool False as well when the Xapian index cannot be opened.
+     */
+    bool isLatestXapianDatabase (const std::string&) const;
+
+    /**
+     * Load the dictionary of codes (see getCodeDictionary()) of the Xapian
+     * database/index, so that the first query does not have to wait for
+     * it. That is done when the context of the query-/search-related
+     * services is created, and whenever the Xapian index has been re-built
+     * or switched. Nothing is done when the Xapian index does not exist
+     * (yet) or cannot be opened.
+     */
+    void loadCodeDictionary();
+
+    /**
+     * Get the vocabulary sketch of the given Xapian database/index, stored
+     * within the directory of that latter by opentrep-indexer.
+     *
+     * The sketch is loaded at the first call, and then shared by all the
+     * threads. It is loaded again whenever the Xapian index has been
+     * re-built in the meantime (i.e., when its UUID has changed). When
+     * there is no sketch for the Xapian index, the returned sketch is not
+     * enabled (and every look-up is then performed on the Xapian index).
+     *
+     * @param const Xapian::Database& Xapian database/index of the calling
+     *        thread (see getXapianDatabaseHandler()).
+     * @return VocabularySketchPtr_T Shared handle on the sketch.
+     */
+    VocabularySketchPtr_T getVocabularySketch (const Xapian::Database&);
+
+    /**
+     * Get the cache of the results of the travel queries, shared by all
+     * the threads. It is emptied whenever the Xapian database/index is
+     * reset (see resetXapianDatabase()).
+     */
+    QueryResultCache& getQueryResultCache() {
+      return _queryResultCache;
+    }
+
+    /**
+     * Get the pool of connections to the SQL database, shared by all
+     * the threads.
+     *
+     * The pool is created at the first call, with the current SQL database
+     * type and connection string. It is released whenever those latter
+     * change, or when the SQL database is re-created (see
+     * resetSQLDBConnectionPool()).
+     *
+     * @return DBConnectionPoolPtr_T Shared handle on the pool.
+     * @throw SQLDatabaseImpossibleConnectionException When there is no
+     *        SQL database (NODB type).
+     */
+    DBConnectionPoolPtr_T getSQLDBConnectionPool();
+
   public:
     // ////////////////// Setters /////////////////////
     /**
@@ -133,6 +320,7 @@ namespace OPENTREP {
      */
     void setSQLDBType (const DBType& iDBType) {
       _sqlDBType = iDBType;
+      resetSQLDBConnectionPool();
     }
     
     /**
@@ -173,11 +361,69 @@ namespace OPENTREP {
     }
     
     /**
-     * Set the Unicode transliterator.
+     * Set the format of the data of the Xapian documents.
+     */
+    void setDocumentFormat (const DocumentFormat& iDocumentFormat) {
+      _documentFormat = iDocumentFormat;
+    }
+    
+    /**
+     * Set the number of rows loaded into the SQL database within a single
+     * transaction.
+     */
+    void setSQLDBBulkLoadBatchSize (const NbOfDBEntries_T& iBatchSize) {
+      _sqlDBBulkLoadBatchSize = iBatchSize;
+    }
+    
+    /**
+     * Set the number of worker threads of the indexing pipeline.
+     */
+    void setNbOfIndexingThreads (const NbOfThreads_T& iNbOfThreads) {
+      _nbOfIndexingThreads = iNbOfThreads;
+    }
+    
+    /**
+     * Set the number of Xapian shards built in parallel at indexing time.
      */
-    void setTransliterator (const OTransliterator& iTransliterator) {
-      _transliterator = iTransliterator;
+    void setNbOfIndexingShards (const NbOfShards_T& iNbOfShards) {
+      _nbOfIndexingShards = iNbOfShards;
     }
+    
+    /**
+     * Set the maximum span of the word combinations indexed for the
+     * alternate names.
+     */
+    void setMaxWordCombinationSpan (const NbOfWords_T& iMaxSpan) {
+      _maxWordCombinationSpan = iMaxSpan;
+    }
+    
+    /**
+     * Set the Unicode transliterator.
+     */
+    void setTransliterator (const OTransliterator& iTransliterator);
+
+    /**
+     * Close the Xapian database/index handles of all the threads, if opened.
+     * They will be re-opened at the next call to getXapianDatabaseHandler().
+     *
+     * As the handles are deleted, that method must not be called while
+     * queries are being performed by other threads.
+     *
+     * The dictionary of codes (see getCodeDictionary()) and the vocabulary
+     * sketch (see getVocabularySketch()) are released too, and the caches
+     * of the query results (see getQueryResultCache()) and of the spelling
+     * suggestions (see SpellingSuggestionCache) are emptied.
+     */
+    void resetXapianDatabase();
+
+    /**
+     * Release the pool of connections to the SQL database, if created.
+     * It is created again at the next call to getSQLDBConnectionPool().
+     *
+     * The queries still using the pool keep their own handle on it; its
+     * connections are closed once all those queries are over.
+     */
+    void resetSQLDBConnectionPool();
 
 
   public:
@@ -247,7 +493,12 @@ namespace OPENTREP {
      * </ul>
      */
     void updateXapianAndSQLDBConnectionWithDeploymentNumber();
-    
+
+    /**
+     * Delete the Unicode transliterators of all the threads.
+     */
+    void resetThreadTransliterators();
+
     /**
      * Default constructor.
      */
@@ -389,10 +640,101 @@ namespace OPENTREP {
      */
     shouldAddPORInSQLDB_T _shouldAddPORInSQLDB;
 
+    /**
+     * Format of the data of the Xapian documents and of the serialised
+     * places of the SQL database (raw CSV POR line or compact binary
+     * encoding). That format is only used at indexing time,
+     * as the search process detects it from the data itself.
+     */
+    DocumentFormat _documentFormat;
+
+    /**
+     * Number of rows loaded into the SQL database within a single
+     * transaction, at indexing time (see DBBulkLoader).
+     */
+    NbOfDBEntries_T _sqlDBBulkLoadBatchSize;
+
+    /**
+     * Number of worker threads parsing the POR and building their Xapian
+     * documents, at indexing time (0 meaning one per hardware thread).
+     */
+    NbOfThreads_T _nbOfIndexingThreads;
+
+    /**
+     * Number of Xapian shards built in parallel, and then compacted into
+     * the Xapian database/index, at indexing time (0 or 1 meaning no
+     * shard).
+     */
+    NbOfShards_T _nbOfIndexingShards;
+
+    /**
+     * Maximum span, in number of words, of the word combinations indexed
+     * for the alternate names of the POR (0 meaning no maximum).
+     */
+    NbOfWords_T _maxWordCombinationSpan;
+
     /**
      * Unicode transliterator.
      */
     OTransliterator _transliterator;
+
+    /**
+     * Unicode transliterators, cloned from the main one (see
+     * getThreadTransliterator()), and handles on the (read-only) Xapian
+     * database/index (see getXapianDatabaseHandler()), for every live
+     * thread having performed queries.
+     */
+    ThreadResourceRegistryPtr_T _threadResourceRegistry;
+
+    /**
+     * In-memory dictionary of the codes of the Xapian database/index,
+     * shared by all the threads. It is NULL as long as it has not been
+     * loaded (see loadCodeDictionary()).
+     */
+    CodeDictionaryPtr_T _codeDictionary;
+
+    /**
+     * UUID of the Xapian database/index the dictionary of codes of which is
+     * being loaded, if any, and the outcome of that loading, for which the
+     * other threads needing the same dictionary wait.
+     */
+    std::string _loadingCodeDictionaryUUID;
+    std::shared_future<CodeDictionaryPtr_T> _loadingCodeDictionary;
+
+    /**
+     * Mutex protecting the dictionary of codes and the loading state above.
+     * It is not held while the dictionary is being loaded.
+     */
+    std::mutex _codeDictionaryMutex;
+
+    /**
+     * Vocabulary sketch of the Xapian database/index, shared by all the
+     * threads. It is NULL as long as no query has needed it.
+     */
+    VocabularySketchPtr_T _vocabularySketch;
+
+    /**
+     * Mutex protecting the vocabulary sketch above. It is held while the
+     * sketch is being loaded, so that it is loaded only once.
+     */
+    std::mutex _vocabularySketchMutex;
+
+    /**
+     * Cache of the results of the travel queries, shared by all the
+     * threads (and thread-safe).
+     */
+    QueryResultCache _queryResultCache;
+
+    /**
+     * Pool of connections to the SQL database, shared by all the threads.
+     * It is NULL as long as no look up has needed it.
+     */
+    DBConnectionPoolPtr_T _sqlDBConnectionPool;
+
+    /**
+     * Mutex protecting the pool of connections above.
+     */
+    std::mutex _sqlDBConnectionPoolMutex;
   };
 
 }
@@ -0,0 +1,227 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <vector>
+// Xapian
+#include <xapian.h>
+// OpenTrep
+#include <opentrep/basic/OTransliterator.hpp>
+#include <opentrep/service/ThreadResourceRegistry.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Helper class
+   *
+   * List of the registries holding resources of the calling thread. There
+   * is one such list per thread; its destructor, called at thread exit,
+   * releases the resources of that thread within all the registries still
+   * alive.
+   */
+  class ThreadResourceWatcher {
+  public:
+    typedef std::vector<std::weak_ptr<ThreadResourceRegistry> > RegistryList_T;
+
+    ~ThreadResourceWatcher() {
+      const std::thread::id lThreadID = std::this_thread::get_id();
+      for (RegistryList_T::iterator itRegistry = _registryList.begin();
+           itRegistry != _registryList.end(); ++itRegistry) {
+        std::shared_ptr<ThreadResourceRegistry> lRegistry_ptr =
+          itRegistry->lock();
+        if (lRegistry_ptr != NULL) {
+          lRegistry_ptr->releaseThread (lThreadID);
+        }
+      }
+    }
+
+    void watch (const std::shared_ptr<ThreadResourceRegistry>& iRegistry_ptr) {
+      // Forget about the registries destroyed in the meantime, and do not
+      // register the same registry twice
+      RegistryList_T::iterator itRegistry = _registryList.begin();
+      while (itRegistry != _registryList.end()) {
+        std::shared_ptr<ThreadResourceRegistry> lRegistry_ptr =
+          itRegistry->lock();
+        if (lRegistry_ptr == iRegistry_ptr) {
+          return;
+        }
+        if (lRegistry_ptr == NULL) {
+          itRegistry = _registryList.erase (itRegistry);
+        } else {
+          ++itRegistry;
+        }
+      }
+      _registryList.push_back (iRegistry_ptr);
+    }
+
+  private:
+    RegistryList_T _registryList;
+  };
+
+  // //////////////////////////////////////////////////////////////////////
+  ThreadResourceRegistry::ThreadResourceRegistry() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  ThreadResourceRegistry::
+  ThreadResourceRegistry (const ThreadResourceRegistry&)
+    : std::enable_shared_from_this<ThreadResourceRegistry>() {
+    assert (false);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  ThreadResourceRegistry::~ThreadResourceRegistry() {
+    resetXapianDatabases();
+    resetTransliterators();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::shared_ptr<ThreadResourceRegistry> ThreadResourceRegistry::create() {
+    return std::shared_ptr<ThreadResourceRegistry> (new ThreadResourceRegistry);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ThreadResourceRegistry::watchCallingThread() {
+    static thread_local ThreadResourceWatcher lThreadResourceWatcher;
+    lThreadResourceWatcher.watch (shared_from_this());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::size_t ThreadResourceRegistry::getNbOfTransliterators() {
+    std::lock_guard<std::mutex> lGuard (_mutex);
+    return _transliteratorMap.size();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::size_t ThreadResourceRegistry::getNbOfXapianDatabases() {
+    std::lock_guard<std::mutex> lGuard (_mutex);
+    return _xapianDatabaseMap.size();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  OTransliterator* ThreadResourceRegistry::
+  findTransliterator (const std::thread::id& iThreadID) {
+    std::lock_guard<std::mutex> lGuard (_mutex);
+
+    TransliteratorMap_T::iterator itTransliterator =
+      _transliteratorMap.find (iThreadID);
+    if (itTransliterator == _transliteratorMap.end()) {
+      return NULL;
+    }
+    return itTransliterator->second;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Xapian::Database* ThreadResourceRegistry::
+  findXapianDatabase (const std::thread::id& iThreadID) {
+    std::lock_guard<std::mutex> lGuard (_mutex);
+
+    XapianDatabaseMap_T::iterator itDatabase =
+      _xapianDatabaseMap.find (iThreadID);
+    if (itDatabase == _xapianDatabaseMap.end()) {
+      return NULL;
+    }
+    return itDatabase->second;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ThreadResourceRegistry::
+  setCallingThreadTransliterator (OTransliterator* ioTransliterator_ptr) {
+    assert (ioTransliterator_ptr != NULL);
+    watchCallingThread();
+
+    const std::thread::id lThreadID = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lGuard (_mutex);
+    const bool insertSucceeded = _transliteratorMap.
+      insert (TransliteratorMap_T::value_type (lThreadID,
+                                               ioTransliterator_ptr)).second;
+    assert (insertSucceeded == true);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ThreadResourceRegistry::
+  setCallingThreadXapianDatabase (Xapian::Database* ioXapianDatabase_ptr) {
+    if (ioXapianDatabase_ptr != NULL) {
+      watchCallingThread();
+    }
+
+    const std::thread::id lThreadID = std::this_thread::get_id();
+    Xapian::Database* lPreviousXapianDatabase_ptr = NULL;
+    {
+      std::lock_guard<std::mutex> lGuard (_mutex);
+
+      Xapian::Database*& lXapianDatabase_ptr = _xapianDatabaseMap[lThreadID];
+      if (lXapianDatabase_ptr != ioXapianDatabase_ptr) {
+        lPreviousXapianDatabase_ptr = lXapianDatabase_ptr;
+        lXapianDatabase_ptr = ioXapianDatabase_ptr;
+      }
+
+      // An absent handle is not kept in the map
+      if (lXapianDatabase_ptr == NULL) {
+        _xapianDatabaseMap.erase (lThreadID);
+      }
+    }
+
+    // The previous handle is closed without holding the lock
+    delete lPreviousXapianDatabase_ptr; lPreviousXapianDatabase_ptr = NULL;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ThreadResourceRegistry::resetTransliterators() {
+    TransliteratorMap_T lTransliteratorMap;
+    {
+      std::lock_guard<std::mutex> lGuard (_mutex);
+      lTransliteratorMap.swap (_transliteratorMap);
+    }
+
+    for (TransliteratorMap_T::iterator itTransliterator =
+           lTransliteratorMap.begin();
+         itTransliterator != lTransliteratorMap.end(); ++itTransliterator) {
+      OTransliterator* lTransliterator_ptr = itTransliterator->second;
+      delete lTransliterator_ptr; lTransliterator_ptr = NULL;
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ThreadResourceRegistry::resetXapianDatabases() {
+    XapianDatabaseMap_T lXapianDatabaseMap;
+    {
+      std::lock_guard<std::mutex> lGuard (_mutex);
+      lXapianDatabaseMap.swap (_xapianDatabaseMap);
+    }
+
+    for (XapianDatabaseMap_T::iterator itDatabase = lXapianDatabaseMap.begin();
+         itDatabase != lXapianDatabaseMap.end(); ++itDatabase) {
+      Xapian::Database* lXapianDatabase_ptr = itDatabase->second;
+      delete lXapianDatabase_ptr; lXapianDatabase_ptr = NULL;
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ThreadResourceRegistry::releaseThread (const std::thread::id& iThreadID) {
+    OTransliterator* lTransliterator_ptr = NULL;
+    Xapian::Database* lXapianDatabase_ptr = NULL;
+    {
+      std::lock_guard<std::mutex> lGuard (_mutex);
+
+      TransliteratorMap_T::iterator itTransliterator =
+        _transliteratorMap.find (iThreadID);
+      if (itTransliterator != _transliteratorMap.end()) {
+        lTransliterator_ptr = itTransliterator->second;
+        _transliteratorMap.erase (itTransliterator);
+      }
+
+      XapianDatabaseMap_T::iterator itDatabase =
+        _xapianDatabaseMap.find (iThreadID);
+      if (itDatabase != _xapianDatabaseMap.end()) {
+        lXapianDatabase_ptr = itDatabase->second;
+        _xapianDatabaseMap.erase (itDatabase);
+      }
+    }
+
+    delete lTransliterator_ptr; lTransliterator_ptr = NULL;
+    delete lXapianDatabase_ptr; lXapianDatabase_ptr = NULL;
+  }
+
+}
@@ -0,0 +1,171 @@
+#ifndef __OPENTREP_SVC_THREADRESOURCEREGISTRY_HPP
+#define __OPENTREP_SVC_THREADRESOURCEREGISTRY_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Forward declarations
+namespace Xapian {
+  class Database;
+}
+
+namespace OPENTREP {
+
+  // Forward declarations
+  class OTransliterator;
+
+  /**
+   * @brief Registry of the resources dedicated to every querying thread
+   *        of a service, i.e., Unicode transliterators and handles on the
+   *        Xapian database/index.
+   *
+   * The resources of a thread are released when that thread exits, so
+   * that a thread pool renewing its threads (e.g., when OpenTREP is hosted
+   * by a Python/WSGI server) does not accumulate the transliterators and
+   * the open Xapian handles (file descriptors) of the dead threads.
+   *
+   * For that purpose, every thread having resources within a registry
+   * keeps a (weak) reference on that registry, in a thread-local list,
+   * the destructor of which releases those resources at thread exit.
+   * The registry must therefore be held by a std::shared_ptr (see
+   * create()); when it has been destroyed in the meantime, there is
+   * nothing left to release.
+   */
+  class ThreadResourceRegistry
+    : public std::enable_shared_from_this<ThreadResourceRegistry> {
+  public:
+    // ////////////// Type definitions /////////////
+    /**
+     * Unicode transliterators, one per thread.
+     */
+    typedef std::map<std::thread::id, OTransliterator*> TransliteratorMap_T;
+
+    /**
+     * Handles on the Xapian database/index, one per thread.
+     */
+    typedef std::map<std::thread::id, Xapian::Database*> XapianDatabaseMap_T;
+
+  public:
+    // //////////////// Getters ///////////////
+    /**
+     * Get the number of threads having a Unicode transliterator.
+     */
+    std::size_t getNbOfTransliterators();
+
+    /**
+     * Get the number of threads having a handle on the Xapian index.
+     */
+    std::size_t getNbOfXapianDatabases();
+
+    /**
+     * Get the Unicode transliterator of the given thread.
+     *
+     * @param const std::thread::id& ID of the thread.
+     * @return OTransliterator* The transliterator, or NULL when there is
+     *         none.
+     */
+    OTransliterator* findTransliterator (const std::thread::id&);
+
+    /**
+     * Get the handle on the Xapian database/index of the given thread.
+     *
+     * @param const std::thread::id& ID of the thread.
+     * @return Xapian::Database* The handle, or NULL when there is none.
+     */
+    Xapian::Database* findXapianDatabase (const std::thread::id&);
+
+  public:
+    // //////////////// Setters ///////////////
+    /**
+     * Set the Unicode transliterator of the calling thread, which is then
+     * owned by the registry. There must not be any transliterator yet for
+     * that thread.
+     */
+    void setCallingThreadTransliterator (OTransliterator*);
+
+    /**
+     * Set (or, when NULL, remove) the handle on the Xapian database/index
+     * of the calling thread, which is then owned by the registry. The
+     * previous handle, if any, is deleted.
+     */
+    void setCallingThreadXapianDatabase (Xapian::Database*);
+
+  public:
+    // //////////////// Business methods ///////////////
+    /**
+     * Delete the Unicode transliterators of all the threads.
+     */
+    void resetTransliterators();
+
+    /**
+     * Delete the handles on the Xapian database/index of all the threads.
+     *
+     * As the handles are deleted, that method must not be called while
+     * queries are being performed by other threads.
+     */
+    void resetXapianDatabases();
+
+    /**
+     * Delete all the resources of the given thread.
+     *
+     * @param const std::thread::id& ID of the thread.
+     */
+    void releaseThread (const std::thread::id&);
+
+  public:
+    // //////////////// Construction and destruction ///////////////
+    /**
+     * Create a registry, held by a std::shared_ptr.
+     */
+    static std::shared_ptr<ThreadResourceRegistry> create();
+
+    /**
+     * Destructor. All the resources of all the threads are deleted.
+     */
+    ~ThreadResourceRegistry();
+
+  private:
+    /**
+     * Default constructor (see create()).
+     */
+    ThreadResourceRegistry();
+
+    /**
+     * Copy constructor. It should not be used.
+     */
+    ThreadResourceRegistry (const ThreadResourceRegistry&);
+
+    /**
+     * Register the registry within the thread-local list of the calling
+     * thread, so that the resources of that thread be released at its
+     * exit.
+     */
+    void watchCallingThread();
+
+  private:
+    // /////////////////////// Attributes //////////////////////
+    /**
+     * Unicode transliterators of the threads.
+     */
+    TransliteratorMap_T _transliteratorMap;
+
+    /**
+     * Handles on the (read-only) Xapian database/index of the threads.
+     */
+    XapianDatabaseMap_T _xapianDatabaseMap;
+
+    /**
+     * Mutex protecting the maps above.
+     */
+    std::mutex _mutex;
+  };
+
+}
+#endif // __OPENTREP_SVC_THREADRESOURCEREGISTRY_HPP
@@ -805,7 +805,10 @@ int main (int argc, char* argv[]) {
       std::cout << "    --------    " << std::endl;
       std::cout << "Management of the database user and database:" << std::endl;
       std::cout << "* For PostgreSQL:" << std::endl;
-      std::cout <<" reset_connection_string db=postgres user=$USER password=<passwd>"
+      std::cout <<" reset_connection_string dbname=postgres user=$USER password=<passwd>"
+                << std::endl;
+      std::cout << " create_user" << std::endl;
+      std::cout <<" reset_connection_string dbname=trep_trep user=trep password=trep"
                 << std::endl;
       std::cout << "* For MySQL:" << std::endl;
       std::cout <<" reset_connection_string db=mysql user=root password=<passwd>"
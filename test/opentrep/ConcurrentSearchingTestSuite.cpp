@@ -0,0 +1,478 @@
+/*!
+ * \page ConcurrentSearchingTestSuite_cpp Command-Line Test to Check the Thread-Safe Query Mode of the OpenTREP Project
+ * \code
+ */
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <future>
+// Boost Unit Test Framework (UTF)
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE ConcurrentSearchingTestSuite
+#include <boost/test/unit_test.hpp>
+// Xapian
+#include <xapian.h>
+// OpenTrep
+#include <opentrep/OPENTREP_Service.hpp>
+#include <opentrep/Location.hpp>
+#include <opentrep/CityDetails.hpp>
+#include <opentrep/basic/QueryResultCache.hpp>
+#include <opentrep/service/ThreadResourceRegistry.hpp>
+
+namespace boost_utf = boost::unit_test;
+
+// (Boost) Unit Test XML Report
+std::ofstream utfReportStream ("ConcurrentSearchingTestSuite_utfresults.xml");
+
+/**
+ * Configuration for the Boost Unit Test Framework (UTF)
+ */
+struct UnitTestConfig {
+  /** Constructor. */
+  UnitTestConfig() {
+    boost_utf::unit_test_log.set_stream (utfReportStream);
+#if defined(BOOST_VERSION) && BOOST_VERSION >= 105900
+    boost_utf::unit_test_log.set_format (boost_utf::OF_XML);
+#else // BOOST_VERSION
+    boost_utf::unit_test_log.set_format (boost_utf::XML);
+#endif // BOOST_VERSION
+    boost_utf::unit_test_log.set_threshold_level (boost_utf::log_test_units);
+  }
+
+  /** Destructor. */
+  ~UnitTestConfig() {
+  }
+};
+
+
+// //////////// Constants for the tests ///////////////
+/**
+ * Xapian database/index file-path (directory containing the index).
+ */
+const std::string X_XAPIAN_DB_FP ("/tmp/opentrep/test_traveldb");
+
+/**
+ * SQL database connection string.
+ */
+const std::string X_SQL_DB_STR ("");
+
+/*
+ * Deployment number/version.
+ */
+const OPENTREP::DeploymentNumber_T X_DEPLOYMENT_NUMBER (0);
+
+/**
+ * Number of concurrent threads.
+ */
+const unsigned short X_NB_OF_THREADS (8);
+
+/**
+ * Number of times every thread performs the whole list of queries.
+ */
+const unsigned short X_NB_OF_ROUNDS (10);
+
+/**
+ * Maximum number of travel queries held by the query result cache.
+ */
+const OPENTREP::NbOfDBEntries_T X_QUERY_RESULT_CACHE_SIZE (64);
+
+/**
+ * Travel queries, performed by every thread.
+ */
+const char* X_TRAVEL_QUERIES[] = {
+  "nce", "sfo", "rio de janeiro", "los angeles", "sna francicso",
+  "reykyavki nce iev mow", "lso angles nyc", "san francisco rio de janero"
+};
+const unsigned short X_NB_OF_TRAVEL_QUERIES =
+  sizeof (X_TRAVEL_QUERIES) / sizeof (X_TRAVEL_QUERIES[0]);
+
+/**
+ * Outcome of a travel query, in a form which can be compared.
+ */
+struct QueryOutcome {
+  OPENTREP::NbOfMatches_T _nbOfMatches;
+  std::string _locations;
+  std::string _nonMatchedWords;
+
+  bool operator== (const QueryOutcome& iOutcome) const {
+    return (_nbOfMatches == iOutcome._nbOfMatches
+            && _locations == iOutcome._locations
+            && _nonMatchedWords == iOutcome._nonMatchedWords);
+  }
+};
+typedef std::vector<QueryOutcome> QueryOutcomeList_T;
+
+/**
+ * Perform the given travel query, and record its outcome.
+ */
+QueryOutcome searchTravelQuery (OPENTREP::OPENTREP_Service& ioOpentrepService,
+                                const std::string& iTravelQuery) {
+  OPENTREP::WordList_T lNonMatchedWordList;
+  OPENTREP::LocationList_T lLocationList;
+
+  QueryOutcome oOutcome;
+  oOutcome._nbOfMatches =
+    ioOpentrepService.interpretTravelRequest (iTravelQuery, lLocationList,
+                                              lNonMatchedWordList);
+
+  std::ostringstream oLocationStr;
+  for (OPENTREP::LocationList_T::const_iterator itLocation =
+         lLocationList.begin(); itLocation != lLocationList.end();
+       ++itLocation) {
+    const OPENTREP::Location& lLocation = *itLocation;
+    oLocationStr << lLocation.toString() << std::endl;
+  }
+  oOutcome._locations = oLocationStr.str();
+
+  std::ostringstream oWordStr;
+  for (OPENTREP::WordList_T::const_iterator itWord =
+         lNonMatchedWordList.begin(); itWord != lNonMatchedWordList.end();
+       ++itWord) {
+    oWordStr << *itWord << " ";
+  }
+  oOutcome._nonMatchedWords = oWordStr.str();
+
+  return oOutcome;
+}
+
+/**
+ * Body of a thread: perform all the travel queries, several times, and
+ * count the outcomes differing from the reference (single-threaded) ones.
+ */
+void searchAllTravelQueries (OPENTREP::OPENTREP_Service& ioOpentrepService,
+                             const QueryOutcomeList_T& iReferenceList,
+                             unsigned int& ioNbOfMismatches,
+                             unsigned int& ioNbOfFailures) {
+  for (unsigned short idxRound = 0; idxRound != X_NB_OF_ROUNDS; ++idxRound) {
+    for (unsigned short idxQuery = 0; idxQuery != X_NB_OF_TRAVEL_QUERIES;
+         ++idxQuery) {
+      try {
+        const QueryOutcome& lOutcome =
+          searchTravelQuery (ioOpentrepService, X_TRAVEL_QUERIES[idxQuery]);
+        if (!(lOutcome == iReferenceList[idxQuery])) {
+          ++ioNbOfMismatches;
+        }
+
+      } catch (...) {
+        ++ioNbOfFailures;
+      }
+    }
+  }
+}
+
+// /////////////// Main: Unit Test Suite //////////////
+
+// Set the UTF configuration (re-direct the output to a specific file)
+BOOST_GLOBAL_FIXTURE (UnitTestConfig);
+
+// Start the test suite
+BOOST_AUTO_TEST_SUITE (master_test_suite)
+
+/**
+ * Perform the same travel searches, concurrently, from several threads
+ * sharing a single service, and check that the results are the same
+ * as the single-threaded ones
+ */
+BOOST_AUTO_TEST_CASE (opentrep_concurrent_search) {
+
+  // Output log File
+  std::string lLogFilename ("ConcurrentSearchingTestSuite.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the context
+  const OPENTREP::TravelDBFilePath_T lTravelDBFilePath (X_XAPIAN_DB_FP);
+  const OPENTREP::DBType lDBType (OPENTREP::DBType::NODB);
+  const OPENTREP::SQLDBConnectionString_T lSQLDBConnStr (X_SQL_DB_STR);
+  const OPENTREP::DeploymentNumber_T lDeploymentNumber (X_DEPLOYMENT_NUMBER);
+  OPENTREP::OPENTREP_Service opentrepService (logOutputFile, lTravelDBFilePath,
+                                              lDBType, lSQLDBConnStr,
+                                              lDeploymentNumber);
+
+  // Reference outcomes, obtained by single-threaded queries
+  QueryOutcomeList_T lReferenceList;
+  for (unsigned short idxQuery = 0; idxQuery != X_NB_OF_TRAVEL_QUERIES;
+       ++idxQuery) {
+    lReferenceList.push_back (searchTravelQuery (opentrepService,
+                                                 X_TRAVEL_QUERIES[idxQuery]));
+  }
+
+  // Perform the same queries, concurrently, on the same service
+  std::vector<unsigned int> lNbOfMismatchesList (X_NB_OF_THREADS, 0);
+  std::vector<unsigned int> lNbOfFailuresList (X_NB_OF_THREADS, 0);
+  std::vector<std::thread> lThreadList;
+  for (unsigned short idxThread = 0; idxThread != X_NB_OF_THREADS;
+       ++idxThread) {
+    lThreadList.push_back (std::thread (searchAllTravelQueries,
+                                        std::ref (opentrepService),
+                                        std::cref (lReferenceList),
+                                        std::ref (lNbOfMismatchesList[idxThread]),
+                                        std::ref (lNbOfFailuresList[idxThread])));
+  }
+  for (std::vector<std::thread>::iterator itThread = lThreadList.begin();
+       itThread != lThreadList.end(); ++itThread) {
+    itThread->join();
+  }
+
+  for (unsigned short idxThread = 0; idxThread != X_NB_OF_THREADS;
+       ++idxThread) {
+    BOOST_CHECK_MESSAGE (lNbOfFailuresList[idxThread] == 0,
+                         "Thread #" << idxThread << ": "
+                         << lNbOfFailuresList[idxThread]
+                         << " travel queries have thrown an exception");
+    BOOST_CHECK_MESSAGE (lNbOfMismatchesList[idxThread] == 0,
+                         "Thread #" << idxThread << ": "
+                         << lNbOfMismatchesList[idxThread]
+                         << " travel queries differ from the single-threaded"
+                         << " ones");
+  }
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Check the limits (size, time-to-live) of the query result cache
+ */
+BOOST_AUTO_TEST_CASE (opentrep_query_result_cache) {
+
+  // Cache of a single travel query by stripe, the results of which
+  // never expire
+  OPENTREP::QueryResultCache lQueryResultCache (16, 0);
+
+  OPENTREP::LocationList_T lLocationList;
+  OPENTREP::WordList_T lWordList;
+  lWordList.push_back ("sna");
+  const std::string& lKey =
+    OPENTREP::QueryResultCache::buildKey (0, "uuid", "sna nce");
+  lQueryResultCache.insert (lKey, lLocationList, lWordList, 1);
+
+  // The results are found, and added to the given lists
+  OPENTREP::LocationList_T lCachedLocationList;
+  OPENTREP::WordList_T lCachedWordList;
+  OPENTREP::NbOfMatches_T lNbOfMatches = 0;
+  BOOST_CHECK (lQueryResultCache.find (lKey, lCachedLocationList,
+                                       lCachedWordList, lNbOfMatches) == true);
+  BOOST_CHECK_EQUAL (lNbOfMatches, 1);
+  BOOST_CHECK (lCachedWordList == lWordList);
+
+  // Another deployment number is another key
+  const std::string& lOtherKey =
+    OPENTREP::QueryResultCache::buildKey (1, "uuid", "sna nce");
+  BOOST_CHECK (lQueryResultCache.find (lOtherKey, lCachedLocationList,
+                                       lCachedWordList, lNbOfMatches) == false);
+  BOOST_CHECK_EQUAL (lQueryResultCache.getNbOfHits(), 1);
+  BOOST_CHECK_EQUAL (lQueryResultCache.getNbOfMisses(), 1);
+
+  // The least recently used results are evicted
+  for (unsigned short idx = 0; idx != 100; ++idx) {
+    std::ostringstream oStr;
+    oStr << "query" << idx;
+    const std::string& lQueryKey =
+      OPENTREP::QueryResultCache::buildKey (0, "uuid", oStr.str());
+    lQueryResultCache.insert (lQueryKey, lLocationList, lWordList, 1);
+  }
+  BOOST_CHECK (lQueryResultCache.getSize() <= 16);
+  BOOST_CHECK (lQueryResultCache.getNbOfEvictions() >= 85);
+
+  // The cache may be emptied
+  lQueryResultCache.clear();
+  BOOST_CHECK_EQUAL (lQueryResultCache.getSize(), 0);
+
+  // The expired results are not used
+  lQueryResultCache.reset (16, 1);
+  lQueryResultCache.insert (lKey, lLocationList, lWordList, 1);
+  std::this_thread::sleep_for (std::chrono::milliseconds (1100));
+  BOOST_CHECK (lQueryResultCache.find (lKey, lCachedLocationList,
+                                       lCachedWordList, lNbOfMatches) == false);
+  BOOST_CHECK_EQUAL (lQueryResultCache.getSize(), 0);
+
+  // No result is stored when the cache is not enabled
+  lQueryResultCache.reset (0, 0);
+  lQueryResultCache.insert (lKey, lLocationList, lWordList, 1);
+  BOOST_CHECK_EQUAL (lQueryResultCache.getSize(), 0);
+}
+
+/**
+ * Perform the same travel searches, concurrently, from several threads
+ * sharing a single service, the query result cache of which is enabled,
+ * and check that the results are the same as the non-cached ones
+ */
+BOOST_AUTO_TEST_CASE (opentrep_concurrent_cached_search) {
+
+  // Output log File
+  std::string lLogFilename ("ConcurrentSearchingTestSuite_cache.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the context
+  const OPENTREP::TravelDBFilePath_T lTravelDBFilePath (X_XAPIAN_DB_FP);
+  const OPENTREP::DBType lDBType (OPENTREP::DBType::NODB);
+  const OPENTREP::SQLDBConnectionString_T lSQLDBConnStr (X_SQL_DB_STR);
+  const OPENTREP::DeploymentNumber_T lDeploymentNumber (X_DEPLOYMENT_NUMBER);
+  OPENTREP::OPENTREP_Service opentrepService (logOutputFile, lTravelDBFilePath,
+                                              lDBType, lSQLDBConnStr,
+                                              lDeploymentNumber);
+
+  // Reference outcomes, obtained by non-cached queries
+  QueryOutcomeList_T lReferenceList;
+  for (unsigned short idxQuery = 0; idxQuery != X_NB_OF_TRAVEL_QUERIES;
+       ++idxQuery) {
+    lReferenceList.push_back (searchTravelQuery (opentrepService,
+                                                 X_TRAVEL_QUERIES[idxQuery]));
+  }
+  BOOST_CHECK_EQUAL (opentrepService.getNbOfQueryResultCacheHits(), 0);
+  BOOST_CHECK_EQUAL (opentrepService.getNbOfQueryResultCacheMisses(), 0);
+
+  // Enable the query result cache, the results of which never expire
+  opentrepService.setQueryResultCacheLimits (X_QUERY_RESULT_CACHE_SIZE, 0);
+
+  // Perform the same queries, concurrently, on the same service
+  std::vector<unsigned int> lNbOfMismatchesList (X_NB_OF_THREADS, 0);
+  std::vector<unsigned int> lNbOfFailuresList (X_NB_OF_THREADS, 0);
+  std::vector<std::thread> lThreadList;
+  for (unsigned short idxThread = 0; idxThread != X_NB_OF_THREADS;
+       ++idxThread) {
+    lThreadList.push_back (std::thread (searchAllTravelQueries,
+                                        std::ref (opentrepService),
+                                        std::cref (lReferenceList),
+                                        std::ref (lNbOfMismatchesList[idxThread]),
+                                        std::ref (lNbOfFailuresList[idxThread])));
+  }
+  for (std::vector<std::thread>::iterator itThread = lThreadList.begin();
+       itThread != lThreadList.end(); ++itThread) {
+    itThread->join();
+  }
+
+  for (unsigned short idxThread = 0; idxThread != X_NB_OF_THREADS;
+       ++idxThread) {
+    BOOST_CHECK_MESSAGE (lNbOfFailuresList[idxThread] == 0,
+                         "Thread #" << idxThread << ": "
+                         << lNbOfFailuresList[idxThread]
+                         << " travel queries have thrown an exception");
+    BOOST_CHECK_MESSAGE (lNbOfMismatchesList[idxThread] == 0,
+                         "Thread #" << idxThread << ": "
+                         << lNbOfMismatchesList[idxThread]
+                         << " cached travel queries differ from the"
+                         << " non-cached ones");
+  }
+
+  // Every travel query has been interpreted at least once, and then
+  // mostly found in the cache
+  const OPENTREP::NbOfLookups_T lNbOfHits =
+    opentrepService.getNbOfQueryResultCacheHits();
+  const OPENTREP::NbOfLookups_T lNbOfMisses =
+    opentrepService.getNbOfQueryResultCacheMisses();
+  BOOST_CHECK_EQUAL (lNbOfHits + lNbOfMisses,
+                     X_NB_OF_THREADS * X_NB_OF_ROUNDS * X_NB_OF_TRAVEL_QUERIES);
+  BOOST_CHECK (lNbOfMisses >= X_NB_OF_TRAVEL_QUERIES);
+  BOOST_CHECK (lNbOfHits > lNbOfMisses);
+
+  // A travel query differing only by its case and spacing is cached on
+  // its own, as its results (e.g., the unmatched words) are specific to it
+  const std::string lVariantQuery ("Rio  DE janeiro");
+  searchTravelQuery (opentrepService, lVariantQuery);
+  BOOST_CHECK_EQUAL (opentrepService.getNbOfQueryResultCacheHits(),
+                     lNbOfHits);
+  const QueryOutcome& lCachedOutcome =
+    searchTravelQuery (opentrepService, lVariantQuery);
+  BOOST_CHECK_EQUAL (opentrepService.getNbOfQueryResultCacheHits(),
+                     lNbOfHits + 1);
+
+  // The cached results are the same as the non-cached ones
+  opentrepService.setQueryResultCacheLimits (0, 0);
+  const QueryOutcome& lNonCachedOutcome =
+    searchTravelQuery (opentrepService, lVariantQuery);
+  BOOST_CHECK_EQUAL (opentrepService.getNbOfQueryResultCacheHits(),
+                     lNbOfHits + 1);
+  BOOST_CHECK (lCachedOutcome == lNonCachedOutcome);
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Body of a thread: open a (empty) Xapian database handle, registered
+ * within the given registry, and exit once told to.
+ */
+void openThreadXapianDatabase (std::shared_ptr<OPENTREP::ThreadResourceRegistry>
+                               ioRegistry_ptr,
+                               std::promise<void>& ioOpenedPromise,
+                               std::shared_future<void> iExitFuture) {
+  ioRegistry_ptr->setCallingThreadXapianDatabase (new Xapian::Database());
+  ioRegistry_ptr.reset();
+  ioOpenedPromise.set_value();
+  iExitFuture.wait();
+}
+
+/**
+ * Check that the resources (here, Xapian handles) of the querying threads
+ * are released when those threads exit
+ */
+BOOST_AUTO_TEST_CASE (opentrep_thread_resource_release) {
+
+  std::shared_ptr<OPENTREP::ThreadResourceRegistry> lRegistry_ptr =
+    OPENTREP::ThreadResourceRegistry::create();
+
+  // The handles of the threads are kept as long as the threads are alive
+  std::vector<std::promise<void> > lOpenedPromiseList (X_NB_OF_THREADS);
+  std::promise<void> lExitPromise;
+  std::shared_future<void> lExitFuture (lExitPromise.get_future());
+  std::vector<std::thread> lThreadList;
+  for (unsigned short idxThread = 0; idxThread != X_NB_OF_THREADS;
+       ++idxThread) {
+    lThreadList.push_back (std::thread (openThreadXapianDatabase,
+                                        lRegistry_ptr,
+                                        std::ref (lOpenedPromiseList[idxThread]),
+                                        lExitFuture));
+  }
+  for (unsigned short idxThread = 0; idxThread != X_NB_OF_THREADS;
+       ++idxThread) {
+    lOpenedPromiseList[idxThread].get_future().wait();
+  }
+  BOOST_CHECK_EQUAL (lRegistry_ptr->getNbOfXapianDatabases(),
+                     X_NB_OF_THREADS);
+
+  // They are released when the threads exit
+  lExitPromise.set_value();
+  for (std::vector<std::thread>::iterator itThread = lThreadList.begin();
+       itThread != lThreadList.end(); ++itThread) {
+    itThread->join();
+  }
+  BOOST_CHECK_EQUAL (lRegistry_ptr->getNbOfXapianDatabases(), 0);
+
+  // A thread may outlive the registry
+  std::promise<void> lOpenedPromise;
+  std::promise<void> lLateExitPromise;
+  std::thread lThread (openThreadXapianDatabase, lRegistry_ptr,
+                       std::ref (lOpenedPromise),
+                       std::shared_future<void> (lLateExitPromise.get_future()));
+  lOpenedPromise.get_future().wait();
+  BOOST_CHECK_EQUAL (lRegistry_ptr->getNbOfXapianDatabases(), 1);
+  lRegistry_ptr.reset();
+  lLateExitPromise.set_value();
+  lThread.join();
+}
+
+// End the test suite
+BOOST_AUTO_TEST_SUITE_END()
+
+/*!
+ * \endcode
+ */
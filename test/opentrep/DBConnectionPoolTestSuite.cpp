@@ -0,0 +1,461 @@
+/*!
+ * \page DBConnectionPoolTestSuite_cpp Command-Line Test to Check the Pool of Connections to the SQL Database of the OpenTREP Project
+ * \code
+ */
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstdlib>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+// Boost Unit Test Framework (UTF)
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE DBConnectionPoolTestSuite
+#include <boost/test/unit_test.hpp>
+// OpenTrep
+#include <opentrep/OPENTREP_Service.hpp>
+#include <opentrep/Location.hpp>
+#include <opentrep/CityDetails.hpp>
+#include <opentrep/command/DBConnection.hpp>
+#include <opentrep/command/DBConnectionPool.hpp>
+#include <opentrep/command/DBManager.hpp>
+#include <opentrep/service/Logger.hpp>
+#include <opentrep/config/opentrep-paths.hpp>
+
+namespace boost_utf = boost::unit_test;
+
+// (Boost) Unit Test XML Report
+std::ofstream utfReportStream ("DBConnectionPoolTestSuite_utfresults.xml");
+
+/**
+ * Configuration for the Boost Unit Test Framework (UTF)
+ */
+struct UnitTestConfig {
+  /** Constructor. */
+  UnitTestConfig() {
+    boost_utf::unit_test_log.set_stream (utfReportStream);
+#if defined(BOOST_VERSION) && BOOST_VERSION >= 105900
+    boost_utf::unit_test_log.set_format (boost_utf::OF_XML);
+#else // BOOST_VERSION
+    boost_utf::unit_test_log.set_format (boost_utf::XML);
+#endif // BOOST_VERSION
+    boost_utf::unit_test_log.set_threshold_level (boost_utf::log_test_units);
+  }
+
+  /** Destructor. */
+  ~UnitTestConfig() {
+  }
+};
+
+
+// //////////// Constants for the tests ///////////////
+/**
+ * File-path of the POR (points of reference) file.
+ */
+const std::string K_POR_FILEPATH (OPENTREP_POR_DATA_DIR
+                                  "/csv/test-optd-por-public.csv");
+
+/**
+ * Xapian database/index file-path (directory containing the index).
+ */
+const std::string X_XAPIAN_DB_FP ("/tmp/opentrep/test_pool_traveldb");
+
+/**
+ * SQLite3 database file-path. The directory is cleared when the database
+ * is re-created, and is therefore dedicated to that test.
+ */
+const std::string X_SQLITE_DB_FP ("/tmp/opentrep/test_pool_sqlite/traveldb");
+
+/**
+ * Names of the environment variables specifying another SQL database
+ * (e.g., a local MariaDB or PostgreSQL instance), on which the same
+ * checks are performed. When they are not set, those checks are skipped.
+ * For instance:
+ * <tt>OPENTREP_TEST_SQL_DB_TYPE=mysql
+ *     OPENTREP_TEST_SQL_DB_CONN="db=trep_trep user=trep password=trep"</tt>
+ */
+const char* X_SQL_DB_TYPE_ENV_VAR ("OPENTREP_TEST_SQL_DB_TYPE");
+const char* X_SQL_DB_CONN_ENV_VAR ("OPENTREP_TEST_SQL_DB_CONN");
+
+/*
+ * Deployment number/version.
+ */
+const OPENTREP::DeploymentNumber_T X_DEPLOYMENT_NUMBER (0);
+
+/**
+ * Number of concurrent threads. It is greater than the number of
+ * connections of the pool, so that some threads have to wait.
+ */
+const unsigned short X_NB_OF_THREADS (12);
+
+/**
+ * Number of look ups performed by every thread.
+ */
+const unsigned short X_NB_OF_LOOKUPS (50);
+
+/**
+ * Fill the Xapian index and the given SQL database from the POR file.
+ *
+ * @return OPENTREP::NbOfDBEntries_T Number of indexed POR.
+ */
+OPENTREP::NbOfDBEntries_T
+buildDatabases (std::ostream& ioLogStream, const OPENTREP::DBType& iDBType,
+                const OPENTREP::SQLDBConnectionString_T& iSQLDBConnStr) {
+  const OPENTREP::PORFilePath_T lPORFilePath (K_POR_FILEPATH);
+  const OPENTREP::TravelDBFilePath_T lTravelDBFilePath (X_XAPIAN_DB_FP);
+  const OPENTREP::DeploymentNumber_T lDeploymentNumber (X_DEPLOYMENT_NUMBER);
+  const OPENTREP::shouldIndexNonIATAPOR_T lShouldIndexNonIATAPOR (false);
+  const OPENTREP::shouldIndexPORInXapian_T lShouldIndexPORInXapian (true);
+  const OPENTREP::shouldAddPORInSQLDB_T lShouldAddPORInSQLDB (true);
+  OPENTREP::OPENTREP_Service opentrepService (ioLogStream, lPORFilePath,
+                                              lTravelDBFilePath,
+                                              iDBType, iSQLDBConnStr,
+                                              lDeploymentNumber,
+                                              lShouldIndexNonIATAPOR,
+                                              lShouldIndexPORInXapian,
+                                              lShouldAddPORInSQLDB);
+
+  // Re-create the SQL database (and, for SQLite3, its directory)
+  opentrepService.createSQLDBUser();
+
+  return opentrepService.insertIntoDBAndXapian();
+}
+
+/**
+ * Check the look ups on the given SQL database, sequentially and then
+ * concurrently, through the pool of connections of the service.
+ */
+void checkLookups (std::ostream& ioLogStream, const OPENTREP::DBType& iDBType,
+                   const OPENTREP::SQLDBConnectionString_T& iSQLDBConnStr) {
+  // Build the Xapian index and fill the SQL database
+  const OPENTREP::NbOfDBEntries_T lNbOfEntries =
+    buildDatabases (ioLogStream, iDBType, iSQLDBConnStr);
+
+  // Initialise the context for the look ups
+  const OPENTREP::TravelDBFilePath_T lTravelDBFilePath (X_XAPIAN_DB_FP);
+  const OPENTREP::DeploymentNumber_T lDeploymentNumber (X_DEPLOYMENT_NUMBER);
+  OPENTREP::OPENTREP_Service opentrepService (ioLogStream, lTravelDBFilePath,
+                                              iDBType, iSQLDBConnStr,
+                                              lDeploymentNumber);
+
+  // All the POR have been added to the SQL database
+  BOOST_CHECK_EQUAL (opentrepService.getNbOfPORFromDB(), lNbOfEntries);
+
+  // The statements, prepared once per connection, give the same results
+  // whatever the number of look ups and the case of the codes
+  for (unsigned short idx = 0; idx != X_NB_OF_LOOKUPS; ++idx) {
+    OPENTREP::LocationList_T lLocationList;
+    const std::string lIataCode ((idx % 2 == 0) ? "nce" : "NCE");
+    const OPENTREP::NbOfMatches_T& lNbOfMatches =
+      opentrepService.listByIataCode (OPENTREP::IATACode_T (lIataCode),
+                                      lLocationList);
+    BOOST_CHECK_EQUAL (lNbOfMatches, 2);
+    BOOST_CHECK_EQUAL (lLocationList.size(), 2);
+
+    lLocationList.clear();
+    BOOST_CHECK_EQUAL (opentrepService.
+                       listByIcaoCode (OPENTREP::ICAOCode_T ("LFMN"),
+                                       lLocationList), 1);
+    BOOST_CHECK_EQUAL (opentrepService.
+                       listByIcaoCode (OPENTREP::ICAOCode_T ("ZZZZ"),
+                                       lLocationList), 0);
+  }
+
+  // Concurrent look ups, with more threads than pooled connections
+  std::vector<unsigned int> lNbOfFailuresList (X_NB_OF_THREADS, 0);
+  std::vector<std::thread> lThreadList;
+  for (unsigned short idxThread = 0; idxThread != X_NB_OF_THREADS;
+       ++idxThread) {
+    unsigned int& lNbOfFailures = lNbOfFailuresList[idxThread];
+    lThreadList.push_back (std::thread ([&opentrepService, &lNbOfFailures]() {
+          for (unsigned short idx = 0; idx != X_NB_OF_LOOKUPS; ++idx) {
+            try {
+              OPENTREP::LocationList_T lLocationList;
+              const OPENTREP::NbOfMatches_T& lNbOfMatches =
+                opentrepService.listByIataCode (OPENTREP::IATACode_T ("sfo"),
+                                                lLocationList);
+              if (lNbOfMatches != 2) {
+                ++lNbOfFailures;
+              }
+
+            } catch (std::exception const& lException) {
+              ++lNbOfFailures;
+            }
+          }
+        }));
+  }
+  for (std::vector<std::thread>::iterator itThread = lThreadList.begin();
+       itThread != lThreadList.end(); ++itThread) {
+    itThread->join();
+  }
+
+  for (unsigned short idxThread = 0; idxThread != X_NB_OF_THREADS;
+       ++idxThread) {
+    BOOST_CHECK_MESSAGE (lNbOfFailuresList[idxThread] == 0,
+                         "Thread #" << idxThread << " got "
+                         << lNbOfFailuresList[idxThread] << " failed look ups");
+  }
+}
+
+// /////////////// Main: Unit Test Suite //////////////
+
+// Set the UTF configuration (re-direct the output to a specific file)
+BOOST_GLOBAL_FIXTURE (UnitTestConfig);
+
+// Start the test suite
+BOOST_AUTO_TEST_SUITE (master_test_suite)
+
+/**
+ * Test the look ups on a SQLite3 database through the pool of connections
+ */
+BOOST_AUTO_TEST_CASE (opentrep_pool_sqlite_lookups) {
+
+  // Output log File
+  std::string lLogFilename ("DBConnectionPoolTestSuite.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  const OPENTREP::DBType lDBType (OPENTREP::DBType::SQLITE3);
+  const OPENTREP::SQLDBConnectionString_T lSQLDBConnStr (X_SQLITE_DB_FP);
+  checkLookups (logOutputFile, lDBType, lSQLDBConnStr);
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Test that a connection is kept opened across leases, along with its
+ * prepared statements, and re-opened once invalidated
+ */
+BOOST_AUTO_TEST_CASE (opentrep_pool_reconnection) {
+
+  // Output log File
+  std::string lLogFilename ("DBConnectionPoolTestSuite_reconnection.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+  OPENTREP::Logger::instance().setLogParameters (OPENTREP::LOG::NOTIFICATION,
+                                                 logOutputFile);
+
+  // The SQLite3 database has been filled by the previous test case. The
+  // deployment number is appended to its file-path by the service
+  std::ostringstream lSQLDBConnStr;
+  lSQLDBConnStr << X_SQLITE_DB_FP << X_DEPLOYMENT_NUMBER;
+  const OPENTREP::DBType lDBType (OPENTREP::DBType::SQLITE3);
+  const OPENTREP::SQLDBConnectionString_T lSQLDBConnString(lSQLDBConnStr.str());
+  OPENTREP::DBConnectionPool lDBConnectionPool (lDBType, lSQLDBConnString, 1);
+
+  for (unsigned short idx = 0; idx != 3; ++idx) {
+    OPENTREP::DBConnectionLease lDBConnectionLease (lDBConnectionPool);
+    OPENTREP::DBConnection& lDBConnection =
+      lDBConnectionLease.getDBConnection();
+    BOOST_CHECK_EQUAL (lDBConnection.getNbOfOpenings(), 1);
+
+    OPENTREP::LocationList_T lLocationList;
+    BOOST_CHECK_EQUAL (OPENTREP::DBManager::
+                       getPORByIATACode (lDBConnection,
+                                         OPENTREP::IATACode_T ("nce"),
+                                         lLocationList, true), 1);
+    BOOST_CHECK (lDBConnection.
+                 findStatement (OPENTREP::DBConnection::SELECT_ON_IATA_CODE)
+                 != NULL);
+  }
+
+  // Once invalidated, the connection is re-opened, and the statements
+  // are prepared again
+  {
+    OPENTREP::DBConnectionLease lDBConnectionLease (lDBConnectionPool);
+    lDBConnectionLease.getDBConnection().invalidate();
+  }
+  {
+    OPENTREP::DBConnectionLease lDBConnectionLease (lDBConnectionPool);
+    OPENTREP::DBConnection& lDBConnection =
+      lDBConnectionLease.getDBConnection();
+    BOOST_CHECK_EQUAL (lDBConnection.getNbOfOpenings(), 2);
+    BOOST_CHECK (lDBConnection.
+                 findStatement (OPENTREP::DBConnection::SELECT_ON_IATA_CODE)
+                 == NULL);
+
+    OPENTREP::LocationList_T lLocationList;
+    BOOST_CHECK_EQUAL (OPENTREP::DBManager::
+                       getPORByIATACode (lDBConnection,
+                                         OPENTREP::IATACode_T ("nce"),
+                                         lLocationList, true), 1);
+  }
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Test the batched look ups, performing a single SQL request for a list
+ * of codes, and dispatching the retrieved POR per code
+ */
+BOOST_AUTO_TEST_CASE (opentrep_pool_batched_lookups) {
+
+  // Output log File
+  std::string lLogFilename ("DBConnectionPoolTestSuite_batched.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+  OPENTREP::Logger::instance().setLogParameters (OPENTREP::LOG::NOTIFICATION,
+                                                 logOutputFile);
+
+  // The SQLite3 database has been filled by the first test case
+  std::ostringstream lSQLDBConnStr;
+  lSQLDBConnStr << X_SQLITE_DB_FP << X_DEPLOYMENT_NUMBER;
+  const OPENTREP::DBType lDBType (OPENTREP::DBType::SQLITE3);
+  const OPENTREP::SQLDBConnectionString_T lSQLDBConnString(lSQLDBConnStr.str());
+  OPENTREP::DBConnectionPool lDBConnectionPool (lDBType, lSQLDBConnString, 1);
+  OPENTREP::DBConnectionLease lDBConnectionLease (lDBConnectionPool);
+  OPENTREP::DBConnection& lDBConnection = lDBConnectionLease.getDBConnection();
+
+  // IATA codes, with a duplicate and an unknown code
+  OPENTREP::IATACodeList_T lIataCodeList;
+  lIataCodeList.push_back (OPENTREP::IATACode_T ("nce"));
+  lIataCodeList.push_back (OPENTREP::IATACode_T ("SFO"));
+  lIataCodeList.push_back (OPENTREP::IATACode_T ("zzz"));
+  lIataCodeList.push_back (OPENTREP::IATACode_T ("NCE"));
+
+  // Only the POR having the highest PageRank value is kept for every code
+  OPENTREP::LocationListList_T lLocationListList;
+  BOOST_CHECK_EQUAL (OPENTREP::DBManager::
+                     getPORByIATACodeList (lDBConnection, lIataCodeList,
+                                           lLocationListList, true), 3);
+  BOOST_REQUIRE_EQUAL (lLocationListList.size(), 4);
+  BOOST_CHECK_EQUAL (lLocationListList[0].size(), 1);
+  BOOST_CHECK_EQUAL (lLocationListList[1].size(), 1);
+  BOOST_CHECK_EQUAL (lLocationListList[2].size(), 0);
+  BOOST_CHECK_EQUAL (lLocationListList[3].size(), 1);
+
+  // The same POR as with the look ups code per code
+  OPENTREP::LocationList_T lLocationList;
+  OPENTREP::DBManager::getPORByIATACode (lDBConnection,
+                                         OPENTREP::IATACode_T ("sfo"),
+                                         lLocationList, true);
+  BOOST_REQUIRE_EQUAL (lLocationList.size(), 1);
+  BOOST_CHECK_EQUAL (lLocationListList[1].front().getGeonamesID(),
+                     lLocationList.front().getGeonamesID());
+  BOOST_CHECK_EQUAL (lLocationListList[1].front().getCorrectedKeywords(),
+                     "SFO");
+
+  // All the POR are kept for every code
+  BOOST_CHECK_EQUAL (OPENTREP::DBManager::
+                     getPORByIATACodeList (lDBConnection, lIataCodeList,
+                                           lLocationListList, false), 6);
+  BOOST_REQUIRE_EQUAL (lLocationListList.size(), 4);
+  BOOST_CHECK_EQUAL (lLocationListList[0].size(), 2);
+  BOOST_CHECK_EQUAL (lLocationListList[1].size(), 2);
+  BOOST_CHECK_EQUAL (lLocationListList[2].size(), 0);
+  BOOST_CHECK_EQUAL (lLocationListList[3].size(), 2);
+
+  // ICAO codes
+  OPENTREP::ICAOCodeList_T lIcaoCodeList;
+  lIcaoCodeList.push_back (OPENTREP::ICAOCode_T ("ksfo"));
+  lIcaoCodeList.push_back (OPENTREP::ICAOCode_T ("LFMN"));
+  BOOST_CHECK_EQUAL (OPENTREP::DBManager::
+                     getPORByICAOCodeList (lDBConnection, lIcaoCodeList,
+                                           lLocationListList), 2);
+  BOOST_REQUIRE_EQUAL (lLocationListList.size(), 2);
+  BOOST_REQUIRE_EQUAL (lLocationListList[0].size(), 1);
+  BOOST_REQUIRE_EQUAL (lLocationListList[1].size(), 1);
+  BOOST_CHECK_EQUAL (lLocationListList[0].front().getGeonamesID(), 5391989);
+  BOOST_CHECK_EQUAL (lLocationListList[1].front().getGeonamesID(), 6299418);
+
+  // UN/LOCODE codes. Both Nice POR (the airport and the city) have the
+  // FRNCE code and the same PageRank value: as with the look ups code per
+  // code, the first one is kept
+  OPENTREP::UNLOCodeList_T lUNLOCodeList;
+  lUNLOCodeList.push_back (OPENTREP::UNLOCode_T ("frnce"));
+  lUNLOCodeList.push_back (OPENTREP::UNLOCode_T ("USLAX"));
+  BOOST_CHECK_EQUAL (OPENTREP::DBManager::
+                     getPORByUNLOCodeList (lDBConnection, lUNLOCodeList,
+                                           lLocationListList, true), 2);
+  BOOST_REQUIRE_EQUAL (lLocationListList.size(), 2);
+  BOOST_REQUIRE_EQUAL (lLocationListList[0].size(), 1);
+  BOOST_REQUIRE_EQUAL (lLocationListList[1].size(), 1);
+  BOOST_CHECK_EQUAL (lLocationListList[1].front().getGeonamesID(), 5368361);
+
+  lLocationList.clear();
+  OPENTREP::DBManager::getPORByUNLOCode (lDBConnection,
+                                         OPENTREP::UNLOCode_T ("frnce"),
+                                         lLocationList, true);
+  BOOST_REQUIRE_EQUAL (lLocationList.size(), 1);
+  BOOST_CHECK_EQUAL (lLocationListList[0].front().getGeonamesID(),
+                     lLocationList.front().getGeonamesID());
+
+  BOOST_CHECK_EQUAL (OPENTREP::DBManager::
+                     getPORByUNLOCodeList (lDBConnection, lUNLOCodeList,
+                                           lLocationListList, false), 4);
+
+  // Geonames IDs
+  OPENTREP::GeonamesIDList_T lGeonamesIDList;
+  lGeonamesIDList.push_back (2990440);
+  lGeonamesIDList.push_back (1);
+  lGeonamesIDList.push_back (5368361);
+  BOOST_CHECK_EQUAL (OPENTREP::DBManager::
+                     getPORByGeonameIDList (lDBConnection, lGeonamesIDList,
+                                            lLocationListList), 2);
+  BOOST_REQUIRE_EQUAL (lLocationListList.size(), 3);
+  BOOST_REQUIRE_EQUAL (lLocationListList[0].size(), 1);
+  BOOST_CHECK_EQUAL (lLocationListList[1].size(), 0);
+  BOOST_REQUIRE_EQUAL (lLocationListList[2].size(), 1);
+  BOOST_CHECK_EQUAL (lLocationListList[2].front().getGeonamesID(), 5368361);
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Test the look ups on another SQL database (e.g., a local MariaDB or
+ * PostgreSQL instance), when specified by the environment
+ */
+BOOST_AUTO_TEST_CASE (opentrep_pool_external_lookups) {
+
+  const char* lSQLDBTypeStr = std::getenv (X_SQL_DB_TYPE_ENV_VAR);
+  const char* lSQLDBConnStr = std::getenv (X_SQL_DB_CONN_ENV_VAR);
+  if (lSQLDBTypeStr == NULL || lSQLDBConnStr == NULL) {
+    BOOST_TEST_MESSAGE ("Neither " << X_SQL_DB_TYPE_ENV_VAR << " nor "
+                        << X_SQL_DB_CONN_ENV_VAR << " is set: the look ups "
+                        << "on another SQL database are skipped");
+    return;
+  }
+
+  // Output log File
+  std::string lLogFilename ("DBConnectionPoolTestSuite_external.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  const OPENTREP::DBType lDBType ((std::string (lSQLDBTypeStr)));
+  checkLookups (logOutputFile, lDBType,
+                OPENTREP::SQLDBConnectionString_T (lSQLDBConnStr));
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+// End the test suite
+BOOST_AUTO_TEST_SUITE_END()
+
+/*!
+ * \endcode
+ */
@@ -67,6 +67,19 @@ const std::string X_XAPIAN_DB_FP ("/tmp/opentrep/test_traveldb");
  */
 const std::string X_SQL_DB_STR ("");
 
+/**
+ * SQLite3 database file-path, for the bulk load test. The directory is
+ * cleared when the database is re-created, and is therefore dedicated
+ * to that test.
+ */
+const std::string X_SQLITE_DB_FP ("/tmp/opentrep/test_bulk_sqlite/traveldb");
+
+/**
+ * Number of rows loaded into the SQL database within a single transaction.
+ * The POR of the test file do not fill the last transaction.
+ */
+const OPENTREP::NbOfDBEntries_T X_SQLDB_BATCH_SIZE (4);
+
 /**
  * Deployment number/version.
  */
@@ -87,6 +100,69 @@ const OPENTREP::shouldIndexPORInXapian_T K_XAPIAN_IDX = true;
  */
 const OPENTREP::shouldAddPORInSQLDB_T K_SQLDB_ADD = false;
 
+/**
+ * Number of worker threads of the parallel indexing pipeline.
+ */
+const OPENTREP::NbOfThreads_T X_NB_OF_INDEXING_THREADS (4);
+
+/**
+ * Number of Xapian shards of the sharded indexation. The POR of the test
+ * file do not fill evenly the shards.
+ */
+const OPENTREP::NbOfShards_T X_NB_OF_INDEXING_SHARDS (4);
+
+
+// //////////// Helpers for the tests ///////////////
+/**
+ * Re-build the Xapian index with the given numbers of indexing threads
+ * and shards, and describe the outcome of a few travel queries on that
+ * index.
+ */
+std::string indexAndSearch (std::ofstream& ioLogOutputFile,
+                            const OPENTREP::NbOfThreads_T& iNbOfThreads,
+                            const OPENTREP::NbOfShards_T& iNbOfShards,
+                            OPENTREP::NbOfDBEntries_T& oNbOfEntries) {
+  const OPENTREP::PORFilePath_T lPORFilePath (K_POR_FILEPATH);
+  const OPENTREP::TravelDBFilePath_T lTravelDBFilePath (X_XAPIAN_DB_FP);
+  const OPENTREP::DBType lDBType (OPENTREP::DBType::NODB);
+  const OPENTREP::SQLDBConnectionString_T lSQLDBConnStr (X_SQL_DB_STR);
+  const OPENTREP::DeploymentNumber_T lDeploymentNumber (X_DEPLOYMENT_NUMBER);
+  const OPENTREP::shouldIndexNonIATAPOR_T lShouldIndexNonIATAPOR (K_ALL_POR);
+  const OPENTREP::shouldIndexPORInXapian_T lShouldIndexPORInXapian(K_XAPIAN_IDX);
+  const OPENTREP::shouldAddPORInSQLDB_T lShouldAddPORInSQLDB (K_SQLDB_ADD);
+  OPENTREP::OPENTREP_Service opentrepService (ioLogOutputFile, lPORFilePath,
+                                              lTravelDBFilePath,
+                                              lDBType, lSQLDBConnStr,
+                                              lDeploymentNumber,
+                                              lShouldIndexNonIATAPOR,
+                                              lShouldIndexPORInXapian,
+                                              lShouldAddPORInSQLDB);
+  opentrepService.setNbOfIndexingThreads (iNbOfThreads);
+  opentrepService.setNbOfIndexingShards (iNbOfShards);
+  oNbOfEntries = opentrepService.insertIntoDBAndXapian();
+
+  std::ostringstream oStr;
+  // The last query is misspelled, so as to rely on the spelling dictionary
+  const char* lTravelQueryList[] = { "sfo", "los angeles", "nce rio",
+                                     "reykjavik", "san francsico" };
+  for (unsigned short idx = 0; idx != 5; ++idx) {
+    const std::string lTravelQuery (lTravelQueryList[idx]);
+    OPENTREP::LocationList_T lLocationList;
+    OPENTREP::WordList_T lNonMatchedWordList;
+    const OPENTREP::NbOfMatches_T nbOfMatches =
+      opentrepService.interpretTravelRequest (lTravelQuery, lLocationList,
+                                              lNonMatchedWordList);
+    oStr << "'" << lTravelQuery << "': " << nbOfMatches << std::endl;
+    for (OPENTREP::LocationList_T::const_iterator itLocation =
+           lLocationList.begin(); itLocation != lLocationList.end();
+         ++itLocation) {
+      const OPENTREP::Location& lLocation = *itLocation;
+      oStr << lLocation.toString() << std::endl;
+    }
+  }
+  return oStr.str();
+}
+
 
 // /////////////// Main: Unit Test Suite //////////////
 
@@ -143,6 +219,147 @@ BOOST_AUTO_TEST_CASE (opentrep_simple_index) {
   logOutputFile.close();
 }
 
+/**
+ * Test the bulk load of a given travel-related database text file into
+ * a SQLite3 database, by batches of rows
+ */
+BOOST_AUTO_TEST_CASE (opentrep_sqlite_bulk_load) {
+    
+  // Output log File
+  std::string lLogFilename ("IndexBuildingTestSuite_bulk.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the context
+  const OPENTREP::PORFilePath_T lPORFilePath (K_POR_FILEPATH);
+  const OPENTREP::TravelDBFilePath_T lTravelDBFilePath (X_XAPIAN_DB_FP);
+  const OPENTREP::DBType lDBType (OPENTREP::DBType::SQLITE3);
+  const OPENTREP::SQLDBConnectionString_T lSQLDBConnStr (X_SQLITE_DB_FP);
+  const OPENTREP::DeploymentNumber_T lDeploymentNumber (X_DEPLOYMENT_NUMBER);
+  const OPENTREP::shouldIndexNonIATAPOR_T lShouldIndexNonIATAPOR (K_ALL_POR);
+  const OPENTREP::shouldIndexPORInXapian_T lShouldIndexPORInXapian(K_XAPIAN_IDX);
+  const OPENTREP::shouldAddPORInSQLDB_T lShouldAddPORInSQLDB (true);
+  OPENTREP::OPENTREP_Service opentrepService (logOutputFile, lPORFilePath,
+                                              lTravelDBFilePath,
+                                              lDBType, lSQLDBConnStr,
+                                              lDeploymentNumber,
+                                              lShouldIndexNonIATAPOR,
+                                              lShouldIndexPORInXapian,
+                                              lShouldAddPORInSQLDB);
+  opentrepService.setSQLDBBulkLoadBatchSize (X_SQLDB_BATCH_SIZE);
+
+  // Re-create the SQL database (and, for SQLite3, its directory)
+  opentrepService.createSQLDBUser();
+
+  // Launch the indexation
+  const OPENTREP::NbOfDBEntries_T nbOfEntries =
+    opentrepService.insertIntoDBAndXapian();
+  BOOST_CHECK_EQUAL (nbOfEntries, 9);
+
+  // All the batches, including the last partial one, have been committed
+  const OPENTREP::NbOfDBEntries_T nbOfPORInDB =
+    opentrepService.getNbOfPORFromDB();
+  BOOST_CHECK_MESSAGE (nbOfPORInDB == nbOfEntries,
+                       "The SQLite3 database contains " << nbOfPORInDB
+                       << " entries, where as " << nbOfEntries
+                       << " are expected.");
+
+  // The rows have been loaded as they are, and indexed
+  OPENTREP::LocationList_T lLocationList;
+  BOOST_CHECK_EQUAL (opentrepService.
+                     listByIataCode (OPENTREP::IATACode_T ("sfo"),
+                                     lLocationList), 2);
+  lLocationList.clear();
+  BOOST_CHECK_EQUAL (opentrepService.
+                     listByGeonameID (5391989, lLocationList), 1);
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Test that the parallel indexing pipeline builds the same Xapian index
+ * as the single-threaded indexation
+ */
+BOOST_AUTO_TEST_CASE (opentrep_parallel_index) {
+    
+  // Output log File
+  std::string lLogFilename ("IndexBuildingTestSuite_parallel.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Single-threaded indexation
+  OPENTREP::NbOfDBEntries_T nbOfSequentialEntries = 0;
+  const std::string lSequentialOutcome =
+    indexAndSearch (logOutputFile, 1, 1, nbOfSequentialEntries);
+  BOOST_CHECK_EQUAL (nbOfSequentialEntries, 9);
+
+  // Parallel indexation
+  OPENTREP::NbOfDBEntries_T nbOfParallelEntries = 0;
+  const std::string lParallelOutcome =
+    indexAndSearch (logOutputFile, X_NB_OF_INDEXING_THREADS, 1,
+                    nbOfParallelEntries);
+  BOOST_CHECK_EQUAL (nbOfParallelEntries, nbOfSequentialEntries);
+
+  // The documents, and therefore the search results, are the same
+  BOOST_CHECK_MESSAGE (lParallelOutcome == lSequentialOutcome,
+                       "With " << X_NB_OF_INDEXING_THREADS << " indexing "
+                       << "threads, the search results are:\n"
+                       << lParallelOutcome << "whereas they are, with a "
+                       << "single indexing thread:\n" << lSequentialOutcome);
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Test that the Xapian index compacted from shards gives the same search
+ * results as the Xapian index built at once
+ */
+BOOST_AUTO_TEST_CASE (opentrep_sharded_index) {
+    
+  // Output log File
+  std::string lLogFilename ("IndexBuildingTestSuite_sharded.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Indexation at once
+  OPENTREP::NbOfDBEntries_T nbOfSerialEntries = 0;
+  const std::string lSerialOutcome =
+    indexAndSearch (logOutputFile, 1, 1, nbOfSerialEntries);
+  BOOST_CHECK_EQUAL (nbOfSerialEntries, 9);
+
+  // Indexation by shards
+  OPENTREP::NbOfDBEntries_T nbOfShardedEntries = 0;
+  const std::string lShardedOutcome =
+    indexAndSearch (logOutputFile, 1, X_NB_OF_INDEXING_SHARDS,
+                    nbOfShardedEntries);
+  BOOST_CHECK_EQUAL (nbOfShardedEntries, nbOfSerialEntries);
+
+  // The documents, spelling terms and document IDs are the same, and
+  // therefore so are the search results
+  BOOST_CHECK_MESSAGE (lShardedOutcome == lSerialOutcome,
+                       "With " << X_NB_OF_INDEXING_SHARDS << " Xapian "
+                       << "shards, the search results are:\n"
+                       << lShardedOutcome << "whereas they are, without "
+                       << "shard:\n" << lSerialOutcome);
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
 // End the test suite
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,268 @@
+/*!
+ * \page LocationSerialiserTestSuite_cpp Command-Line Test to Check the Binary Encoding of the Location Structures of the OpenTREP Project
+ * \code
+ */
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+// Boost Unit Test Framework (UTF)
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE LocationSerialiserTestSuite
+#include <boost/test/unit_test.hpp>
+// OpenTrep
+#include <opentrep/OPENTREP_exceptions.hpp>
+#include <opentrep/Location.hpp>
+#include <opentrep/CityDetails.hpp>
+#include <opentrep/basic/BasChronometer.hpp>
+#include <opentrep/bom/PORParserHelper.hpp>
+#include <opentrep/bom/LocationSerialiser.hpp>
+#include <opentrep/service/Logger.hpp>
+#include <opentrep/config/opentrep-paths.hpp>
+
+namespace boost_utf = boost::unit_test;
+
+// (Boost) Unit Test XML Report
+std::ofstream utfReportStream ("LocationSerialiserTestSuite_utfresults.xml");
+
+/**
+ * Configuration for the Boost Unit Test Framework (UTF)
+ */
+struct UnitTestConfig {
+  /** Constructor. */
+  UnitTestConfig() {
+    boost_utf::unit_test_log.set_stream (utfReportStream);
+#if defined(BOOST_VERSION) && BOOST_VERSION >= 105900
+    boost_utf::unit_test_log.set_format (boost_utf::OF_XML);
+#else // BOOST_VERSION
+    boost_utf::unit_test_log.set_format (boost_utf::XML);
+#endif // BOOST_VERSION
+    boost_utf::unit_test_log.set_threshold_level (boost_utf::log_test_units);
+  }
+
+  /** Destructor. */
+  ~UnitTestConfig() {
+  }
+};
+
+
+// //////////// Constants for the tests ///////////////
+/**
+ * File-path of the POR (points of reference) file.
+ */
+const std::string K_POR_FILEPATH (OPENTREP_POR_DATA_DIR
+                                  "/csv/test-optd-por-public.csv");
+
+/**
+ * Number of times all the POR are decoded by the micro-benchmark.
+ */
+const unsigned int K_NB_OF_BENCHMARK_ROUNDS (200);
+
+/**
+ * Read the POR lines (i.e., all the lines but the header) of the POR file.
+ */
+std::vector<std::string> readPORLines (const std::string& iFilePath) {
+  std::vector<std::string> oLineList;
+
+  std::ifstream lPORFileStream (iFilePath.c_str());
+  std::string lLine;
+  while (std::getline (lPORFileStream, lLine)) {
+    if (lLine.empty() == true || lLine.compare (0, 9, "iata_code") == 0) {
+      continue;
+    }
+    oLineList.push_back (lLine);
+  }
+
+  return oLineList;
+}
+
+// /////////////// Main: Unit Test Suite //////////////
+
+// Set the UTF configuration (re-direct the output to a specific file)
+BOOST_GLOBAL_FIXTURE (UnitTestConfig);
+
+// Start the test suite
+BOOST_AUTO_TEST_SUITE (master_test_suite)
+
+/**
+ * Check that the binary encoding of the Location structures is lossless,
+ * that the fixed-offset accessors give the same fields as the full
+ * decoding, and compare the decoding and parsing speeds
+ */
+BOOST_AUTO_TEST_CASE (opentrep_location_serialiser) {
+
+  // Output log File
+  std::string lLogFilename ("LocationSerialiserTestSuite.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+  OPENTREP::Logger::instance().setLogParameters (OPENTREP::LOG::NOTIFICATION,
+                                                 logOutputFile);
+
+  // Read the POR lines
+  const std::vector<std::string>& lLineList = readPORLines (K_POR_FILEPATH);
+  BOOST_REQUIRE_MESSAGE (lLineList.empty() == false,
+                         "No POR line can be read from '" << K_POR_FILEPATH
+                         << "'");
+
+  OPENTREP::PORLineParser& lLineParser =
+    OPENTREP::PORLineParser::getThreadParser();
+  std::vector<std::string> lDataList;
+  std::size_t lCSVSize = 0;
+  std::size_t lBinarySize = 0;
+  for (std::vector<std::string>::const_iterator itLine = lLineList.begin();
+       itLine != lLineList.end(); ++itLine) {
+    const std::string& lLine = *itLine;
+
+    // The raw POR lines are not mistaken for binary-encoded ones
+    BOOST_CHECK (OPENTREP::LocationSerialiser::isSerialised (lLine) == false);
+
+    // The decoded Location structure is the same as the encoded one
+    const OPENTREP::Location& lLocation = lLineParser.parse (lLine);
+    const std::string& lData =
+      OPENTREP::LocationSerialiser::serialise (lLocation);
+    BOOST_CHECK (OPENTREP::LocationSerialiser::isSerialised (lData) == true);
+    const OPENTREP::Location& lDecodedLocation =
+      OPENTREP::LocationSerialiser::deserialise (lData);
+    BOOST_CHECK_MESSAGE (lDecodedLocation.toString() == lLocation.toString(),
+                         "The POR line '" << lLine << "' is decoded into '"
+                         << lDecodedLocation.toString() << "', whereas '"
+                         << lLocation.toString() << "' is expected");
+    BOOST_CHECK_EQUAL (lDecodedLocation.getRawDataString(), lLine);
+
+    // The text form, as stored within the SQL database, gives back the
+    // same binary encoding, and is not mistaken for a raw POR line
+    const std::string& lText =
+      OPENTREP::LocationSerialiser::encodeAsText (lData);
+    BOOST_CHECK (OPENTREP::LocationSerialiser::isTextEncoded (lText) == true);
+    BOOST_CHECK (OPENTREP::LocationSerialiser::isTextEncoded (lLine) == false);
+    BOOST_CHECK (OPENTREP::LocationSerialiser::decodeText (lText) == lData);
+
+    // The fixed-offset accessors give the same fields
+    const OPENTREP::LocationKey& lKey = lLocation.getKey();
+    BOOST_CHECK_EQUAL (OPENTREP::LocationSerialiser::getIataCode (lData),
+                       lKey.getIataCode());
+    BOOST_CHECK (OPENTREP::LocationSerialiser::getIataType (lData)
+                 == lKey.getIataType().getType());
+    BOOST_CHECK_EQUAL (OPENTREP::LocationSerialiser::getGeonamesID (lData),
+                       lKey.getGeonamesID());
+    BOOST_CHECK_EQUAL (OPENTREP::LocationSerialiser::getEnvelopeID (lData),
+                       lLocation.getEnvelopeID());
+    BOOST_CHECK_EQUAL (OPENTREP::LocationSerialiser::getPageRank (lData),
+                       lLocation.getPageRank());
+    BOOST_CHECK_EQUAL (OPENTREP::LocationSerialiser::getLatitude (lData),
+                       lLocation.getLatitude());
+    BOOST_CHECK_EQUAL (OPENTREP::LocationSerialiser::getLongitude (lData),
+                       lLocation.getLongitude());
+    BOOST_CHECK_EQUAL (OPENTREP::LocationSerialiser::getCommonName (lData),
+                       lLocation.getCommonName());
+
+    // A truncated encoding is rejected
+    const std::string lTruncatedData (lData, 0, lData.size() - 1);
+    BOOST_CHECK_THROW (OPENTREP::LocationSerialiser::
+                       deserialise (lTruncatedData),
+                       OPENTREP::SerDeException);
+
+    lDataList.push_back (lData);
+    lCSVSize += lLine.size();
+    lBinarySize += lData.size();
+  }
+
+  // Micro-benchmark: parsing of the raw POR lines
+  const double lNbOfDecodedPOR =
+    static_cast<double> (K_NB_OF_BENCHMARK_ROUNDS * lLineList.size());
+  OPENTREP::BasChronometer lParserChronometer;
+  lParserChronometer.start();
+  for (unsigned int idxRound = 0; idxRound != K_NB_OF_BENCHMARK_ROUNDS;
+       ++idxRound) {
+    for (std::vector<std::string>::const_iterator itLine = lLineList.begin();
+         itLine != lLineList.end(); ++itLine) {
+      lLineParser.parse (*itLine);
+    }
+  }
+  const double lParserMeasure = lParserChronometer.elapsed();
+
+  // Micro-benchmark: decoding of the binary-encoded Location structures
+  OPENTREP::BasChronometer lDecoderChronometer;
+  lDecoderChronometer.start();
+  for (unsigned int idxRound = 0; idxRound != K_NB_OF_BENCHMARK_ROUNDS;
+       ++idxRound) {
+    for (std::vector<std::string>::const_iterator itData = lDataList.begin();
+         itData != lDataList.end(); ++itData) {
+      OPENTREP::LocationSerialiser::deserialise (*itData);
+    }
+  }
+  const double lDecoderMeasure = lDecoderChronometer.elapsed();
+
+  // Report the sizes and the number of POR decoded per second
+  OPENTREP_LOG_NOTIFICATION ("Size of " << lLineList.size()
+                             << " POR - CSV: " << lCSVSize
+                             << " bytes; binary: " << lBinarySize
+                             << " bytes. Decoding of " << lNbOfDecodedPOR
+                             << " POR - PORLineParser: "
+                             << lNbOfDecodedPOR / lParserMeasure
+                             << " POR/s; LocationSerialiser: "
+                             << lNbOfDecodedPOR / lDecoderMeasure
+                             << " POR/s");
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Check that the data which are not binary-encoded Location structures
+ * are rejected
+ */
+BOOST_AUTO_TEST_CASE (opentrep_location_serialiser_invalid_data) {
+
+  // Neither a raw POR line nor an empty string can be decoded
+  BOOST_CHECK_THROW (OPENTREP::LocationSerialiser::deserialise ("NCE^LFMN^"),
+                     OPENTREP::SerDeException);
+  BOOST_CHECK_THROW (OPENTREP::LocationSerialiser::deserialise (""),
+                     OPENTREP::SerDeException);
+
+  // An encoding of another version cannot be decoded
+  const OPENTREP::Location lLocation;
+  std::string lData = OPENTREP::LocationSerialiser::serialise (lLocation);
+  BOOST_CHECK_NO_THROW (OPENTREP::LocationSerialiser::deserialise (lData));
+  std::string lNextVersionData (lData);
+  lNextVersionData[4] = static_cast<char> (lNextVersionData[4] + 1);
+  BOOST_CHECK_THROW (OPENTREP::LocationSerialiser::
+                     deserialise (lNextVersionData),
+                     OPENTREP::SerDeException);
+
+  // The version 1 of the encoding, without the (here empty) trailing raw
+  // data string, can still be decoded
+  std::string lVersion1Data (lData, 0, lData.size() - 1);
+  lVersion1Data[4] = 1;
+  BOOST_CHECK_NO_THROW (OPENTREP::LocationSerialiser::
+                        deserialise (lVersion1Data));
+
+  // Invalid text forms cannot be decoded
+  const std::string& lText =
+    OPENTREP::LocationSerialiser::encodeAsText (lData);
+  BOOST_CHECK_THROW (OPENTREP::LocationSerialiser::decodeText ("NCE^LFMN^"),
+                     OPENTREP::SerDeException);
+  BOOST_CHECK_THROW (OPENTREP::LocationSerialiser::
+                     decodeText (lText.substr (0, lText.size() - 1)),
+                     OPENTREP::SerDeException);
+  std::string lInvalidText (lText);
+  lInvalidText[lInvalidText.size() - 5] = '^';
+  BOOST_CHECK_THROW (OPENTREP::LocationSerialiser::decodeText (lInvalidText),
+                     OPENTREP::SerDeException);
+}
+
+// End the test suite
+BOOST_AUTO_TEST_SUITE_END()
+
+/*!
+ * \endcode
+ */
@@ -0,0 +1,300 @@
+/*!
+ * \page PORParserTestSuite_cpp Command-Line Test to Check and Benchmark the POR Parsers of the OpenTREP Project
+ * \code
+ */
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+// Boost Unit Test Framework (UTF)
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE PORParserTestSuite
+#include <boost/test/unit_test.hpp>
+// OpenTrep
+#include <opentrep/OPENTREP_exceptions.hpp>
+#include <opentrep/Location.hpp>
+#include <opentrep/CityDetails.hpp>
+#include <opentrep/basic/BasChronometer.hpp>
+#include <opentrep/bom/PORParserHelper.hpp>
+#include <opentrep/service/Logger.hpp>
+#include <opentrep/config/opentrep-paths.hpp>
+
+namespace boost_utf = boost::unit_test;
+
+// (Boost) Unit Test XML Report
+std::ofstream utfReportStream ("PORParserTestSuite_utfresults.xml");
+
+/**
+ * Configuration for the Boost Unit Test Framework (UTF)
+ */
+struct UnitTestConfig {
+  /** Constructor. */
+  UnitTestConfig() {
+    boost_utf::unit_test_log.set_stream (utfReportStream);
+#if defined(BOOST_VERSION) && BOOST_VERSION >= 105900
+    boost_utf::unit_test_log.set_format (boost_utf::OF_XML);
+#else // BOOST_VERSION
+    boost_utf::unit_test_log.set_format (boost_utf::XML);
+#endif // BOOST_VERSION
+    boost_utf::unit_test_log.set_threshold_level (boost_utf::log_test_units);
+  }
+
+  /** Destructor. */
+  ~UnitTestConfig() {
+  }
+};
+
+
+// //////////// Constants for the tests ///////////////
+/**
+ * File-path of the POR (points of reference) file.
+ */
+const std::string K_POR_FILEPATH (OPENTREP_POR_DATA_DIR
+                                  "/csv/test-optd-por-public.csv");
+
+/**
+ * Number of times the whole POR file is parsed by the micro-benchmark.
+ */
+const unsigned int K_NB_OF_BENCHMARK_ROUNDS (200);
+
+/**
+ * Read the POR lines (i.e., all the lines but the header) of the POR file.
+ */
+std::vector<std::string> readPORLines (const std::string& iFilePath) {
+  std::vector<std::string> oLineList;
+
+  std::ifstream lPORFileStream (iFilePath.c_str());
+  std::string lLine;
+  while (std::getline (lPORFileStream, lLine)) {
+    if (lLine.empty() == true || lLine.compare (0, 9, "iata_code") == 0) {
+      continue;
+    }
+    oLineList.push_back (lLine);
+  }
+
+  return oLineList;
+}
+
+/**
+ * Replace the given (0-based) caret-separated field of the given POR line.
+ */
+std::string replacePORField (const std::string& iLine,
+                             const unsigned short iFieldIdx,
+                             const std::string& iValue) {
+  std::string::size_type lFieldBegin = 0;
+  for (unsigned short idxField = 0; idxField != iFieldIdx; ++idxField) {
+    lFieldBegin = iLine.find ('^', lFieldBegin) + 1;
+  }
+  std::string::size_type lFieldEnd = iLine.find ('^', lFieldBegin);
+  if (lFieldEnd == std::string::npos) {
+    lFieldEnd = iLine.size();
+  }
+  std::string oLine (iLine);
+  oLine.replace (lFieldBegin, lFieldEnd - lFieldBegin, iValue);
+  return oLine;
+}
+
+/**
+ * Parse the given POR line with the one-shot string parser, and describe
+ * the outcome (Location structure or parsing error).
+ */
+std::string describeStringParsing (const std::string& iLine) {
+  try {
+    OPENTREP::PORStringParser lStringParser (iLine);
+    return lStringParser.generateLocation().toString();
+
+  } catch (const OPENTREP::PorFileParsingException&) {
+    return "PorFileParsingException";
+  }
+}
+
+/**
+ * Parse the given POR line with the re-usable line parser, and describe
+ * the outcome (Location structure or parsing error).
+ */
+std::string describeLineParsing (const std::string& iLine) {
+  try {
+    OPENTREP::PORLineParser& lLineParser =
+      OPENTREP::PORLineParser::getThreadParser();
+    return lLineParser.parse (iLine).toString();
+
+  } catch (const OPENTREP::PorFileParsingException&) {
+    return "PorFileParsingException";
+  }
+}
+
+// /////////////// Main: Unit Test Suite //////////////
+
+// Set the UTF configuration (re-direct the output to a specific file)
+BOOST_GLOBAL_FIXTURE (UnitTestConfig);
+
+// Start the test suite
+BOOST_AUTO_TEST_SUITE (master_test_suite)
+
+/**
+ * Check that the re-usable line parser gives the same Location structures
+ * as the one-shot string parser, and compare their parsing speeds
+ */
+BOOST_AUTO_TEST_CASE (opentrep_por_line_parser) {
+
+  // Output log File
+  std::string lLogFilename ("PORParserTestSuite.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+  OPENTREP::Logger::instance().setLogParameters (OPENTREP::LOG::NOTIFICATION,
+                                                 logOutputFile);
+
+  // Read the POR lines
+  const std::vector<std::string>& lLineList = readPORLines (K_POR_FILEPATH);
+  BOOST_REQUIRE_MESSAGE (lLineList.empty() == false,
+                         "No POR line can be read from '" << K_POR_FILEPATH
+                         << "'");
+
+  // Both parsers must give the same Location structures
+  OPENTREP::PORLineParser& lLineParser =
+    OPENTREP::PORLineParser::getThreadParser();
+  for (std::vector<std::string>::const_iterator itLine = lLineList.begin();
+       itLine != lLineList.end(); ++itLine) {
+    const std::string& lLine = *itLine;
+
+    OPENTREP::PORStringParser lStringParser (lLine);
+    const OPENTREP::Location& lStringLocation = lStringParser.generateLocation();
+    const OPENTREP::Location& lLineLocation = lLineParser.parse (lLine);
+
+    BOOST_CHECK_MESSAGE (lLineLocation.toString()
+                         == lStringLocation.toString(),
+                         "The POR line '" << lLine << "' is parsed into '"
+                         << lLineLocation.toString() << "', whereas '"
+                         << lStringLocation.toString() << "' is expected");
+  }
+
+  // Micro-benchmark: one-shot string parser
+  const double lNbOfParsedLines =
+    static_cast<double> (K_NB_OF_BENCHMARK_ROUNDS * lLineList.size());
+  OPENTREP::BasChronometer lStringParserChronometer;
+  lStringParserChronometer.start();
+  for (unsigned int idxRound = 0; idxRound != K_NB_OF_BENCHMARK_ROUNDS;
+       ++idxRound) {
+    for (std::vector<std::string>::const_iterator itLine = lLineList.begin();
+         itLine != lLineList.end(); ++itLine) {
+      OPENTREP::PORStringParser lStringParser (*itLine);
+      lStringParser.generateLocation();
+    }
+  }
+  const double lStringParserMeasure = lStringParserChronometer.elapsed();
+
+  // Micro-benchmark: re-usable line parser
+  OPENTREP::BasChronometer lLineParserChronometer;
+  lLineParserChronometer.start();
+  for (unsigned int idxRound = 0; idxRound != K_NB_OF_BENCHMARK_ROUNDS;
+       ++idxRound) {
+    for (std::vector<std::string>::const_iterator itLine = lLineList.begin();
+         itLine != lLineList.end(); ++itLine) {
+      lLineParser.parse (*itLine);
+    }
+  }
+  const double lLineParserMeasure = lLineParserChronometer.elapsed();
+
+  // Report the number of lines parsed per second
+  OPENTREP_LOG_NOTIFICATION ("Parsing of " << lNbOfParsedLines
+                             << " POR lines - PORStringParser: "
+                             << lNbOfParsedLines / lStringParserMeasure
+                             << " lines/s; PORLineParser: "
+                             << lNbOfParsedLines / lLineParserMeasure
+                             << " lines/s");
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Check that the hand-written splitter handles all the regular POR lines,
+ * and that, whatever the POR line, the line parser gives the same outcome
+ * as the grammar
+ */
+BOOST_AUTO_TEST_CASE (opentrep_por_line_splitter) {
+
+  // Output log File
+  std::string lLogFilename ("PORParserTestSuite.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str(), std::ios::app);
+  OPENTREP::Logger::instance().setLogParameters (OPENTREP::LOG::NOTIFICATION,
+                                                 logOutputFile);
+
+  // Read the POR lines
+  const std::vector<std::string>& lLineList = readPORLines (K_POR_FILEPATH);
+  BOOST_REQUIRE_MESSAGE (lLineList.empty() == false,
+                         "No POR line can be read from '" << K_POR_FILEPATH
+                         << "'");
+
+  OPENTREP::PORLineParser& lLineParser =
+    OPENTREP::PORLineParser::getThreadParser();
+  for (std::vector<std::string>::const_iterator itLine = lLineList.begin();
+       itLine != lLineList.end(); ++itLine) {
+    const std::string& lLine = *itLine;
+
+    // The lines of the POR file all have the regular layout
+    const char* lBegin = lLine.data();
+    const bool isRegular =
+      lLineParser.parseRegularLine (lBegin, lBegin + lLine.size());
+    BOOST_CHECK_MESSAGE (isRegular == true,
+                         "The POR line '" << lLine << "' is not handled by "
+                         << "the hand-written splitter");
+
+    // Variants of the line, some of them being handled by the hand-written
+    // splitter, the others by the grammar
+    std::vector<std::string> lVariantList;
+    lVariantList.push_back (lLine);
+    lVariantList.push_back (replacePORField (lLine, 43, ""));
+    lVariantList.push_back (replacePORField (replacePORField (lLine, 47, ""),
+                                             43, ""));
+    lVariantList.push_back (replacePORField (lLine, 43, "en|Nice|p=|Nizza|"));
+    lVariantList.push_back (replacePORField (lLine, 38,
+                                             "NCE|2990440|Nice|Nice|FR|"
+                                             "=MCM|2993458|Monaco|Monaco||"));
+    lVariantList.push_back (replacePORField (lLine, 6, " Leading blank"));
+    lVariantList.push_back (replacePORField (lLine, 8, " 43.5"));
+    lVariantList.push_back (replacePORField (lLine, 8, "43.5 "));
+    lVariantList.push_back (replacePORField (lLine, 0, "NC"));
+    lVariantList.push_back (replacePORField (lLine, 35, "-1"));
+    lVariantList.push_back (replacePORField (lLine, 35, ""));
+    lVariantList.push_back (replacePORField (lLine, 47, "FRNCE|=FRNIC|hp"));
+    lVariantList.push_back (replacePORField (lLine, 48, "8775100|h=87751|"));
+    lVariantList.push_back (lLine + "^");
+    lVariantList.push_back (lLine + " ");
+
+    for (std::vector<std::string>::const_iterator itVariant =
+           lVariantList.begin(); itVariant != lVariantList.end();
+         ++itVariant) {
+      const std::string& lVariant = *itVariant;
+      const std::string& lExpected = describeStringParsing (lVariant);
+      const std::string& lParsed = describeLineParsing (lVariant);
+      BOOST_CHECK_MESSAGE (lParsed == lExpected,
+                           "The POR line '" << lVariant << "' is parsed into '"
+                           << lParsed << "', whereas '" << lExpected
+                           << "' is expected");
+    }
+  }
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+// End the test suite
+BOOST_AUTO_TEST_SUITE_END()
+
+/*!
+ * \endcode
+ */
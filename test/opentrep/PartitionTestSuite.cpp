@@ -11,13 +11,20 @@
 #include <fstream>
 #include <string>
 #include <list>
+#include <set>
+#include <map>
+#include <cmath>
 // Boost Unit Test Framework (UTF)
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_MODULE PartitionTestSuite
 #include <boost/test/unit_test.hpp>
 // OpenTrep
+#include <opentrep/basic/BasConst_General.hpp>
+#include <opentrep/basic/Utilities.hpp>
 #include <opentrep/bom/StringPartition.hpp>
+#include <opentrep/bom/StringSegmentation.hpp>
+#include <opentrep/bom/WordCombinationHolder.hpp>
 
 namespace boost_utf = boost::unit_test;
 
@@ -46,6 +53,193 @@ struct UnitTestConfig {
 };
 
 
+/**
+ * Weights (percentages) of the word combinations, as they would be
+ * given by the full-text matches (see Result::getBestCombinedWeight()).
+ */
+typedef std::map<std::string, OPENTREP::Percentage_T> WeightMap_T;
+
+/**
+ * Weight of a word combination, mimicking the rules of
+ * Result::calculateCombinedWeights(): known word combinations get their
+ * weight from the given map; unknown single words get 100%, and unknown
+ * word combinations get 10^(-3n)%, n being their number of words.
+ */
+OPENTREP::Percentage_T getWeight (const WeightMap_T& iWeightMap,
+                                  const std::string& iWordCombination) {
+  WeightMap_T::const_iterator itWeight = iWeightMap.find (iWordCombination);
+  if (itWeight != iWeightMap.end()) {
+    return itWeight->second;
+  }
+
+  OPENTREP::WordList_T lWordList;
+  OPENTREP::tokeniseStringIntoWordList (iWordCombination, lWordList);
+  const OPENTREP::NbOfWords_T nbOfWords = lWordList.size();
+  if (nbOfWords == 1) {
+    return 100.0;
+  }
+  return std::pow (10.0, -3.0 * nbOfWords);
+}
+
+/**
+ * Weight of a word combination, pseudo-randomly derived from the given
+ * seed and from the word combination itself (FNV-1a hash). About one word
+ * combination out of five gets a null weight. With even seeds, the weights
+ * are rounded to a few values, so that many string partitions have the
+ * same weight (and the order in which they are chosen is checked).
+ */
+OPENTREP::Percentage_T getRandomWeight (const unsigned int iSeed,
+                                        const std::string& iWordCombination) {
+  unsigned int lHash = 2166136261u ^ iSeed;
+  for (std::string::const_iterator itChar = iWordCombination.begin();
+       itChar != iWordCombination.end(); ++itChar) {
+    lHash ^= static_cast<unsigned char> (*itChar);
+    lHash *= 16777619u;
+  }
+
+  if (lHash % 5 == 0) {
+    return 0.0;
+  }
+  if (iSeed % 2 == 0) {
+    return 50.0 * ((lHash / 5) % 2 + 1);
+  }
+  return 0.01 + (lHash / 5) % 10000 / 100.0;
+}
+
+/**
+ * Select the best string partition by enumerating all of them, the same
+ * way as ResultCombination::chooseBestMatchingResultHolder() does on the
+ * weights calculated by ResultHolder::calculateCombinedWeights().
+ */
+OPENTREP::Percentage_T
+chooseExhaustively (const OPENTREP::StringPartition& iStringPartition,
+                    const OPENTREP::StringSegmentation& iStringSegmentation,
+                    OPENTREP::StringSet& ioBestStringSet) {
+  OPENTREP::Percentage_T oMaxPercentage = 0.0;
+
+  const OPENTREP::StringPartition::StringPartition_T& lPartition =
+    iStringPartition._partition;
+  for (OPENTREP::StringPartition::StringPartition_T::const_iterator itSet =
+         lPartition.begin(); itSet != lPartition.end(); ++itSet) {
+    const OPENTREP::StringSet& lStringSet = *itSet;
+
+    // Retrieve, from the segmentation, the weight of every word combination
+    OPENTREP::Percentage_T lPercentage = 100.0;
+    OPENTREP::NbOfWords_T lBeginIdx = 0;
+    for (OPENTREP::StringSet::StringSet_T::const_iterator itString =
+           lStringSet._set.begin(); itString != lStringSet._set.end();
+         ++itString) {
+      OPENTREP::WordList_T lWordList;
+      OPENTREP::tokeniseStringIntoWordList (*itString, lWordList);
+      const OPENTREP::NbOfWords_T lEndIdx = lBeginIdx + lWordList.size();
+      lPercentage *= iStringSegmentation.getWeight (lBeginIdx, lEndIdx) / 100.0;
+      lBeginIdx = lEndIdx;
+    }
+    const unsigned short nbOfStrings = lStringSet.size();
+    if (nbOfStrings > 1) {
+      lPercentage /= std::pow (OPENTREP::K_DEFAULT_ATTENUATION_FCTR,
+                               nbOfStrings);
+    }
+
+    if (lPercentage > oMaxPercentage) {
+      oMaxPercentage = lPercentage;
+      ioBestStringSet = lStringSet;
+    }
+  }
+
+  return oMaxPercentage;
+}
+
+/**
+ * Check that the dynamic programming-based segmentation chooses the same
+ * string partition as the exhaustive enumeration.
+ */
+void checkSegmentation (std::ofstream& ioLogOutputFile,
+                        const std::string& iString,
+                        const WeightMap_T& iWeightMap,
+                        const unsigned int iSeed) {
+  //
+  OPENTREP::StringSegmentation lStringSegmentation (iString);
+  const OPENTREP::NbOfWords_T nbOfWords = lStringSegmentation.getNbOfWords();
+  for (OPENTREP::NbOfWords_T lBeginIdx = 0; lBeginIdx != nbOfWords;
+       ++lBeginIdx) {
+    for (OPENTREP::NbOfWords_T lEndIdx = lBeginIdx + 1; lEndIdx <= nbOfWords;
+         ++lEndIdx) {
+      const std::string& lWordCombination =
+        lStringSegmentation.getWordCombination (lBeginIdx, lEndIdx);
+      const OPENTREP::Percentage_T lWeight = (iSeed == 0)?
+        getWeight (iWeightMap, lWordCombination)
+        : getRandomWeight (iSeed, lWordCombination);
+      lStringSegmentation.setWeight (lBeginIdx, lEndIdx, lWeight);
+    }
+  }
+  lStringSegmentation.calculateBestSegmentation();
+  ioLogOutputFile << lStringSegmentation << std::endl;
+
+  //
+  const OPENTREP::StringPartition lStringPartition (iString);
+  OPENTREP::StringSet lExpectedStringSet;
+  const OPENTREP::Percentage_T lExpectedWeight =
+    chooseExhaustively (lStringPartition, lStringSegmentation,
+                        lExpectedStringSet);
+
+  //
+  const OPENTREP::Percentage_T& lWeight = lStringSegmentation.getBestWeight();
+  BOOST_CHECK_CLOSE (lWeight, lExpectedWeight, 1e-9);
+
+  if (lExpectedWeight > 0.0) {
+    const OPENTREP::StringSet& lStringSet =
+      lStringSegmentation.getBestSegmentation();
+    BOOST_CHECK_MESSAGE (lStringSet._set == lExpectedStringSet._set,
+                         "The best segmentation of '" << iString
+                         << "' (seed: " << iSeed << ") should be "
+                         << lExpectedStringSet.describe() << ". However, it is "
+                         << lStringSet.describe() << ".");
+  }
+}
+
+
+/**
+ * Set of (unique) word combinations.
+ */
+typedef std::set<std::string> WordCombinationSet_T;
+
+/**
+ * Derive the word combinations of the given string the way they were
+ * derived before the direct enumeration (see WordCombinationHolder): the
+ * word combinations of all the partitions of the string, and the string
+ * deprived of every group of its middle words.
+ */
+void deriveReferenceWordCombinations (const std::string& iPhrase,
+                                      WordCombinationSet_T& ioSet) {
+  const OPENTREP::StringPartition lStringPartitionHolder (iPhrase);
+  const OPENTREP::StringPartition::StringPartition_T& lStringPartition =
+    lStringPartitionHolder._partition;
+  for (OPENTREP::StringPartition::StringPartition_T::const_iterator itSet =
+         lStringPartition.begin(); itSet != lStringPartition.end(); ++itSet) {
+    const OPENTREP::StringSet::StringSet_T& lStringList = itSet->_set;
+    ioSet.insert (lStringList.begin(), lStringList.end());
+  }
+
+  OPENTREP::WordList_T lWordList;
+  OPENTREP::tokeniseStringIntoWordList (iPhrase, lWordList);
+  const short nbOfWords = lWordList.size();
+  for (short mdl_string_len = 1; mdl_string_len < nbOfWords-1;
+       ++mdl_string_len) {
+    for (short idx_word=1; idx_word != nbOfWords-mdl_string_len; ++idx_word) {
+      const std::string& lLeftHandString =
+        OPENTREP::createStringFromWordList (lWordList, idx_word);
+      const std::string& lRightHandString =
+        OPENTREP::createStringFromWordList (lWordList,
+                                            idx_word + mdl_string_len, false);
+      ioSet.insert (lLeftHandString + " " + lRightHandString);
+    }
+  }
+
+  // The partition of an empty string gives an empty word combination
+  ioSet.erase ("");
+}
+
 // /////////////// Main: Unit Test Suite //////////////
 
 // Set the UTF configuration (re-direct the output to a specific file)
@@ -97,6 +291,144 @@ BOOST_AUTO_TEST_CASE (partition_small_string) {
   logOutputFile.close();
 }
 
+/**
+ * Test that the segmentation algorithm (dynamic programming) gives
+ * the same best string partition as the exhaustive enumeration
+ */
+BOOST_AUTO_TEST_CASE (segmentation_vs_partition) {
+
+  // Output log File
+  std::string lLogFilename ("PartitionTestSuite_segmentation.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  std::list<std::string> lStringList;
+  lStringList.push_back ("los angeles");
+  lStringList.push_back ("lso angeles");
+  lStringList.push_back ("rio de janeiro");
+  lStringList.push_back ("rio de janero");
+  lStringList.push_back ("reikjavik");
+  lStringList.push_back ("rekyavik");
+  lStringList.push_back ("san francisco rio de janeiro");
+  lStringList.push_back ("san francicso rio de janero");
+  lStringList.push_back ("sna francicso rio de janero");
+  lStringList.push_back ("chelsea municipal airport");
+
+  // Weights of the word combinations known by the (fake) index
+  WeightMap_T lWeightMap;
+  lWeightMap["los angeles"] = 92.5;
+  lWeightMap["angeles"] = 12.0;
+  lWeightMap["rio de janeiro"] = 97.0;
+  lWeightMap["rio"] = 20.0;
+  lWeightMap["de"] = 0.5;
+  lWeightMap["rio de janero"] = 81.0;
+  lWeightMap["san francisco"] = 95.0;
+  lWeightMap["francisco"] = 35.0;
+  lWeightMap["san francicso"] = 78.0;
+  lWeightMap["francicso"] = 30.0;
+  lWeightMap["reikjavik"] = 99.0;
+  lWeightMap["chelsea"] = 40.0;
+  lWeightMap["chelsea municipal airport"] = 88.0;
+  lWeightMap["municipal airport"] = 0.0;
+  lWeightMap["airport"] = 0.0;
+
+  for (std::list<std::string>::const_iterator itString = lStringList.begin();
+       itString != lStringList.end(); ++itString) {
+    const std::string& lString = *itString;
+
+    // Weights mimicking the ones of the full-text matches
+    checkSegmentation (logOutputFile, lString, lWeightMap, 0);
+
+    // Pseudo-random weights
+    for (unsigned int lSeed = 1; lSeed <= 50; ++lSeed) {
+      checkSegmentation (logOutputFile, lString, lWeightMap, lSeed);
+    }
+  }
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Test that the word combinations enumerated directly (see
+ * WordCombinationHolder) are the same as the ones derived from the string
+ * partitions, and that the bounded enumeration keeps only the word
+ * combinations within the maximum span
+ */
+BOOST_AUTO_TEST_CASE (word_combinations_vs_partition) {
+
+  // Output log File
+  std::string lLogFilename ("PartitionTestSuite_wordcombinations.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  std::list<std::string> lStringList;
+  lStringList.push_back ("");
+  lStringList.push_back ("reikjavik");
+  lStringList.push_back ("los angeles");
+  lStringList.push_back ("rio de janeiro");
+  lStringList.push_back ("chelsea municipal airport");
+  lStringList.push_back ("san francisco rio de janeiro");
+  lStringList.push_back ("aeroport international de la region de bruxelles");
+
+  for (std::list<std::string>::const_iterator itString = lStringList.begin();
+       itString != lStringList.end(); ++itString) {
+    const std::string& lString = *itString;
+
+    // Without bound, the word combinations are the same as before
+    const OPENTREP::WordCombinationHolder lWordCombinationHolder (lString, 0);
+    logOutputFile << "'" << lString << "': " << lWordCombinationHolder
+                  << std::endl;
+
+    const OPENTREP::WordCombinationHolder::StringList_T& lWCList =
+      lWordCombinationHolder._list;
+    const WordCombinationSet_T lWCSet (lWCList.begin(), lWCList.end());
+    BOOST_CHECK_MESSAGE (lWCSet.size() == lWCList.size(),
+                         "The word combinations of '" << lString
+                         << "' should not contain any duplicate");
+
+    WordCombinationSet_T lReferenceSet;
+    deriveReferenceWordCombinations (lString, lReferenceSet);
+    BOOST_CHECK_MESSAGE (lWCSet == lReferenceSet,
+                         "The word combinations of '" << lString << "' ("
+                         << lWCSet.size() << ") should be the same as "
+                         << "the ones derived from its partitions ("
+                         << lReferenceSet.size() << ")");
+
+    // With a bound, only the word combinations spanning no more words
+    // than that bound are kept
+    for (OPENTREP::NbOfWords_T lMaxSpan = 1; lMaxSpan <= 3; ++lMaxSpan) {
+      const OPENTREP::WordCombinationHolder lBoundedHolder (lString, lMaxSpan);
+      const OPENTREP::WordCombinationHolder::StringList_T& lBoundedList =
+        lBoundedHolder._list;
+      for (OPENTREP::WordCombinationHolder::StringList_T::const_iterator
+             itWC = lBoundedList.begin(); itWC != lBoundedList.end(); ++itWC) {
+        const std::string& lWordCombination = *itWC;
+        BOOST_CHECK_MESSAGE (lWCSet.find (lWordCombination) != lWCSet.end(),
+                             "'" << lWordCombination << "' should be a word "
+                             << "combination of '" << lString << "'");
+
+        OPENTREP::WordList_T lWordList;
+        OPENTREP::tokeniseStringIntoWordList (lWordCombination, lWordList);
+        BOOST_CHECK_MESSAGE (lWordList.size() <= lMaxSpan,
+                             "'" << lWordCombination << "' spans more than "
+                             << lMaxSpan << " words of '" << lString << "'");
+      }
+    }
+  }
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
 // End the test suite
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,403 @@
+/*!
+ * \page SQLDBBackendTestSuite_cpp Command-Line Test to Compare the SQL Database Back-Ends of the OpenTREP Project
+ * \code
+ */
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstdlib>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+// Boost Unit Test Framework (UTF)
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE SQLDBBackendTestSuite
+#include <boost/test/unit_test.hpp>
+// SOCI
+#include <soci/soci.h>
+// OpenTrep
+#include <opentrep/OPENTREP_Service.hpp>
+#include <opentrep/Location.hpp>
+#include <opentrep/CityDetails.hpp>
+#include <opentrep/basic/BasChronometer.hpp>
+#include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
+#include <opentrep/basic/Utilities.hpp>
+#include <opentrep/command/DBConnection.hpp>
+#include <opentrep/command/DBConnectionPool.hpp>
+#include <opentrep/command/DBManager.hpp>
+#include <opentrep/service/Logger.hpp>
+#include <opentrep/config/opentrep-paths.hpp>
+
+namespace boost_utf = boost::unit_test;
+
+// (Boost) Unit Test XML Report
+std::ofstream utfReportStream ("SQLDBBackendTestSuite_utfresults.xml");
+
+/**
+ * Configuration for the Boost Unit Test Framework (UTF)
+ */
+struct UnitTestConfig {
+  /** Constructor. */
+  UnitTestConfig() {
+    boost_utf::unit_test_log.set_stream (utfReportStream);
+#if defined(BOOST_VERSION) && BOOST_VERSION >= 105900
+    boost_utf::unit_test_log.set_format (boost_utf::OF_XML);
+#else // BOOST_VERSION
+    boost_utf::unit_test_log.set_format (boost_utf::XML);
+#endif // BOOST_VERSION
+    boost_utf::unit_test_log.set_threshold_level (boost_utf::log_test_units);
+  }
+
+  /** Destructor. */
+  ~UnitTestConfig() {
+  }
+};
+
+
+// //////////// Constants for the tests ///////////////
+/**
+ * File-path of the POR (points of reference) file.
+ */
+const std::string K_POR_FILEPATH (OPENTREP_POR_DATA_DIR
+                                  "/csv/test-optd-por-public.csv");
+
+/**
+ * Xapian database/index file-path (directory containing the index).
+ */
+const std::string X_XAPIAN_DB_FP ("/tmp/opentrep/test_backend_traveldb");
+
+/**
+ * SQLite3 database file-path. The directory is cleared when the database
+ * is re-created, and is therefore dedicated to that test.
+ */
+const std::string X_SQLITE_DB_FP ("/tmp/opentrep/test_backend_sqlite/traveldb");
+
+/**
+ * Names of the environment variables specifying the connection strings
+ * to the administration databases of local MariaDB/MySQL and PostgreSQL
+ * instances. The 'trep' user and the 'trep_trep' database are (re-)created
+ * from there. When those variables are not set, the corresponding back-ends
+ * are skipped. For instance:
+ * <tt>OPENTREP_TEST_MYSQL_ADMIN_CONN="db=mysql user=root password=<passwd>"
+ *     OPENTREP_TEST_PG_ADMIN_CONN="dbname=postgres user=postgres"</tt>
+ */
+const char* X_MYSQL_ADMIN_CONN_ENV_VAR ("OPENTREP_TEST_MYSQL_ADMIN_CONN");
+const char* X_PG_ADMIN_CONN_ENV_VAR ("OPENTREP_TEST_PG_ADMIN_CONN");
+
+/*
+ * Deployment number/version.
+ */
+const OPENTREP::DeploymentNumber_T X_DEPLOYMENT_NUMBER (0);
+
+/**
+ * Number of times every look up is performed, for the latency to be
+ * measured.
+ */
+const unsigned short X_NB_OF_LOOKUPS (200);
+
+/**
+ * Measures for a given SQL database back-end.
+ */
+struct BackendReport {
+  /** SQL database type. */
+  std::string _sqlDBType;
+  /** Number of POR loaded into the SQL database. */
+  OPENTREP::NbOfDBEntries_T _nbOfPOR;
+  /** Time for loading and indexing the SQL database (in seconds). */
+  double _loadTime;
+  /** Average latency of the look ups on IATA code (in milliseconds). */
+  double _iataLatency;
+  /** Average latency of the look ups on Geonames ID (in milliseconds). */
+  double _geonameIDLatency;
+};
+
+/**
+ * Measures of the back-ends having been tested so far.
+ */
+std::vector<BackendReport> gBackendReportList;
+
+/**
+ * Re-create the given SQL database from its administration connection,
+ * fill it, along with the Xapian index, from the POR file, and check and
+ * measure the look ups.
+ */
+void checkBackend (std::ostream& ioLogStream, const OPENTREP::DBType& iDBType,
+                   const OPENTREP::SQLDBConnectionString_T& iAdminConnStr,
+                   const OPENTREP::SQLDBConnectionString_T& iSQLDBConnStr) {
+  BackendReport lBackendReport;
+  lBackendReport._sqlDBType = iDBType.describe();
+
+  const OPENTREP::PORFilePath_T lPORFilePath (K_POR_FILEPATH);
+  const OPENTREP::TravelDBFilePath_T lTravelDBFilePath (X_XAPIAN_DB_FP);
+  const OPENTREP::DeploymentNumber_T lDeploymentNumber (X_DEPLOYMENT_NUMBER);
+
+  {
+    const OPENTREP::shouldIndexNonIATAPOR_T lShouldIndexNonIATAPOR (false);
+    const OPENTREP::shouldIndexPORInXapian_T lShouldIndexPORInXapian (true);
+    const OPENTREP::shouldAddPORInSQLDB_T lShouldAddPORInSQLDB (true);
+    OPENTREP::OPENTREP_Service opentrepService (ioLogStream, lPORFilePath,
+                                                lTravelDBFilePath,
+                                                iDBType, iAdminConnStr,
+                                                lDeploymentNumber,
+                                                lShouldIndexNonIATAPOR,
+                                                lShouldIndexPORInXapian,
+                                                lShouldAddPORInSQLDB);
+
+    // Re-create the SQL database user and database
+    const bool lCreationSuccessful = opentrepService.createSQLDBUser();
+    BOOST_REQUIRE_MESSAGE (lCreationSuccessful == true,
+                           "The " << iDBType.describe() << " database "
+                           << "cannot be created from '" << iAdminConnStr
+                           << "'");
+
+    // Fill the SQL database, through the 'trep' user
+    opentrepService.setSQLDBConnectString (iSQLDBConnStr);
+    OPENTREP::BasChronometer lLoadChronometer;
+    lLoadChronometer.start();
+    lBackendReport._nbOfPOR = opentrepService.insertIntoDBAndXapian();
+    lBackendReport._loadTime = lLoadChronometer.elapsed();
+  }
+
+  // Initialise the context for the look ups
+  OPENTREP::OPENTREP_Service opentrepService (ioLogStream, lTravelDBFilePath,
+                                              iDBType, iSQLDBConnStr,
+                                              lDeploymentNumber);
+
+  // All the POR have been added to the SQL database
+  BOOST_CHECK_EQUAL (lBackendReport._nbOfPOR, 9);
+  BOOST_CHECK_EQUAL (opentrepService.getNbOfPORFromDB(),
+                     lBackendReport._nbOfPOR);
+
+  // Look ups on every kind of code
+  OPENTREP::LocationList_T lLocationList;
+  BOOST_CHECK_EQUAL (opentrepService.
+                     listByIcaoCode (OPENTREP::ICAOCode_T ("lfmn"),
+                                     lLocationList), 1);
+  lLocationList.clear();
+  BOOST_CHECK_EQUAL (opentrepService.
+                     listByFaaCode (OPENTREP::FAACode_T ("lax"),
+                                    lLocationList), 1);
+  lLocationList.clear();
+  BOOST_CHECK_EQUAL (opentrepService.
+                     listByGeonameID (6299418, lLocationList), 1);
+  BOOST_REQUIRE_EQUAL (lLocationList.size(), 1);
+  BOOST_CHECK_EQUAL (lLocationList.front().getIataCode(), "NCE");
+  BOOST_CHECK_EQUAL (lLocationList.front().getIcaoCode(), "LFMN");
+  lLocationList.clear();
+  BOOST_CHECK_EQUAL (opentrepService.
+                     listByIcaoCode (OPENTREP::ICAOCode_T ("ZZZZ"),
+                                     lLocationList), 0);
+
+  // Latency of the look ups on IATA code
+  OPENTREP::BasChronometer lIataChronometer;
+  lIataChronometer.start();
+  for (unsigned short idx = 0; idx != X_NB_OF_LOOKUPS; ++idx) {
+    OPENTREP::LocationList_T lIataLocationList;
+    const OPENTREP::NbOfMatches_T& lNbOfMatches =
+      opentrepService.listByIataCode (OPENTREP::IATACode_T ("sfo"),
+                                      lIataLocationList);
+    BOOST_REQUIRE_EQUAL (lNbOfMatches, 2);
+  }
+  lBackendReport._iataLatency =
+    1000.0 * lIataChronometer.elapsed() / X_NB_OF_LOOKUPS;
+
+  // Latency of the look ups on Geonames ID
+  OPENTREP::BasChronometer lGeonameIDChronometer;
+  lGeonameIDChronometer.start();
+  for (unsigned short idx = 0; idx != X_NB_OF_LOOKUPS; ++idx) {
+    OPENTREP::LocationList_T lGeoLocationList;
+    const OPENTREP::NbOfMatches_T& lNbOfMatches =
+      opentrepService.listByGeonameID (5391989, lGeoLocationList);
+    BOOST_REQUIRE_EQUAL (lNbOfMatches, 1);
+  }
+  lBackendReport._geonameIDLatency =
+    1000.0 * lGeonameIDChronometer.elapsed() / X_NB_OF_LOOKUPS;
+
+  gBackendReportList.push_back (lBackendReport);
+}
+
+// /////////////// Main: Unit Test Suite //////////////
+
+// Set the UTF configuration (re-direct the output to a specific file)
+BOOST_GLOBAL_FIXTURE (UnitTestConfig);
+
+// Start the test suite
+BOOST_AUTO_TEST_SUITE (master_test_suite)
+
+/**
+ * Test the loading and the look ups on a SQLite3 database
+ */
+BOOST_AUTO_TEST_CASE (opentrep_sqldb_sqlite) {
+
+  // Output log File
+  std::string lLogFilename ("SQLDBBackendTestSuite_sqlite.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // With SQLite3, the database file is also the administration one
+  const OPENTREP::DBType lDBType (OPENTREP::DBType::SQLITE3);
+  const OPENTREP::SQLDBConnectionString_T lSQLDBConnStr (X_SQLITE_DB_FP);
+  checkBackend (logOutputFile, lDBType, lSQLDBConnStr, lSQLDBConnStr);
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Test the loading and the look ups on a local MariaDB/MySQL instance,
+ * when specified by the environment
+ */
+BOOST_AUTO_TEST_CASE (opentrep_sqldb_mysql) {
+
+  const char* lAdminConnStr = std::getenv (X_MYSQL_ADMIN_CONN_ENV_VAR);
+  if (lAdminConnStr == NULL) {
+    BOOST_TEST_MESSAGE (X_MYSQL_ADMIN_CONN_ENV_VAR << " is not set: the "
+                        << "MariaDB/MySQL database is skipped");
+    return;
+  }
+
+  // Output log File
+  std::string lLogFilename ("SQLDBBackendTestSuite_mysql.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  const OPENTREP::DBType lDBType (OPENTREP::DBType::MYSQL);
+  const OPENTREP::SQLDBConnectionString_T
+    lSQLDBConnStr (OPENTREP::DEFAULT_OPENTREP_MYSQL_CONN_STRING);
+  checkBackend (logOutputFile, lDBType,
+                OPENTREP::SQLDBConnectionString_T (lAdminConnStr),
+                lSQLDBConnStr);
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Test the loading and the look ups on a local PostgreSQL instance,
+ * when specified by the environment. The look ups are checked to rely
+ * on statements prepared on the server.
+ */
+BOOST_AUTO_TEST_CASE (opentrep_sqldb_pg) {
+
+  const char* lAdminConnStr = std::getenv (X_PG_ADMIN_CONN_ENV_VAR);
+  if (lAdminConnStr == NULL) {
+    BOOST_TEST_MESSAGE (X_PG_ADMIN_CONN_ENV_VAR << " is not set: the "
+                        << "PostgreSQL database is skipped");
+    return;
+  }
+
+  // Output log File
+  std::string lLogFilename ("SQLDBBackendTestSuite_pg.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  const OPENTREP::DBType lDBType (OPENTREP::DBType::PG);
+  const OPENTREP::SQLDBConnectionString_T
+    lSQLDBConnStr (OPENTREP::DEFAULT_OPENTREP_PG_CONN_STRING);
+  checkBackend (logOutputFile, lDBType,
+                OPENTREP::SQLDBConnectionString_T (lAdminConnStr),
+                lSQLDBConnStr);
+
+  // The service appends the deployment number to the database name
+  OPENTREP::Logger::instance().setLogParameters (OPENTREP::LOG::NOTIFICATION,
+                                                 logOutputFile);
+  const OPENTREP::StringMap_T& lStrMap =
+    OPENTREP::parsePGConnectionString (lSQLDBConnStr);
+  const OPENTREP::SQLDBConnectionString_T& lSQLDBConnString =
+    OPENTREP::buildPGConnectionString (lStrMap, X_DEPLOYMENT_NUMBER);
+  OPENTREP::DBConnectionPool lDBConnectionPool (lDBType, lSQLDBConnString, 1);
+  OPENTREP::DBConnectionLease lDBConnectionLease (lDBConnectionPool);
+  OPENTREP::DBConnection& lDBConnection = lDBConnectionLease.getDBConnection();
+
+  // The statement is prepared once on the server, and then re-used
+  for (unsigned short idx = 0; idx != 3; ++idx) {
+    OPENTREP::LocationList_T lLocationList;
+    BOOST_CHECK_EQUAL (OPENTREP::DBManager::
+                       getPORByIATACode (lDBConnection,
+                                         OPENTREP::IATACode_T ("nce"),
+                                         lLocationList, true), 1);
+  }
+  int lNbOfPreparedStatements = 0;
+  lDBConnection.getSession()
+    << "select count(1) from pg_prepared_statements",
+    soci::into (lNbOfPreparedStatements);
+  BOOST_CHECK_EQUAL (lNbOfPreparedStatements, 1);
+
+  // Batched look ups
+  OPENTREP::IATACodeList_T lIataCodeList;
+  lIataCodeList.push_back (OPENTREP::IATACode_T ("nce"));
+  lIataCodeList.push_back (OPENTREP::IATACode_T ("zzz"));
+  lIataCodeList.push_back (OPENTREP::IATACode_T ("SFO"));
+  OPENTREP::LocationListList_T lLocationListList;
+  BOOST_CHECK_EQUAL (OPENTREP::DBManager::
+                     getPORByIATACodeList (lDBConnection, lIataCodeList,
+                                           lLocationListList, false), 4);
+  BOOST_REQUIRE_EQUAL (lLocationListList.size(), 3);
+  BOOST_CHECK_EQUAL (lLocationListList[0].size(), 2);
+  BOOST_CHECK_EQUAL (lLocationListList[1].size(), 0);
+  BOOST_CHECK_EQUAL (lLocationListList[2].size(), 2);
+
+  OPENTREP::GeonamesIDList_T lGeonamesIDList;
+  lGeonamesIDList.push_back (5368361);
+  lGeonamesIDList.push_back (2990440);
+  BOOST_CHECK_EQUAL (OPENTREP::DBManager::
+                     getPORByGeonameIDList (lDBConnection, lGeonamesIDList,
+                                            lLocationListList), 2);
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Report the load time and the look up latency of the tested back-ends,
+ * next to each other
+ */
+BOOST_AUTO_TEST_CASE (opentrep_sqldb_report) {
+
+  std::ostringstream oStr;
+  oStr << std::setw (16) << std::left << "SQL database"
+       << std::setw (8) << std::right << "#POR"
+       << std::setw (14) << "load (s)"
+       << std::setw (20) << "IATA look up (ms)"
+       << std::setw (22) << "Geonames look up (ms)" << std::endl;
+  for (std::vector<BackendReport>::const_iterator itReport =
+         gBackendReportList.begin();
+       itReport != gBackendReportList.end(); ++itReport) {
+    const BackendReport& lBackendReport = *itReport;
+    oStr << std::setw (16) << std::left << lBackendReport._sqlDBType
+         << std::setw (8) << std::right << lBackendReport._nbOfPOR
+         << std::fixed << std::setprecision (3)
+         << std::setw (14) << lBackendReport._loadTime
+         << std::setw (20) << lBackendReport._iataLatency
+         << std::setw (22) << lBackendReport._geonameIDLatency << std::endl;
+  }
+
+  BOOST_TEST_MESSAGE (oStr.str());
+  std::cout << oStr.str();
+
+  // At least SQLite3 has been measured
+  BOOST_CHECK (gBackendReportList.empty() == false);
+}
+
+// End the test suite
+BOOST_AUTO_TEST_SUITE_END()
+
+/*!
+ * \endcode
+ */
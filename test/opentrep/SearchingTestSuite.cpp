@@ -112,6 +112,58 @@ BOOST_AUTO_TEST_CASE (opentrep_simple_search) {
   logOutputFile.close();
 }
 
+/**
+ * Test a travel search made only of codes, which is answered by the
+ * in-memory dictionary of codes, even without any SQL database
+ */
+BOOST_AUTO_TEST_CASE (opentrep_code_search) {
+
+  // Output log File
+  std::string lLogFilename ("SearchingTestSuite_code.log");
+
+  // Travel query, made of IATA and ICAO codes
+  std::string lTravelQuery ("lax kef lfmn");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the context
+  const OPENTREP::TravelDBFilePath_T lTravelDBFilePath (X_XAPIAN_DB_FP);
+  const OPENTREP::DBType lDBType (OPENTREP::DBType::NODB);
+  const OPENTREP::SQLDBConnectionString_T lSQLDBConnStr (X_SQL_DB_STR);
+  const OPENTREP::DeploymentNumber_T lDeploymentNumber (X_DEPLOYMENT_NUMBER);
+  OPENTREP::OPENTREP_Service opentrepService (logOutputFile, lTravelDBFilePath,
+                                              lDBType, lSQLDBConnStr,
+                                              lDeploymentNumber);
+
+  // Query the Xapian database (index)
+  OPENTREP::WordList_T lNonMatchedWordList;
+  OPENTREP::LocationList_T lLocationList;
+  const OPENTREP::NbOfMatches_T nbOfMatches =
+    opentrepService.interpretTravelRequest (lTravelQuery, lLocationList,
+                                            lNonMatchedWordList);
+  BOOST_CHECK_MESSAGE (nbOfMatches == 3,
+                       "The travel query ('" << lTravelQuery
+                       << "') matches with " << nbOfMatches
+                       << " key-words, whereas 3 are expected.");
+  BOOST_REQUIRE (lLocationList.empty() == false);
+
+  // Among the POR having the LAX IATA code, the city (Geonames ID 5368361)
+  // has the highest PageRank value
+  const OPENTREP::Location& lLocation = lLocationList.front();
+  const OPENTREP::GeonamesID_T& lGeonamesID =
+    lLocation.getKey().getGeonamesID();
+  BOOST_CHECK_MESSAGE (lGeonamesID == 5368361,
+                       "The Geonames ID of LAX is " << lGeonamesID
+                       << ", whereas 5368361 is expected.");
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
 // End the test suite
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -21,6 +21,9 @@
 // OpenTrep
 #include <opentrep/basic/OTransliterator.hpp>
 #include <opentrep/bom/QuerySlices.hpp>
+#include <opentrep/bom/PhraseProbe.hpp>
+#include <opentrep/bom/VocabularySketch.hpp>
+#include <opentrep/bom/SpellingSuggestionCache.hpp>
 #include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
 #include <opentrep/OPENTREP_Service.hpp>
 #include <opentrep/service/Logger.hpp>
@@ -121,12 +124,20 @@ BOOST_AUTO_TEST_CASE (slice_small_string) {
   oStr << lTravelDBFilePath << lDeploymentNumber;
   Xapian::Database lXapianDatabase (oStr.str());
 
+  // Load the vocabulary sketch, built along with the Xapian database. When
+  // there is none, it is not enabled, and the slices are the same
+  const OPENTREP::TravelDBFilePath_T lActualTravelDBFilePath (oStr.str());
+  OPENTREP::VocabularySketch lVocabularySketch;
+  lVocabularySketch.load (OPENTREP::VocabularySketch::
+                          getFilePath (lActualTravelDBFilePath),
+                          lXapianDatabase);
+
   // Create a Unicode transliterator
   const OPENTREP::OTransliterator lTransliterator;
       
   // Create the query slices
-  OPENTREP::QuerySlices lQuerySlices (lXapianDatabase, lLwoIevHrk1Str,
-                                      lTransliterator);
+  OPENTREP::QuerySlices lQuerySlices (lXapianDatabase, lVocabularySketch,
+                                      lLwoIevHrk1Str, lTransliterator);
 
   // DEBUG
   OPENTREP_LOG_DEBUG (lQuerySlices.size() << " slices: "
@@ -140,7 +151,8 @@ BOOST_AUTO_TEST_CASE (slice_small_string) {
                        << ".");
 
   // Create other query slices
-  OPENTREP::QuerySlices lAnotherQuerySlices (lXapianDatabase, lChelseaStr,
+  OPENTREP::QuerySlices lAnotherQuerySlices (lXapianDatabase,
+                                             lVocabularySketch, lChelseaStr,
                                              lTransliterator);
 
   // DEBUG
@@ -158,6 +170,200 @@ BOOST_AUTO_TEST_CASE (slice_small_string) {
   logOutputFile.close();
 }
 
+/**
+ * Test the probe of the phrases made of two contiguous words
+ */
+BOOST_AUTO_TEST_CASE (slice_phrase_probe) {
+
+  // Output log File
+  const std::string lLogFilename ("SliceTestSuite_probe.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the context
+  const OPENTREP::TravelDBFilePath_T lTravelDBFilePath (X_XAPIAN_DB_FP);
+  const OPENTREP::DBType lDBType (OPENTREP::DBType::NODB);
+  const OPENTREP::SQLDBConnectionString_T lSQLDBConnStr (X_SQL_DB_STR);
+  const OPENTREP::DeploymentNumber_T lDeploymentNumber (X_DEPLOYMENT_NUMBER);
+  OPENTREP::OPENTREP_Service opentrepService (logOutputFile, lTravelDBFilePath,
+                                              lDBType, lSQLDBConnStr,
+                                              lDeploymentNumber);
+
+  // Open the Xapian database (the deployment number/version is added to the
+  // file-path
+  std::ostringstream oStr;
+  oStr << lTravelDBFilePath << lDeploymentNumber;
+  Xapian::Database lXapianDatabase (oStr.str());
+
+  // Build the vocabulary sketch of the Xapian database
+  OPENTREP::VocabularySketch lVocabularySketch;
+  lVocabularySketch.build (lXapianDatabase, 0.01);
+  BOOST_CHECK (lVocabularySketch.isEnabled() == true);
+
+  // The probe of the thread is re-used, as long as the Xapian database
+  // stays the same
+  OPENTREP::PhraseProbe& lPhraseProbe =
+    OPENTREP::PhraseProbe::getThreadProbe (lXapianDatabase, lVocabularySketch);
+  BOOST_CHECK (&lPhraseProbe
+               == &OPENTREP::PhraseProbe::getThreadProbe (lXapianDatabase,
+                                                          lVocabularySketch));
+
+  // Phrases present within the Xapian index, whatever the case
+  BOOST_CHECK (lPhraseProbe.doesMatch ("los", "angeles") == true);
+  BOOST_CHECK (lPhraseProbe.doesMatch ("Los", "Angeles") == true);
+  BOOST_CHECK (lPhraseProbe.doesMatch ("san", "francisco") == true);
+  BOOST_CHECK (lPhraseProbe.doesMatch ("rio", "de") == true);
+
+  // Phrases absent from the Xapian index (see also the slices of
+  // 'lviv kiev kharkov' above)
+  BOOST_CHECK (lPhraseProbe.doesMatch ("lviv", "kiev") == false);
+  BOOST_CHECK (lPhraseProbe.doesMatch ("kiev", "kharkov") == false);
+
+  // Terms absent from the Xapian index
+  OPENTREP::PhraseProbe::TermList_T lTermList;
+  lTermList.push_back ("zzzzzzzz");
+  lTermList.push_back ("angeles");
+  BOOST_CHECK (lPhraseProbe.doesPhraseExist (lTermList) == false);
+
+  // The sketch, once stored and loaded back, gives the same answers
+  const std::string lSketchFilePath ("SliceTestSuite_sketch.bin");
+  lVocabularySketch.save (lSketchFilePath);
+  OPENTREP::VocabularySketch lLoadedVocabularySketch;
+  BOOST_CHECK (lLoadedVocabularySketch.load (lSketchFilePath, lXapianDatabase)
+               == true);
+  BOOST_CHECK (lLoadedVocabularySketch.describe()
+               == lVocabularySketch.describe());
+  BOOST_CHECK (lLoadedVocabularySketch.mayContainTerm ("angeles") == true);
+  BOOST_CHECK (lLoadedVocabularySketch.mayContainTerm ("zzzzzzzz")
+               == lVocabularySketch.mayContainTerm ("zzzzzzzz"));
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Test the vocabulary sketch, independently from any Xapian database
+ */
+BOOST_AUTO_TEST_CASE (slice_vocabulary_sketch) {
+
+  // As long as it is not enabled, the sketch cannot reject anything
+  OPENTREP::VocabularySketch lVocabularySketch;
+  BOOST_CHECK (lVocabularySketch.isEnabled() == false);
+  BOOST_CHECK (lVocabularySketch.mayContainTerm ("zzzzzzzz") == true);
+
+  // Index a few names
+  const std::string lNameArray[] = { "san francisco", "rio de janeiro",
+                                     "los angeles", "lviv", "kiev",
+                                     "kharkiv", "chelsea municipal airport" };
+  const size_t lNbOfNames = sizeof (lNameArray) / sizeof (lNameArray[0]);
+  for (size_t idx = 0; idx != lNbOfNames; ++idx) {
+    OPENTREP::VocabularySketch::TermList_T lTermList;
+    OPENTREP::VocabularySketch::deriveTerms (lNameArray[idx], lTermList);
+    lVocabularySketch.addTerms (lTermList);
+  }
+  lVocabularySketch.finalise (0.01);
+  BOOST_CHECK (lVocabularySketch.isEnabled() == true);
+
+  // Whatever the rate of false positives, there is no false negative
+  for (size_t idx = 0; idx != lNbOfNames; ++idx) {
+    OPENTREP::VocabularySketch::TermList_T lTermList;
+    OPENTREP::VocabularySketch::deriveTerms (lNameArray[idx], lTermList);
+    BOOST_CHECK (lVocabularySketch.mayContainPhrase (lTermList) == true);
+  }
+  BOOST_CHECK (lVocabularySketch.mayContainTerm ("janeiro") == true);
+
+  // Unknown words, and known words which are not contiguous in any name
+  OPENTREP::VocabularySketch::TermList_T lUnknownTermList;
+  OPENTREP::VocabularySketch::deriveTerms ("Sna Francicso", lUnknownTermList);
+  BOOST_CHECK (lVocabularySketch.mayContainPhrase (lUnknownTermList) == false);
+
+  OPENTREP::VocabularySketch::TermList_T lDisjointTermList;
+  OPENTREP::VocabularySketch::deriveTerms ("lviv kiev", lDisjointTermList);
+  BOOST_CHECK (lVocabularySketch.mayContainPhrase (lDisjointTermList) == false);
+
+  OPENTREP::VocabularySketch::TermList_T lReversedTermList;
+  OPENTREP::VocabularySketch::deriveTerms ("angeles los", lReversedTermList);
+  BOOST_CHECK (lVocabularySketch.mayContainPhrase (lReversedTermList) == false);
+}
+
+/**
+ * Test the cache of the spelling suggestions, including the absences
+ * of suggestion
+ */
+BOOST_AUTO_TEST_CASE (slice_spelling_suggestion_cache) {
+
+  // Output log File
+  const std::string lLogFilename ("SliceTestSuite_spelling.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the context
+  const OPENTREP::TravelDBFilePath_T lTravelDBFilePath (X_XAPIAN_DB_FP);
+  const OPENTREP::DBType lDBType (OPENTREP::DBType::NODB);
+  const OPENTREP::SQLDBConnectionString_T lSQLDBConnStr (X_SQL_DB_STR);
+  const OPENTREP::DeploymentNumber_T lDeploymentNumber (X_DEPLOYMENT_NUMBER);
+  OPENTREP::OPENTREP_Service opentrepService (logOutputFile, lTravelDBFilePath,
+                                              lDBType, lSQLDBConnStr,
+                                              lDeploymentNumber);
+
+  // Open the Xapian database (the deployment number/version is added to the
+  // file-path
+  std::ostringstream oStr;
+  oStr << lTravelDBFilePath << lDeploymentNumber;
+  Xapian::Database lXapianDatabase (oStr.str());
+
+  // The spelling suggestion is computed by Xapian only once
+  OPENTREP::SpellingSuggestionCache lSpellingSuggestionCache (100);
+  OPENTREP::NbOfErrors_T lEditDistance = 0;
+  const std::string& lCorrectedString =
+    lSpellingSuggestionCache.getSpellingSuggestion (lXapianDatabase,
+                                                    "francicso", 2,
+                                                    lEditDistance);
+  BOOST_CHECK_EQUAL (lCorrectedString, "francisco");
+  BOOST_CHECK_EQUAL (lEditDistance, 1);
+  BOOST_CHECK_EQUAL (lSpellingSuggestionCache.getNbOfMisses(), 1);
+
+  OPENTREP::NbOfErrors_T lCachedEditDistance = 0;
+  BOOST_CHECK_EQUAL (lSpellingSuggestionCache.
+                     getSpellingSuggestion (lXapianDatabase, "francicso", 2,
+                                            lCachedEditDistance),
+                     lCorrectedString);
+  BOOST_CHECK_EQUAL (lCachedEditDistance, lEditDistance);
+  BOOST_CHECK_EQUAL (lSpellingSuggestionCache.getNbOfHits(), 1);
+
+  // Another allowable edit distance is another entry
+  lSpellingSuggestionCache.getSpellingSuggestion (lXapianDatabase,
+                                                  "francicso", 1,
+                                                  lCachedEditDistance);
+  BOOST_CHECK_EQUAL (lSpellingSuggestionCache.getNbOfMisses(), 2);
+
+  // So is the absence of suggestion
+  BOOST_CHECK (lSpellingSuggestionCache.
+               getSpellingSuggestion (lXapianDatabase, "zzzzzzzz", 2,
+                                      lEditDistance).empty() == true);
+  BOOST_CHECK (lSpellingSuggestionCache.
+               getSpellingSuggestion (lXapianDatabase, "zzzzzzzz", 2,
+                                      lEditDistance).empty() == true);
+  BOOST_CHECK_EQUAL (lEditDistance, 0);
+  BOOST_CHECK_EQUAL (lSpellingSuggestionCache.getNbOfHits(), 2);
+  BOOST_CHECK_EQUAL (lSpellingSuggestionCache.getSize(), 3);
+
+  // The cache may be emptied
+  lSpellingSuggestionCache.clear();
+  BOOST_CHECK_EQUAL (lSpellingSuggestionCache.getSize(), 0);
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
 // End the test suite
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -17,7 +17,9 @@
 #define BOOST_TEST_MODULE UnicodeTestSuite
 #include <boost/test/unit_test.hpp>
 // OpenTrep
+#include <opentrep/basic/BasChronometer.hpp>
 #include <opentrep/basic/OTransliterator.hpp>
+#include <opentrep/basic/NormalisationCache.hpp>
 
 namespace boost_utf = boost::unit_test;
 
@@ -212,6 +214,177 @@ BOOST_AUTO_TEST_CASE (unicode_strings) {
   logOutputFile.close();
 }
 
+/**
+ * Test the cache of the Unicode normalisations
+ */
+BOOST_AUTO_TEST_CASE (unicode_normalisation_cache) {
+
+  // Output log File
+  std::string lLogFilename ("UnicodeTestSuite_cache.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Unicode transliterator
+  OPENTREP::OTransliterator lTransliterator;
+
+  std::list<std::string> lStringList;
+  lStringList.push_back ("À côté de Nice Côte d'Azur");
+  lStringList.push_back ("Аэропорт «Аннаба», Биологическом");
+  lStringList.push_back ("舊金山國際機場");
+  lStringList.push_back ("Sân bay quốc tế San Francisco");
+
+  // Cache large enough for all the strings: every string is normalised
+  // by ICU only once
+  OPENTREP::NormalisationCache lNormalisationCache (lTransliterator, 10);
+  for (unsigned short idx = 0; idx != 3; ++idx) {
+    for (std::list<std::string>::const_iterator itString =
+           lStringList.begin(); itString != lStringList.end(); ++itString) {
+      const std::string& lString = *itString;
+      const std::string& lNormalisedStr = lTransliterator.normalise (lString);
+      const std::string& lCachedStr = lNormalisationCache.normalise (lString);
+      BOOST_CHECK_MESSAGE (lCachedStr == lNormalisedStr,
+                           "The cached normalisation of '" << lString
+                           << "' should be '" << lNormalisedStr << "'. "
+                           << "However, it is '" << lCachedStr << "'.");
+    }
+  }
+  logOutputFile << lNormalisationCache.describe() << std::endl;
+
+  BOOST_CHECK_MESSAGE (lNormalisationCache.getNbOfMisses() == 4
+                       && lNormalisationCache.getNbOfHits() == 8,
+                       "The cache should have been missed 4 times and hit "
+                       << "8 times. However: "
+                       << lNormalisationCache.describe());
+
+  // Cache smaller than the number of strings: the cache never holds more
+  // normalisations than its capacity, and the least recently used one
+  // is evicted
+  OPENTREP::NormalisationCache lSmallCache (lTransliterator, 2);
+  for (std::list<std::string>::const_iterator itString = lStringList.begin();
+       itString != lStringList.end(); ++itString) {
+    lSmallCache.normalise (*itString);
+    BOOST_CHECK (lSmallCache.getSize() <= 2);
+  }
+  lSmallCache.normalise (lStringList.back());
+  lSmallCache.normalise (lStringList.front());
+  logOutputFile << lSmallCache.describe() << std::endl;
+
+  BOOST_CHECK_MESSAGE (lSmallCache.getNbOfHits() == 1
+                       && lSmallCache.getNbOfMisses() == 5
+                       && lSmallCache.getNbOfEvictions() == 3,
+                       "The small cache should have been hit once, missed "
+                       << "5 times and should have evicted 3 normalisations. "
+                       << "However: " << lSmallCache.describe());
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Check that the fused (single-pass) normalisation gives the same result
+ * as the separate transformations, and measure both of them
+ */
+BOOST_AUTO_TEST_CASE (unicode_fused_normalisation) {
+
+  // Output log File
+  std::string lLogFilename ("UnicodeTestSuite_fused.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Unicode transliterator
+  OPENTREP::OTransliterator lTransliterator;
+
+  std::list<std::string> lStringList;
+  lStringList.push_back ("");
+  lStringList.push_back ("nice");
+  lStringList.push_back ("À côté de Nice Côte d'Azur");
+  lStringList.push_back ("San Franciscó-i nemzetközi repülőtér");
+  lStringList.push_back ("Αλφαβητικός Κατάλογος");
+  lStringList.push_back ("Аэропорт «Аннаба», Биологическом");
+  lStringList.push_back ("San Francisco Uluslararası Havalimanı");
+  lStringList.push_back ("مطار سان فرانسيسكو الدولي");
+  lStringList.push_back ("舊金山國際機場");
+  lStringList.push_back ("サンフランシスコ国際空港");
+  lStringList.push_back ("샌프란시스코 국제공항");
+  lStringList.push_back ("ท่าอากาศยานนานาชาติซานฟรานซิสโก");
+  lStringList.push_back ("Sân bay quốc tế San Francisco");
+  lStringList.push_back ("Rio de Janeiro/RJ/BR:Galeão \u201CTom Jobim\u201D");
+  lStringList.push_back ("Xi\u02B9an Xianyang \u201CInternational\u201D");
+
+  // The fused transformations give the same result as the separate ones
+  for (std::list<std::string>::const_iterator itString = lStringList.begin();
+       itString != lStringList.end(); ++itString) {
+    const std::string& lString = *itString;
+
+    const std::string& lFusedStr = lTransliterator.normalise (lString);
+    const std::string& lSeparateStr =
+      lTransliterator.transliterate (lTransliterator.unpunctuate
+                                     (lTransliterator.unquote
+                                      (lTransliterator.unaccent (lString))));
+    logOutputFile << lString << " -> " << lFusedStr << std::endl;
+    BOOST_CHECK_MESSAGE (lFusedStr == lSeparateStr,
+                         "The normalised string for '" << lString
+                         << "' should be '" << lSeparateStr << "'. "
+                         << "However, it is '" << lFusedStr << "'.");
+
+    const std::string& lFusedQueryStr =
+      lTransliterator.unpunctuateAndUnquote (lString);
+    const std::string& lSeparateQueryStr =
+      lTransliterator.unquote (lTransliterator.unpunctuate (lString));
+    BOOST_CHECK_MESSAGE (lFusedQueryStr == lSeparateQueryStr,
+                         "The unpunctuated and unquoted string for '"
+                         << lString << "' should be '" << lSeparateQueryStr
+                         << "'. However, it is '" << lFusedQueryStr << "'.");
+  }
+
+  // Measure the number of normalisations per second, with the separate
+  // and with the fused transformations
+  const unsigned int lNbOfRounds = 100;
+  const unsigned int lNbOfNormalisations = lNbOfRounds * lStringList.size();
+
+  OPENTREP::BasChronometer lSeparateChronometer;
+  lSeparateChronometer.start();
+  for (unsigned int idx = 0; idx != lNbOfRounds; ++idx) {
+    for (std::list<std::string>::const_iterator itString =
+           lStringList.begin(); itString != lStringList.end(); ++itString) {
+      lTransliterator.transliterate (lTransliterator.unpunctuate
+                                     (lTransliterator.unquote
+                                      (lTransliterator.unaccent (*itString))));
+    }
+  }
+  const double lSeparateElapsed = lSeparateChronometer.elapsed();
+
+  OPENTREP::BasChronometer lFusedChronometer;
+  lFusedChronometer.start();
+  for (unsigned int idx = 0; idx != lNbOfRounds; ++idx) {
+    for (std::list<std::string>::const_iterator itString =
+           lStringList.begin(); itString != lStringList.end(); ++itString) {
+      lTransliterator.normalise (*itString);
+    }
+  }
+  const double lFusedElapsed = lFusedChronometer.elapsed();
+
+  logOutputFile << "Separate transformations: " << lNbOfNormalisations
+                << " normalisations in " << lSeparateElapsed << " s, i.e. "
+                << lNbOfNormalisations / lSeparateElapsed
+                << " normalisations per second" << std::endl;
+  logOutputFile << "Fused transformations: " << lNbOfNormalisations
+                << " normalisations in " << lFusedElapsed << " s, i.e. "
+                << lNbOfNormalisations / lFusedElapsed
+                << " normalisations per second" << std::endl;
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
 // End the test suite
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -1,107 +1,117 @@
-// Levenshtein Distance Algorithm: C++ Implementation by Anders Sewerin Johansen
+// Levenshtein Distance Algorithm: differential and performance tests of
+// the bit-parallel implementation against the reference one.
 // STL
 #include <iostream>
 #include <string>
 #include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+// OpenTREP
+#include <opentrep/bom/Levenshtein.hpp>
+
+// //////////// Constants for the tests ///////////////
+/**
+ * Number of random pairs of strings compared by the differential test.
+ */
+const unsigned int K_NB_OF_RANDOM_PAIRS = 20000;
+
+/**
+ * Maximum length of the random strings. It is over 128, so that the
+ * bit-vectors span several (64-bit) blocks.
+ */
+const unsigned int K_MAX_RANDOM_LENGTH = 150;
+
+/**
+ * Number of runs of the performance test.
+ */
+const unsigned int K_NB_OF_PERFORMANCE_RUNS = 20000;
 
 // //////////////////////////////////////////////////////////////////
-int getLevenshteinDistance (const std::string& source,
-                            const std::string& target) {
-
-  // Step 1
-
-  const int n = source.length();
-  const int m = target.length();
-  if (n == 0) {
-    return m;
-  }
-  if (m == 0) {
-    return n;
-  }
-
-  // Definition of Matrix Type
-  typedef std::vector< std::vector<int> > Matrix_T; 
-
-  Matrix_T matrix (n+1);
-
-  // Size the vectors in the 2.nd dimension. Unfortunately C++ doesn't
-  // allow for allocation on declaration of 2.nd dimension of vec of vec
-
-  for (int i = 0; i <= n; i++) {
-    matrix[i].resize(m+1);
-  }
-
-  // Step 2
-
-  for (int i = 0; i <= n; i++) {
-    matrix[i][0]=i;
+/**
+ * Check that the given distance is the expected one.
+ *
+ * @return bool Whether the distance is the expected one.
+ */
+bool checkDistance (const std::string& iSource, const std::string& iTarget,
+                    const std::string& iMethod, const int iDistance,
+                    const int iExpectedDistance) {
+  if (iDistance == iExpectedDistance) {
+    return true;
   }
+  std::cerr << iMethod << ": the distance between '" << iSource
+            << "' and '" << iTarget << "' is " << iDistance
+            << ", whereas " << iExpectedDistance << " was expected"
+            << std::endl;
+  return false;
+}
 
-  for (int j = 0; j <= m; j++) {
-    matrix[0][j]=j;
+// //////////////////////////////////////////////////////////////////
+/**
+ * Generate a random string. The alphabet is small, so that the strings
+ * share many letters (and transpositions).
+ */
+std::string generateRandomString (std::mt19937& ioGenerator,
+                                  const unsigned int iMaxLength) {
+  static const std::string lAlphabet ("abcde ");
+  std::uniform_int_distribution<unsigned int> lLengthDistribution (0,
+                                                                   iMaxLength);
+  std::uniform_int_distribution<unsigned int>
+    lLetterDistribution (0, lAlphabet.size() - 1);
+
+  const unsigned int lLength = lLengthDistribution (ioGenerator);
+  std::string oString;
+  for (unsigned int idx = 0; idx != lLength; ++idx) {
+    oString.push_back (lAlphabet[lLetterDistribution (ioGenerator)]);
   }
+  return oString;
+}
 
-  // Step 3
-
-  for (int i = 1; i <= n; i++) {
-
-    const char s_i = source[i-1];
-
-    // Step 4
-
-    for (int j = 1; j <= m; j++) {
-
-      const char t_j = target[j-1];
-
-      // Step 5
-
-      int cost;
-      if (s_i == t_j) {
-        cost = 0;
+// //////////////////////////////////////////////////////////////////
+/**
+ * Misspell the given string, with a few random edits (substitutions,
+ * insertions, deletions and transpositions).
+ */
+std::string misspellString (std::mt19937& ioGenerator,
+                            const std::string& iString) {
+  std::string oString (iString);
+  std::uniform_int_distribution<unsigned int> lNbOfEditsDistribution (0, 4);
+  std::uniform_int_distribution<unsigned int> lEditTypeDistribution (0, 3);
+  const unsigned int lNbOfEdits = lNbOfEditsDistribution (ioGenerator);
+
+  for (unsigned int idx = 0; idx != lNbOfEdits; ++idx) {
+    std::uniform_int_distribution<unsigned int>
+      lPositionDistribution (0, oString.size());
+    const unsigned int lPosition = lPositionDistribution (ioGenerator);
+    switch (lEditTypeDistribution (ioGenerator)) {
+    case 0:
+      if (lPosition < oString.size()) {
+        oString[lPosition] = 'z';
       }
-      else {
-        cost = 1;
+      break;
+    case 1:
+      oString.insert (lPosition, 1, 'y');
+      break;
+    case 2:
+      if (lPosition < oString.size()) {
+        oString.erase (lPosition, 1);
       }
-
-      // Step 6
-
-      const int above = matrix[i-1][j];
-      const int left = matrix[i][j-1];
-      const int diag = matrix[i-1][j-1];
-      int cell = std::min ( above + 1, std::min (left + 1, diag + cost));
-
-      // Step 6A: Cover transposition, in addition to deletion,
-      // insertion and substitution. This step is taken from:
-      // Berghel, Hal ; Roach, David : "An Extension of Ukkonen's 
-      // Enhanced Dynamic Programming ASM Algorithm"
-      // (http://www.acm.org/~hlb/publications/asm/asm.html)
-
-      if (i>2 && j>2) {
-        int trans = matrix[i-2][j-2] + 1;
-        if (source[i-2] != t_j) {
-          trans++;
-        }
-        if (s_i != target[j-2]) {
-          trans++;
-        }
-        if (cell > trans) {
-          cell = trans;
-        }
+      break;
+    default:
+      if (lPosition + 1 < oString.size()) {
+        std::swap (oString[lPosition], oString[lPosition + 1]);
       }
-
-      matrix[i][j] = cell;
+      break;
     }
   }
-
-  // Step 7
-
-  return matrix[n][m];
+  return oString;
 }
 
-
 // /////////// M A I N ////////////////
-int main (int argc, char* argv[]) {
+int main() {
+  unsigned int lNbOfErrors = 0;
 
+  // Known pairs of strings
   const std::string lLax1Str = "los angeles";
   const std::string lLax2Str = "lso angeles";
   const std::string lRio1Str = "rio de janeiro";
@@ -111,21 +121,121 @@ int main (int argc, char* argv[]) {
   const std::string lSfoRio1Str = "san francisco rio de janeiro";
   const std::string lSfoRio2Str = "san francicso rio de janero";
 
-  std::cout << "Distance between '" << lLax1Str
-            << "' and '" << lLax2Str << "' is: "
-            << getLevenshteinDistance (lLax1Str, lLax2Str) << std::endl;
-  
-  std::cout << "Distance between '" << lRio1Str
-            << "' and '" << lRio2Str << "' is: "
-            << getLevenshteinDistance (lRio1Str, lRio2Str) << std::endl;
-  
-  std::cout << "Distance between '" << lRek1Str
-            << "' and '" << lRek2Str << "' is: "
-            << getLevenshteinDistance (lRek1Str, lRek2Str) << std::endl;
-  
-  std::cout << "Distance between '" << lSfoRio1Str
-            << "' and '" << lSfoRio2Str << "' is: "
-            << getLevenshteinDistance (lSfoRio1Str, lSfoRio2Str) << std::endl;
-  
-  return 0;
+  typedef std::vector<std::pair<std::string, std::string> > PairList_T;
+  PairList_T lKnownPairList;
+  lKnownPairList.push_back (std::make_pair (lLax1Str, lLax2Str));
+  lKnownPairList.push_back (std::make_pair (lRio1Str, lRio2Str));
+  lKnownPairList.push_back (std::make_pair (lRek1Str, lRek2Str));
+  lKnownPairList.push_back (std::make_pair (lSfoRio1Str, lSfoRio2Str));
+  lKnownPairList.push_back (std::make_pair ("", ""));
+  lKnownPairList.push_back (std::make_pair ("", "nce"));
+  lKnownPairList.push_back (std::make_pair ("ab", "ba"));
+  lKnownPairList.push_back (std::make_pair ("abc", "acb"));
+
+  for (PairList_T::const_iterator itPair = lKnownPairList.begin();
+       itPair != lKnownPairList.end(); ++itPair) {
+    const std::string& lSource = itPair->first;
+    const std::string& lTarget = itPair->second;
+    const int lDistance = OPENTREP::Levenshtein::getDistance (lSource,
+                                                              lTarget);
+    const int lBoundedDistance =
+      OPENTREP::Levenshtein::getBoundedDistance (lSource, lTarget, -1, false);
+
+    std::cout << "Distance between '" << lSource << "' and '" << lTarget
+              << "' is: " << lDistance << std::endl;
+    if (checkDistance (lSource, lTarget, "Bit-parallel", lBoundedDistance,
+                       lDistance) == false) {
+      ++lNbOfErrors;
+    }
+  }
+
+  // Differential test on random pairs of strings, with and without
+  // maximum distance
+  std::mt19937 lGenerator (42);
+  std::uniform_int_distribution<int> lMaxDistanceDistribution (0, 6);
+  for (unsigned int idx = 0; idx != K_NB_OF_RANDOM_PAIRS; ++idx) {
+    const std::string lSource =
+      generateRandomString (lGenerator, K_MAX_RANDOM_LENGTH);
+    const std::string lTarget = (idx % 2 == 0) ?
+      misspellString (lGenerator, lSource)
+      : generateRandomString (lGenerator, K_MAX_RANDOM_LENGTH);
+
+    const int lDistance = OPENTREP::Levenshtein::getDistance (lSource,
+                                                              lTarget);
+    const int lBoundedDistance =
+      OPENTREP::Levenshtein::getBoundedDistance (lSource, lTarget, -1, false);
+    if (checkDistance (lSource, lTarget, "Bit-parallel", lBoundedDistance,
+                       lDistance) == false) {
+      ++lNbOfErrors;
+    }
+
+    // Without any multi-byte character, the code points are the bytes
+    const int lCodePointDistance =
+      OPENTREP::Levenshtein::getBoundedDistance (lSource, lTarget, -1, true);
+    if (checkDistance (lSource, lTarget, "Bit-parallel (code points)",
+                       lCodePointDistance, lDistance) == false) {
+      ++lNbOfErrors;
+    }
+
+    const int lMaxDistance = lMaxDistanceDistribution (lGenerator);
+    const int lExpectedDistance = std::min (lDistance, lMaxDistance + 1);
+    const int lCappedDistance =
+      OPENTREP::Levenshtein::getBoundedDistance (lSource, lTarget,
+                                                 lMaxDistance, false);
+    if (checkDistance (lSource, lTarget, "Bounded bit-parallel",
+                       lCappedDistance, lExpectedDistance) == false) {
+      ++lNbOfErrors;
+    }
+  }
+
+  // Unicode code points rather than bytes: "ü" is made of two bytes
+  const std::string lZrh1Str = "zurich";
+  const std::string lZrh2Str = "z\xC3\xBCrich";
+  if (checkDistance (lZrh1Str, lZrh2Str, "Bit-parallel (bytes)",
+                     OPENTREP::Levenshtein::getBoundedDistance (lZrh1Str,
+                                                                lZrh2Str,
+                                                                -1, false),
+                     2) == false) {
+    ++lNbOfErrors;
+  }
+  if (checkDistance (lZrh1Str, lZrh2Str, "Bit-parallel (code points)",
+                     OPENTREP::Levenshtein::getBoundedDistance (lZrh1Str,
+                                                                lZrh2Str,
+                                                                -1, true),
+                     1) == false) {
+    ++lNbOfErrors;
+  }
+
+  // Performance of both implementations, on a typical misspelled query
+  int lChecksum = 0;
+  const std::chrono::steady_clock::time_point lReferenceStart =
+    std::chrono::steady_clock::now();
+  for (unsigned int idx = 0; idx != K_NB_OF_PERFORMANCE_RUNS; ++idx) {
+    lChecksum += OPENTREP::Levenshtein::getDistance (lSfoRio1Str, lSfoRio2Str);
+  }
+  const std::chrono::steady_clock::time_point lBitParallelStart =
+    std::chrono::steady_clock::now();
+  for (unsigned int idx = 0; idx != K_NB_OF_PERFORMANCE_RUNS; ++idx) {
+    lChecksum -=
+      OPENTREP::Levenshtein::getBoundedDistance (lSfoRio1Str, lSfoRio2Str,
+                                                 -1, false);
+  }
+  const std::chrono::steady_clock::time_point lEnd =
+    std::chrono::steady_clock::now();
+
+  typedef std::chrono::duration<double, std::micro> Microseconds_T;
+  std::cout << K_NB_OF_PERFORMANCE_RUNS << " runs of the reference "
+            << "implementation: "
+            << Microseconds_T (lBitParallelStart - lReferenceStart).count()
+            << " micro-seconds; of the bit-parallel implementation: "
+            << Microseconds_T (lEnd - lBitParallelStart).count()
+            << " micro-seconds" << std::endl;
+  if (lChecksum != 0) {
+    std::cerr << "The implementations disagree on the performance test"
+              << std::endl;
+    ++lNbOfErrors;
+  }
+
+  std::cout << lNbOfErrors << " error(s)" << std::endl;
+  return (lNbOfErrors == 0) ? 0 : 1;
 }